@@ -0,0 +1,148 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/Arena.h"
+
+#include "carla/Debug.h"
+#include "carla/profiler/Metrics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace carla {
+
+  using profiler::Metrics;
+
+  // ===========================================================================
+  // -- MonotonicArena ---------------------------------------------------------
+  // ===========================================================================
+
+  MonotonicArena::MonotonicArena(const size_t initial_size) {
+    AddBlock(std::max<size_t>(initial_size, 64u));
+  }
+
+  MonotonicArena::~MonotonicArena() {
+    for (auto &&block : _blocks) {
+      ::operator delete(block.data);
+    }
+  }
+
+  void *MonotonicArena::Allocate(const size_t size, const size_t alignment) {
+    DEBUG_ASSERT((alignment & (alignment - 1u)) == 0u);
+    for (;;) {
+      const auto address = reinterpret_cast<uintptr_t>(_cursor);
+      const auto padding = (alignment - (address & (alignment - 1u))) & (alignment - 1u);
+      if (padding + size <= static_cast<size_t>(_end - _cursor)) {
+        auto *result = _cursor + padding;
+        _cursor = result + size;
+        return result;
+      }
+      // Move to the next block kept from a previous round, or grow.
+      _used_before_current += static_cast<size_t>(_cursor - _blocks[_current].data);
+      if (_current + 1u < _blocks.size()) {
+        ++_current;
+        _cursor = _blocks[_current].data;
+        _end = _cursor + _blocks[_current].size;
+      } else {
+        AddBlock(std::max(2u * _blocks.back().size, size + alignment));
+      }
+    }
+  }
+
+  void MonotonicArena::Reset() {
+    if (_blocks.size() > 1u) {
+      const auto capacity = GetCapacity();
+      for (auto &&block : _blocks) {
+        ::operator delete(block.data);
+      }
+      _blocks.clear();
+      AddBlock(capacity);
+    }
+    _current = 0u;
+    _cursor = _blocks[0u].data;
+    _end = _cursor + _blocks[0u].size;
+    _used_before_current = 0u;
+  }
+
+  size_t MonotonicArena::GetCapacity() const {
+    size_t capacity = 0u;
+    for (auto &&block : _blocks) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+
+  void MonotonicArena::AddBlock(const size_t size) {
+    static auto &heap_allocations = Metrics::GetCounter("memory.arena.heap_allocations");
+    static auto &heap_bytes = Metrics::GetCounter("memory.arena.heap_bytes");
+    heap_allocations.Increment();
+    heap_bytes.Increment(size);
+    _blocks.push_back(Block{static_cast<char *>(::operator new(size)), size});
+    _current = _blocks.size() - 1u;
+    _cursor = _blocks.back().data;
+    _end = _cursor + size;
+  }
+
+  // ===========================================================================
+  // -- ArenaPool --------------------------------------------------------------
+  // ===========================================================================
+
+  /// Arenas beyond this number are freed instead of kept in the pool.
+  static constexpr size_t MAX_FREE_ARENAS = 16u;
+
+  namespace {
+
+    struct FreeArenas {
+      std::mutex mutex;
+      std::vector<MonotonicArena *> arenas;
+
+      FreeArenas() {
+        arenas.reserve(MAX_FREE_ARENAS);
+      }
+    };
+
+  } // namespace
+
+  /// Never destroyed, arenas may still be released by static objects going
+  /// out of scope at exit.
+  static FreeArenas &GetFreeArenas() {
+    static FreeArenas *FREE_ARENAS = new FreeArenas;
+    return *FREE_ARENAS;
+  }
+
+  ArenaPool::ArenaPtr ArenaPool::Acquire() {
+    static auto &reused = Metrics::GetCounter("memory.arena_pool.reused");
+    auto &pool = GetFreeArenas();
+    {
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      if (!pool.arenas.empty()) {
+        ArenaPtr arena{pool.arenas.back()};
+        pool.arenas.pop_back();
+        reused.Increment();
+        return arena;
+      }
+    }
+    static auto &created = Metrics::GetCounter("memory.arena_pool.created");
+    created.Increment();
+    return ArenaPtr{new MonotonicArena};
+  }
+
+  void ArenaPool::Releaser::operator()(MonotonicArena *arena) const {
+    arena->Reset();
+    auto &pool = GetFreeArenas();
+    {
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      if (pool.arenas.size() < MAX_FREE_ARENAS) {
+        pool.arenas.push_back(arena);
+        return;
+      }
+    }
+    delete arena;
+  }
+
+} // namespace carla
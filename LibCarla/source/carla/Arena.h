@@ -0,0 +1,142 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace carla {
+
+  // ===========================================================================
+  // -- MonotonicArena ---------------------------------------------------------
+  // ===========================================================================
+
+  /// Memory resource that hands out memory from large blocks by bumping a
+  /// pointer, individual deallocations are ignored and everything is released
+  /// at once on Reset. Meant for objects that live and die together, like the
+  /// containers of a single tick.
+  ///
+  /// The blocks are kept on Reset, if several were needed they are merged into
+  /// one as large as all of them, so a workload that repeats allocates from
+  /// the heap only during the first rounds.
+  class MonotonicArena : private NonCopyable {
+  public:
+
+    explicit MonotonicArena(size_t initial_size = 16384u);
+
+    ~MonotonicArena();
+
+    void *Allocate(size_t size, size_t alignment);
+
+    /// Release every allocation, keeping the memory.
+    void Reset();
+
+    /// Bytes reserved from the heap.
+    size_t GetCapacity() const;
+
+    /// Bytes handed out since the last reset, including alignment padding.
+    size_t GetUsedSize() const {
+      return _used_before_current + static_cast<size_t>(_cursor - _blocks[_current].data);
+    }
+
+  private:
+
+    struct Block {
+      char *data;
+      size_t size;
+    };
+
+    void AddBlock(size_t size);
+
+    std::vector<Block> _blocks;
+
+    size_t _current = 0u;
+
+    char *_cursor = nullptr;
+
+    char *_end = nullptr;
+
+    /// Bytes used in the blocks before the current one.
+    size_t _used_before_current = 0u;
+  };
+
+  // ===========================================================================
+  // -- ArenaAllocator ---------------------------------------------------------
+  // ===========================================================================
+
+  /// Standard allocator drawing from a MonotonicArena, in the spirit of
+  /// std::pmr::polymorphic_allocator. Allocators of different types sharing
+  /// the same arena compare equal. A default-constructed allocator has no
+  /// arena and uses the heap.
+  template <typename T>
+  class ArenaAllocator {
+  public:
+
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+
+    explicit ArenaAllocator(MonotonicArena *arena) noexcept : _arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : _arena(other.GetArena()) {}
+
+    T *allocate(size_t n) {
+      if (_arena == nullptr) {
+        return std::allocator<T>().allocate(n);
+      }
+      return static_cast<T *>(_arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) noexcept {
+      if (_arena == nullptr) {
+        std::allocator<T>().deallocate(ptr, n);
+      }
+    }
+
+    MonotonicArena *GetArena() const noexcept {
+      return _arena;
+    }
+
+  private:
+
+    MonotonicArena *_arena = nullptr;
+  };
+
+  template <typename T, typename U>
+  inline bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+  }
+
+  template <typename T, typename U>
+  inline bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  // ===========================================================================
+  // -- ArenaPool --------------------------------------------------------------
+  // ===========================================================================
+
+  /// Process-wide pool of arenas. An arena acquired is reset and returned to
+  /// the pool when released, so the memory of a tick is reused by the next.
+  class ArenaPool {
+  public:
+
+    struct Releaser {
+      void operator()(MonotonicArena *arena) const;
+    };
+
+    using ArenaPtr = std::unique_ptr<MonotonicArena, Releaser>;
+
+    /// Take an arena from the pool, or create one if the pool is empty.
+    static ArenaPtr Acquire();
+  };
+
+} // namespace carla
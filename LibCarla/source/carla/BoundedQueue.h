@@ -0,0 +1,121 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace carla {
+
+  /// Fixed-capacity lock-free queue, safe to use with multiple producers and
+  /// multiple consumers.
+  ///
+  /// Each cell carries a sequence number telling whether it is ready to be
+  /// written or read at a given position, so producers and consumers only
+  /// contend on the position counters (D. Vyukov's bounded MPMC queue).
+  template <typename T>
+  class BoundedQueue : private NonCopyable {
+  public:
+
+    explicit BoundedQueue(size_t capacity)
+      : _capacity(capacity),
+        _cells(std::make_unique<Cell[]>(capacity)) {
+      DEBUG_ASSERT(capacity > 0u);
+      for (size_t i = 0u; i < _capacity; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    /// Push @a value at the back of the queue, return false (and leave
+    /// @a value untouched) if the queue is full.
+    bool TryPush(T &value) {
+      Cell *cell;
+      size_t position = _push_position.load(std::memory_order_relaxed);
+      for (;;) {
+        cell = &_cells[position % _capacity];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+          if (_push_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = _push_position.load(std::memory_order_relaxed);
+        }
+      }
+      cell->value = std::move(value);
+      cell->sequence.store(position + 1u, std::memory_order_release);
+      return true;
+    }
+
+    /// Pop the front of the queue into @a value, return false if the queue is
+    /// empty.
+    bool TryPop(T &value) {
+      Cell *cell;
+      size_t position = _pop_position.load(std::memory_order_relaxed);
+      for (;;) {
+        cell = &_cells[position % _capacity];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1u));
+        if (difference == 0) {
+          if (_pop_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (difference < 0) {
+          return false;
+        } else {
+          position = _pop_position.load(std::memory_order_relaxed);
+        }
+      }
+      value = std::move(cell->value);
+      cell->value = T{};
+      cell->sequence.store(position + _capacity, std::memory_order_release);
+      return true;
+    }
+
+    /// Number of elements in the queue, only exact if no other thread is
+    /// using the queue.
+    size_t size() const {
+      const size_t pushed = _push_position.load(std::memory_order_acquire);
+      const size_t popped = _pop_position.load(std::memory_order_acquire);
+      return pushed > popped ? pushed - popped : 0u;
+    }
+
+    bool empty() const {
+      return size() == 0u;
+    }
+
+    size_t capacity() const {
+      return _capacity;
+    }
+
+  private:
+
+    struct Cell {
+      std::atomic_size_t sequence;
+      T value;
+    };
+
+    const size_t _capacity;
+
+    const std::unique_ptr<Cell[]> _cells;
+
+    /// Padded to keep producers and consumers off the same cache line.
+    std::atomic_size_t _push_position{0u};
+
+    char _padding[64u - sizeof(std::atomic_size_t)];
+
+    std::atomic_size_t _pop_position{0u};
+  };
+
+} // namespace carla
@@ -0,0 +1,323 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/Logging.h"
+
+#include "carla/BoundedQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// The server library is linked by the simulator, there records are written
+/// by the calling thread so no background thread is started.
+#ifndef LIBCARLA_LOG_SYNCHRONOUS
+#  define LIBCARLA_LOG_SYNCHRONOUS false
+#endif
+
+namespace carla {
+namespace logging {
+namespace detail {
+
+  // ===========================================================================
+  // -- Formatting -------------------------------------------------------------
+  // ===========================================================================
+
+  static const char *GetLevelName(int level) {
+    if (level >= LIBCARLA_LOG_LEVEL_CRITICAL) {
+      return "CRITICAL";
+    } else if (level >= LIBCARLA_LOG_LEVEL_ERROR) {
+      return "ERROR";
+    } else if (level >= LIBCARLA_LOG_LEVEL_WARNING) {
+      return "WARNING";
+    } else if (level >= LIBCARLA_LOG_LEVEL_INFO) {
+      return "INFO";
+    }
+    return "DEBUG";
+  }
+
+  static void WriteJsonString(std::ostream &out, const std::string &str) {
+    out << '"';
+    for (auto c : str) {
+      switch (c) {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20u) {
+            char buffer[8u];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            out << buffer;
+          } else {
+            out << c;
+          }
+      }
+    }
+    out << '"';
+  }
+
+  static void WriteRecord(std::ostream &out, const Record &record, const Format format) {
+    if (format == Format::Json) {
+      out << "{\"time\":" << record.time
+          << ",\"level\":\"" << GetLevelName(record.level)
+          << "\",\"thread\":" << record.thread
+          << ",\"message\":";
+      WriteJsonString(out, record.message);
+      for (auto &&field : record.fields) {
+        out << ',';
+        WriteJsonString(out, field.first);
+        out << ':';
+        WriteJsonString(out, field.second);
+      }
+      out << "}\n";
+    } else {
+      out << GetLevelName(record.level) << ": " << record.message;
+      for (auto &&field : record.fields) {
+        out << ' ' << field.first << '=' << field.second;
+      }
+      out << '\n';
+    }
+  }
+
+  // ===========================================================================
+  // -- Logger -----------------------------------------------------------------
+  // ===========================================================================
+
+  /// Records are pushed into a single lock-free bounded queue shared by every
+  /// thread (a multi-producer ring, not a buffer per thread) and written by a
+  /// background thread, started with the first record. If the queue is full
+  /// the record is dropped and the number of dropped records reported later.
+  /// Errors are written and flushed right away by the calling thread, as the
+  /// process may be about to terminate; the records still queued are left to
+  /// the writer thread, so an error may show up before them.
+  ///
+  /// Identical consecutive records are collapsed, a summary of how many times
+  /// it repeated is written at most once per second, and when flushing.
+  class Logger {
+  public:
+
+    /// Never destroyed, messages may still be logged by static objects going
+    /// out of scope at exit.
+    static Logger &Get() {
+      static Logger *LOGGER = new Logger;
+      return *LOGGER;
+    }
+
+    std::atomic_int level{LIBCARLA_LOG_LEVEL};
+
+    std::atomic<Format> format{Format::Text};
+
+    std::atomic_bool synchronous{LIBCARLA_LOG_SYNCHRONOUS};
+
+    void Push(Record &&record) {
+      if (synchronous) {
+        std::lock_guard<std::mutex> lock(_write_mutex);
+        // Keep the order of the records queued before switching.
+        WriteQueued();
+        WriteCollapsed(record);
+        FlushStreams();
+        return;
+      }
+      if (record.level >= LIBCARLA_LOG_LEVEL_ERROR) {
+        // The writer thread takes the lock per record, so we wait for one
+        // record at most.
+        std::lock_guard<std::mutex> lock(_write_mutex);
+        WriteCollapsed(record);
+        GetStream(record.level).flush();
+        return;
+      }
+      std::call_once(_start_flag, [this]() { Start(); });
+      if (!_queue.TryPush(record)) {
+        ++_dropped;
+        return;
+      }
+      // Pairs with the fence in Run, either the writer sees the record or we
+      // see the writer sleeping.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (_sleeping) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _condition.notify_one();
+      }
+    }
+
+    /// Write every queued record, and the summary of the repeated ones, from
+    /// the calling thread.
+    void Drain() {
+      std::lock_guard<std::mutex> lock(_write_mutex);
+      WriteQueued();
+      if (_repeated > 0u) {
+        WriteRepeatedSummary();
+      }
+      FlushStreams();
+    }
+
+  private:
+
+    static constexpr size_t QueueCapacity = 4096u;
+
+    Logger() : _queue(QueueCapacity) {}
+
+    void Start() {
+      std::thread([this]() { Run(); }).detach();
+      std::atexit([]() { Logger::Get().Drain(); });
+    }
+
+    /// Writer thread, sleeps until a record arrives or, if a summary of
+    /// repeated records is pending, until it is due.
+    void Run() {
+      for (;;) {
+        Record record;
+        for (;;) {
+          std::lock_guard<std::mutex> write_lock(_write_mutex);
+          if (!_queue.TryPop(record)) {
+            break;
+          }
+          WriteCollapsed(record);
+        }
+        bool summary_pending;
+        {
+          std::lock_guard<std::mutex> write_lock(_write_mutex);
+          WriteDropped();
+          // In synchronous mode only the calling threads write.
+          if ((_repeated > 0u) && !synchronous &&
+              (std::chrono::steady_clock::now() - _last_summary >= std::chrono::seconds(1))) {
+            WriteRepeatedSummary();
+          }
+          FlushStreams();
+          summary_pending = (_repeated > 0u) && !synchronous;
+        }
+        // _mutex only guards the wait, a producer that sees us sleeping never
+        // waits for the console.
+        std::unique_lock<std::mutex> lock(_mutex);
+        _sleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto has_records = [this]() { return !_queue.empty(); };
+        if (summary_pending) {
+          _condition.wait_for(lock, std::chrono::seconds(1), has_records);
+        } else {
+          _condition.wait(lock, has_records);
+        }
+        _sleeping = false;
+      }
+    }
+
+    /// @pre _write_mutex is locked.
+    void WriteQueued() {
+      Record record;
+      while (_queue.TryPop(record)) {
+        WriteCollapsed(record);
+      }
+      WriteDropped();
+    }
+
+    /// @pre _write_mutex is locked.
+    void WriteDropped() {
+      const auto dropped = _dropped.exchange(0u);
+      if (dropped > 0u) {
+        std::cerr << "WARNING: logger queue full, " << dropped << " messages dropped\n";
+      }
+    }
+
+    /// @pre _write_mutex is locked.
+    void WriteCollapsed(const Record &record) {
+      if ((record.level == _last.level) &&
+          (record.message == _last.message) &&
+          (record.fields == _last.fields)) {
+        ++_repeated;
+        return;
+      }
+      if (_repeated > 0u) {
+        WriteRepeatedSummary();
+      }
+      WriteRecord(GetStream(record.level), record, format);
+      _last = record;
+      _last_summary = std::chrono::steady_clock::now();
+    }
+
+    /// @pre _write_mutex is locked.
+    void WriteRepeatedSummary() {
+      Record summary;
+      summary.level = _last.level;
+      summary.message = "last message repeated " + std::to_string(_repeated) + " times";
+      summary.time = _last.time;
+      summary.thread = _last.thread;
+      WriteRecord(GetStream(summary.level), summary, format);
+      _repeated = 0u;
+      _last_summary = std::chrono::steady_clock::now();
+    }
+
+    static std::ostream &GetStream(int level) {
+      return level >= LIBCARLA_LOG_LEVEL_WARNING ? std::cerr : std::cout;
+    }
+
+    static void FlushStreams() {
+      std::cout.flush();
+      std::cerr.flush();
+    }
+
+    BoundedQueue<Record> _queue;
+
+    std::atomic_size_t _dropped{0u};
+
+    std::once_flag _start_flag;
+
+    /// Whether the writer thread is waiting for records.
+    std::atomic_bool _sleeping{false};
+
+    std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    /// Serializes the writes to the console.
+    std::mutex _write_mutex;
+
+    Record _last;
+
+    size_t _repeated = 0u;
+
+    std::chrono::steady_clock::time_point _last_summary;
+  };
+
+  void Push(Record &&record) {
+    record.time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    record.thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    Logger::Get().Push(std::move(record));
+  }
+
+} // namespace detail
+
+  void SetLevel(const int level) {
+    detail::Logger::Get().level = level;
+  }
+
+  int GetLevel() {
+    return detail::Logger::Get().level;
+  }
+
+  void SetFormat(const Format format) {
+    detail::Logger::Get().format = format;
+  }
+
+  void SetSynchronous(const bool synchronous) {
+    auto &logger = detail::Logger::Get();
+    logger.Drain();
+    logger.synchronous = synchronous;
+  }
+
+  void Flush() {
+    detail::Logger::Get().Drain();
+  }
+
+} // namespace logging
+} // namespace carla
@@ -33,12 +33,25 @@
 //
 //  * LOG_DEBUG_ONLY(/* code here */)
 //  * LOG_INFO_ONLY(/* code here */)
+//
+// Messages are formatted on the calling thread and written to the console by
+// a background thread, so logging never blocks on terminal or pipe writes.
+// The level can be raised at runtime with logging::SetLevel, and key-value
+// pairs can be attached to a message with logging::kv, e.g.
+//
+//   log_info("session closed", logging::kv("session", id));
 
 // =============================================================================
 // -- Implementation of log functions ------------------------------------------
 // =============================================================================
 
+#include <cstdint>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace carla {
 
@@ -52,18 +65,123 @@ namespace logging {
     (void) expander{0, (void(out << ' ' << std::forward<Args>(args)), 0) ...};
   }
 
+  /// Write directly to std::cout, regardless of the log level.
   template <typename ... Args>
   static inline void log(Args && ... args) {
     logging::write_to_stream(std::cout, std::forward<Args>(args) ..., '\n');
   }
 
+  enum class Format {
+    /// "LEVEL: message key=value ...".
+    Text,
+    /// One JSON object per line with time, level, thread, message, and the
+    /// key-value pairs as fields.
+    Json
+  };
+
+  /// Discard messages below @a level. Messages below the compile-time
+  /// LIBCARLA_LOG_LEVEL are always discarded.
+  void SetLevel(int level);
+
+  int GetLevel();
+
+  void SetFormat(Format format);
+
+  /// Write messages from the calling thread instead of the background thread.
+  /// Errors are always written from the calling thread.
+  void SetSynchronous(bool synchronous);
+
+  /// Block until every message logged so far has been written, including the
+  /// count of the last message repeated.
+  void Flush();
+
+  /// A key-value pair attached to a log message.
+  template <typename T>
+  struct KeyValue {
+    const char *key;
+    T value;
+  };
+
+  template <typename T>
+  static inline KeyValue<std::decay_t<T>> kv(const char *key, T &&value) {
+    return {key, std::forward<T>(value)};
+  }
+
+namespace detail {
+
+  struct Record {
+
+    int level = 0;
+
+    std::string message;
+
+    std::vector<std::pair<std::string, std::string>> fields;
+
+    /// Microseconds since epoch.
+    uint64_t time = 0u;
+
+    size_t thread = 0u;
+  };
+
+  /// Hand @a record to the background writer.
+  void Push(Record &&record);
+
+  class RecordBuilder {
+  public:
+
+    explicit RecordBuilder(int level) {
+      _record.level = level;
+      _message << std::boolalpha;
+    }
+
+    template <typename T>
+    void Add(const T &arg) {
+      if (_has_message) {
+        _message << ' ';
+      }
+      _message << arg;
+      _has_message = true;
+    }
+
+    template <typename T>
+    void Add(const KeyValue<T> &pair) {
+      std::ostringstream value;
+      value << std::boolalpha << pair.value;
+      _record.fields.emplace_back(pair.key, value.str());
+    }
+
+    Record Build() {
+      _record.message = _message.str();
+      return std::move(_record);
+    }
+
+  private:
+
+    std::ostringstream _message;
+
+    bool _has_message = false;
+
+    Record _record;
+  };
+
+  template <typename ... Args>
+  static inline void log(int level, const Args & ... args) {
+    if (level >= GetLevel()) {
+      RecordBuilder builder{level};
+      using expander = int[];
+      (void) expander{0, (builder.Add(args), 0) ...};
+      Push(builder.Build());
+    }
+  }
+
+} // namespace detail
 } // namespace logging
 
 #if LIBCARLA_LOG_LEVEL <= LIBCARLA_LOG_LEVEL_DEBUG
 
   template <typename ... Args>
-  static inline void log_debug(Args && ... args) {
-    logging::write_to_stream(std::cout, "DEBUG:", std::forward<Args>(args) ..., '\n');
+  static inline void log_debug(const Args & ... args) {
+    logging::detail::log(LIBCARLA_LOG_LEVEL_DEBUG, args ...);
   }
 
 #else
@@ -76,8 +194,8 @@ namespace logging {
 #if LIBCARLA_LOG_LEVEL <= LIBCARLA_LOG_LEVEL_INFO
 
   template <typename ... Args>
-  static inline void log_info(Args && ... args) {
-    logging::write_to_stream(std::cout, "INFO: ", std::forward<Args>(args) ..., '\n');
+  static inline void log_info(const Args & ... args) {
+    logging::detail::log(LIBCARLA_LOG_LEVEL_INFO, args ...);
   }
 
 #else
@@ -90,8 +208,8 @@ namespace logging {
 #if LIBCARLA_LOG_LEVEL <= LIBCARLA_LOG_LEVEL_WARNING
 
   template <typename ... Args>
-  static inline void log_warning(Args && ... args) {
-    logging::write_to_stream(std::cerr, "WARNING:", std::forward<Args>(args) ..., '\n');
+  static inline void log_warning(const Args & ... args) {
+    logging::detail::log(LIBCARLA_LOG_LEVEL_WARNING, args ...);
   }
 
 #else
@@ -104,8 +222,8 @@ namespace logging {
 #if LIBCARLA_LOG_LEVEL <= LIBCARLA_LOG_LEVEL_ERROR
 
   template <typename ... Args>
-  static inline void log_error(Args && ... args) {
-    logging::write_to_stream(std::cerr, "ERROR:", std::forward<Args>(args) ..., '\n');
+  static inline void log_error(const Args & ... args) {
+    logging::detail::log(LIBCARLA_LOG_LEVEL_ERROR, args ...);
   }
 
 #else
@@ -118,8 +236,8 @@ namespace logging {
 #if LIBCARLA_LOG_LEVEL <= LIBCARLA_LOG_LEVEL_CRITICAL
 
   template <typename ... Args>
-  static inline void log_critical(Args && ... args) {
-    logging::write_to_stream(std::cerr, "CRITICAL:", std::forward<Args>(args) ..., '\n');
+  static inline void log_critical(const Args & ... args) {
+    logging::detail::log(LIBCARLA_LOG_LEVEL_CRITICAL, args ...);
   }
 
 #else
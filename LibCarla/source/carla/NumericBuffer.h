@@ -0,0 +1,106 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace carla {
+
+  /// Description of a buffer exported with the Python buffer protocol
+  /// (PEP 3118), like a numpy array, with the fields needed to read it as a
+  /// sequence of numbers. Kept apart from Python so it can be tested without
+  /// it.
+  struct NumericBuffer {
+
+    const void *data = nullptr;
+
+    /// Format of the items in the syntax of the struct module, e.g. "<f".
+    const char *format = nullptr;
+
+    /// Size of an item in bytes.
+    size_t item_size = 0u;
+
+    /// Size of the buffer in bytes.
+    size_t length = 0u;
+
+    size_t ndim = 1u;
+
+    /// Bytes from one item to the next in the first dimension.
+    std::ptrdiff_t stride = 0;
+
+    /// Copy the items into @a result if this is a 1-dimensional, contiguous
+    /// buffer of native numbers. Returns false otherwise, leaving @a result
+    /// untouched.
+    template <typename T>
+    bool CopyTo(std::vector<T> &result) const;
+
+  private:
+
+    template <typename U, typename T>
+    bool CopyItems(std::vector<T> &result) const {
+      // The stride of a single item does not matter, numpy leaves it arbitrary.
+      const bool is_contiguous =
+          (length <= sizeof(U)) || (stride == static_cast<std::ptrdiff_t>(sizeof(U)));
+      if ((item_size != sizeof(U)) || !is_contiguous) {
+        return false;
+      }
+      // Items may not be aligned, copy them byte-wise.
+      const auto *bytes = static_cast<const unsigned char *>(data);
+      std::vector<T> items;
+      items.reserve(length / sizeof(U));
+      for (size_t offset = 0u; offset < length; offset += sizeof(U)) {
+        U item;
+        std::memcpy(&item, bytes + offset, sizeof(U));
+        items.emplace_back(static_cast<T>(item));
+      }
+      result = std::move(items);
+      return true;
+    }
+  };
+
+  template <typename T>
+  bool NumericBuffer::CopyTo(std::vector<T> &result) const {
+    if ((ndim != 1u) || (format == nullptr) || (item_size == 0u) || (length % item_size != 0u)) {
+      return false;
+    }
+    std::string type = format;
+    const uint16_t endianness_test = 1u;
+    const bool is_little_endian = *reinterpret_cast<const uint8_t *>(&endianness_test) == 1u;
+    // Native byte order only, the item size check below rejects the standard
+    // sizes of '=' that differ from the native ones.
+    if (!type.empty() &&
+        ((type[0u] == '@') || (type[0u] == '=') ||
+         ((type[0u] == '<') && is_little_endian) ||
+         (((type[0u] == '>') || (type[0u] == '!')) && !is_little_endian))) {
+      type.erase(0u, 1u);
+    }
+    if (type.size() != 1u) {
+      return false;
+    }
+    switch (type[0u]) {
+      case '?': return CopyItems<bool>(result);
+      case 'b': return CopyItems<int8_t>(result);
+      case 'B': return CopyItems<uint8_t>(result);
+      case 'h': return CopyItems<int16_t>(result);
+      case 'H': return CopyItems<uint16_t>(result);
+      case 'i': return CopyItems<int32_t>(result);
+      case 'I': return CopyItems<uint32_t>(result);
+      case 'l': return CopyItems<long>(result);
+      case 'L': return CopyItems<unsigned long>(result);
+      case 'q': return CopyItems<long long>(result);
+      case 'Q': return CopyItems<unsigned long long>(result);
+      case 'f': return CopyItems<float>(result);
+      case 'd': return CopyItems<double>(result);
+      default:  return false;
+    }
+  }
+
+} // namespace carla
@@ -6,15 +6,19 @@
 
 #pragma once
 
+#include "carla/AtomicSharedPtr.h"
+#include "carla/Debug.h"
 #include "carla/Exception.h"
 #include "carla/Time.h"
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <exception>
-#include <map>
+#include <memory>
 #include <mutex>
 
 namespace carla {
@@ -31,6 +35,12 @@ namespace detail {
 
   /// This class is meant to be used similar to a shared future, but the value
   /// can be set any number of times.
+  ///
+  /// Every value set gets the next sequence number. The latest value is
+  /// published through an atomic shared pointer, and waiters just compare the
+  /// sequence number, so waiting does not allocate and setting a value does
+  /// not depend on the number of waiting threads. The mutex and condition
+  /// variable are only touched when there are threads sleeping.
   template <typename T>
   class RecurrentSharedFuture {
   public:
@@ -41,7 +51,21 @@ namespace detail {
     /// simultaneously.
     ///
     /// @return empty optional if the timeout is met.
-    boost::optional<T> WaitFor(time_duration timeout);
+    boost::optional<T> WaitFor(time_duration timeout) {
+      return WaitForNewerThan(GetSequenceNumber(), timeout);
+    }
+
+    /// Wait until a value with sequence number greater than @a sequence is
+    /// set, return immediately if it already was. If several values were set
+    /// meanwhile, the latest is returned.
+    ///
+    /// @return empty optional if the timeout is met.
+    boost::optional<T> WaitForNewerThan(uint64_t sequence, time_duration timeout);
+
+    /// Sequence number of the latest value set, 0 if none was set.
+    uint64_t GetSequenceNumber() const {
+      return _sequence.load(std::memory_order_acquire);
+    }
 
     /// Set the value and notify all waiting threads.
     template <typename T2>
@@ -57,16 +81,17 @@ namespace detail {
 
   private:
 
-    std::mutex _mutex;
+    using value_type = boost::variant<T, SharedException>;
 
-    std::condition_variable _cv;
+    AtomicSharedPtr<const value_type> _value;
+
+    std::atomic<uint64_t> _sequence{0u};
+
+    std::atomic_size_t _number_of_waiters{0u};
 
-    struct mapped_type {
-      bool should_wait;
-      boost::variant<T, SharedException> value;
-    };
+    std::mutex _mutex;
 
-    std::map<const char *, mapped_type> _map;
+    std::condition_variable _cv;
   };
 
   // ===========================================================================
@@ -75,8 +100,6 @@ namespace detail {
 
 namespace detail {
 
-  static thread_local const char thread_tag{};
-
   class SharedException : public std::exception {
   public:
 
@@ -101,28 +124,38 @@ namespace detail {
 } // namespace detail
 
   template <typename T>
-  boost::optional<T> RecurrentSharedFuture<T>::WaitFor(time_duration timeout) {
-    std::unique_lock<std::mutex> lock(_mutex);
-    auto &r = _map[&detail::thread_tag];
-    r.should_wait = true;
-    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() { return !r.should_wait; })) {
-      return {};
+  boost::optional<T> RecurrentSharedFuture<T>::WaitForNewerThan(
+      const uint64_t sequence,
+      const time_duration timeout) {
+    auto is_ready = [this, sequence]() { return _sequence.load() > sequence; };
+    if (!is_ready()) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      // Pairs with SetValue, either we see the new sequence number or the
+      // setter sees us waiting and locks the mutex before notifying.
+      ++_number_of_waiters;
+      const bool success = _cv.wait_for(lock, timeout.to_chrono(), is_ready);
+      --_number_of_waiters;
+      if (!success) {
+        return {};
+      }
     }
-    if (r.value.which() == 1) {
-      throw_exception(boost::get<SharedException>(r.value));
+    const auto value = _value.load();
+    DEBUG_ASSERT(value != nullptr);
+    if (value->which() == 1) {
+      throw_exception(boost::get<SharedException>(*value));
     }
-    return boost::get<T>(std::move(r.value));
+    return boost::get<T>(*value);
   }
 
   template <typename T>
   template <typename T2>
   void RecurrentSharedFuture<T>::SetValue(const T2 &value) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    for (auto &pair : _map) {
-      pair.second.should_wait = false;
-      pair.second.value = value;
+    _value = std::make_shared<const value_type>(value);
+    ++_sequence;
+    if (_number_of_waiters > 0u) {
+      { std::lock_guard<std::mutex> lock(_mutex); }
+      _cv.notify_all();
     }
-    _cv.notify_all();
   }
 
   template <typename T>
@@ -0,0 +1,94 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/RecyclingAllocator.h"
+
+#include "carla/profiler/Metrics.h"
+
+#include <array>
+#include <mutex>
+
+namespace carla {
+namespace detail {
+
+  using profiler::Metrics;
+
+  /// Size classes are powers of two from 2^MIN_SIZE_CLASS to 2^MAX_SIZE_CLASS
+  /// bytes.
+  static constexpr size_t MIN_SIZE_CLASS = 4u;
+
+  static constexpr size_t MAX_SIZE_CLASS = 11u;
+
+  /// Blocks freed beyond this number per size class go back to the heap.
+  static constexpr size_t MAX_FREE_BLOCKS = 4096u;
+
+  namespace {
+
+    /// Free blocks linked through their first bytes.
+    struct FreeBlock {
+      FreeBlock *next;
+    };
+
+    struct FreeList {
+      std::mutex mutex;
+      FreeBlock *head = nullptr;
+      size_t size = 0u;
+    };
+
+  } // namespace
+
+  static size_t GetSizeClass(const size_t size) {
+    size_t size_class = MIN_SIZE_CLASS;
+    while ((size_t(1u) << size_class) < size) {
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  /// Never destroyed, objects may still be freed by static objects going out
+  /// of scope at exit.
+  static FreeList &GetFreeList(const size_t size_class) {
+    static auto *FREE_LISTS = new std::array<FreeList, MAX_SIZE_CLASS - MIN_SIZE_CLASS + 1u>;
+    return (*FREE_LISTS)[size_class - MIN_SIZE_CLASS];
+  }
+
+  void *RecyclingAllocate(const size_t size) {
+    static auto &heap_allocations = Metrics::GetCounter("memory.recycling.heap_allocations");
+    static auto &reused = Metrics::GetCounter("memory.recycling.reused");
+    const auto size_class = GetSizeClass(size);
+    if (size_class <= MAX_SIZE_CLASS) {
+      auto &free_list = GetFreeList(size_class);
+      std::lock_guard<std::mutex> lock(free_list.mutex);
+      if (free_list.head != nullptr) {
+        auto *block = free_list.head;
+        free_list.head = block->next;
+        --free_list.size;
+        reused.Increment();
+        return block;
+      }
+    }
+    heap_allocations.Increment();
+    return ::operator new(size_class <= MAX_SIZE_CLASS ? (size_t(1u) << size_class) : size);
+  }
+
+  void RecyclingDeallocate(void *ptr, const size_t size) noexcept {
+    const auto size_class = GetSizeClass(size);
+    if (size_class <= MAX_SIZE_CLASS) {
+      auto &free_list = GetFreeList(size_class);
+      std::lock_guard<std::mutex> lock(free_list.mutex);
+      if (free_list.size < MAX_FREE_BLOCKS) {
+        auto *block = static_cast<FreeBlock *>(ptr);
+        block->next = free_list.head;
+        free_list.head = block;
+        ++free_list.size;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+} // namespace detail
+} // namespace carla
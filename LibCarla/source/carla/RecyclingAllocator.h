@@ -0,0 +1,88 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+
+#include <cstddef>
+#include <new>
+
+namespace carla {
+namespace detail {
+
+  /// Memory from a process-wide free list of blocks of the size class of
+  /// @a size, blocks above the largest size class come straight from the
+  /// heap.
+  void *RecyclingAllocate(size_t size);
+
+  /// Return @a ptr, allocated with the same @a size, to its free list.
+  void RecyclingDeallocate(void *ptr, size_t size) noexcept;
+
+} // namespace detail
+
+  /// Standard allocator that recycles the blocks freed instead of returning
+  /// them to the heap, for small objects created and destroyed at a high rate
+  /// like the data of every sensor message. Thread-safe, memory freed by one
+  /// thread is reused by any other.
+  template <typename T>
+  class RecyclingAllocator {
+  public:
+
+    using value_type = T;
+
+    RecyclingAllocator() noexcept = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) {
+      static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types not supported");
+      return static_cast<T *>(detail::RecyclingAllocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) noexcept {
+      detail::RecyclingDeallocate(ptr, n * sizeof(T));
+    }
+  };
+
+  template <typename T, typename U>
+  inline bool operator==(const RecyclingAllocator<T> &, const RecyclingAllocator<U> &) noexcept {
+    return true;
+  }
+
+  template <typename T, typename U>
+  inline bool operator!=(const RecyclingAllocator<T> &, const RecyclingAllocator<U> &) noexcept {
+    return false;
+  }
+
+  /// Destroys and deallocates an object allocated with RecyclingAllocator.
+  template <typename T>
+  struct RecyclingDeleter {
+    void operator()(T *ptr) const noexcept {
+      ptr->~T();
+      RecyclingAllocator<T>().deallocate(ptr, 1u);
+    }
+  };
+
+  /// Create a SharedPtr to an object and its reference count allocated from
+  /// recycled memory. The object is created by @a construct(memory) with
+  /// placement new, so the caller can use constructors only accessible to it.
+  template <typename T, typename ConstructF>
+  static inline SharedPtr<T> MakeRecycledShared(ConstructF &&construct) {
+    RecyclingAllocator<T> allocator;
+    T *memory = allocator.allocate(1u);
+    T *ptr;
+    try {
+      ptr = construct(static_cast<void *>(memory));
+    } catch (...) {
+      allocator.deallocate(memory, 1u);
+      throw;
+    }
+    return SharedPtr<T>(ptr, RecyclingDeleter<T>{}, allocator);
+  }
+
+} // namespace carla
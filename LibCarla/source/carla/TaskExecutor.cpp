@@ -0,0 +1,218 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/TaskExecutor.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/profiler/Metrics.h"
+
+#include <stdexcept>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif // __linux__
+
+namespace carla {
+
+  // ===========================================================================
+  // -- Worker -----------------------------------------------------------------
+  // ===========================================================================
+
+  /// The owner pushes and pops at the back, other workers steal from the
+  /// front so they take the oldest (usually largest) tasks.
+  struct TaskExecutor::Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  static thread_local const TaskExecutor *CURRENT_EXECUTOR = nullptr;
+
+  static thread_local size_t CURRENT_WORKER_INDEX = 0u;
+
+  static void PinCurrentThread(size_t core) {
+#ifdef __linux__
+    core %= std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+      log_warning("task executor: failed to pin worker to core", core);
+    }
+#else
+    (void) core;
+    log_warning("task executor: pinning workers is not supported on this platform");
+#endif // __linux__
+  }
+
+  static void RunTask(TaskExecutor::Task &task) {
+    try {
+      task();
+    } catch (const std::exception &e) {
+      log_error("task executor: exception thrown by task:", e.what());
+    } catch (...) {
+      log_error("task executor: unknown exception thrown by task");
+    }
+    task = nullptr;
+  }
+
+  // ===========================================================================
+  // -- TaskExecutor -----------------------------------------------------------
+  // ===========================================================================
+
+  TaskExecutor::TaskExecutor(Options options)
+    : _options(options) {
+    const size_t number_of_workers = _options.number_of_workers > 0u ?
+        _options.number_of_workers :
+        std::max(1u, std::thread::hardware_concurrency());
+    _workers.reserve(number_of_workers);
+    for (size_t i = 0u; i < number_of_workers; ++i) {
+      _workers.emplace_back(std::make_unique<Worker>());
+    }
+    _threads.reserve(number_of_workers);
+    for (size_t i = 0u; i < number_of_workers; ++i) {
+      _threads.emplace_back([this, i]() { Run(i); });
+    }
+  }
+
+  TaskExecutor::~TaskExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(_sleep_mutex);
+      _done = true;
+    }
+    _sleep_condition.notify_all();
+    for (auto &thread : _threads) {
+      thread.join();
+    }
+  }
+
+  // ===========================================================================
+  // -- Process-wide executor --------------------------------------------------
+  // ===========================================================================
+
+  static std::mutex DEFAULT_EXECUTOR_MUTEX;
+
+  static std::atomic<TaskExecutor *> DEFAULT_EXECUTOR{nullptr};
+
+  static TaskExecutor::Options DEFAULT_EXECUTOR_OPTIONS;
+
+  TaskExecutor &TaskExecutor::GetDefault() {
+    auto *executor = DEFAULT_EXECUTOR.load(std::memory_order_acquire);
+    if (executor == nullptr) {
+      std::lock_guard<std::mutex> lock(DEFAULT_EXECUTOR_MUTEX);
+      executor = DEFAULT_EXECUTOR.load(std::memory_order_relaxed);
+      if (executor == nullptr) {
+        // Never destroyed, tasks may still be posted by static objects going
+        // out of scope at exit.
+        executor = new TaskExecutor(DEFAULT_EXECUTOR_OPTIONS);
+        DEFAULT_EXECUTOR.store(executor, std::memory_order_release);
+      }
+    }
+    return *executor;
+  }
+
+  void TaskExecutor::ConfigureDefault(Options options) {
+    std::lock_guard<std::mutex> lock(DEFAULT_EXECUTOR_MUTEX);
+    if (DEFAULT_EXECUTOR.load() != nullptr) {
+      throw_exception(std::logic_error(
+          "task executor already running, it must be configured before connecting any client"));
+    }
+    DEFAULT_EXECUTOR_OPTIONS = options;
+  }
+
+  // ===========================================================================
+  // -- Scheduling -------------------------------------------------------------
+  // ===========================================================================
+
+  TaskExecutor::Worker *TaskExecutor::GetCurrentWorker() const {
+    return CURRENT_EXECUTOR == this ? _workers[CURRENT_WORKER_INDEX].get() : nullptr;
+  }
+
+  void TaskExecutor::Post(Task task) {
+    auto *worker = GetCurrentWorker();
+    if (worker == nullptr) {
+      worker = _workers[_next_worker++ % _workers.size()].get();
+    }
+    // Count it before it is visible so _pending never goes below zero.
+    ++_pending;
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->tasks.emplace_back(std::move(task));
+    }
+    if (_sleeping > 0u) {
+      std::lock_guard<std::mutex> lock(_sleep_mutex);
+      _sleep_condition.notify_one();
+    }
+  }
+
+  bool TaskExecutor::TryPop(Worker *worker, Task &task) {
+    if (worker != nullptr) {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      if (!worker->tasks.empty()) {
+        task = std::move(worker->tasks.back());
+        worker->tasks.pop_back();
+        --_pending;
+        return true;
+      }
+    }
+    // Nothing of our own, steal starting from the next worker so the thieves
+    // spread over the queues.
+    static auto &steals = profiler::Metrics::GetCounter("task_executor.steals");
+    const size_t first = worker != nullptr ? CURRENT_WORKER_INDEX + 1u : _next_worker.load();
+    for (size_t i = 0u; i < _workers.size(); ++i) {
+      auto &victim = *_workers[(first + i) % _workers.size()];
+      if (&victim == worker) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --_pending;
+        if (worker != nullptr) {
+          steals.Increment();
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool TaskExecutor::TryRunPendingTask() {
+    Task task;
+    if (TryPop(GetCurrentWorker(), task)) {
+      RunTask(task);
+      return true;
+    }
+    return false;
+  }
+
+  void TaskExecutor::Run(const size_t index) {
+    CURRENT_EXECUTOR = this;
+    CURRENT_WORKER_INDEX = index;
+    if (_options.pin_workers) {
+      PinCurrentThread(_options.first_core + index);
+    }
+    auto *worker = _workers[index].get();
+    Task task;
+    for (;;) {
+      if (TryPop(worker, task)) {
+        RunTask(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(_sleep_mutex);
+      ++_sleeping;
+      _sleep_condition.wait(lock, [this]() { return _done || (_pending > 0u); });
+      --_sleeping;
+      if (_done && (_pending == 0u)) {
+        break;
+      }
+    }
+    CURRENT_EXECUTOR = nullptr;
+  }
+
+} // namespace carla
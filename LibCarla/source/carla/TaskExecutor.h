@@ -0,0 +1,185 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace carla {
+
+  /// Pool of worker threads running tasks, each worker has its own queue and
+  /// steals from the others when it runs out of work.
+  ///
+  /// A single process-wide executor (GetDefault) is shared by the
+  /// client-side sensors and the batch map queries of every client in the
+  /// process. The streaming data and its callbacks are not run here, each
+  /// client still has its own pool of worker_threads for them. It is only
+  /// used through ParallelFor, which returns once the work is done, so no task
+  /// of a client runs after the client is destroyed.
+  class TaskExecutor : private NonCopyable {
+  public:
+
+    using Task = std::function<void()>;
+
+    struct Options {
+      /// Number of worker threads, 0 for one per hardware thread.
+      size_t number_of_workers = 0u;
+
+      /// Pin each worker to a core, starting at first_core. Only supported
+      /// on Linux, ignored elsewhere.
+      bool pin_workers = false;
+
+      size_t first_core = 0u;
+    };
+
+    TaskExecutor() : TaskExecutor(Options{}) {}
+
+    explicit TaskExecutor(Options options);
+
+    /// Runs the tasks still queued and joins the workers.
+    ~TaskExecutor();
+
+    /// The process-wide executor, created on first use.
+    static TaskExecutor &GetDefault();
+
+    /// Set the options of the process-wide executor.
+    ///
+    /// @throw std::logic_error if it is already created.
+    static void ConfigureDefault(Options options);
+
+    size_t GetNumberOfWorkers() const {
+      return _workers.size();
+    }
+
+    /// Queue @a task to run on a worker. If called from a worker the task goes
+    /// to its own queue, to run next unless another worker steals it first.
+    void Post(Task task);
+
+    /// Run a queued task on the calling thread if there is any, return false
+    /// otherwise.
+    bool TryRunPendingTask();
+
+    /// Call @a functor(begin, end) for consecutive ranges covering
+    /// [0, @a count), of at least @a grain_size elements, in parallel on the
+    /// workers and the calling thread. Returns when every range is done.
+    /// The calling thread only runs ranges of this call, never other queued
+    /// tasks, so it is safe to call from a worker or while holding a lock;
+    /// ranges the workers are too busy to take are run by the caller.
+    ///
+    /// If any call throws, the remaining ranges are skipped and the first
+    /// exception is rethrown.
+    template <typename F>
+    void ParallelFor(size_t count, size_t grain_size, F &&functor);
+
+  private:
+
+    struct Worker;
+
+    /// Worker the calling thread belongs to, nullptr if it is not a worker of
+    /// this executor.
+    Worker *GetCurrentWorker() const;
+
+    bool TryPop(Worker *worker, Task &task);
+
+    void Run(size_t index);
+
+    const Options _options;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::vector<std::thread> _threads;
+
+    /// Round-robin index for the tasks posted from outside the workers.
+    std::atomic_size_t _next_worker{0u};
+
+    /// Tasks queued and not yet taken.
+    std::atomic_size_t _pending{0u};
+
+    std::atomic_bool _done{false};
+
+    std::mutex _sleep_mutex;
+
+    std::condition_variable _sleep_condition;
+
+    std::atomic_size_t _sleeping{0u};
+  };
+
+  template <typename F>
+  void TaskExecutor::ParallelFor(const size_t count, size_t grain_size, F &&functor) {
+    if (count == 0u) {
+      return;
+    }
+    grain_size = std::max<size_t>(grain_size, 1u);
+    // A few ranges per thread, taken dynamically so uneven ranges balance out.
+    const size_t max_ranges = 4u * (GetNumberOfWorkers() + 1u);
+    const size_t number_of_ranges = std::min(max_ranges, (count + grain_size - 1u) / grain_size);
+    if (number_of_ranges <= 1u) {
+      functor(size_t(0u), count);
+      return;
+    }
+    const size_t range_size = (count + number_of_ranges - 1u) / number_of_ranges;
+
+    // Shared with the helpers, a helper still queued when we return finds no
+    // range left and only touches this state, never the functor.
+    struct State {
+      std::atomic_size_t next{0u};
+      std::atomic_bool failed{false};
+      std::exception_ptr exception;
+      std::mutex mutex;
+      std::condition_variable condition;
+      size_t finished_ranges = 0u;
+    };
+    auto state = std::make_shared<State>();
+    auto *function = &functor;
+
+    auto run = [=]() {
+      for (auto i = state->next++; i < number_of_ranges; i = state->next++) {
+        const auto begin = i * range_size;
+        if ((begin < count) && !state->failed) {
+          try {
+            (*function)(begin, std::min(begin + range_size, count));
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->failed.exchange(true)) {
+              state->exception = std::current_exception();
+            }
+          }
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (++state->finished_ranges == number_of_ranges) {
+          state->condition.notify_all();
+        }
+      }
+    };
+
+    const size_t helpers = std::min(GetNumberOfWorkers(), number_of_ranges - 1u);
+    for (auto i = 0u; i < helpers; ++i) {
+      Post(run);
+    }
+    run();
+
+    // Every range is taken by now, wait only for the ones still running on
+    // the helpers. We do not run other queued tasks meanwhile, the caller may
+    // be holding a lock that they need.
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&]() { return state->finished_ranges == number_of_ranges; });
+    if (state->exception) {
+      std::rethrow_exception(state->exception);
+    }
+  }
+
+} // namespace carla
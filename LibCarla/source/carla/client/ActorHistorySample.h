@@ -0,0 +1,42 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Transform.h"
+#include "carla/geom/Vector3D.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace client {
+
+#pragma pack(push, 1)
+  /// Dynamic state of an actor at a past frame, packed so an array of them
+  /// can be handed over as a single buffer.
+  struct ActorHistorySample {
+
+    uint64_t frame_count;
+
+    /// Simulated seconds elapsed since the beginning of the episode.
+    double elapsed_seconds;
+
+    geom::Transform transform;
+
+    geom::Vector3D velocity;
+
+    geom::Vector3D angular_velocity;
+
+    geom::Vector3D acceleration;
+  };
+#pragma pack(pop)
+
+  static_assert(
+      sizeof(ActorHistorySample) == sizeof(uint64_t) + sizeof(double) + 15u * sizeof(float),
+      "Invalid ActorHistorySample size");
+
+} // namespace client
+} // namespace carla
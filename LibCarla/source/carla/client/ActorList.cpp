@@ -6,7 +6,6 @@
 
 #include "carla/client/ActorList.h"
 
-#include "carla/StringUtil.h"
 #include "carla/client/detail/ActorFactory.h"
 
 #include <iterator>
@@ -18,25 +17,27 @@ namespace client {
       detail::EpisodeProxy episode,
       std::vector<rpc::Actor> actors)
     : _episode(std::move(episode)),
-      _actors(std::make_move_iterator(actors.begin()), std::make_move_iterator(actors.end())) {}
+      _actors(std::make_move_iterator(actors.begin()), std::make_move_iterator(actors.end())),
+      _index(_actors) {}
+
+  ActorList::ActorList(
+      detail::EpisodeProxy episode,
+      std::vector<detail::ActorVariant> actors)
+    : _episode(std::move(episode)),
+      _actors(std::move(actors)),
+      _index(_actors) {}
 
   SharedPtr<Actor> ActorList::Find(const ActorId actor_id) const {
-    for (auto &actor : _actors) {
-      if (actor_id == actor.GetId()) {
-        return actor.Get(_episode, shared_from_this());
-      }
-    }
-    return nullptr;
+    const auto pos = _index.Find(actor_id);
+    return pos.has_value() ? _actors[*pos].Get(_episode, shared_from_this()) : nullptr;
   }
 
   ActorList ActorList::Filter(const std::string &wildcard_pattern) const {
-    ActorList filtered{_episode, {}};
-    for (auto &&actor : _actors) {
-      if (StringUtil::Match(actor.GetTypeId(), wildcard_pattern)) {
-        filtered._actors.push_back(actor);
-      }
+    std::vector<detail::ActorVariant> filtered;
+    for (auto &&range : _index.Filter(wildcard_pattern)) {
+      filtered.insert(filtered.end(), _actors.begin() + range.first, _actors.begin() + range.second);
     }
-    return filtered;
+    return ActorList{_episode, std::move(filtered)};
   }
 
 } // namespace client
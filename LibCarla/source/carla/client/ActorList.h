@@ -6,15 +6,20 @@
 
 #pragma once
 
+#include "carla/client/detail/ActorListIndex.h"
 #include "carla/client/detail/ActorVariant.h"
 
 #include <boost/iterator/transform_iterator.hpp>
 
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace carla {
 namespace client {
 
+  /// List of actors, indexed by id and by type id. Actors are kept sorted by
+  /// type id so filtering by type only looks up the matching type ids.
   class ActorList : public EnableSharedFromThis<ActorList> {
   private:
 
@@ -63,9 +68,14 @@ namespace client {
 
     ActorList(detail::EpisodeProxy episode, std::vector<rpc::Actor> actors);
 
+    ActorList(detail::EpisodeProxy episode, std::vector<detail::ActorVariant> actors);
+
     detail::EpisodeProxy _episode;
 
+    /// Sorted by type id and id.
     std::vector<detail::ActorVariant> _actors;
+
+    detail::ActorListIndex _index;
   };
 
 } // namespace client
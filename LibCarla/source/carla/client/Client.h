@@ -20,8 +20,9 @@ namespace client {
     ///
     /// @param host IP address of the host machine running the simulator.
     /// @param port TCP port to connect with the simulator.
-    /// @param worker_threads number of asynchronous threads to use, or 0 to use
-    ///        all available hardware concurrency.
+    /// @param worker_threads number of asynchronous threads receiving the
+    ///        sensor data and running its callbacks, or 0 to use all available
+    ///        hardware concurrency. Each client has its own.
     explicit Client(
         const std::string &host,
         uint16_t port,
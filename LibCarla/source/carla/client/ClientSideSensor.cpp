@@ -0,0 +1,52 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/ClientSideSensor.h"
+
+#include "carla/Logging.h"
+#include "carla/client/detail/Simulator.h"
+
+#include <exception>
+
+namespace carla {
+namespace client {
+
+  ClientSideSensor::~ClientSideSensor() {
+    auto simulator = GetEpisode().TryLock();
+    if (_is_listening && (simulator != nullptr)) {
+      try {
+        simulator->UnregisterClientSideSensor(*this);
+      } catch (const std::exception &e) {
+        log_error("exception trying to stop sensor:", GetDisplayId(), ':', e.what());
+      }
+    }
+  }
+
+  void ClientSideSensor::Stop() {
+    GetEpisode().Lock()->UnregisterClientSideSensor(*this);
+    _is_listening = false;
+  }
+
+  void ClientSideSensor::ListenToTick(CallbackFunctionType callback) {
+    auto self = boost::static_pointer_cast<ClientSideSensor>(shared_from_this());
+
+    log_debug(GetDisplayId(), ": subscribing to tick event");
+    GetEpisode().Lock()->RegisterClientSideSensor(*this, [
+        cb=std::move(callback),
+        weak_self=WeakPtr<ClientSideSensor>(self)](const auto &state) {
+      auto self = weak_self.lock();
+      if (self != nullptr) {
+        auto data = self->Tick(state);
+        if (data != nullptr) {
+          cb(std::move(data));
+        }
+      }
+    });
+    _is_listening = true;
+  }
+
+} // namespace client
+} // namespace carla
@@ -11,10 +11,40 @@
 namespace carla {
 namespace client {
 
+  namespace detail { class EpisodeState; }
+
+  /// A sensor whose measurements are computed in the client from the episode
+  /// state received on each tick. The measurements of every client-side
+  /// sensor of the episode are computed in parallel.
   class ClientSideSensor : public Sensor {
   public:
 
     using Sensor::Sensor;
+
+    ~ClientSideSensor();
+
+    /// Stop listening for new measurements.
+    void Stop() override;
+
+    /// Return whether this Sensor instance is currently listening to new
+    /// measurements.
+    bool IsListening() const override {
+      return _is_listening;
+    }
+
+  protected:
+
+    /// Start computing a measurement on each tick, @a callback is called
+    /// with each measurement that is not nullptr.
+    void ListenToTick(CallbackFunctionType callback);
+
+    /// Compute the measurement of the episode state @a state, may return
+    /// nullptr if there is nothing to report. Called from a worker thread.
+    virtual SharedPtr<sensor::SensorData> Tick(const detail::EpisodeState &state) = 0;
+
+  private:
+
+    bool _is_listening = false;
   };
 
 } // namespace client
@@ -0,0 +1,35 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/rpc/ActorId.h"
+
+#include <cstddef>
+#include <string>
+
+namespace carla {
+namespace client {
+
+  /// Time spent computing the measurements of a client-side sensor.
+  struct ClientSideSensorStats {
+
+    ActorId sensor_id = 0u;
+
+    std::string display_id;
+
+    /// Number of ticks processed.
+    std::size_t tick_count = 0u;
+
+    double last_tick_seconds = 0.0;
+
+    double max_tick_seconds = 0.0;
+
+    double total_tick_seconds = 0.0;
+  };
+
+} // namespace client
+} // namespace carla
@@ -7,7 +7,7 @@
 
 #include "carla/Logging.h"
 #include "carla/client/Map.h"
-#include "carla/client/detail/Simulator.h"
+#include "carla/client/detail/EpisodeState.h"
 #include "carla/geom/Math.h"
 #include "carla/sensor/data/GnssEvent.h"
 #include "carla/StringUtil.h"
@@ -65,7 +65,7 @@ namespace client {
   GnssSensor::~GnssSensor() = default;
 
   void GnssSensor::Listen(CallbackFunctionType callback) {
-    if (_is_listening) {
+    if (IsListening()) {
       log_error(GetDisplayId(), ": already listening");
       return;
     }
@@ -79,8 +79,6 @@ namespace client {
 
     DEBUG_ASSERT(map != nullptr);
 
-    auto self = boost::static_pointer_cast<GnssSensor>(shared_from_this());
-
     //parse geo reference string
     _map_latitude = std::numeric_limits<double>::quiet_NaN();
     _map_longitude = std::numeric_limits<double>::quiet_NaN();
@@ -110,19 +108,7 @@ namespace client {
 
     log_debug(GetDisplayId(), ": map geo reference: latitude ", _map_latitude, ", longitude ", _map_longitude);
 
-    log_debug(GetDisplayId(), ": subscribing to tick event");
-    GetEpisode().Lock()->RegisterOnTickEvent([
-        cb=std::move(callback),
-        weak_self=WeakPtr<GnssSensor>(self)](const auto &timestamp) {
-      auto self = weak_self.lock();
-      if (self != nullptr) {
-        auto data = self->TickGnssSensor(timestamp);
-        if (data != nullptr) {
-          cb(std::move(data));
-        }
-      }
-    });
-    _is_listening = true;
+    ListenToTick(std::move(callback));
   }
 
   double GnssSensor::ParseDouble(std::string const &stringValue) const {
@@ -136,17 +122,19 @@ namespace client {
     return value;
   }
 
-  SharedPtr<sensor::SensorData> GnssSensor::TickGnssSensor(
-      const Timestamp &timestamp) {
+  SharedPtr<sensor::SensorData> GnssSensor::Tick(const detail::EpisodeState &state) {
     try {
-      const auto location = GetLocation();
+      const auto transform = state.GetActorState(GetId()).transform;
+      const auto &location = transform.location;
       double current_lat, current_lon;
 
       LatLonAddMeters(_map_latitude, _map_longitude, location.x, location.y, current_lat, current_lon);
 
+      const auto &timestamp = state.GetTimestamp();
       return MakeShared<sensor::data::GnssEvent>(
                timestamp.frame_count,
-               GetTransform(),
+               timestamp.elapsed_seconds,
+               transform,
                current_lat,
                current_lon,
                location.z);
@@ -158,9 +146,5 @@ namespace client {
 
   }
 
-  void GnssSensor::Stop() {
-    _is_listening = false;
-  }
-
 } // namespace client
 } // namespace carla
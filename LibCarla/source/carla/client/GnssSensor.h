@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "carla/client/Sensor.h"
+#include "carla/client/ClientSideSensor.h"
 #include <string>
 
 namespace carla {
@@ -14,10 +14,10 @@ namespace client {
   class Map;
   class Vehicle;
 
-  class GnssSensor final : public Sensor {
+  class GnssSensor final : public ClientSideSensor {
   public:
 
-    using Sensor::Sensor;
+    using ClientSideSensor::ClientSideSensor;
 
     ~GnssSensor();
 
@@ -30,27 +30,15 @@ namespace client {
     /// the same sensor in the simulator.
     void Listen(CallbackFunctionType callback) override;
 
-    /// Stop listening for new measurements.
-    void Stop() override;
-
-    /// Return whether this Sensor instance is currently listening to the
-    /// associated sensor in the simulator.
-    bool IsListening() const override {
-      return _is_listening;
-    }
-
   private:
 
-    SharedPtr<sensor::SensorData> TickGnssSensor(const Timestamp &timestamp);
+    SharedPtr<sensor::SensorData> Tick(const detail::EpisodeState &state) override;
 
     double ParseDouble(std::string const &stringValue) const;
 
     double _map_latitude;
 
     double _map_longitude;
-
-    bool _is_listening = false;
-
   };
 
 } // namespace client
@@ -0,0 +1,155 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/HazardDetector.h"
+
+#include "carla/StringUtil.h"
+#include "carla/client/Actor.h"
+#include "carla/client/Map.h"
+#include "carla/client/detail/ActorFactory.h"
+#include "carla/client/detail/Simulator.h"
+#include "carla/road/LaneOccupancy.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace carla {
+namespace client {
+
+  static bool IsVehicle(const rpc::Actor &actor) {
+    return StringUtil::StartsWith(actor.description.id, "vehicle.");
+  }
+
+  static bool IsTrafficLight(const rpc::Actor &actor) {
+    return StringUtil::StartsWith(actor.description.id, "traffic.traffic_light");
+  }
+
+  HazardDetector::HazardDetector(World world)
+    : _world(std::move(world)) {}
+
+  HazardDetector::~HazardDetector() = default;
+
+  HazardDetector::Hazards HazardDetector::Query(
+      const Actor &ego,
+      const double lookahead,
+      const bool expand_branches) {
+    return QueryImpl({ego.GetId()}, lookahead, expand_branches).front();
+  }
+
+  std::vector<HazardDetector::Hazards> HazardDetector::Query(
+      const std::vector<SharedPtr<Actor>> &egos,
+      const double lookahead,
+      const bool expand_branches) {
+    std::vector<ActorId> ids;
+    ids.reserve(egos.size());
+    for (auto &&ego : egos) {
+      DEBUG_ASSERT(ego != nullptr);
+      ids.emplace_back(ego->GetId());
+    }
+    return QueryImpl(ids, lookahead, expand_branches);
+  }
+
+  std::vector<HazardDetector::Hazards> HazardDetector::QueryImpl(
+      const std::vector<ActorId> &egos,
+      const double lookahead,
+      const bool expand_branches) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Refresh();
+    const auto hazards = _occupancy->Query(egos, lookahead, expand_branches);
+    std::vector<Hazards> result(hazards.size());
+    for (auto i = 0u; i < hazards.size(); ++i) {
+      if (hazards[i].vehicle_id != 0u) {
+        result[i].vehicle = MakeActor(hazards[i].vehicle_id);
+        result[i].vehicle_distance = hazards[i].vehicle_distance;
+      }
+      if (hazards[i].traffic_light_id != 0u) {
+        result[i].traffic_light = MakeActor(hazards[i].traffic_light_id);
+        result[i].traffic_light_distance = hazards[i].traffic_light_distance;
+        result[i].traffic_light_state = hazards[i].traffic_light_state;
+      }
+    }
+    return result;
+  }
+
+  void HazardDetector::Refresh() {
+    auto simulator = _world._episode.Lock();
+    const auto state = simulator->GetCurrentEpisodeState();
+    if ((_occupancy != nullptr) &&
+        (state->GetEpisodeId() == _episode_id) &&
+        (state->GetFrameCount() == _frame)) {
+      return;
+    }
+    if ((_occupancy == nullptr) || (state->GetEpisodeId() != _episode_id)) {
+      _map = simulator->GetCurrentMap();
+      _occupancy = std::make_unique<road::LaneOccupancy>(_map->_map);
+      _actors.clear();
+      _ignored_actors.clear();
+      _episode_id = state->GetEpisodeId();
+    }
+    _frame = state->GetFrameCount();
+
+    // Descriptions are only requested when new actors appear.
+    const auto ids = state->GetActorIds();
+    const bool has_new_actors = std::any_of(ids.begin(), ids.end(), [this](ActorId id) {
+      return (_actors.find(id) == _actors.end()) && (_ignored_actors.find(id) == _ignored_actors.end());
+    });
+    if (has_new_actors) {
+      for (auto &&actor : simulator->GetAllTheActorsInTheEpisode()) {
+        if (IsVehicle(actor) || IsTrafficLight(actor)) {
+          _actors.emplace(actor.id, std::move(actor));
+        } else {
+          _ignored_actors.emplace(actor.id);
+        }
+      }
+    }
+
+    // Forget the actors destroyed, every actor alive is known by now.
+    if ((_actors.size() + _ignored_actors.size()) > static_cast<size_t>(ids.size())) {
+      std::unordered_set<ActorId> alive(ids.begin(), ids.end());
+      for (auto it = _actors.begin(); it != _actors.end();) {
+        it = alive.count(it->first) > 0u ? std::next(it) : _actors.erase(it);
+      }
+      for (auto it = _ignored_actors.begin(); it != _ignored_actors.end();) {
+        it = alive.count(*it) > 0u ? std::next(it) : _ignored_actors.erase(it);
+      }
+    }
+
+    std::vector<road::LaneOccupancy::Vehicle> vehicles;
+    std::vector<road::LaneOccupancy::TrafficLight> traffic_lights;
+    for (auto &&id : ids) {
+      auto it = _actors.find(id);
+      if (it == _actors.end()) {
+        continue;
+      }
+      const auto actor = state->GetActorState(id);
+      if (IsVehicle(it->second)) {
+        const auto &data = actor.state.vehicle_data;
+        vehicles.push_back({
+            id,
+            actor.transform.location,
+            data.has_traffic_light ? data.traffic_light_id : 0u});
+      } else {
+        traffic_lights.push_back({
+            id,
+            actor.transform.location,
+            actor.state.traffic_light_data.state});
+      }
+    }
+    _occupancy->Update(vehicles, traffic_lights);
+  }
+
+  SharedPtr<Actor> HazardDetector::MakeActor(const ActorId id) const {
+    auto it = _actors.find(id);
+    DEBUG_ASSERT(it != _actors.end());
+    return detail::ActorFactory::MakeActor(
+        _world._episode,
+        it->second,
+        nullptr,
+        GarbageCollectionPolicy::Disabled);
+  }
+
+} // namespace client
+} // namespace carla
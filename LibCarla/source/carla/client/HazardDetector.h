@@ -0,0 +1,103 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/client/World.h"
+#include "carla/rpc/Actor.h"
+#include "carla/rpc/TrafficLightState.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carla {
+namespace road { class LaneOccupancy; }
+namespace client {
+
+  class Actor;
+  class Map;
+
+  /// Finds the closest vehicle blocking a vehicle and the traffic light
+  /// ahead of it, following the lanes it can drive on.
+  ///
+  /// The positions of every vehicle and traffic light are taken from the
+  /// episode state received with the world tick, and indexed by lane once
+  /// per frame; the map is downloaded once. Querying many vehicles on the
+  /// same frame only costs a short walk along the lanes ahead of each.
+  class HazardDetector
+    : public EnableSharedFromThis<HazardDetector>,
+      private NonCopyable {
+  public:
+
+    struct Hazards {
+      /// Closest vehicle ahead, nullptr if none.
+      SharedPtr<Actor> vehicle;
+      /// Distance along the lanes to the vehicle.
+      double vehicle_distance = 0.0;
+      /// Traffic light affecting the vehicle or, if none, the closest
+      /// traffic light ahead; nullptr if none.
+      SharedPtr<Actor> traffic_light;
+      /// Distance along the lanes to the traffic light, 0 if it is already
+      /// affecting the vehicle.
+      double traffic_light_distance = 0.0;
+      rpc::TrafficLightState traffic_light_state = rpc::TrafficLightState::Unknown;
+    };
+
+    explicit HazardDetector(World world);
+
+    ~HazardDetector();
+
+    /// Hazards within @a lookahead meters ahead of @a ego on the last frame
+    /// received. Where the lane forks only the straightest branch is
+    /// searched, unless @a expand_branches is set, see
+    /// road::LaneOccupancy::Query.
+    Hazards Query(const Actor &ego, double lookahead, bool expand_branches = false);
+
+    /// Same as above for several vehicles at once, computed in parallel.
+    std::vector<Hazards> Query(
+        const std::vector<SharedPtr<Actor>> &egos,
+        double lookahead,
+        bool expand_branches = false);
+
+  private:
+
+    std::vector<Hazards> QueryImpl(
+        const std::vector<ActorId> &egos,
+        double lookahead,
+        bool expand_branches);
+
+    /// Index the actors of the current episode state if not done yet.
+    /// @pre _mutex is locked.
+    void Refresh();
+
+    SharedPtr<Actor> MakeActor(ActorId id) const;
+
+    World _world;
+
+    std::mutex _mutex;
+
+    uint64_t _episode_id = 0u;
+
+    size_t _frame = 0u;
+
+    SharedPtr<Map> _map;
+
+    std::unique_ptr<road::LaneOccupancy> _occupancy;
+
+    /// Descriptions of the vehicles and traffic lights alive.
+    std::unordered_map<ActorId, rpc::Actor> _actors;
+
+    /// Actors alive that are neither vehicles nor traffic lights.
+    std::unordered_set<ActorId> _ignored_actors;
+  };
+
+} // namespace client
+} // namespace carla
@@ -9,7 +9,7 @@
 #include "carla/Logging.h"
 #include "carla/client/Map.h"
 #include "carla/client/Vehicle.h"
-#include "carla/client/detail/Simulator.h"
+#include "carla/client/detail/EpisodeState.h"
 #include "carla/geom/Math.h"
 #include "carla/sensor/data/LaneInvasionEvent.h"
 
@@ -28,9 +28,9 @@ namespace client {
         location.z};
   }
 
-  static std::array<geom::Location, 4u> GetVehicleBounds(const Vehicle &vehicle) {
-    const auto &box = vehicle.GetBoundingBox();
-    const auto &transform = vehicle.GetTransform();
+  static std::array<geom::Location, 4u> GetVehicleBounds(
+      const geom::BoundingBox &box,
+      const geom::Transform &transform) {
     const auto location = transform.location + box.location;
     const auto yaw = transform.rotation.yaw;
     return {
@@ -43,7 +43,7 @@ namespace client {
   LaneDetector::~LaneDetector() = default;
 
   void LaneDetector::Listen(CallbackFunctionType callback) {
-    if (_is_listening) {
+    if (IsListening()) {
       log_error(GetDisplayId(), ": already listening");
       return;
     }
@@ -57,42 +57,28 @@ namespace client {
     _map = GetWorld().GetMap();
     DEBUG_ASSERT(_map != nullptr);
 
-    auto self = boost::static_pointer_cast<LaneDetector>(shared_from_this());
-
-    log_debug(GetDisplayId(), ": subscribing to tick event");
-    GetEpisode().Lock()->RegisterOnTickEvent([
-        cb=std::move(callback),
-        weak_self=WeakPtr<LaneDetector>(self)](const auto &timestamp) {
-      auto self = weak_self.lock();
-      if (self != nullptr) {
-        auto data = self->TickLaneDetector(timestamp);
-        if (data != nullptr) {
-          cb(std::move(data));
-        }
-      }
-    });
-    _is_listening = true;
-  }
-
-  void LaneDetector::Stop() {
-    throw_exception(std::runtime_error("LaneDetector::Stop(): not implemented."));
+    ListenToTick(std::move(callback));
   }
 
-  SharedPtr<sensor::SensorData> LaneDetector::TickLaneDetector(
-      const Timestamp &timestamp) {
+  SharedPtr<sensor::SensorData> LaneDetector::Tick(const detail::EpisodeState &state) {
     try {
-      const auto new_bounds = GetVehicleBounds(*_vehicle);
+      // The vehicle is read from the episode state being processed, no need
+      // to go through the simulator.
+      const auto transform = state.GetActorState(_vehicle->GetId()).transform;
+      const auto new_bounds = GetVehicleBounds(_vehicle->GetBoundingBox(), transform);
       std::vector<road::element::LaneMarking> crossed_lanes;
       for (auto i = 0u; i < _bounds.size(); ++i) {
         const auto lanes = _map->CalculateCrossedLanes(_bounds[i], new_bounds[i]);
         crossed_lanes.insert(crossed_lanes.end(), lanes.begin(), lanes.end());
       }
       _bounds = new_bounds;
+      const auto &timestamp = state.GetTimestamp();
       return crossed_lanes.empty() ?
           nullptr :
           MakeShared<sensor::data::LaneInvasionEvent>(
               timestamp.frame_count,
-              _vehicle->GetTransform(),
+              timestamp.elapsed_seconds,
+              transform,
               _vehicle,
               crossed_lanes);
     } catch (const std::exception &e) {
@@ -31,21 +31,9 @@ namespace client {
     /// @todo This is different from other sensors.
     void Listen(CallbackFunctionType callback) override;
 
-    /// Stop listening for new measurements.
-    /// @throw Not implemented error.
-    void Stop() override;
-
-    /// Return whether this Sensor instance is currently listening to the
-    /// associated sensor in the simulator.
-    bool IsListening() const override {
-      return _is_listening;
-    }
-
   private:
 
-    SharedPtr<sensor::SensorData> TickLaneDetector(const Timestamp &timestamp);
-
-    bool _is_listening = false;
+    SharedPtr<sensor::SensorData> Tick(const detail::EpisodeState &state) override;
 
     SharedPtr<Map> _map;
 
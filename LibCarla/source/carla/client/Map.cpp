@@ -6,11 +6,16 @@
 
 #include "carla/client/Map.h"
 
+#include "carla/FileSystem.h"
 #include "carla/client/Waypoint.h"
 #include "carla/opendrive/OpenDrive.h"
+#include "carla/road/ContractionHierarchy.h"
+#include "carla/road/LanePolylines.h"
 #include "carla/road/Map.h"
+#include "carla/road/RoutingGraph.h"
 #include "carla/road/WaypointGenerator.h"
 
+#include <limits>
 #include <sstream>
 
 namespace carla {
@@ -29,13 +34,14 @@ namespace client {
 
   SharedPtr<Waypoint> Map::GetWaypoint(
       const geom::Location &location,
-      bool project_to_road) const {
+      bool project_to_road,
+      road::element::LaneType lane_type) const {
     DEBUG_ASSERT(_map != nullptr);
     boost::optional<road::element::Waypoint> waypoint;
     if (project_to_road) {
-      waypoint = _map->GetClosestWaypointOnRoad(location);
+      waypoint = _map->GetClosestWaypointOnRoad(location, lane_type);
     } else {
-      waypoint = _map->GetWaypoint(location);
+      waypoint = _map->GetWaypoint(location, lane_type);
     }
     return waypoint.has_value() ?
         SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
@@ -69,9 +75,11 @@ namespace client {
     return result;
   }
 
-  std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(double distance) const {
+  std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(
+      double distance,
+      road::element::LaneType lane_type) const {
     std::vector<SharedPtr<Waypoint>> result;
-    const auto waypoints = road::WaypointGenerator::GenerateAll(*_map, distance);
+    const auto waypoints = road::WaypointGenerator::GenerateAll(*_map, distance, lane_type);
     result.reserve(waypoints.size());
     for (const auto &waypoint : waypoints) {
       result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
@@ -91,5 +99,179 @@ namespace client {
     DEBUG_ASSERT(_map != nullptr);
     return _map->GetData().GetGeoReference();
   }
+
+  Map::Route Map::ComputeRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      const bool bidirectional) const {
+    auto routes = ComputeRoutes({{origin, destination}}, bidirectional);
+    DEBUG_ASSERT(routes.size() == 1u);
+    return std::move(routes.front());
+  }
+
+  std::vector<Map::Route> Map::ComputeRoutes(
+      const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+      const bool bidirectional) const {
+    DEBUG_ASSERT(_map != nullptr);
+    using RoutingGraph = road::RoutingGraph;
+    const auto &graph = GetRoutingGraph();
+
+    const auto algorithm = bidirectional ?
+        RoutingGraph::Algorithm::BidirectionalDijkstra :
+        RoutingGraph::Algorithm::AStar;
+
+    std::vector<std::pair<road::element::Waypoint, road::element::Waypoint>> waypoints;
+    std::vector<std::pair<RoutingGraph::node_id_type, RoutingGraph::node_id_type>> lanes;
+    std::vector<size_t> indices;
+    waypoints.reserve(queries.size());
+    lanes.reserve(queries.size());
+    indices.reserve(queries.size());
+    // Destinations behind the origin on the same lane, solved apart.
+    std::vector<size_t> around;
+    for (auto i = 0u; i < queries.size(); ++i) {
+      const auto w0 = _map->GetClosestWaypointOnRoad(queries[i].first);
+      const auto w1 = _map->GetClosestWaypointOnRoad(queries[i].second);
+      if (!w0.has_value() || !w1.has_value()) {
+        continue;
+      }
+      const auto origin = graph.FindLane(*w0);
+      const auto destination = graph.FindLane(*w1);
+      if (origin.has_value() && destination.has_value()) {
+        if (RoutingGraph::IsBehind(*w0, *w1)) {
+          around.emplace_back(waypoints.size());
+        }
+        waypoints.emplace_back(*w0, *w1);
+        lanes.emplace_back(*origin, *destination);
+        indices.emplace_back(i);
+      }
+    }
+
+    const auto index = GetRoutingIndex();
+    auto lane_routes = index != nullptr ?
+        index->FindRoutes(lanes) :
+        graph.FindRoutes(lanes, algorithm);
+    for (auto i : around) {
+      lane_routes[i] = graph.FindRouteAround(lanes[i].first, algorithm);
+    }
+
+    auto make_waypoint = [this](const road::element::Waypoint &waypoint) {
+      return SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint});
+    };
+
+    std::vector<Route> result(queries.size());
+    for (auto i = 0u; i < lane_routes.size(); ++i) {
+      const auto &lane_route = lane_routes[i];
+      if (lane_route.empty()) {
+        continue;
+      }
+      const auto &endpoints = waypoints[i];
+      auto &route = result[indices[i]];
+      route.reserve(lane_route.lanes.size() + 1u);
+      route.emplace_back(make_waypoint(endpoints.first), road::RoadOption::LaneFollow);
+      for (auto j = 1u; j < lane_route.lanes.size(); ++j) {
+        route.emplace_back(
+            make_waypoint(graph.GetLaneBegin(*_map, lane_route.lanes[j])),
+            lane_route.options[j]);
+      }
+      route.emplace_back(make_waypoint(endpoints.second), road::RoadOption::LaneFollow);
+    }
+    return result;
+  }
+
+  std::vector<std::vector<double>> Map::ComputeRouteDistances(
+      const std::vector<geom::Location> &origins,
+      const std::vector<geom::Location> &destinations) const {
+    DEBUG_ASSERT(_map != nullptr);
+    using node_id_type = road::RoutingGraph::node_id_type;
+    const auto &graph = GetRoutingGraph();
+    auto index = GetRoutingIndex();
+    if (index == nullptr) {
+      BuildRoutingIndex();
+      index = GetRoutingIndex();
+    }
+    DEBUG_ASSERT(index != nullptr);
+
+    // Locations not on a lane of the routing graph are left out of the table.
+    auto find_lanes = [&](const std::vector<geom::Location> &locations) {
+      std::vector<node_id_type> lanes;
+      std::vector<size_t> indices;
+      for (auto i = 0u; i < locations.size(); ++i) {
+        const auto waypoint = _map->GetClosestWaypointOnRoad(locations[i]);
+        const auto lane = waypoint.has_value() ?
+            graph.FindLane(*waypoint) :
+            boost::optional<node_id_type>{};
+        if (lane.has_value()) {
+          lanes.emplace_back(*lane);
+          indices.emplace_back(i);
+        }
+      }
+      return std::make_pair(std::move(lanes), std::move(indices));
+    };
+    const auto rows = find_lanes(origins);
+    const auto columns = find_lanes(destinations);
+    const auto table = index->GetDistanceTable(rows.first, columns.first);
+
+    std::vector<std::vector<double>> result(
+        origins.size(),
+        std::vector<double>(destinations.size(), std::numeric_limits<double>::infinity()));
+    for (auto i = 0u; i < rows.second.size(); ++i) {
+      auto &row = result[rows.second[i]];
+      for (auto j = 0u; j < columns.second.size(); ++j) {
+        row[columns.second[j]] = table[i * columns.second.size() + j];
+      }
+    }
+    return result;
+  }
+
+  void Map::BuildRoutingIndex() const {
+    auto index = std::make_shared<const road::ContractionHierarchy>(GetRoutingGraph());
+    std::lock_guard<std::mutex> lock(_routing_index_mutex);
+    _routing_index = std::move(index);
+  }
+
+  void Map::SaveRoutingIndex(std::string path) const {
+    auto index = GetRoutingIndex();
+    if (index == nullptr) {
+      BuildRoutingIndex();
+      index = GetRoutingIndex();
+    }
+    DEBUG_ASSERT(index != nullptr);
+    FileSystem::ValidateFilePath(path, ".routing");
+    index->Save(path);
+  }
+
+  void Map::LoadRoutingIndex(const std::string &path) const {
+    auto index = std::make_shared<const road::ContractionHierarchy>(
+        road::ContractionHierarchy::Load(path, GetRoutingGraph()));
+    std::lock_guard<std::mutex> lock(_routing_index_mutex);
+    _routing_index = std::move(index);
+  }
+
+  SharedPtr<const road::LanePolylines> Map::GetLanePolylines(
+      const double resolution,
+      const road::element::LaneType lane_type) const {
+    DEBUG_ASSERT(_map != nullptr);
+    std::lock_guard<std::mutex> lock(_lane_polylines_mutex);
+    if ((_lane_polylines == nullptr) ||
+        (_lane_polylines->GetResolution() != resolution) ||
+        (_lane_polylines->GetLaneType() != lane_type)) {
+      _lane_polylines = MakeShared<const road::LanePolylines>(*_map, resolution, lane_type);
+    }
+    return _lane_polylines;
+  }
+
+  std::shared_ptr<const road::ContractionHierarchy> Map::GetRoutingIndex() const {
+    std::lock_guard<std::mutex> lock(_routing_index_mutex);
+    return _routing_index;
+  }
+
+  const road::RoutingGraph &Map::GetRoutingGraph() const {
+    DEBUG_ASSERT(_map != nullptr);
+    std::call_once(_routing_graph_flag, [this]() {
+      _routing_graph = std::make_unique<road::RoutingGraph>(*_map);
+    });
+    return *_routing_graph;
+  }
+
 } // namespace client
 } // namespace carla
@@ -9,12 +9,24 @@
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/LaneType.h"
 #include "carla/rpc/MapInfo.h"
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace carla {
-namespace road { class Map; }
+namespace road {
+  class ContractionHierarchy;
+  class LanePolylines;
+  class Map;
+  class RoutingGraph;
+  enum class RoadOption : int8_t;
+} // namespace road
 namespace client {
 
   class Waypoint;
@@ -40,15 +52,20 @@ namespace client {
       return _description.recommended_spawn_points;
     }
 
+    /// Waypoint on the lanes whose type is in the @a lane_type mask, nullptr
+    /// if there is none.
     SharedPtr<Waypoint> GetWaypoint(
         const geom::Location &location,
-        bool project_to_road = true) const;
+        bool project_to_road = true,
+        road::element::LaneType lane_type = road::element::LaneType::Driving) const;
 
     using TopologyList = std::vector<std::pair<SharedPtr<Waypoint>, SharedPtr<Waypoint>>>;
 
     TopologyList GetTopology() const;
 
-    std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
+    std::vector<SharedPtr<Waypoint>> GenerateWaypoints(
+        double distance,
+        road::element::LaneType lane_type = road::element::LaneType::Driving) const;
 
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
@@ -56,11 +73,80 @@ namespace client {
 
     std::string GetGeoReference() const;
 
+    /// Waypoints of a route, each paired with the maneuver needed to reach it.
+    using Route = std::vector<std::pair<SharedPtr<Waypoint>, road::RoadOption>>;
+
+    /// Compute the shortest lane-level route between the closest waypoints
+    /// to @a origin and @a destination. The route contains the origin, the
+    /// entrance of every lane traversed, and the destination; it is empty if
+    /// the destination cannot be reached.
+    ///
+    /// The routing graph is built on the first call.
+    Route ComputeRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        bool bidirectional = false) const;
+
+    /// Compute the route of every origin-destination pair in @a queries.
+    ///
+    /// If a routing index has been built or loaded, it is used instead of
+    /// searching the routing graph.
+    std::vector<Route> ComputeRoutes(
+        const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+        bool bidirectional = false) const;
+
+    /// Length of the shortest route between every origin and every
+    /// destination, one row per origin; infinity if not reachable. Lengths
+    /// are measured between the beginnings of the lanes of the closest
+    /// waypoints.
+    ///
+    /// The routing index is built on the first call if not loaded before.
+    std::vector<std::vector<double>> ComputeRouteDistances(
+        const std::vector<geom::Location> &origins,
+        const std::vector<geom::Location> &destinations) const;
+
+    /// Precompute the routing index (a contraction hierarchy of the routing
+    /// graph) to speed up subsequent route queries.
+    void BuildRoutingIndex() const;
+
+    /// Save the routing index to @a path, building it if needed.
+    void SaveRoutingIndex(std::string path) const;
+
+    /// Load a routing index saved with SaveRoutingIndex. Throws
+    /// std::invalid_argument if it does not belong to this map.
+    void LoadRoutingIndex(const std::string &path) const;
+
+    /// Center lines of the lanes whose type is in the @a lane_type mask
+    /// sampled every @a resolution meters, as flat arrays. The last
+    /// polylines computed are kept and returned again if requested with the
+    /// same arguments.
+    SharedPtr<const road::LanePolylines> GetLanePolylines(
+        double resolution,
+        road::element::LaneType lane_type = road::element::LaneType::Driving) const;
+
   private:
 
+    friend class HazardDetector;
+
+    const road::RoutingGraph &GetRoutingGraph() const;
+
+    std::shared_ptr<const road::ContractionHierarchy> GetRoutingIndex() const;
+
     rpc::MapInfo _description;
 
     SharedPtr<road::Map> _map;
+
+    mutable std::once_flag _routing_graph_flag;
+
+    mutable std::unique_ptr<road::RoutingGraph> _routing_graph;
+
+    mutable std::mutex _routing_index_mutex;
+
+    mutable std::shared_ptr<const road::ContractionHierarchy> _routing_index;
+
+    mutable std::mutex _lane_polylines_mutex;
+
+    mutable SharedPtr<const road::LanePolylines> _lane_polylines;
   };
 
 } // namespace client
@@ -0,0 +1,127 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/client/Timestamp.h"
+#include "carla/client/detail/EpisodeState.h"
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+namespace detail { class SensorFrameAssembler; }
+
+  /// Set of measurements generated in the same simulation frame by the
+  /// sensors of a SensorSynchronizer, plus the episode state of that frame.
+  ///
+  /// Measurements are stored in the same order the sensors were given to the
+  /// synchronizer. If the bundle is not complete, the missing measurements
+  /// are nullptr.
+  class SensorBundle : private NonCopyable {
+  public:
+
+    using value_type = SharedPtr<sensor::SensorData>;
+
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    SensorBundle(size_t frame_number, size_t number_of_sensors)
+      : _frame_number(frame_number),
+        _data(number_of_sensors) {}
+
+    /// Frame count shared by all the measurements in this bundle.
+    size_t GetFrameNumber() const {
+      return _frame_number;
+    }
+
+    /// Time-stamp of the world tick of this frame, empty if the tick was not
+    /// received.
+    const boost::optional<Timestamp> &GetTimestamp() const {
+      return _timestamp;
+    }
+
+    /// State of the episode at this frame, nullptr if not available.
+    const std::shared_ptr<const detail::EpisodeState> &GetEpisodeState() const {
+      return _state;
+    }
+
+    /// Whether every sensor and the world tick contributed to this bundle.
+    bool IsComplete() const {
+      return _missing == 0u;
+    }
+
+    const value_type &at(size_t pos) const {
+      return _data.at(pos);
+    }
+
+    const value_type &operator[](size_t pos) const {
+      return _data[pos];
+    }
+
+    const_iterator begin() const {
+      return _data.begin();
+    }
+
+    const_iterator end() const {
+      return _data.end();
+    }
+
+    size_t size() const {
+      return _data.size();
+    }
+
+    bool empty() const {
+      return _data.empty();
+    }
+
+  private:
+
+    friend class detail::SensorFrameAssembler;
+
+    /// Return true if the slot was empty.
+    bool SetData(size_t pos, value_type data) {
+      DEBUG_ASSERT(pos < _data.size());
+      if (_data[pos] != nullptr) {
+        return false;
+      }
+      _data[pos] = std::move(data);
+      return true;
+    }
+
+    /// Return true if the tick was not set yet.
+    bool SetTick(
+        const Timestamp &timestamp,
+        std::shared_ptr<const detail::EpisodeState> state) {
+      if (_timestamp.has_value()) {
+        return false;
+      }
+      _timestamp = timestamp;
+      _state = std::move(state);
+      return true;
+    }
+
+    const size_t _frame_number;
+
+    std::vector<value_type> _data;
+
+    boost::optional<Timestamp> _timestamp;
+
+    std::shared_ptr<const detail::EpisodeState> _state;
+
+    /// Number of pieces still missing, set by the synchronizer.
+    size_t _missing = 0u;
+  };
+
+} // namespace client
+} // namespace carla
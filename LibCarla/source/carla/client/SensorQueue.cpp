@@ -0,0 +1,173 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/SensorQueue.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/client/Sensor.h"
+#include "carla/profiler/Metrics.h"
+#include "carla/sensor/SensorData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace carla {
+namespace client {
+
+  SensorQueue::SensorQueue(const size_t capacity, const OverflowPolicy policy)
+    : _queue(capacity),
+      _policy(policy) {}
+
+  SensorQueue::~SensorQueue() {
+    try {
+      Stop();
+    } catch (const std::exception &e) {
+      log_error("exception trying to stop sensor queue:", e.what());
+    }
+  }
+
+  void SensorQueue::Listen(SharedPtr<Sensor> sensor) {
+    DEBUG_ASSERT(sensor != nullptr);
+    WeakPtr<SensorQueue> weak = shared_from_this();
+    sensor->Listen([weak](DataPtr data) {
+      auto self = weak.lock();
+      if (self != nullptr) {
+        self->Push(std::move(data));
+      }
+    });
+    std::lock_guard<std::mutex> lock(_sensors_mutex);
+    _sensors.emplace_back(std::move(sensor));
+  }
+
+  void SensorQueue::Stop() {
+    std::vector<SharedPtr<Sensor>> sensors;
+    {
+      std::lock_guard<std::mutex> lock(_sensors_mutex);
+      std::swap(sensors, _sensors);
+    }
+    for (auto &&sensor : sensors) {
+      if (sensor->IsListening()) {
+        sensor->Stop();
+      }
+    }
+  }
+
+  void SensorQueue::Push(DataPtr data) {
+    static auto &overflows = profiler::Metrics::GetCounter("sensor_queue.overflows");
+    while (!_queue.TryPush(data)) {
+      overflows.Increment();
+      if (_policy == OverflowPolicy::DropNewest) {
+        ++_dropped;
+        return;
+      }
+      DataPtr oldest;
+      if (_queue.TryPop(oldest)) {
+        ++_dropped;
+      }
+    }
+    // Pairs with the fence in WaitAndPop, either the consumer sees the data or
+    // we see the consumer waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiting > 0u) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _condition.notify_all();
+    }
+  }
+
+  bool SensorQueue::TryPop(DataPtr &data) {
+    if (_pending != nullptr) {
+      data = std::move(_pending);
+      _pending = nullptr;
+      return true;
+    }
+    return _queue.TryPop(data);
+  }
+
+  bool SensorQueue::WaitAndPop(
+      std::unique_lock<std::mutex> &lock,
+      const time_duration timeout,
+      DataPtr &data) {
+    if (TryPop(data)) {
+      return true;
+    }
+    ++_waiting;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool success = _condition.wait_for(lock, timeout.to_chrono(), [&]() {
+      return TryPop(data);
+    });
+    --_waiting;
+    return success;
+  }
+
+  SensorQueue::DataPtr SensorQueue::Get(const time_duration timeout) {
+    DataPtr data;
+    std::unique_lock<std::mutex> lock(_mutex);
+    WaitAndPop(lock, timeout, data);
+    return data;
+  }
+
+  SensorQueue::DataPtr SensorQueue::GetFrame(const size_t frame_number, const time_duration timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout.to_chrono();
+    std::unique_lock<std::mutex> lock(_mutex);
+    DataPtr data;
+    for (;;) {
+      const auto now = std::chrono::steady_clock::now();
+      const time_duration remaining = now < deadline ?
+          std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now) :
+          std::chrono::milliseconds(0);
+      if (!WaitAndPop(lock, remaining, data)) {
+        return nullptr;
+      }
+      if (data->GetFrameNumber() == frame_number) {
+        return data;
+      }
+      if (data->GetFrameNumber() > frame_number) {
+        _pending = std::move(data);
+        return nullptr;
+      }
+      ++_dropped;
+    }
+  }
+
+  std::vector<SensorQueue::DataPtr> SensorQueue::GetBatch(
+      const size_t max_count,
+      const time_duration timeout) {
+    std::vector<DataPtr> result;
+    DataPtr data;
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!WaitAndPop(lock, timeout, data)) {
+      return result;
+    }
+    const size_t count = max_count > 0u ? max_count : _queue.capacity() + 1u;
+    result.reserve(std::min(count, _queue.size() + 1u));
+    do {
+      result.emplace_back(std::move(data));
+    } while ((result.size() < count) && TryPop(data));
+    return result;
+  }
+
+  SensorQueue::DataPtr SensorQueue::GetLatest() {
+    DataPtr latest;
+    DataPtr data;
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (TryPop(data)) {
+      if (latest != nullptr) {
+        ++_dropped;
+      }
+      latest = std::move(data);
+    }
+    return latest;
+  }
+
+  size_t SensorQueue::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size() + (_pending != nullptr ? 1u : 0u);
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,127 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/BoundedQueue.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  class Sensor;
+
+  /// Bounded queue receiving the measurements of one or several sensors, to
+  /// be pulled by the user instead of pushed to a callback.
+  ///
+  /// The streaming threads only push into a lock-free ring and never call
+  /// user code, so no interpreter lock needs to be acquired there. Pulling
+  /// calls may block waiting for data.
+  class SensorQueue
+    : public EnableSharedFromThis<SensorQueue>,
+      private NonCopyable {
+  public:
+
+    using DataPtr = SharedPtr<sensor::SensorData>;
+
+    /// What to do with a measurement arriving when the queue is full.
+    enum class OverflowPolicy {
+      /// Drop the oldest measurement in the queue to make room.
+      DropOldest,
+      /// Drop the incoming measurement.
+      DropNewest
+    };
+
+    explicit SensorQueue(size_t capacity = 64u, OverflowPolicy policy = OverflowPolicy::DropOldest);
+
+    ~SensorQueue();
+
+    /// Push every measurement of @a sensor into this queue.
+    ///
+    /// @warning This steals the data stream of the sensor, any callback
+    /// previously registered with Sensor::Listen is replaced.
+    void Listen(SharedPtr<Sensor> sensor);
+
+    /// Stop every sensor pushing into this queue, measurements already queued
+    /// can still be retrieved.
+    void Stop();
+
+    /// Pop the oldest measurement, waiting up to @a timeout for one to
+    /// arrive. Return nullptr on timeout.
+    DataPtr Get(time_duration timeout);
+
+    /// Pop the oldest measurement of frame @a frame_number, waiting up to
+    /// @a timeout. Older measurements are discarded. Return nullptr on
+    /// timeout, or if a newer frame arrives first (it stays in the queue).
+    DataPtr GetFrame(size_t frame_number, time_duration timeout);
+
+    /// Pop up to @a max_count measurements (all if 0), waiting up to
+    /// @a timeout for at least one to arrive.
+    std::vector<DataPtr> GetBatch(size_t max_count, time_duration timeout);
+
+    /// Pop every measurement queued and return the newest, discarding the
+    /// rest. Return nullptr if the queue is empty.
+    DataPtr GetLatest();
+
+    /// Number of measurements queued.
+    size_t size() const;
+
+    size_t capacity() const {
+      return _queue.capacity();
+    }
+
+    /// Number of measurements dropped or discarded since the queue was
+    /// created.
+    size_t GetNumberOfDroppedMeasurements() const {
+      return _dropped;
+    }
+
+  protected:
+
+    /// Push a measurement as the sensor streams do, protected for testing.
+    void Push(DataPtr data);
+
+  private:
+
+    /// @pre _mutex is locked.
+    bool TryPop(DataPtr &data);
+
+    /// Pop into @a data waiting up to @a timeout. @pre @a lock holds _mutex.
+    bool WaitAndPop(std::unique_lock<std::mutex> &lock, time_duration timeout, DataPtr &data);
+
+    BoundedQueue<DataPtr> _queue;
+
+    const OverflowPolicy _policy;
+
+    std::atomic_size_t _dropped{0u};
+
+    /// Consumers waiting for data, producers only lock _mutex to wake them.
+    std::atomic_size_t _waiting{0u};
+
+    /// Serializes the consumers.
+    mutable std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    /// Measurement popped by GetFrame that belongs to a later frame, returned
+    /// before anything in the queue.
+    DataPtr _pending;
+
+    std::mutex _sensors_mutex;
+
+    std::vector<SharedPtr<Sensor>> _sensors;
+  };
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,280 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/SensorRecorder.h"
+
+#include "carla/FileSystem.h"
+#include "carla/Logging.h"
+#include "carla/StopWatch.h"
+#include "carla/client/ServerSideSensor.h"
+#include "carla/client/detail/AppendFile.h"
+#include "carla/client/detail/SensorRecordingFormat.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  // ===========================================================================
+  // -- SensorRecorder::Writer -------------------------------------------------
+  // ===========================================================================
+
+  /// Writes the segments and the index of a recording, used only by the I/O
+  /// thread.
+  class SensorRecorder::Writer : private NonCopyable {
+  public:
+
+    Writer(std::string folder, const Options &options)
+      : _folder(std::move(folder)),
+        _options(options),
+        _index(detail::recording::GetIndexFileName(_folder), false, 64u * 1024u) {
+      detail::recording::IndexHeader header;
+      std::memcpy(header.magic, detail::recording::magic, sizeof(header.magic));
+      header.version = detail::recording::version;
+      header.reserved = 0u;
+      _index.Append(&header, sizeof(header));
+      // Readable as an empty recording until the first flush.
+      _index.Flush();
+      OpenSegment();
+    }
+
+    void Write(const Buffer &buffer) {
+      if ((_segment->size() > 0u) &&
+          ((_segment->size() + buffer.size()) > _options.segment_size)) {
+        NextSegment();
+      }
+      detail::recording::IndexEntry entry;
+      entry.frame_number = GetFrameNumber(buffer);
+      entry.offset = _segment->size();
+      entry.segment = _segment_count - 1u;
+      entry.size = static_cast<uint32_t>(buffer.size());
+      _segment->Append(buffer.data(), buffer.size());
+      _pending.emplace_back(entry);
+      _unflushed_bytes += buffer.size();
+      if (_options.sync_policy == SyncPolicy::EveryMessage) {
+        Flush(true);
+      }
+    }
+
+    /// Write the pending index entries after the data they point to.
+    void Flush(bool sync) {
+      if (sync) {
+        _segment->Sync();
+      } else {
+        _segment->Flush();
+      }
+      if (!_pending.empty()) {
+        _index.Append(_pending.data(), sizeof(_pending[0u]) * _pending.size());
+        _pending.clear();
+      }
+      if (sync) {
+        _index.Sync();
+      } else {
+        _index.Flush();
+      }
+      _unflushed_bytes = 0u;
+      _since_last_flush.Restart();
+    }
+
+    /// Whether there are messages written that are not flushed yet.
+    bool HasUnflushedData() const {
+      return !_pending.empty();
+    }
+
+    /// Whether the unflushed data reached the flush size or has been waiting
+    /// longer than the flush interval.
+    bool IsFlushDue() const {
+      return HasUnflushedData() && (
+          (_unflushed_bytes >= _options.flush_size) ||
+          (GetTimeUntilFlush() == std::chrono::milliseconds(0)));
+    }
+
+    /// Time left until the flush interval passes.
+    std::chrono::milliseconds GetTimeUntilFlush() const {
+      const auto interval = _options.flush_interval.to_chrono();
+      const auto elapsed = std::chrono::milliseconds(_since_last_flush.GetElapsedTime());
+      return elapsed < interval ? interval - elapsed : std::chrono::milliseconds(0);
+    }
+
+    void Close() {
+      Flush(_options.sync_policy != SyncPolicy::Never);
+      _segment->Close();
+      _index.Close();
+    }
+
+  private:
+
+    static uint64_t GetFrameNumber(const Buffer &buffer) {
+      using Serializer = sensor::s11n::SensorHeaderSerializer;
+      return buffer.size() >= Serializer::header_offset ?
+          Serializer::Deserialize(buffer).frame_number :
+          0u;
+    }
+
+    void OpenSegment() {
+      _segment = std::make_unique<detail::AppendFile>(
+          detail::recording::GetSegmentFileName(_folder, _segment_count),
+          _options.direct_io,
+          1024u * 1024u);
+      ++_segment_count;
+    }
+
+    void NextSegment() {
+      Flush(_options.sync_policy != SyncPolicy::Never);
+      _segment->Close();
+      OpenSegment();
+    }
+
+    const std::string _folder;
+
+    const Options &_options;
+
+    detail::AppendFile _index;
+
+    std::unique_ptr<detail::AppendFile> _segment;
+
+    uint32_t _segment_count = 0u;
+
+    std::vector<detail::recording::IndexEntry> _pending;
+
+    size_t _unflushed_bytes = 0u;
+
+    StopWatch _since_last_flush;
+  };
+
+  // ===========================================================================
+  // -- SensorRecorder ---------------------------------------------------------
+  // ===========================================================================
+
+  static std::string MakeRecordingFolder(std::string folder) {
+    auto index = detail::recording::GetIndexFileName(folder);
+    FileSystem::ValidateFilePath(index);
+    return folder;
+  }
+
+  SensorRecorder::SensorRecorder(std::string folder, Options options)
+    : _folder(MakeRecordingFolder(std::move(folder))),
+      _options(options) {
+    // Open the files here to report any error to the caller.
+    auto writer = std::make_unique<Writer>(_folder, _options);
+    _thread = std::thread(&SensorRecorder::Run, this, std::move(writer));
+  }
+
+  SensorRecorder::SensorRecorder(std::string folder)
+    : SensorRecorder(std::move(folder), Options{}) {}
+
+  SensorRecorder::~SensorRecorder() {
+    try {
+      Close();
+    } catch (const std::exception &e) {
+      log_error("exception closing sensor recorder:", e.what());
+    }
+  }
+
+  void SensorRecorder::Listen(SharedPtr<ServerSideSensor> sensor) {
+    DEBUG_ASSERT(sensor != nullptr);
+    if (IsListening()) {
+      Stop();
+    }
+    WeakPtr<SensorRecorder> weak_self = shared_from_this();
+    sensor->ListenToSerializedData([weak_self](Buffer buffer) {
+      auto self = weak_self.lock();
+      if (self != nullptr) {
+        self->Record(std::move(buffer));
+      }
+    });
+    _sensor = std::move(sensor);
+  }
+
+  void SensorRecorder::Stop() {
+    if (_sensor != nullptr) {
+      if (_sensor->IsListening()) {
+        _sensor->Stop();
+      }
+      _sensor = nullptr;
+    }
+  }
+
+  void SensorRecorder::Record(Buffer buffer) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!_done && ((_queued_bytes + buffer.size()) <= _options.max_queue_size)) {
+        _queued_bytes += buffer.size();
+        _queue.emplace_back(std::move(buffer));
+        _condition.notify_one();
+        return;
+      }
+    }
+    ++_dropped;
+  }
+
+  void SensorRecorder::Close() {
+    try {
+      Stop();
+    } catch (const std::exception &e) {
+      // The I/O thread has to be joined regardless.
+      log_error("exception trying to stop sensor:", e.what());
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _done = true;
+    }
+    _condition.notify_one();
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+    if (_error != nullptr) {
+      auto error = _error;
+      _error = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  void SensorRecorder::Run(std::unique_ptr<Writer> writer) {
+    try {
+      for (;;) {
+        Buffer buffer;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          auto has_work = [this]() { return _done || !_queue.empty(); };
+          if (!writer->HasUnflushedData()) {
+            _condition.wait(lock, has_work);
+          } else if (!_condition.wait_for(lock, writer->GetTimeUntilFlush(), has_work)) {
+            // Nothing else to do, flush what is pending before waiting again.
+            lock.unlock();
+            writer->Flush(false);
+            continue;
+          }
+          if (_queue.empty()) {
+            break;
+          }
+          buffer = std::move(_queue.front());
+          _queue.pop_front();
+          _queued_bytes -= buffer.size();
+        }
+        writer->Write(buffer);
+        ++_recorded;
+        if (writer->IsFlushDue()) {
+          writer->Flush(false);
+        }
+      }
+      writer->Close();
+    } catch (const std::exception &e) {
+      log_error("sensor recorder:", e.what());
+      std::lock_guard<std::mutex> lock(_mutex);
+      _error = std::current_exception();
+      _done = true;
+      _dropped += _queue.size();
+      _queue.clear();
+      _queued_bytes = 0u;
+    }
+  }
+
+} // namespace client
+} // namespace carla
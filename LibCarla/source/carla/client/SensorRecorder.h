@@ -0,0 +1,146 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace carla {
+namespace client {
+
+  class ServerSideSensor;
+
+  /// Records the data of a sensor to disk, without deserializing it.
+  ///
+  /// The messages are written exactly as received from the stream into a
+  /// recording folder (see detail::recording) by a dedicated I/O thread,
+  /// so capture runs at the rate of the network, independently of the user
+  /// code. Recordings can be read back with SensorRecording.
+  ///
+  /// If the I/O thread cannot keep up and more than max_queue_size bytes are
+  /// waiting to be written, new messages are dropped.
+  class SensorRecorder
+    : public EnableSharedFromThis<SensorRecorder>,
+      private NonCopyable {
+  public:
+
+    /// When to ask the OS to commit the written data to the storage device.
+    enum class SyncPolicy {
+      Never,
+      EverySegment,
+      EveryMessage
+    };
+
+    struct Options {
+      /// Maximum size in bytes of a segment file, a message never spans two
+      /// segments.
+      size_t segment_size = 1024u * 1024u * 1024u;
+
+      /// Maximum number of bytes waiting to be written.
+      size_t max_queue_size = 256u * 1024u * 1024u;
+
+      /// Open the segment files with direct I/O (bypass the OS page cache),
+      /// falls back to buffered I/O where not supported.
+      bool direct_io = false;
+
+      SyncPolicy sync_policy = SyncPolicy::EverySegment;
+
+      /// Make the messages written visible to readers once this many bytes
+      /// are pending, or once flush_interval has passed since the last flush.
+      /// Each flush rewrites the partial tail block when using direct I/O, so
+      /// flushing too often defeats the batching.
+      size_t flush_size = 8u * 1024u * 1024u;
+
+      time_duration flush_interval = time_duration::seconds(1u);
+    };
+
+    /// Create a new recording at @a folder, any previous recording in the
+    /// folder is overwritten.
+    SensorRecorder(std::string folder, Options options);
+
+    explicit SensorRecorder(std::string folder);
+
+    ~SensorRecorder();
+
+    const std::string &GetFolder() const {
+      return _folder;
+    }
+
+    /// Start recording the data of @a sensor.
+    ///
+    /// @warning This steals the data stream of the sensor, any callback
+    /// previously registered with Sensor::Listen is replaced.
+    void Listen(SharedPtr<ServerSideSensor> sensor);
+
+    /// Stop listening to the sensor, the messages already received are still
+    /// written.
+    void Stop();
+
+    bool IsListening() const {
+      return _sensor != nullptr;
+    }
+
+    /// Queue @a buffer to be written, @a buffer must contain a serialized
+    /// sensor message.
+    void Record(Buffer buffer);
+
+    /// Stop listening, write every message queued and close the recording.
+    /// Rethrows the error, if any, that stopped the I/O thread.
+    void Close();
+
+    size_t GetNumberOfRecordedMessages() const {
+      return _recorded;
+    }
+
+    size_t GetNumberOfDroppedMessages() const {
+      return _dropped;
+    }
+
+  private:
+
+    class Writer;
+
+    void Run(std::unique_ptr<Writer> writer);
+
+    const std::string _folder;
+
+    const Options _options;
+
+    SharedPtr<ServerSideSensor> _sensor;
+
+    std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    std::deque<Buffer> _queue;
+
+    size_t _queued_bytes = 0u;
+
+    bool _done = false;
+
+    std::exception_ptr _error;
+
+    std::atomic_size_t _recorded{0u};
+
+    std::atomic_size_t _dropped{0u};
+
+    std::thread _thread;
+  };
+
+} // namespace client
+} // namespace carla
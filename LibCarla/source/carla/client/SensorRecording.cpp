@@ -0,0 +1,91 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/SensorRecording.h"
+
+#include "carla/Exception.h"
+#include "carla/sensor/Deserializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace carla {
+namespace client {
+
+  SensorRecording::SensorRecording(std::string folder)
+    : _folder(std::move(folder)) {
+    namespace rec = detail::recording;
+    const auto filename = rec::GetIndexFileName(_folder);
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+      throw_exception(std::invalid_argument("cannot open sensor recording " + filename));
+    }
+    const auto file_size = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    rec::IndexHeader header;
+    if ((file_size < sizeof(header)) ||
+        !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        (std::memcmp(header.magic, rec::magic, sizeof(rec::magic)) != 0)) {
+      throw_exception(std::invalid_argument(filename + " is not a sensor recording"));
+    }
+    if (header.version != rec::version) {
+      throw_exception(std::invalid_argument(filename + ": unsupported recording version"));
+    }
+    // Ignore a trailing partial entry, the recorder may have been interrupted.
+    _index.resize((file_size - sizeof(header)) / sizeof(rec::IndexEntry));
+    file.read(
+        reinterpret_cast<char *>(_index.data()),
+        static_cast<std::streamsize>(sizeof(rec::IndexEntry) * _index.size()));
+    // Frames arrive mostly in order, but this is not guaranteed.
+    _positions_by_frame.resize(_index.size());
+    std::iota(_positions_by_frame.begin(), _positions_by_frame.end(), 0u);
+    std::stable_sort(_positions_by_frame.begin(), _positions_by_frame.end(), [this](size_t lhs, size_t rhs) {
+      return _index[lhs].frame_number < _index[rhs].frame_number;
+    });
+  }
+
+  boost::optional<size_t> SensorRecording::Find(const uint64_t frame_number) const {
+    auto it = std::lower_bound(
+        _positions_by_frame.begin(),
+        _positions_by_frame.end(),
+        frame_number,
+        [this](size_t pos, uint64_t frame) { return _index[pos].frame_number < frame; });
+    if ((it == _positions_by_frame.end()) || (_index[*it].frame_number != frame_number)) {
+      return boost::none;
+    }
+    return *it;
+  }
+
+  Buffer SensorRecording::Read(const size_t pos) {
+    const auto &entry = _index.at(pos);
+    Buffer buffer(entry.size);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_segment.is_open() || (_open_segment != entry.segment)) {
+      _segment.close();
+      _segment.clear();
+      _segment.open(
+          detail::recording::GetSegmentFileName(_folder, entry.segment),
+          std::ios::binary);
+      _open_segment = entry.segment;
+    }
+    _segment.seekg(static_cast<std::streamoff>(entry.offset));
+    _segment.read(reinterpret_cast<char *>(buffer.data()), entry.size);
+    if (!_segment) {
+      _segment.close();
+      throw_exception(std::runtime_error(
+          "failed to read message " + std::to_string(pos) + " of sensor recording " + _folder));
+    }
+    return buffer;
+  }
+
+  SharedPtr<sensor::SensorData> SensorRecording::ReadData(const size_t pos) {
+    return sensor::Deserializer::Deserialize(Read(pos));
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,79 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/client/detail/SensorRecordingFormat.h"
+
+#include <boost/optional.hpp>
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  /// Reads a recording written by SensorRecorder.
+  class SensorRecording : private NonCopyable {
+  public:
+
+    /// Open the recording at @a folder, only the index is loaded into memory.
+    explicit SensorRecording(std::string folder);
+
+    const std::string &GetFolder() const {
+      return _folder;
+    }
+
+    /// Number of messages in the recording.
+    size_t size() const {
+      return _index.size();
+    }
+
+    bool empty() const {
+      return _index.empty();
+    }
+
+    uint64_t GetFrameNumber(size_t pos) const {
+      return _index.at(pos).frame_number;
+    }
+
+    /// Position of the first message of @a frame_number, if any.
+    boost::optional<size_t> Find(uint64_t frame_number) const;
+
+    /// Read the message at @a pos as it was received from the stream.
+    Buffer Read(size_t pos);
+
+    /// Read and deserialize the message at @a pos.
+    ///
+    /// @note The data is not attached to any episode, so the data that
+    /// references other actors (e.g. collision events) cannot retrieve them.
+    SharedPtr<sensor::SensorData> ReadData(size_t pos);
+
+  private:
+
+    const std::string _folder;
+
+    std::vector<detail::recording::IndexEntry> _index;
+
+    /// Positions in _index sorted by frame number, in recording order within
+    /// the same frame.
+    std::vector<size_t> _positions_by_frame;
+
+    std::mutex _mutex;
+
+    std::ifstream _segment;
+
+    uint32_t _open_segment = 0u;
+  };
+
+} // namespace client
+} // namespace carla
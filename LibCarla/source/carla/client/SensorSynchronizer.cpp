@@ -0,0 +1,143 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/SensorSynchronizer.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/client/Sensor.h"
+#include "carla/client/detail/Simulator.h"
+#include "carla/sensor/SensorData.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace carla {
+namespace client {
+
+  SensorSynchronizer::SensorSynchronizer(
+      World world,
+      std::vector<SharedPtr<Sensor>> sensors,
+      const size_t window,
+      const time_duration timeout,
+      const IncompleteFramePolicy policy)
+    : _world(std::move(world)),
+      _sensors(std::move(sensors)),
+      _assembler(_sensors.size(), window, timeout, policy) {
+    if (window == 0u) {
+      throw_exception(std::invalid_argument("SensorSynchronizer: window cannot be zero"));
+    }
+    for (auto &sensor : _sensors) {
+      if (sensor == nullptr) {
+        throw_exception(std::invalid_argument("SensorSynchronizer: invalid sensor"));
+      }
+    }
+  }
+
+  SensorSynchronizer::~SensorSynchronizer() {
+    if (IsListening()) {
+      try {
+        Stop();
+      } catch (const std::exception &e) {
+        log_error("exception trying to stop sensor synchronizer:", e.what());
+      }
+    }
+  }
+
+  void SensorSynchronizer::Listen(CallbackFunctionType callback) {
+    if (_is_listening) {
+      log_error("sensor synchronizer: already listening");
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_delivery_mutex);
+      _callback = std::move(callback);
+    }
+    _is_listening = true;
+
+    WeakPtr<SensorSynchronizer> weak_self = shared_from_this();
+
+    _tick_callback_id = _world.OnTick([weak_self](const auto &timestamp) {
+      auto self = weak_self.lock();
+      if (self != nullptr) {
+        self->OnTick(timestamp);
+      }
+    });
+
+    for (auto i = 0u; i < _sensors.size(); ++i) {
+      _sensors[i]->Listen([weak_self, i](auto data) {
+        auto self = weak_self.lock();
+        if (self != nullptr) {
+          self->OnSensorData(i, std::move(data));
+        }
+      });
+    }
+  }
+
+  void SensorSynchronizer::Stop() {
+    _is_listening = false;
+    if (_tick_callback_id != 0u) {
+      const auto id = _tick_callback_id;
+      _tick_callback_id = 0u;
+      _world.RemoveOnTick(id);
+    }
+    for (auto &sensor : _sensors) {
+      if (sensor->IsListening()) {
+        sensor->Stop();
+      }
+    }
+    _assembler.Clear();
+  }
+
+  void SensorSynchronizer::OnSensorData(
+      const size_t index,
+      SharedPtr<sensor::SensorData> data) {
+    if (!_is_listening || (data == nullptr)) {
+      return;
+    }
+    _assembler.AddData(index, std::move(data));
+    Deliver();
+  }
+
+  void SensorSynchronizer::OnTick(const Timestamp &timestamp) {
+    if (!_is_listening) {
+      return;
+    }
+    // The episode may have moved to a more recent frame by now, in which case
+    // the state of this frame is not available anymore.
+    std::shared_ptr<const detail::EpisodeState> state;
+    auto episode = _world._episode.TryLock();
+    if (episode != nullptr) {
+      state = episode->GetCurrentEpisodeState();
+      if ((state != nullptr) && (state->GetFrameCount() != timestamp.frame_count)) {
+        state = nullptr;
+      }
+    }
+    _assembler.AddTick(timestamp, std::move(state));
+    Deliver();
+  }
+
+  void SensorSynchronizer::Deliver() {
+    for (;;) {
+      std::unique_lock<std::mutex> delivery_lock(_delivery_mutex, std::try_to_lock);
+      if (!delivery_lock.owns_lock()) {
+        // The thread delivering will pick up our bundles.
+        return;
+      }
+      for (auto bundle = _assembler.PopReady(); bundle != nullptr; bundle = _assembler.PopReady()) {
+        _callback(std::move(bundle));
+      }
+      delivery_lock.unlock();
+      // Bundles may have been made ready after the last one was popped but
+      // before releasing the delivery lock.
+      if (!_assembler.HasReady()) {
+        return;
+      }
+    }
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,116 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/client/SensorBundle.h"
+#include "carla/client/World.h"
+#include "carla/client/detail/SensorFrameAssembler.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  class Sensor;
+
+  /// Listens to a set of sensors plus the world tick, and assembles the
+  /// measurements generated in the same frame into a single SensorBundle.
+  /// Each bundle is delivered with a single call to the user callback, in
+  /// increasing frame order.
+  ///
+  /// At most @a window frames are kept waiting for their missing pieces, when
+  /// the window is full, or a frame has been waiting longer than @a timeout,
+  /// the oldest frame is evicted and either dropped or delivered incomplete
+  /// depending on the IncompleteFramePolicy. A frame is also evicted as soon
+  /// as a more recent frame is completed, as the data streams are ordered and
+  /// its missing pieces can never arrive.
+  ///
+  /// @note Only sensors producing data every frame should be synchronized,
+  /// event-based sensors (e.g. collision detectors) would leave most of the
+  /// frames incomplete.
+  class SensorSynchronizer
+    : public EnableSharedFromThis<SensorSynchronizer>,
+      private NonCopyable {
+  public:
+
+    using CallbackFunctionType = std::function<void(SharedPtr<SensorBundle>)>;
+
+    /// What to do with frames evicted before being completed.
+    using IncompleteFramePolicy = detail::SensorFrameAssembler::IncompleteFramePolicy;
+
+    SensorSynchronizer(
+        World world,
+        std::vector<SharedPtr<Sensor>> sensors,
+        size_t window = 8u,
+        time_duration timeout = time_duration::seconds(2u),
+        IncompleteFramePolicy policy = IncompleteFramePolicy::Drop);
+
+    ~SensorSynchronizer();
+
+    /// Start listening to the sensors and the world tick, @a callback is
+    /// called with every bundle assembled.
+    ///
+    /// @warning This steals the data stream of the sensors, any callback
+    /// previously registered with Sensor::Listen is replaced.
+    /// @note The callback is executed in the streaming threads, but never
+    /// concurrently with itself.
+    void Listen(CallbackFunctionType callback);
+
+    /// Stop listening to the sensors and discard any frame waiting to be
+    /// completed.
+    void Stop();
+
+    bool IsListening() const {
+      return _is_listening;
+    }
+
+    const std::vector<SharedPtr<Sensor>> &GetSensors() const {
+      return _sensors;
+    }
+
+    /// Number of incomplete frames dropped since the synchronizer was
+    /// created, always zero if the policy is Deliver.
+    size_t GetNumberOfDroppedFrames() const {
+      return _assembler.GetNumberOfDroppedFrames();
+    }
+
+  private:
+
+    void OnSensorData(size_t index, SharedPtr<sensor::SensorData> data);
+
+    void OnTick(const Timestamp &timestamp);
+
+    /// Call the user callback with the bundles ready, unless another thread
+    /// is already doing it.
+    void Deliver();
+
+    World _world;
+
+    const std::vector<SharedPtr<Sensor>> _sensors;
+
+    std::atomic_bool _is_listening{false};
+
+    /// ID of the tick callback registered in the world, 0 if none.
+    size_t _tick_callback_id = 0u;
+
+    detail::SensorFrameAssembler _assembler;
+
+    /// Held by the only thread allowed to call the user callback, this keeps
+    /// the bundles in order. Also guards _callback.
+    std::mutex _delivery_mutex;
+
+    CallbackFunctionType _callback;
+  };
+
+} // namespace client
+} // namespace carla
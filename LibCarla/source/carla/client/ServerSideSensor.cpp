@@ -11,8 +11,6 @@
 
 #include <exception>
 
-#include <exception>
-
 namespace carla {
 namespace client {
 
@@ -38,6 +36,12 @@ namespace client {
     _is_listening = true;
   }
 
+  void ServerSideSensor::ListenToSerializedData(std::function<void(Buffer)> callback) {
+    log_debug(GetDisplayId(), ": subscribing to stream (serialized data)");
+    GetEpisode().Lock()->SubscribeToSensorStream(*this, std::move(callback));
+    _is_listening = true;
+  }
+
   void ServerSideSensor::Stop() {
     if (!_is_listening) {
       log_warning(
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
 #include "carla/client/Sensor.h"
 
+#include <functional>
+
 namespace carla {
 namespace client {
 
@@ -27,6 +30,10 @@ namespace client {
     /// the same sensor in the simulator.
     void Listen(CallbackFunctionType callback) override;
 
+    /// Same as Listen, but @a callback receives the messages as received from
+    /// the stream, without deserializing them.
+    void ListenToSerializedData(std::function<void(Buffer)> callback);
+
     /// Stop listening for new measurements.
     void Stop() override;
 
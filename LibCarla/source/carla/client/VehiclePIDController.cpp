@@ -0,0 +1,158 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/VehiclePIDController.h"
+
+#include "carla/Debug.h"
+#include "carla/client/Client.h"
+#include "carla/client/World.h"
+#include "carla/geom/Math.h"
+#include "carla/sensor/data/RawEpisodeState.h"
+
+#include <cmath>
+
+namespace carla {
+namespace client {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Signed angle in radians between the heading of the vehicle and the
+  /// direction to @a target, positive if the target is to the right.
+  static double GetLateralError(const geom::Transform &transform, const geom::Location &target) {
+    const double yaw = geom::Math::to_radians(transform.rotation.yaw);
+    const double vx = std::cos(yaw);
+    const double vy = std::sin(yaw);
+    const double wx = target.x - transform.location.x;
+    const double wy = target.y - transform.location.y;
+    const double norm = std::sqrt(wx * wx + wy * wy);
+    if (norm == 0.0) {
+      return 0.0;
+    }
+    const double angle = std::acos(geom::Math::clamp((vx * wx + vy * wy) / norm, -1.0, 1.0));
+    return (vx * wy - vy * wx) < 0.0 ? -angle : angle;
+  }
+
+  /// Speed in km/h.
+  static double GetSpeed(const geom::Vector3D &velocity) {
+    return 3.6 * velocity.Length();
+  }
+
+  // ===========================================================================
+  // -- VehiclePIDController ---------------------------------------------------
+  // ===========================================================================
+
+  VehiclePIDController::VehiclePIDController()
+    : VehiclePIDController(Gains{}, Gains{}) {}
+
+  VehiclePIDController::VehiclePIDController(
+      const Gains lateral,
+      const Gains longitudinal,
+      const double delta_seconds)
+    : _lateral(lateral),
+      _longitudinal(longitudinal),
+      _delta_seconds(delta_seconds) {}
+
+  template <size_t N>
+  double VehiclePIDController::RunStep(
+      const Gains &gains,
+      ErrorBuffer<N> &buffer,
+      const double error) const {
+    buffer.Push(error);
+    double de = 0.0;
+    double ie = 0.0;
+    if (buffer.size() >= 2u) {
+      de = (buffer.back(0u) - buffer.back(1u)) / _delta_seconds;
+      ie = buffer.sum() * _delta_seconds;
+    }
+    return gains.k_p * error + gains.k_d * de / _delta_seconds + gains.k_i * ie * _delta_seconds;
+  }
+
+  std::vector<rpc::VehicleControl> VehiclePIDController::Compute(
+      const std::vector<Target> &targets,
+      const std::vector<VehicleState> &states) {
+    DEBUG_ASSERT(targets.size() == states.size());
+    std::vector<rpc::VehicleControl> result(targets.size());
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto i = 0u; i < targets.size(); ++i) {
+      auto &pid = _vehicles[targets[i].vehicle];
+      const double throttle = RunStep(
+          _longitudinal,
+          pid.longitudinal,
+          targets[i].speed - GetSpeed(states[i].velocity));
+      const double steer = RunStep(
+          _lateral,
+          pid.lateral,
+          GetLateralError(states[i].transform, targets[i].location));
+      result[i].throttle = static_cast<float>(geom::Math::clamp(throttle, 0.0, 1.0));
+      result[i].steer = static_cast<float>(geom::Math::clamp(steer, -1.0, 1.0));
+      result[i].brake = 0.0f;
+      result[i].hand_brake = false;
+      result[i].manual_gear_shift = false;
+    }
+    return result;
+  }
+
+  std::vector<rpc::Command> VehiclePIDController::ComputeCommands(
+      const World &world,
+      const std::vector<Target> &targets) {
+    std::unordered_map<ActorId, size_t> indices;
+    indices.reserve(targets.size());
+    for (auto i = 0u; i < targets.size(); ++i) {
+      indices.emplace(targets[i].vehicle, i);
+    }
+    // Single pass over the episode state to find every vehicle.
+    std::vector<bool> found(targets.size(), false);
+    std::vector<VehicleState> states(targets.size());
+    for (auto &&actor : *world.GetRawEpisodeState()) {
+      auto it = indices.find(actor.id);
+      if (it != indices.end()) {
+        found[it->second] = true;
+        states[it->second] = VehicleState{actor.transform, actor.velocity};
+      }
+    }
+    std::vector<Target> present_targets;
+    std::vector<VehicleState> present_states;
+    present_targets.reserve(targets.size());
+    present_states.reserve(targets.size());
+    for (auto i = 0u; i < targets.size(); ++i) {
+      if (found[i]) {
+        present_targets.emplace_back(targets[i]);
+        present_states.emplace_back(states[i]);
+      }
+    }
+    const auto controls = Compute(present_targets, present_states);
+    std::vector<rpc::Command> commands;
+    commands.reserve(controls.size());
+    for (auto i = 0u; i < controls.size(); ++i) {
+      commands.emplace_back(rpc::Command::ApplyVehicleControl{present_targets[i].vehicle, controls[i]});
+    }
+    return commands;
+  }
+
+  void VehiclePIDController::Step(
+      const Client &client,
+      const World &world,
+      const std::vector<Target> &targets) {
+    auto commands = ComputeCommands(world, targets);
+    if (!commands.empty()) {
+      client.ApplyBatch(std::move(commands));
+    }
+  }
+
+  void VehiclePIDController::Remove(const ActorId vehicle) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _vehicles.erase(vehicle);
+  }
+
+  void VehiclePIDController::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _vehicles.clear();
+  }
+
+} // namespace client
+} // namespace carla
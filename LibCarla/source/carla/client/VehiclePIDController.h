@@ -0,0 +1,147 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/geom/Transform.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/Command.h"
+#include "carla/rpc/VehicleControl.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  class Client;
+  class World;
+
+  /// Lateral and longitudinal PID control of many vehicles at once, the same
+  /// as the VehiclePIDController of the Python agents.
+  ///
+  /// The controller keeps the error history of every vehicle it steered,
+  /// vehicles are identified by their actor id. Controls are computed from
+  /// the episode state received with the world tick and sent in a single
+  /// batch, so no request per vehicle is needed.
+  class VehiclePIDController : private NonCopyable {
+  public:
+
+    struct Gains {
+      double k_p = 1.0;
+      double k_d = 0.0;
+      double k_i = 0.0;
+    };
+
+    struct Target {
+      ActorId vehicle;
+      /// Location the vehicle should steer to.
+      geom::Location location;
+      /// Desired speed in km/h.
+      double speed;
+    };
+
+    struct VehicleState {
+      geom::Transform transform;
+      geom::Vector3D velocity;
+    };
+
+    VehiclePIDController();
+
+    VehiclePIDController(Gains lateral, Gains longitudinal, double delta_seconds = 0.03);
+
+    /// Compute the control of each target, @a states[i] being the current
+    /// state of @a targets[i].vehicle. Updates the error history of the
+    /// vehicles.
+    std::vector<rpc::VehicleControl> Compute(
+        const std::vector<Target> &targets,
+        const std::vector<VehicleState> &states);
+
+    /// Compute the controls of @a targets from the last episode state
+    /// received by @a world. Targets whose vehicle is not in the episode are
+    /// skipped.
+    std::vector<rpc::Command> ComputeCommands(const World &world, const std::vector<Target> &targets);
+
+    /// Compute the controls of @a targets and apply them with a single batch.
+    void Step(const Client &client, const World &world, const std::vector<Target> &targets);
+
+    /// Forget the error history of @a vehicle.
+    void Remove(ActorId vehicle);
+
+    /// Forget the error history of every vehicle.
+    void Clear();
+
+    size_t GetNumberOfVehicles() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _vehicles.size();
+    }
+
+  private:
+
+    /// The last N errors of a controller, oldest first once full.
+    template <size_t N>
+    class ErrorBuffer {
+    public:
+
+      void Push(double error) {
+        _errors[_next] = error;
+        _next = (_next + 1u) % N;
+        _size = std::min(_size + 1u, N);
+      }
+
+      size_t size() const {
+        return _size;
+      }
+
+      double sum() const {
+        double result = 0.0;
+        for (auto i = 0u; i < _size; ++i) {
+          result += back(i);
+        }
+        return result;
+      }
+
+      /// Error pushed @a i calls ago, 0 being the last one.
+      double back(size_t i = 0u) const {
+        return _errors[(_next + N - 1u - i) % N];
+      }
+
+    private:
+
+      std::array<double, N> _errors{};
+
+      size_t _next = 0u;
+
+      size_t _size = 0u;
+    };
+
+    struct PIDState {
+      ErrorBuffer<10u> lateral;
+      ErrorBuffer<30u> longitudinal;
+    };
+
+    template <size_t N>
+    double RunStep(const Gains &gains, ErrorBuffer<N> &buffer, double error) const;
+
+    const Gains _lateral;
+
+    const Gains _longitudinal;
+
+    const double _delta_seconds;
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<ActorId, PIDState> _vehicles;
+  };
+
+} // namespace client
+} // namespace carla
@@ -51,7 +51,7 @@ namespace client {
       return _waypoint.GetLaneId();
     }
 
-    std::string GetType() const {
+    road::element::LaneType GetType() const {
       return _waypoint.GetType();
     }
 
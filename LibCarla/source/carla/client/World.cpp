@@ -6,6 +6,7 @@
 
 #include "carla/client/World.h"
 
+#include "carla/Exception.h"
 #include "carla/Logging.h"
 #include "carla/client/Actor.h"
 #include "carla/client/ActorBlueprint.h"
@@ -13,6 +14,7 @@
 #include "carla/client/detail/Simulator.h"
 
 #include <exception>
+#include <stdexcept>
 
 namespace carla {
 namespace client {
@@ -69,14 +71,63 @@ namespace client {
     }
   }
 
+  SharedPtr<const sensor::data::RawEpisodeState> World::GetRawEpisodeState() const {
+    return _episode.Lock()->GetCurrentEpisodeState()->GetRawState();
+  }
+
+  std::vector<sensor::data::ActorDynamicState> World::GetActorStates(
+      const std::vector<ActorId> &ids) const {
+    return _episode.Lock()->GetCurrentEpisodeState()->GetActorStates(ids);
+  }
+
+  std::vector<sensor::data::ActorDynamicState> World::GetActorStates(
+      const std::vector<ActorId> &ids,
+      const uint64_t frame_count) const {
+    const auto state = _episode.Lock()->GetEpisodeStateHistory().GetState(frame_count);
+    if (state == nullptr) {
+      throw_exception(std::out_of_range(
+          "frame " + std::to_string(frame_count) + " not in the state history"));
+    }
+    return state->GetActorStates(ids);
+  }
+
+  size_t World::GetStateHistorySize() const {
+    return _episode.Lock()->GetEpisodeStateHistory().GetCapacity();
+  }
+
+  void World::SetStateHistorySize(const size_t frames) {
+    _episode.Lock()->GetEpisodeStateHistory().SetCapacity(frames);
+  }
+
+  boost::optional<geom::Transform> World::GetInterpolatedTransform(
+      const ActorId id,
+      const double elapsed_seconds) const {
+    return _episode.Lock()->GetEpisodeStateHistory().GetInterpolatedTransform(id, elapsed_seconds);
+  }
+
+  std::vector<ActorHistorySample> World::GetActorHistory(
+      const ActorId id,
+      const double from_seconds,
+      const double to_seconds) const {
+    return _episode.Lock()->GetEpisodeStateHistory().GetActorHistory(id, from_seconds, to_seconds);
+  }
+
+  std::vector<ClientSideSensorStats> World::GetClientSideSensorStats() const {
+    return _episode.Lock()->GetClientSideSensorStats();
+  }
+
   Timestamp World::WaitForTick(time_duration timeout) const {
     return _episode.Lock()->WaitForTick(timeout);
   }
 
-  void World::OnTick(std::function<void(Timestamp)> callback) {
+  size_t World::OnTick(std::function<void(Timestamp)> callback) {
     return _episode.Lock()->RegisterOnTickEvent(std::move(callback));
   }
 
+  void World::RemoveOnTick(const size_t callback_id) {
+    _episode.Lock()->RemoveOnTickEvent(callback_id);
+  }
+
   void World::Tick() {
     _episode.Lock()->Tick();
   }
@@ -8,6 +8,8 @@
 
 #include "carla/Memory.h"
 #include "carla/Time.h"
+#include "carla/client/ActorHistorySample.h"
+#include "carla/client/ClientSideSensorStats.h"
 #include "carla/client/DebugHelper.h"
 #include "carla/client/Timestamp.h"
 #include "carla/client/detail/EpisodeProxy.h"
@@ -16,15 +18,21 @@
 #include "carla/rpc/EpisodeSettings.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
 #include "carla/rpc/WeatherParameters.h"
+#include "carla/sensor/data/ActorDynamicState.h"
+
+#include <boost/optional.hpp>
 
 namespace carla {
+namespace sensor { namespace data { class RawEpisodeState; } }
 namespace client {
 
   class Actor;
   class ActorBlueprint;
   class ActorList;
   class BlueprintLibrary;
+  class HazardDetector;
   class Map;
+  class SensorSynchronizer;
 
   class World {
   public:
@@ -81,11 +89,59 @@ namespace client {
         const geom::Transform &transform,
         Actor *parent = nullptr) noexcept;
 
+    /// Return the dynamic state of every actor as received with the last
+    /// world tick, laid out in a contiguous array.
+    SharedPtr<const sensor::data::RawEpisodeState> GetRawEpisodeState() const;
+
+    /// Return the dynamic state of each actor in @a ids, in the same order,
+    /// all of them from the last world tick. Actors not found get a state
+    /// with id 0 and zeroed values.
+    std::vector<sensor::data::ActorDynamicState> GetActorStates(
+        const std::vector<ActorId> &ids) const;
+
+    /// Same as GetActorStates, but from the world tick at @a frame_count.
+    /// Throws std::out_of_range if that frame is not in the state history.
+    std::vector<sensor::data::ActorDynamicState> GetActorStates(
+        const std::vector<ActorId> &ids,
+        uint64_t frame_count) const;
+
+    /// Number of frames of world ticks kept in the state history.
+    size_t GetStateHistorySize() const;
+
+    /// Keep the episode states received in the last @a frames frames on the
+    /// client, 0 (the default) disables the history. The history is cleared
+    /// when the episode changes.
+    void SetStateHistorySize(size_t frames);
+
+    /// Transform of actor @a id at @a elapsed_seconds of simulated time,
+    /// interpolated between the world ticks in the state history around that
+    /// time. Return none if the time is not covered by the history.
+    boost::optional<geom::Transform> GetInterpolatedTransform(
+        ActorId id,
+        double elapsed_seconds) const;
+
+    /// Dynamic state of actor @a id in each world tick of the state history
+    /// between @a from_seconds and @a to_seconds of simulated time, from the
+    /// oldest to the newest.
+    std::vector<ActorHistorySample> GetActorHistory(
+        ActorId id,
+        double from_seconds,
+        double to_seconds) const;
+
+    /// Return the time spent by each client-side sensor listening, including
+    /// its callback.
+    std::vector<ClientSideSensorStats> GetClientSideSensorStats() const;
+
     /// Block calling thread until a world tick is received.
     Timestamp WaitForTick(time_duration timeout) const;
 
     /// Register a @a callback to be called every time a world tick is received.
-    void OnTick(std::function<void(Timestamp)> callback);
+    ///
+    /// @return ID of the callback, use it to remove the callback.
+    size_t OnTick(std::function<void(Timestamp)> callback);
+
+    /// Remove a callback registered with OnTick.
+    void RemoveOnTick(size_t callback_id);
 
     /// Signal the simulator to continue to next tick (only has effect on
     /// synchronous mode).
@@ -97,6 +153,9 @@ namespace client {
 
   private:
 
+    friend class HazardDetector;
+    friend class SensorSynchronizer;
+
     detail::EpisodeProxy _episode;
   };
 
@@ -0,0 +1,89 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/ActorListIndex.h"
+
+#include "carla/StringUtil.h"
+
+#include <algorithm>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Part of @a wildcard_pattern before the first special character, every
+  /// type id matching the pattern starts with it.
+  static std::string GetLiteralPrefix(const std::string &wildcard_pattern) {
+    return wildcard_pattern.substr(0u, wildcard_pattern.find_first_of("*?[\\"));
+  }
+
+  static bool HasPrefix(const std::string &str, const std::string &prefix) {
+    return str.compare(0u, prefix.size(), prefix) == 0;
+  }
+
+  // ===========================================================================
+  // -- ActorListIndex ---------------------------------------------------------
+  // ===========================================================================
+
+  ActorListIndex::ActorListIndex(std::vector<ActorVariant> &actors) {
+    auto less = [](const ActorVariant &lhs, const ActorVariant &rhs) {
+      const int compare = lhs.GetTypeId().compare(rhs.GetTypeId());
+      return (compare < 0) || ((compare == 0) && (lhs.GetId() < rhs.GetId()));
+    };
+    // The episode already provides the actors sorted.
+    if (!std::is_sorted(actors.begin(), actors.end(), less)) {
+      std::sort(actors.begin(), actors.end(), less);
+    }
+    _ids.reserve(actors.size());
+    for (auto i = 0u; i < actors.size(); ++i) {
+      const auto &type_id = actors[i].GetTypeId();
+      if (_types.empty() || (_types.back().type_id != type_id)) {
+        _types.push_back({type_id, i, i});
+      }
+      ++_types.back().end;
+      _ids.emplace_back(actors[i].GetId(), i);
+    }
+    std::sort(_ids.begin(), _ids.end());
+  }
+
+  boost::optional<size_t> ActorListIndex::Find(const ActorId actor_id) const {
+    auto it = std::lower_bound(
+        _ids.begin(),
+        _ids.end(),
+        actor_id,
+        [](const std::pair<ActorId, size_t> &item, ActorId id) { return item.first < id; });
+    if ((it != _ids.end()) && (it->first == actor_id)) {
+      return it->second;
+    }
+    return boost::none;
+  }
+
+  std::vector<ActorListIndex::Range> ActorListIndex::Filter(const std::string &wildcard_pattern) const {
+    const auto prefix = GetLiteralPrefix(wildcard_pattern);
+    // Patterns like "vehicle.*" match every type id with the prefix.
+    const bool match_prefix = (wildcard_pattern.size() == prefix.size() + 1u) && (wildcard_pattern.back() == '*');
+    std::vector<Range> result;
+    for (auto type = std::lower_bound(
+             _types.begin(),
+             _types.end(),
+             prefix,
+             [](const TypeRange &range, const std::string &str) { return range.type_id < str; });
+         (type != _types.end()) && HasPrefix(type->type_id, prefix);
+         ++type) {
+      if (match_prefix || StringUtil::Match(type->type_id, wildcard_pattern)) {
+        result.emplace_back(type->begin, type->end);
+      }
+    }
+    return result;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
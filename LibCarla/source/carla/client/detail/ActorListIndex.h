@@ -0,0 +1,60 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/client/detail/ActorVariant.h"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Index of the actors of an ActorList by id and by type id. The actors
+  /// are sorted by type id so filtering by type only looks up the matching
+  /// type ids.
+  class ActorListIndex {
+  public:
+
+    /// Positions [begin, end) of a list of actors.
+    using Range = std::pair<size_t, size_t>;
+
+    ActorListIndex() = default;
+
+    /// Sort @a actors by type id and id, and index them.
+    explicit ActorListIndex(std::vector<ActorVariant> &actors);
+
+    /// Position of the actor @a actor_id, if any.
+    boost::optional<size_t> Find(ActorId actor_id) const;
+
+    /// Ranges of the actors with type id matching @a wildcard_pattern, in
+    /// type id order.
+    std::vector<Range> Filter(const std::string &wildcard_pattern) const;
+
+  private:
+
+    /// Actors with the same type id.
+    struct TypeRange {
+      std::string type_id;
+      size_t begin;
+      size_t end;
+    };
+
+    /// Sorted by type id.
+    std::vector<TypeRange> _types;
+
+    /// Position of each id, sorted by id.
+    std::vector<std::pair<ActorId, size_t>> _ids;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
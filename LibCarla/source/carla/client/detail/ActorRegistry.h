@@ -0,0 +1,172 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/rpc/Actor.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- ActorRegistry ----------------------------------------------------------
+  // ===========================================================================
+
+  /// Keeps the descriptions of the actors of the episode to avoid requesting
+  /// them each time to the server, indexed by id and by type id.
+  ///
+  /// The registry follows the set of actors of the episode state: actors
+  /// that were alive and are missing from a later state are evicted. Actors
+  /// inserted before appearing in any state (e.g. just spawned) are kept
+  /// until they do.
+  class ActorRegistry : private MovableNonCopyable {
+  public:
+
+    /// Inserts an actor not yet present in the episode state.
+    void Insert(rpc::Actor actor);
+
+    /// Inserts the actors of the last update missing from the registry.
+    void InsertRange(std::vector<rpc::Actor> actors);
+
+    /// Sets the actors alive to the ids in @a range, evicting the actors
+    /// destroyed. Returns the ids in @a range missing from the registry.
+    template <typename RangeT>
+    std::vector<ActorId> Update(const RangeT &range);
+
+    /// Retrieve the actors alive in the last update, sorted by type id and
+    /// then by id so the actors of each type id, or type id prefix, are
+    /// contiguous.
+    std::vector<rpc::Actor> GetActors() const;
+
+    size_t size() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _actors.size();
+    }
+
+    void Clear();
+
+  private:
+
+    struct Entry {
+      rpc::Actor actor;
+      /// Present in the last update.
+      bool alive;
+      /// Present in any update.
+      bool seen;
+    };
+
+    /// @pre _mutex is locked.
+    void InsertEntry(rpc::Actor actor, bool alive);
+
+    /// @pre _mutex is locked.
+    void Evict(ActorId id, const std::string &type_id);
+
+    mutable std::mutex _mutex;
+
+    /// Actors by type id and id, ordered so that iterating the index lists
+    /// the actors of a type prefix together.
+    std::map<std::string, std::map<ActorId, Entry>> _types;
+
+    /// Actors by id, pointing into _types.
+    std::unordered_map<ActorId, Entry *> _actors;
+  };
+
+  // ===========================================================================
+  // -- ActorRegistry implementation -------------------------------------------
+  // ===========================================================================
+
+  inline void ActorRegistry::Insert(rpc::Actor actor) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    InsertEntry(std::move(actor), false);
+  }
+
+  inline void ActorRegistry::InsertRange(std::vector<rpc::Actor> actors) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &&actor : actors) {
+      InsertEntry(std::move(actor), true);
+    }
+  }
+
+  template <typename RangeT>
+  inline std::vector<ActorId> ActorRegistry::Update(const RangeT &range) {
+    const std::unordered_set<ActorId> ids(std::begin(range), std::end(range));
+    std::vector<ActorId> missing;
+    std::vector<std::pair<ActorId, const std::string *>> destroyed;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &&item : _actors) {
+      auto &entry = *item.second;
+      entry.alive = (ids.find(item.first) != ids.end());
+      if (entry.alive) {
+        entry.seen = true;
+      } else if (entry.seen) {
+        destroyed.emplace_back(item.first, &entry.actor.description.id);
+      }
+    }
+    for (auto &&actor : destroyed) {
+      // Copy the type id, the entry holding it is erased.
+      Evict(actor.first, std::string(*actor.second));
+    }
+    for (auto &&id : ids) {
+      if (_actors.find(id) == _actors.end()) {
+        missing.emplace_back(id);
+      }
+    }
+    return missing;
+  }
+
+  inline std::vector<rpc::Actor> ActorRegistry::GetActors() const {
+    std::vector<rpc::Actor> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_actors.size());
+    for (auto &&type : _types) {
+      for (auto &&item : type.second) {
+        if (item.second.alive) {
+          result.emplace_back(item.second.actor);
+        }
+      }
+    }
+    return result;
+  }
+
+  inline void ActorRegistry::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _actors.clear();
+    _types.clear();
+  }
+
+  inline void ActorRegistry::InsertEntry(rpc::Actor actor, const bool alive) {
+    const auto id = actor.id;
+    if (_actors.find(id) != _actors.end()) {
+      return;
+    }
+    auto &type = _types[actor.description.id];
+    auto it = type.emplace(id, Entry{std::move(actor), alive, alive}).first;
+    _actors.emplace(id, &it->second);
+  }
+
+  inline void ActorRegistry::Evict(const ActorId id, const std::string &type_id) {
+    _actors.erase(id);
+    auto type = _types.find(type_id);
+    if (type != _types.end()) {
+      type->second.erase(id);
+      if (type->second.empty()) {
+        _types.erase(type);
+      }
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,252 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/AppendFile.h"
+
+#include "carla/Debug.h"
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <system_error>
+
+#ifdef _WIN32
+#  include <fcntl.h>
+#  include <io.h>
+#  include <malloc.h>
+#  include <sys/stat.h>
+#else
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- Platform specific ------------------------------------------------------
+  // ===========================================================================
+
+  [[noreturn]] static void ThrowSystemError(const std::string &what) {
+    throw_exception(std::system_error(errno, std::generic_category(), what));
+  }
+
+#ifdef _WIN32
+
+  static int OpenFile(const std::string &path, bool) {
+    return _open(
+        path.c_str(),
+        _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+        _S_IREAD | _S_IWRITE);
+  }
+
+  static bool WriteAt(int fd, const unsigned char *data, size_t size, uint64_t offset) {
+    if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) {
+      return false;
+    }
+    while (size > 0u) {
+      const auto written = _write(fd, data, static_cast<unsigned>(size));
+      if (written < 0) {
+        return false;
+      }
+      data += written;
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  static bool TruncateFile(int fd, uint64_t size) {
+    return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+  }
+
+  static bool SyncFile(int fd) {
+    return _commit(fd) == 0;
+  }
+
+  static void CloseFile(int fd) {
+    _close(fd);
+  }
+
+  static unsigned char *AlignedAlloc(size_t size) {
+    return static_cast<unsigned char *>(_aligned_malloc(size, AppendFile::alignment));
+  }
+
+  void AppendFile::AlignedFree::operator()(unsigned char *ptr) const {
+    _aligned_free(ptr);
+  }
+
+#else
+
+  static int OpenFile(const std::string &path, bool direct_io) {
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    if (direct_io) {
+      flags |= O_DIRECT;
+    }
+#else
+    if (direct_io) {
+      errno = EINVAL;
+      return -1;
+    }
+#endif // O_DIRECT
+    return ::open(path.c_str(), flags, 0644);
+  }
+
+  static bool WriteAt(int fd, const unsigned char *data, size_t size, uint64_t offset) {
+    while (size > 0u) {
+      const auto written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += written;
+      offset += static_cast<uint64_t>(written);
+      size -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+  static bool TruncateFile(int fd, uint64_t size) {
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+  }
+
+  static bool SyncFile(int fd) {
+#ifdef __linux__
+    return ::fdatasync(fd) == 0;
+#else
+    return ::fsync(fd) == 0;
+#endif // __linux__
+  }
+
+  static void CloseFile(int fd) {
+    ::close(fd);
+  }
+
+  static unsigned char *AlignedAlloc(size_t size) {
+    void *ptr = nullptr;
+    return ::posix_memalign(&ptr, AppendFile::alignment, size) == 0 ?
+        static_cast<unsigned char *>(ptr) :
+        nullptr;
+  }
+
+  void AppendFile::AlignedFree::operator()(unsigned char *ptr) const {
+    std::free(ptr);
+  }
+
+#endif // _WIN32
+
+  // ===========================================================================
+  // -- AppendFile -------------------------------------------------------------
+  // ===========================================================================
+
+  constexpr size_t AppendFile::alignment;
+
+  static size_t RoundUp(size_t size) {
+    return ((size + AppendFile::alignment - 1u) / AppendFile::alignment) * AppendFile::alignment;
+  }
+
+  AppendFile::AppendFile(const std::string &path, const bool direct_io, const size_t buffer_size)
+    : _capacity(RoundUp(std::max<size_t>(buffer_size, 1u))),
+      _staging(AlignedAlloc(_capacity)) {
+    if (_staging == nullptr) {
+      throw_exception(std::bad_alloc());
+    }
+    _fd = OpenFile(path, direct_io);
+    _direct = direct_io && (_fd >= 0);
+    if ((_fd < 0) && direct_io) {
+      log_warning("direct I/O not supported, using buffered I/O for", path);
+      _fd = OpenFile(path, false);
+    }
+    if (_fd < 0) {
+      ThrowSystemError("failed to open " + path);
+    }
+  }
+
+  AppendFile::~AppendFile() {
+    try {
+      Close();
+    } catch (const std::exception &e) {
+      log_error("exception closing file:", e.what());
+    }
+  }
+
+  void AppendFile::Append(const void *data, size_t size) {
+    DEBUG_ASSERT(IsOpen());
+    auto *src = static_cast<const unsigned char *>(data);
+    while (size > 0u) {
+      const auto count = std::min(size, _capacity - _staged);
+      std::memcpy(_staging.get() + _staged, src, count);
+      _staged += count;
+      _size += count;
+      src += count;
+      size -= count;
+      if (_staged == _capacity) {
+        Write(_capacity);
+        _block_offset += _capacity;
+        _staged = 0u;
+      }
+    }
+  }
+
+  void AppendFile::Flush() {
+    if (!IsOpen() || (_staged == 0u)) {
+      return;
+    }
+    if (!_direct) {
+      Write(_staged);
+      _block_offset += _staged;
+      _staged = 0u;
+      return;
+    }
+    // Direct I/O requires whole blocks, pad the last one.
+    const auto padded = RoundUp(_staged);
+    std::memset(_staging.get() + _staged, 0, padded - _staged);
+    Write(padded);
+    // Keep the last partial block in memory, it will be written again in the
+    // same position when complete.
+    const auto complete = (_staged / alignment) * alignment;
+    std::memmove(_staging.get(), _staging.get() + complete, _staged - complete);
+    _block_offset += complete;
+    _staged -= complete;
+  }
+
+  void AppendFile::Sync() {
+    Flush();
+    if (IsOpen() && !SyncFile(_fd)) {
+      ThrowSystemError("failed to sync file");
+    }
+  }
+
+  void AppendFile::Close() {
+    if (!IsOpen()) {
+      return;
+    }
+    Flush();
+    const bool truncated = !_direct || TruncateFile(_fd, _size);
+    CloseFile(_fd);
+    _fd = -1;
+    if (!truncated) {
+      ThrowSystemError("failed to truncate file");
+    }
+  }
+
+  void AppendFile::Write(const size_t size) {
+    if (!WriteAt(_fd, _staging.get(), size, _block_offset)) {
+      ThrowSystemError("failed to write file");
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,93 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Append-only binary file with its own write buffer.
+  ///
+  /// Data is staged in a memory block aligned to the page size and written in
+  /// whole blocks, this allows opening the file with direct I/O (bypassing the
+  /// OS page cache) where supported. On flush the last partial block is padded
+  /// and written, but kept in memory to be re-written when more data is
+  /// appended; the padding is truncated when the file is closed.
+  ///
+  /// If direct I/O is not supported by the platform or the file system, the
+  /// file falls back to regular buffered I/O.
+  class AppendFile : private NonCopyable {
+  public:
+
+    static constexpr size_t alignment = 4096u;
+
+    /// Create (or truncate) the file at @a path. @a buffer_size is rounded up
+    /// to a multiple of the alignment.
+    AppendFile(const std::string &path, bool direct_io, size_t buffer_size);
+
+    ~AppendFile();
+
+    void Append(const void *data, size_t size);
+
+    /// Write to the file everything appended so far.
+    void Flush();
+
+    /// Flush and ask the OS to commit the data to the storage device.
+    void Sync();
+
+    /// Flush and close the file. Further calls have no effect.
+    void Close();
+
+    bool IsOpen() const {
+      return _fd >= 0;
+    }
+
+    /// Whether the file was opened with direct I/O.
+    bool IsDirect() const {
+      return _direct;
+    }
+
+    /// Number of bytes appended to the file.
+    uint64_t size() const {
+      return _size;
+    }
+
+  private:
+
+    struct AlignedFree {
+      void operator()(unsigned char *ptr) const;
+    };
+
+    /// Write the first @a size bytes of the staging buffer at _block_offset.
+    void Write(size_t size);
+
+    int _fd = -1;
+
+    bool _direct = false;
+
+    const size_t _capacity;
+
+    std::unique_ptr<unsigned char, AlignedFree> _staging;
+
+    /// Number of bytes in the staging buffer.
+    size_t _staged = 0u;
+
+    /// File offset of the first byte of the staging buffer.
+    uint64_t _block_offset = 0u;
+
+    uint64_t _size = 0u;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -9,7 +9,10 @@
 #include "carla/AtomicSharedPtr.h"
 #include "carla/NonCopyable.h"
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace carla {
@@ -26,25 +29,50 @@ namespace detail {
 
     void Call(InputsT... args) const {
       auto list = _list.load();
-      for (auto &callback : *list) {
-        callback(args...);
+      for (auto &item : *list) {
+        item.second(args...);
       }
     }
 
-    /// @todo This function cannot be called concurrently.
-    void RegisterCallback(CallbackType callback) {
+    /// Return an id to remove the callback with RemoveCallback, never 0.
+    size_t RegisterCallback(CallbackType callback) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      const auto id = ++_last_id;
       auto new_list = std::make_shared<ListType>(*_list.load());
-      new_list->emplace_back(std::move(callback));
+      new_list->emplace_back(id, std::move(callback));
       _list = new_list;
+      return id;
+    }
+
+    /// Return false if no callback with @a id is registered. The callback may
+    /// still be running in another thread when this function returns.
+    bool RemoveCallback(size_t id) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto new_list = std::make_shared<ListType>(*_list.load());
+      auto it = std::find_if(new_list->begin(), new_list->end(), [id](const auto &item) {
+        return item.first == id;
+      });
+      if (it == new_list->end()) {
+        return false;
+      }
+      new_list->erase(it);
+      _list = new_list;
+      return true;
     }
 
     void Clear() {
+      std::lock_guard<std::mutex> lock(_mutex);
       _list = std::make_shared<ListType>();
     }
 
   private:
 
-    using ListType = std::vector<CallbackType>;
+    using ListType = std::vector<std::pair<size_t, CallbackType>>;
+
+    /// Serializes the modifications, calls read the list without locking.
+    std::mutex _mutex;
+
+    size_t _last_id = 0u;
 
     AtomicSharedPtr<const ListType> _list;
   };
@@ -9,6 +9,8 @@
 #include "carla/Exception.h"
 #include "carla/Version.h"
 #include "carla/client/TimeoutException.h"
+#include "carla/profiler/Metrics.h"
+#include "carla/profiler/Tracer.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/Client.h"
 #include "carla/rpc/DebugShape.h"
@@ -20,6 +22,7 @@
 #include <rpc/rpc_error.h>
 
 #include <thread>
+#include <unordered_map>
 
 namespace carla {
 namespace client {
@@ -41,11 +44,26 @@ namespace detail {
   class Client::Pimpl {
   private:
 
+    /// Latency histogram of @a function, cached per thread so calls skip
+    /// building the name and locking the metrics registry.
+    static profiler::Histogram &GetLatencyHistogram(const std::string &function) {
+      static thread_local std::unordered_map<std::string, profiler::Histogram *> histograms;
+      auto it = histograms.find(function);
+      if (it == histograms.end()) {
+        auto &histogram = profiler::Metrics::GetHistogram("rpc.call." + function + "_us");
+        it = histograms.emplace(function, &histogram).first;
+      }
+      return *it->second;
+    }
+
     template <typename... Args>
     auto Call(const std::string &function, Args &&... args) {
+      static auto &timeouts = profiler::Metrics::GetCounter("rpc.timeouts");
+      profiler::ScopedMetricsTimer timer(GetLatencyHistogram(function));
       try {
         return rpc_client.call(function, std::forward<Args>(args)...);
       } catch (const ::rpc::timeout &) {
+        timeouts.Increment();
         throw_exception(TimeoutException(endpoint, GetTimeout()));
       }
     }
@@ -63,6 +81,7 @@ namespace detail {
 
     template <typename T, typename... Args>
     auto CallAndWait(const std::string &function, Args &&... args) {
+      CARLA_TRACE_SCOPE(rpc, function);
       auto object = Call(function, std::forward<Args>(args)...);
       using R = typename carla::rpc::Response<T>;
       auto response = object.template as<R>();
@@ -74,6 +93,8 @@ namespace detail {
 
     template <typename... Args>
     void AsyncCall(const std::string &function, Args &&... args) {
+      static auto &async_calls = profiler::Metrics::GetCounter("rpc.async_calls");
+      async_calls.Increment();
       // Discard returned future.
       rpc_client.async_call(function, std::forward<Args>(args)...);
     }
@@ -0,0 +1,122 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/ClientSideSensorExecutor.h"
+
+#include "carla/Logging.h"
+#include "carla/StopWatch.h"
+#include "carla/client/detail/EpisodeState.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  // ===========================================================================
+  // -- ClientSideSensorExecutor::Task -----------------------------------------
+  // ===========================================================================
+
+  class ClientSideSensorExecutor::Task : private NonCopyable {
+  public:
+
+    Task(ActorId sensor_id, std::string display_id, TickFunctionType tick)
+      : _tick(std::move(tick)) {
+      _stats.sensor_id = sensor_id;
+      _stats.display_id = std::move(display_id);
+    }
+
+    void Run(const EpisodeState &state) {
+      StopWatch stop_watch;
+      try {
+        _tick(state);
+      } catch (const std::exception &e) {
+        log_error(_stats.display_id, ": exception computing client-side sensor:", e.what());
+      }
+      stop_watch.Stop();
+      const double seconds = 1e-6 * static_cast<double>(stop_watch.GetElapsedTime<std::chrono::microseconds>());
+      std::lock_guard<std::mutex> lock(_mutex);
+      ++_stats.tick_count;
+      _stats.last_tick_seconds = seconds;
+      _stats.max_tick_seconds = std::max(_stats.max_tick_seconds, seconds);
+      _stats.total_tick_seconds += seconds;
+    }
+
+    ClientSideSensorStats GetStats() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _stats;
+    }
+
+  private:
+
+    const TickFunctionType _tick;
+
+    mutable std::mutex _mutex;
+
+    ClientSideSensorStats _stats;
+  };
+
+  // ===========================================================================
+  // -- ClientSideSensorExecutor -----------------------------------------------
+  // ===========================================================================
+
+  ClientSideSensorExecutor::~ClientSideSensorExecutor() = default;
+
+  void ClientSideSensorExecutor::Register(
+      const ActorId sensor_id,
+      std::string display_id,
+      TickFunctionType tick) {
+    auto task = std::make_shared<Task>(sensor_id, std::move(display_id), std::move(tick));
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks[sensor_id] = std::move(task);
+  }
+
+  void ClientSideSensorExecutor::Unregister(const ActorId sensor_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.erase(sensor_id);
+  }
+
+  void ClientSideSensorExecutor::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.clear();
+  }
+
+  void ClientSideSensorExecutor::Tick(const EpisodeState &state) {
+    std::lock_guard<std::mutex> tick_lock(_tick_mutex);
+    std::vector<std::shared_ptr<Task>> tasks;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      tasks.reserve(_tasks.size());
+      for (auto &&item : _tasks) {
+        tasks.emplace_back(item.second);
+      }
+    }
+    // Sensors may take very different times, with a grain of one sensor the
+    // ranges are small enough for the threads to balance them.
+    _executor.ParallelFor(tasks.size(), 1u, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        tasks[i]->Run(state);
+      }
+    });
+  }
+
+  std::vector<ClientSideSensorStats> ClientSideSensorExecutor::GetStats() const {
+    std::vector<ClientSideSensorStats> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_tasks.size());
+    for (auto &&item : _tasks) {
+      result.emplace_back(item.second->GetStats());
+    }
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.sensor_id < rhs.sensor_id;
+    });
+    return result;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
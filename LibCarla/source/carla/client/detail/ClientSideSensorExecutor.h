@@ -0,0 +1,72 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/TaskExecutor.h"
+#include "carla/client/ClientSideSensorStats.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  class EpisodeState;
+
+  /// Computes the measurements of the client-side sensors of an episode each
+  /// time an episode state is received, spread over the workers of a
+  /// TaskExecutor.
+  ///
+  /// Ticks do not overlap, every sensor finishes a state before any sensor
+  /// starts the next one.
+  class ClientSideSensorExecutor : private NonCopyable {
+  public:
+
+    using TickFunctionType = std::function<void(const EpisodeState &)>;
+
+    explicit ClientSideSensorExecutor(TaskExecutor &executor = TaskExecutor::GetDefault())
+      : _executor(executor) {}
+
+    ~ClientSideSensorExecutor();
+
+    /// Register the function computing the measurement of @a sensor_id,
+    /// replacing any previous one.
+    void Register(ActorId sensor_id, std::string display_id, TickFunctionType tick);
+
+    void Unregister(ActorId sensor_id);
+
+    void Clear();
+
+    /// Run the tick function of every sensor registered on @a state, returns
+    /// when all of them are done.
+    void Tick(const EpisodeState &state);
+
+    std::vector<ClientSideSensorStats> GetStats() const;
+
+  private:
+
+    class Task;
+
+    TaskExecutor &_executor;
+
+    /// Serializes the ticks.
+    std::mutex _tick_mutex;
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<ActorId, std::shared_ptr<Task>> _tasks;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
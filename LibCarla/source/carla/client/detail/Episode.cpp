@@ -7,18 +7,22 @@
 #include "carla/client/detail/Episode.h"
 
 #include "carla/Logging.h"
+#include "carla/RecyclingAllocator.h"
 #include "carla/client/detail/Client.h"
+#include "carla/profiler/Metrics.h"
+#include "carla/profiler/Tracer.h"
 #include "carla/sensor/Deserializer.h"
 
+#include <chrono>
 #include <exception>
 
 namespace carla {
 namespace client {
 namespace detail {
 
-  static auto &CastData(const sensor::SensorData &data) {
+  static auto CastData(SharedPtr<sensor::SensorData> data) {
     using target_t = const sensor::data::RawEpisodeState;
-    return static_cast<target_t &>(data);
+    return boost::static_pointer_cast<target_t>(std::move(data));
   }
 
   Episode::Episode(Client &client)
@@ -38,16 +42,33 @@ namespace detail {
   }
 
   void Episode::Listen() {
+    using profiler::Metrics;
+    using profiler::ScopedMetricsTimer;
+    static auto &ticks = Metrics::GetCounter("episode.ticks");
+    static auto &late_ticks = Metrics::GetCounter("episode.late_ticks");
+    static auto &deserialize_time = Metrics::GetHistogram("episode.deserialize_us");
+    static auto &client_side_sensors_time = Metrics::GetHistogram("episode.client_side_sensors_us");
+    static auto &callbacks_time = Metrics::GetHistogram("episode.callbacks_us");
     std::weak_ptr<Episode> weak = shared_from_this();
     _client.SubscribeToStream(_token, [weak](auto buffer) {
       auto self = weak.lock();
       if (self != nullptr) {
-        auto data = sensor::Deserializer::Deserialize(std::move(buffer));
+        CARLA_TRACE_SCOPE(episode, "tick");
+        std::shared_ptr<const EpisodeState> next;
+        {
+          CARLA_TRACE_SCOPE(episode, "deserialize");
+          ScopedMetricsTimer timer(deserialize_time);
+          auto data = sensor::Deserializer::Deserialize(std::move(buffer));
+          next = std::allocate_shared<EpisodeState>(
+              RecyclingAllocator<EpisodeState>(),
+              CastData(std::move(data)));
+        }
+        ticks.Increment();
 
-        auto next = std::make_shared<const EpisodeState>(CastData(*data));
         auto prev = self->GetState();
         do {
           if (prev->GetFrameCount() >= next->GetFrameCount()) {
+            late_ticks.Increment();
             self->_on_tick_callbacks.Call(next->GetTimestamp());
             return;
           }
@@ -56,26 +77,63 @@ namespace detail {
         if (next->GetEpisodeId() != prev->GetEpisodeId()) {
           self->OnEpisodeStarted();
         }
+        self->_history.Push(next);
 
-        // Notify waiting threads and do the callbacks.
+        // Notify waiting threads, compute the client-side sensors, and do the
+        // callbacks.
         self->_timestamp.SetValue(next->GetTimestamp());
-        self->_on_tick_callbacks.Call(next->GetTimestamp());
+        {
+          CARLA_TRACE_SCOPE(episode, "client_side_sensors");
+          ScopedMetricsTimer timer(client_side_sensors_time);
+          self->_client_side_sensors.Tick(*next);
+        }
+        {
+          CARLA_TRACE_SCOPE(episode, "callbacks");
+          ScopedMetricsTimer timer(callbacks_time);
+          self->_on_tick_callbacks.Call(next->GetTimestamp());
+        }
       }
     });
   }
 
+  boost::optional<Timestamp> Episode::WaitForStateAfter(
+      const size_t frame_count,
+      const time_duration timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout.to_chrono();
+    for (;;) {
+      // The state is updated before notifying, reading the sequence number
+      // first a state received meanwhile is never missed.
+      const auto sequence = _timestamp.GetSequenceNumber();
+      const auto state = GetState();
+      if (state->GetFrameCount() > frame_count) {
+        return state->GetTimestamp();
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        return boost::none;
+      }
+      // Rounded up, a wait shorter than the time left would time out early.
+      const time_duration remaining =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              deadline - now + std::chrono::microseconds(999));
+      // On time out check the state once more, the loop returns when the
+      // deadline has passed.
+      _timestamp.WaitForNewerThan(sequence, remaining);
+    }
+  }
+
   std::vector<rpc::Actor> Episode::GetActors() {
     const auto state = GetState();
-    const auto actor_ids = state->GetActorIds();
-    auto missing_ids = _actors.GetMissingIds(actor_ids);
+    auto missing_ids = _actors.Update(state->GetActorIds());
     if (!missing_ids.empty()) {
       _actors.InsertRange(_client.GetActorsById(missing_ids));
     }
-    return _actors.GetActorsById(actor_ids);
+    return _actors.GetActors();
   }
 
   void Episode::OnEpisodeStarted() {
     _actors.Clear();
+    _client_side_sensors.Clear();
     _on_tick_callbacks.Clear();
   }
 
@@ -10,9 +10,11 @@
 #include "carla/NonCopyable.h"
 #include "carla/RecurrentSharedFuture.h"
 #include "carla/client/Timestamp.h"
-#include "carla/client/detail/CachedActorList.h"
+#include "carla/client/detail/ActorRegistry.h"
 #include "carla/client/detail/CallbackList.h"
+#include "carla/client/detail/ClientSideSensorExecutor.h"
 #include "carla/client/detail/EpisodeState.h"
+#include "carla/client/detail/EpisodeStateHistory.h"
 #include "carla/rpc/EpisodeInfo.h"
 
 namespace carla {
@@ -49,14 +51,49 @@ namespace detail {
       _actors.Insert(std::move(actor));
     }
 
+    /// Actors of the current episode state, sorted by type id and id.
     std::vector<rpc::Actor> GetActors();
 
+    /// Wait until the state of a frame after the current one is received.
     boost::optional<Timestamp> WaitForState(time_duration timeout) {
-      return _timestamp.WaitFor(timeout);
+      return WaitForStateAfter(GetState()->GetFrameCount(), timeout);
     }
 
-    void RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
-      _on_tick_callbacks.RegisterCallback(std::move(callback));
+    /// Wait until the state of a frame after @a frame_count is received,
+    /// return immediately if it already was.
+    boost::optional<Timestamp> WaitForStateAfter(size_t frame_count, time_duration timeout);
+
+    size_t RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
+      return _on_tick_callbacks.RegisterCallback(std::move(callback));
+    }
+
+    void RemoveOnTickEvent(size_t id) {
+      _on_tick_callbacks.RemoveCallback(id);
+    }
+
+    void RegisterClientSideSensor(
+        ActorId sensor_id,
+        std::string display_id,
+        ClientSideSensorExecutor::TickFunctionType tick) {
+      _client_side_sensors.Register(sensor_id, std::move(display_id), std::move(tick));
+    }
+
+    void UnregisterClientSideSensor(ActorId sensor_id) {
+      _client_side_sensors.Unregister(sensor_id);
+    }
+
+    std::vector<ClientSideSensorStats> GetClientSideSensorStats() const {
+      return _client_side_sensors.GetStats();
+    }
+
+    /// Past episode states, filled as the world ticks are received. Empty
+    /// unless a capacity is set.
+    EpisodeStateHistory &GetStateHistory() {
+      return _history;
+    }
+
+    const EpisodeStateHistory &GetStateHistory() const {
+      return _history;
     }
 
   private:
@@ -69,10 +106,14 @@ namespace detail {
 
     AtomicSharedPtr<const EpisodeState> _state;
 
-    CachedActorList _actors;
+    ActorRegistry _actors;
 
     CallbackList<Timestamp> _on_tick_callbacks;
 
+    ClientSideSensorExecutor _client_side_sensors;
+
+    EpisodeStateHistory _history;
+
     RecurrentSharedFuture<Timestamp> _timestamp;
 
     const streaming::Token _token;
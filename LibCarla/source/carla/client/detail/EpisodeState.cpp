@@ -6,19 +6,27 @@
 
 #include "carla/client/detail/EpisodeState.h"
 
+#include <cstring>
+
 namespace carla {
 namespace client {
 namespace detail {
 
-  EpisodeState::EpisodeState(const sensor::data::RawEpisodeState &state)
-    : _episode_id(state.GetEpisodeId()),
+  EpisodeState::EpisodeState(SharedPtr<const sensor::data::RawEpisodeState> state)
+    : _episode_id(state->GetEpisodeId()),
       _timestamp(
-          state.GetFrameNumber(),
-          state.GetGameTimeStamp(),
-          state.GetDeltaSeconds(),
-          state.GetPlatformTimeStamp()) {
-    _actors.reserve(state.size());
-    for (auto &&actor : state) {
+          state->GetFrameNumber(),
+          state->GetGameTimeStamp(),
+          state->GetDeltaSeconds(),
+          state->GetPlatformTimeStamp()),
+      _arena(ArenaPool::Acquire()),
+      _actors(
+          state->size(),
+          ActorMap::hasher(),
+          ActorMap::key_equal(),
+          ActorMap::allocator_type(_arena.get())),
+      _raw_state(std::move(state)) {
+    for (auto &&actor : *_raw_state) {
       DEBUG_ONLY(auto result = )
       _actors.emplace(
           actor.id,
@@ -32,6 +40,27 @@ namespace detail {
     }
   }
 
+  std::vector<sensor::data::ActorDynamicState> EpisodeState::GetActorStates(
+      const std::vector<ActorId> &ids) const {
+    std::vector<sensor::data::ActorDynamicState> result(ids.size());
+    for (auto i = 0u; i < ids.size(); ++i) {
+      auto &record = result[i];
+      const auto *actor = FindActorState(ids[i]);
+      if (actor != nullptr) {
+        record.id = ids[i];
+        record.transform = actor->transform;
+        record.velocity = actor->velocity;
+        record.angular_velocity = actor->angular_velocity;
+        record.acceleration = actor->acceleration;
+        record.state = actor->state;
+      } else {
+        // Packed plain data, zero the padding of the type-dependent state too.
+        std::memset(static_cast<void *>(&record), 0, sizeof(record));
+      }
+    }
+    return result;
+  }
+
 } // namespace detail
 } // namespace client
 } // namespace carla
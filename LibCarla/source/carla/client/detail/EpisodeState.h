@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include "carla/Arena.h"
 #include "carla/Iterator.h"
 #include "carla/ListView.h"
+#include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/client/Timestamp.h"
 #include "carla/sensor/data/ActorDynamicState.h"
@@ -15,12 +17,17 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace client {
 namespace detail {
 
   /// Represents the state of all the actors of an episode at a given frame.
+  ///
+  /// The index of the actors is allocated from an arena of the ArenaPool,
+  /// recycled when the state is destroyed, so a new state per tick does not
+  /// allocate from the heap once the pool is warm.
   class EpisodeState
     : std::enable_shared_from_this<EpisodeState>,
       private NonCopyable {
@@ -36,7 +43,7 @@ namespace detail {
 
     explicit EpisodeState(uint64_t episode_id) : _episode_id(episode_id) {}
 
-    explicit EpisodeState(const sensor::data::RawEpisodeState &state);
+    explicit EpisodeState(SharedPtr<const sensor::data::RawEpisodeState> state);
 
     auto GetEpisodeId() const {
       return _episode_id;
@@ -50,6 +57,12 @@ namespace detail {
       return _timestamp;
     }
 
+    /// Return nullptr if @a id is not in this episode state.
+    const ActorState *FindActorState(ActorId id) const {
+      auto it = _actors.find(id);
+      return it != _actors.end() ? &it->second : nullptr;
+    }
+
     ActorState GetActorState(ActorId id) const {
       ActorState state;
       auto it = _actors.find(id);
@@ -61,6 +74,18 @@ namespace detail {
       return state;
     }
 
+    /// Return the dynamic state of each actor in @a ids, in the same order.
+    /// Actors not found get a state with id 0 and zeroed values.
+    std::vector<sensor::data::ActorDynamicState> GetActorStates(
+        const std::vector<ActorId> &ids) const;
+
+    /// Raw data received from the simulator, the dynamic state of every actor
+    /// laid out in a contiguous array. nullptr if this state was not created
+    /// from simulator data.
+    const SharedPtr<const sensor::data::RawEpisodeState> &GetRawState() const {
+      return _raw_state;
+    }
+
     auto GetActorIds() const {
       return MakeListView(
           iterator::make_map_keys_iterator(_actors.begin()),
@@ -69,11 +94,24 @@ namespace detail {
 
   private:
 
+    using ActorMap = std::unordered_map<
+        ActorId,
+        ActorState,
+        std::hash<ActorId>,
+        std::equal_to<ActorId>,
+        ArenaAllocator<std::pair<const ActorId, ActorState>>>;
+
     const uint64_t _episode_id;
 
     const Timestamp _timestamp;
 
-    std::unordered_map<ActorId, ActorState> _actors;
+    /// Declared before _actors so it outlives them.
+    ArenaPool::ArenaPtr _arena;
+
+    ActorMap _actors;
+
+    /// Keeps alive the buffer received from the simulator.
+    const SharedPtr<const sensor::data::RawEpisodeState> _raw_state;
   };
 
 } // namespace detail
@@ -0,0 +1,180 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/EpisodeStateHistory.h"
+
+#include "carla/Debug.h"
+
+#include <cmath>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  static float LerpAngle(const float a, const float b, const float alpha) {
+    auto delta = std::fmod(b - a, 360.0f);
+    if (delta > 180.0f) {
+      delta -= 360.0f;
+    } else if (delta < -180.0f) {
+      delta += 360.0f;
+    }
+    return a + alpha * delta;
+  }
+
+  static geom::Transform LerpTransform(
+      const geom::Transform &a,
+      const geom::Transform &b,
+      const float alpha) {
+    const auto &la = a.location;
+    const auto &lb = b.location;
+    const auto &ra = a.rotation;
+    const auto &rb = b.rotation;
+    return geom::Transform{
+        geom::Location{
+            la.x + alpha * (lb.x - la.x),
+            la.y + alpha * (lb.y - la.y),
+            la.z + alpha * (lb.z - la.z)},
+        geom::Rotation{
+            LerpAngle(ra.pitch, rb.pitch, alpha),
+            LerpAngle(ra.yaw, rb.yaw, alpha),
+            LerpAngle(ra.roll, rb.roll, alpha)}};
+  }
+
+  EpisodeStateHistory::EpisodeStateHistory(const size_t capacity)
+    : _ring(capacity) {}
+
+  size_t EpisodeStateHistory::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _ring.size();
+  }
+
+  void EpisodeStateHistory::SetCapacity(const size_t capacity) {
+    std::vector<StatePtr> ring(capacity);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::swap(_ring, ring);
+      _empty = true;
+    }
+    // The states dropped are destroyed outside the lock.
+  }
+
+  void EpisodeStateHistory::Push(StatePtr state) {
+    DEBUG_ASSERT(state != nullptr);
+    const auto frame = state->GetFrameCount();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_ring.empty()) {
+      return;
+    }
+    if (!_empty && (GetSlot(_newest_frame)->GetEpisodeId() != state->GetEpisodeId())) {
+      for (auto &&slot : _ring) {
+        slot.reset();
+      }
+      _empty = true;
+    }
+    if (_empty || (frame > _newest_frame)) {
+      _newest_frame = frame;
+      _empty = false;
+    } else if (!IsInWindow(frame)) {
+      return;
+    }
+    auto &slot = _ring[frame % _ring.size()];
+    if ((slot == nullptr) || (slot->GetFrameCount() <= frame)) {
+      slot = std::move(state);
+    }
+  }
+
+  void EpisodeStateHistory::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &&slot : _ring) {
+      slot.reset();
+    }
+    _empty = true;
+  }
+
+  EpisodeStateHistory::StatePtr EpisodeStateHistory::GetState(const uint64_t frame_count) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_empty || !IsInWindow(frame_count)) {
+      return nullptr;
+    }
+    const auto &state = GetSlot(frame_count);
+    return ((state != nullptr) && (state->GetFrameCount() == frame_count)) ? state : nullptr;
+  }
+
+  std::vector<EpisodeStateHistory::StatePtr> EpisodeStateHistory::GetStates() const {
+    std::vector<StatePtr> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_ring.size());
+    ForEachState([&](const StatePtr &state) { result.emplace_back(state); });
+    return result;
+  }
+
+  boost::optional<geom::Transform> EpisodeStateHistory::GetInterpolatedTransform(
+      const ActorId id,
+      const double elapsed_seconds) const {
+    StatePtr before;
+    StatePtr after;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      ForEachState([&](const StatePtr &state) {
+        if (state->GetTimestamp().elapsed_seconds <= elapsed_seconds) {
+          before = state;
+        } else if (after == nullptr) {
+          after = state;
+        }
+      });
+    }
+    if (before == nullptr) {
+      return boost::none;
+    }
+    const auto *actor_before = before->FindActorState(id);
+    if (actor_before == nullptr) {
+      return boost::none;
+    }
+    const auto t0 = before->GetTimestamp().elapsed_seconds;
+    if (t0 == elapsed_seconds) {
+      return actor_before->transform;
+    }
+    if (after == nullptr) {
+      return boost::none;
+    }
+    const auto *actor_after = after->FindActorState(id);
+    if (actor_after == nullptr) {
+      return boost::none;
+    }
+    const auto t1 = after->GetTimestamp().elapsed_seconds;
+    const auto alpha = static_cast<float>((elapsed_seconds - t0) / (t1 - t0));
+    return LerpTransform(actor_before->transform, actor_after->transform, alpha);
+  }
+
+  std::vector<ActorHistorySample> EpisodeStateHistory::GetActorHistory(
+      const ActorId id,
+      const double from_seconds,
+      const double to_seconds) const {
+    std::vector<ActorHistorySample> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_ring.size());
+    ForEachState([&](const StatePtr &state) {
+      const auto &timestamp = state->GetTimestamp();
+      if ((timestamp.elapsed_seconds < from_seconds) || (timestamp.elapsed_seconds > to_seconds)) {
+        return;
+      }
+      const auto *actor = state->FindActorState(id);
+      if (actor != nullptr) {
+        result.push_back(ActorHistorySample{
+            timestamp.frame_count,
+            timestamp.elapsed_seconds,
+            actor->transform,
+            actor->velocity,
+            actor->angular_velocity,
+            actor->acceleration});
+      }
+    });
+    return result;
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,114 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/client/ActorHistorySample.h"
+#include "carla/client/detail/EpisodeState.h"
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Fixed-size ring of the last episode states received, indexed by frame
+  /// count. Keeping a state is just keeping a reference to it, the history
+  /// adds no traffic with the simulator.
+  ///
+  /// Frames skipped by the simulator leave empty slots, so the history covers
+  /// the last "capacity" frames rather than the last "capacity" states.
+  ///
+  /// All the methods are thread-safe.
+  class EpisodeStateHistory : private NonCopyable {
+  public:
+
+    using StatePtr = std::shared_ptr<const EpisodeState>;
+
+    /// A capacity of 0 disables the history.
+    explicit EpisodeStateHistory(size_t capacity = 0u);
+
+    size_t GetCapacity() const;
+
+    /// Set the number of frames kept, drops the states already kept.
+    void SetCapacity(size_t capacity);
+
+    /// Add @a state to the history. A state of a different episode than the
+    /// ones kept clears the history first.
+    void Push(StatePtr state);
+
+    void Clear();
+
+    /// Return the state at @a frame_count in constant time, nullptr if it is
+    /// not in the history.
+    StatePtr GetState(uint64_t frame_count) const;
+
+    /// States kept, from the oldest to the newest.
+    std::vector<StatePtr> GetStates() const;
+
+    /// Transform of actor @a id at @a elapsed_seconds, linearly interpolated
+    /// between the two states around that time. Rotations take the shortest
+    /// way around. Return none if the time is not covered by the history or
+    /// the actor is not present in both states.
+    boost::optional<geom::Transform> GetInterpolatedTransform(
+        ActorId id,
+        double elapsed_seconds) const;
+
+    /// Dynamic state of actor @a id in each of the states kept with
+    /// elapsed seconds within [@a from_seconds, @a to_seconds], from the
+    /// oldest to the newest. States in which the actor is not present are
+    /// skipped.
+    std::vector<ActorHistorySample> GetActorHistory(
+        ActorId id,
+        double from_seconds,
+        double to_seconds) const;
+
+  private:
+
+    bool IsInWindow(uint64_t frame_count) const {
+      return (frame_count <= _newest_frame) && (frame_count + _ring.size() > _newest_frame);
+    }
+
+    /// @pre _mutex is locked.
+    const StatePtr &GetSlot(uint64_t frame_count) const {
+      return _ring[frame_count % _ring.size()];
+    }
+
+    /// Call @a functor with each state kept, from the oldest to the newest.
+    /// @pre _mutex is locked.
+    template <typename FunctorT>
+    void ForEachState(FunctorT &&functor) const {
+      if (_empty) {
+        return;
+      }
+      const uint64_t size = _ring.size();
+      const uint64_t oldest = _newest_frame + 1u > size ? _newest_frame + 1u - size : 0u;
+      for (auto frame = oldest; frame <= _newest_frame; ++frame) {
+        const auto &state = GetSlot(frame);
+        if ((state != nullptr) && (state->GetFrameCount() == frame)) {
+          functor(state);
+        }
+      }
+    }
+
+    mutable std::mutex _mutex;
+
+    std::vector<StatePtr> _ring;
+
+    uint64_t _newest_frame = 0u;
+
+    /// Whether _ring holds any state.
+    bool _empty = true;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
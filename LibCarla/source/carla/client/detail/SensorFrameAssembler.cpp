@@ -0,0 +1,126 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/SensorFrameAssembler.h"
+
+#include "carla/Logging.h"
+#include "carla/sensor/SensorData.h"
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  SensorFrameAssembler::SensorFrameAssembler(
+      const size_t number_of_sensors,
+      const size_t window,
+      const time_duration timeout,
+      const IncompleteFramePolicy policy)
+    : _number_of_sensors(number_of_sensors),
+      _window(window),
+      _timeout(timeout),
+      _policy(policy) {
+    DEBUG_ASSERT(_window > 0u);
+  }
+
+  void SensorFrameAssembler::AddData(
+      const size_t index,
+      SharedPtr<sensor::SensorData> data) {
+    DEBUG_ASSERT(data != nullptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto *bundle = GetBundle(data->GetFrameNumber());
+    if (bundle == nullptr) {
+      log_debug("sensor synchronizer: discarding late data of frame", data->GetFrameNumber());
+    } else if (bundle->SetData(index, std::move(data))) {
+      --bundle->_missing;
+    }
+    Evict();
+  }
+
+  void SensorFrameAssembler::AddTick(
+      const Timestamp &timestamp,
+      std::shared_ptr<const EpisodeState> state) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto *bundle = GetBundle(timestamp.frame_count);
+    if ((bundle != nullptr) && bundle->SetTick(timestamp, std::move(state))) {
+      --bundle->_missing;
+    }
+    Evict();
+  }
+
+  SharedPtr<SensorBundle> SensorFrameAssembler::PopReady() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_ready.empty()) {
+      return nullptr;
+    }
+    auto bundle = std::move(_ready.front());
+    _ready.pop_front();
+    return bundle;
+  }
+
+  bool SensorFrameAssembler::HasReady() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return !_ready.empty();
+  }
+
+  void SensorFrameAssembler::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.clear();
+    _ready.clear();
+  }
+
+  SensorBundle *SensorFrameAssembler::GetBundle(const size_t frame) {
+    if (frame < _first_valid_frame) {
+      return nullptr;
+    }
+    auto result = _pending.emplace(frame, PendingFrame{});
+    auto &pending = result.first->second;
+    if (result.second) {
+      pending.bundle = MakeShared<SensorBundle>(frame, _number_of_sensors);
+      pending.bundle->_missing = _number_of_sensors + 1u;
+    }
+    return pending.bundle.get();
+  }
+
+  void SensorFrameAssembler::Evict() {
+    auto pop_front = [&]() {
+      auto it = _pending.begin();
+      _first_valid_frame = it->first + 1u;
+      auto bundle = std::move(it->second.bundle);
+      _pending.erase(it);
+      if (bundle->IsComplete() || (_policy == IncompleteFramePolicy::Deliver)) {
+        _ready.emplace_back(std::move(bundle));
+      } else {
+        log_debug("sensor synchronizer: dropping incomplete frame", bundle->GetFrameNumber());
+        ++_dropped_frames;
+      }
+    };
+
+    // A complete frame evicts every frame before it.
+    auto last_complete = _pending.end();
+    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
+      if (it->second.bundle->IsComplete()) {
+        last_complete = it;
+      }
+    }
+    if (last_complete != _pending.end()) {
+      const auto frame = last_complete->first;
+      while (!_pending.empty() && (_pending.begin()->first <= frame)) {
+        pop_front();
+      }
+    }
+
+    // Then make room in the window and evict the frames that timed out.
+    const auto timeout = _timeout.milliseconds();
+    while (!_pending.empty() && (
+              (_pending.size() > _window) ||
+              (static_cast<size_t>(_pending.begin()->second.age.GetElapsedTime()) > timeout))) {
+      pop_front();
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,106 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/StopWatch.h"
+#include "carla/Time.h"
+#include "carla/client/SensorBundle.h"
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Frame bookkeeping of a SensorSynchronizer, kept apart from the streams
+  /// and the user callback. Measurements and world ticks are grouped by frame
+  /// into SensorBundle objects, which become ready in increasing frame order
+  /// once complete or evicted from the window, see SensorSynchronizer for the
+  /// eviction rules.
+  ///
+  /// All the methods are thread-safe.
+  class SensorFrameAssembler : private NonCopyable {
+  public:
+
+    /// What to do with frames evicted before being completed.
+    enum class IncompleteFramePolicy {
+      Drop,
+      Deliver
+    };
+
+    SensorFrameAssembler(
+        size_t number_of_sensors,
+        size_t window,
+        time_duration timeout,
+        IncompleteFramePolicy policy);
+
+    /// Add the measurement of sensor @a index. Data of a frame already
+    /// evicted is discarded.
+    void AddData(size_t index, SharedPtr<sensor::SensorData> data);
+
+    /// Add the world tick of the frame in @a timestamp.
+    void AddTick(const Timestamp &timestamp, std::shared_ptr<const EpisodeState> state);
+
+    /// Pop the oldest bundle ready, nullptr if none.
+    SharedPtr<SensorBundle> PopReady();
+
+    bool HasReady() const;
+
+    /// Discard every frame waiting and every bundle ready.
+    void Clear();
+
+    /// Number of incomplete frames dropped, always zero if the policy is
+    /// Deliver.
+    size_t GetNumberOfDroppedFrames() const {
+      return _dropped_frames;
+    }
+
+  private:
+
+    struct PendingFrame {
+      SharedPtr<SensorBundle> bundle;
+      StopWatch age;
+    };
+
+    /// Find or insert the bundle of @a frame, nullptr if the frame is older
+    /// than the last frame evicted.
+    /// @pre _mutex is locked.
+    SensorBundle *GetBundle(size_t frame);
+
+    /// Move to the ready queue every frame that has to leave the window, in
+    /// frame order.
+    /// @pre _mutex is locked.
+    void Evict();
+
+    const size_t _number_of_sensors;
+
+    const size_t _window;
+
+    const time_duration _timeout;
+
+    const IncompleteFramePolicy _policy;
+
+    std::atomic_size_t _dropped_frames{0u};
+
+    mutable std::mutex _mutex;
+
+    std::map<size_t, PendingFrame> _pending;
+
+    std::deque<SharedPtr<SensorBundle>> _ready;
+
+    /// Every frame up to this one (not included) has already left the window.
+    size_t _first_valid_frame = 0u;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
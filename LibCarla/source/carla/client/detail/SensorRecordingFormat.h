@@ -0,0 +1,60 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Layout of the sensor recordings written by SensorRecorder.
+  ///
+  /// A recording is a folder containing an index file plus one or more
+  /// segment files. Segments are the serialized sensor messages, exactly as
+  /// received from the stream, concatenated. The index contains a small header
+  /// followed by one entry per message, in the order they were received.
+  namespace recording {
+
+    constexpr char magic[8u] = {'C', 'A', 'R', 'L', 'A', 'S', 'R', 'I'};
+
+    constexpr uint32_t version = 1u;
+
+    struct IndexHeader {
+      char magic[8u];
+      uint32_t version;
+      uint32_t reserved;
+    };
+
+    struct IndexEntry {
+      uint64_t frame_number;
+      /// Offset of the message in its segment file.
+      uint64_t offset;
+      uint32_t segment;
+      uint32_t size;
+    };
+
+    static_assert(sizeof(IndexHeader) == 16u, "Invalid index header size");
+    static_assert(sizeof(IndexEntry) == 24u, "Invalid index entry size");
+
+    static inline std::string GetIndexFileName(const std::string &folder) {
+      return folder + "/index.bin";
+    }
+
+    static inline std::string GetSegmentFileName(const std::string &folder, uint32_t segment) {
+      char name[32u];
+      std::snprintf(name, sizeof(name), "/segment_%06u.bin", segment);
+      return folder + name;
+    }
+
+  } // namespace recording
+
+} // namespace detail
+} // namespace client
+} // namespace carla
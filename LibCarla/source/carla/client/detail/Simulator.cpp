@@ -14,6 +14,8 @@
 #include "carla/client/Sensor.h"
 #include "carla/client/TimeoutException.h"
 #include "carla/client/detail/ActorFactory.h"
+#include "carla/profiler/Metrics.h"
+#include "carla/profiler/Tracer.h"
 #include "carla/sensor/Deserializer.h"
 
 #include <exception>
@@ -82,7 +84,8 @@ namespace detail {
       _episode = std::make_shared<Episode>(_client);
       _episode->Listen();
       if (!GetEpisodeSettings().synchronous_mode) {
-        WaitForTick(_client.GetTimeout());
+        // Any tick received since listening will do.
+        WaitForTickAfter(0u, _client.GetTimeout());
       }
     }
     return EpisodeProxy{shared_from_this()};
@@ -98,7 +101,13 @@ namespace detail {
 
   Timestamp Simulator::WaitForTick(time_duration timeout) {
     DEBUG_ASSERT(_episode != nullptr);
-    auto result = _episode->WaitForState(timeout);
+    return WaitForTickAfter(_episode->GetState()->GetFrameCount(), timeout);
+  }
+
+  Timestamp Simulator::WaitForTickAfter(const size_t frame_count, const time_duration timeout) {
+    DEBUG_ASSERT(_episode != nullptr);
+    CARLA_TRACE_SCOPE(episode, "wait_for_tick");
+    auto result = _episode->WaitForStateAfter(frame_count, timeout);
     if (!result.has_value()) {
       throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
     }
@@ -189,16 +198,45 @@ namespace detail {
     _client.SubscribeToStream(
         sensor.GetActorDescription().GetStreamToken(),
         [cb=std::move(callback), ep=WeakEpisodeProxy{shared_from_this()}](auto buffer) {
-          auto data = sensor::Deserializer::Deserialize(std::move(buffer));
+          static auto &deserialize_time =
+              profiler::Metrics::GetHistogram("sensor.deserialize_us");
+          SharedPtr<sensor::SensorData> data;
+          {
+            CARLA_TRACE_SCOPE(sensor, "deserialize");
+            profiler::ScopedMetricsTimer timer(deserialize_time);
+            data = sensor::Deserializer::Deserialize(std::move(buffer));
+          }
           data->_episode = ep.TryLock();
+          CARLA_TRACE_SCOPE(sensor, "callback");
           cb(std::move(data));
         });
   }
 
+  void Simulator::SubscribeToSensorStream(
+      const Sensor &sensor,
+      std::function<void(Buffer)> callback) {
+    DEBUG_ASSERT(_episode != nullptr);
+    _client.SubscribeToStream(
+        sensor.GetActorDescription().GetStreamToken(),
+        std::move(callback));
+  }
+
   void Simulator::UnSubscribeFromSensor(const Sensor &sensor) {
     _client.UnSubscribeFromStream(sensor.GetActorDescription().GetStreamToken());
   }
 
+  void Simulator::RegisterClientSideSensor(
+      const Sensor &sensor,
+      std::function<void(const EpisodeState &)> tick) {
+    DEBUG_ASSERT(_episode != nullptr);
+    _episode->RegisterClientSideSensor(sensor.GetId(), sensor.GetDisplayId(), std::move(tick));
+  }
+
+  void Simulator::UnregisterClientSideSensor(const Sensor &sensor) {
+    DEBUG_ASSERT(_episode != nullptr);
+    _episode->UnregisterClientSideSensor(sensor.GetId());
+  }
+
 } // namespace detail
 } // namespace client
 } // namespace carla
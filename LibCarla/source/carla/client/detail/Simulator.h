@@ -79,6 +79,12 @@ namespace detail {
 
     EpisodeProxy GetCurrentEpisode();
 
+    /// @pre Cannot be called previous to GetCurrentEpisode.
+    std::shared_ptr<const EpisodeState> GetCurrentEpisodeState() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetState();
+    }
+
     /// @}
     // =========================================================================
     /// @name Map related methods
@@ -127,9 +133,14 @@ namespace detail {
 
     Timestamp WaitForTick(time_duration timeout);
 
-    void RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
+    size_t RegisterOnTickEvent(std::function<void(Timestamp)> callback) {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->RegisterOnTickEvent(std::move(callback));
+    }
+
+    void RemoveOnTickEvent(size_t id) {
       DEBUG_ASSERT(_episode != nullptr);
-      _episode->RegisterOnTickEvent(std::move(callback));
+      _episode->RemoveOnTickEvent(id);
     }
 
     void Tick() {
@@ -299,8 +310,32 @@ namespace detail {
         const Sensor &sensor,
         std::function<void(SharedPtr<sensor::SensorData>)> callback);
 
+    /// Subscribe to the stream of @a sensor, the messages are passed to @a
+    /// callback without being deserialized.
+    void SubscribeToSensorStream(
+        const Sensor &sensor,
+        std::function<void(Buffer)> callback);
+
     void UnSubscribeFromSensor(const Sensor &sensor);
 
+    /// Compute the measurement of a client-side sensor on each episode state
+    /// received, in parallel with the other client-side sensors.
+    void RegisterClientSideSensor(
+        const Sensor &sensor,
+        std::function<void(const EpisodeState &)> tick);
+
+    void UnregisterClientSideSensor(const Sensor &sensor);
+
+    std::vector<ClientSideSensorStats> GetClientSideSensorStats() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetClientSideSensorStats();
+    }
+
+    EpisodeStateHistory &GetEpisodeStateHistory() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetStateHistory();
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations with traffic lights
@@ -355,6 +390,9 @@ namespace detail {
 
   private:
 
+    /// Wait for the tick of a frame after @a frame_count, throw on timeout.
+    Timestamp WaitForTickAfter(size_t frame_count, time_duration timeout);
+
     Client _client;
 
     std::shared_ptr<Episode> _episode;
@@ -55,7 +55,7 @@ namespace opendrive {
         itSec != roadInfo->lanes.lane_sections.rend() - 1;
         ++itSec) {
       for (auto itLane = itSec->left.begin(); itLane != itSec->left.end(); ++itLane) {
-        if (itLane->attributes.type == "driving" && itLane->attributes.id == id) {
+        if (itLane->attributes.type == road::element::LaneType::Driving && itLane->attributes.id == id) {
           id = itLane->link ? itLane->link->predecessor_id : 0;
           break;
         }
@@ -136,7 +136,7 @@ namespace opendrive {
 
       for (auto &&left_lanes : it->second->lanes.lane_sections[0].left) {
         if (left_lanes.link != nullptr) {
-          if (left_lanes.attributes.type != "driving") {
+          if (left_lanes.attributes.type != road::element::LaneType::Driving) {
             continue;
           }
           if (left_lanes.link->successor_id != 0) {
@@ -161,7 +161,7 @@ namespace opendrive {
 
       for (auto &&right_lanes : it->second->lanes.lane_sections[0].right) {
         if (right_lanes.link != nullptr) {
-          if (right_lanes.attributes.type != "driving") {
+          if (right_lanes.attributes.type != road::element::LaneType::Driving) {
             continue;
           }
           if (right_lanes.link->successor_id != 0) {
@@ -296,23 +296,6 @@ namespace opendrive {
       // Add lane change information
       for (auto &&lane_section : it->second->lanes.lane_sections) {
 
-        // Lambda to convert from string to enum LaneChange
-        auto string_2_lane_change_enum = [](auto lane_change)->
-            carla::road::element::RoadInfoMarkRecord::LaneChange {
-          if (lane_change == "increase") {
-            return carla::road::element::RoadInfoMarkRecord::LaneChange::Increase;
-          }
-          else if (lane_change == "decrease") {
-            return carla::road::element::RoadInfoMarkRecord::LaneChange::Decrease;
-          }
-          else if (lane_change == "both") {
-            return carla::road::element::RoadInfoMarkRecord::LaneChange::Both;
-          }
-          else {
-            return carla::road::element::RoadInfoMarkRecord::LaneChange::None;
-          }
-        };
-
         const auto lane_sec_s_offset = lane_section.start_position;
 
         // Create a new RoadInfoMarkRecord for each lane section. Each RoadInfoMarkRecord
@@ -328,7 +311,7 @@ namespace opendrive {
               road_marker.color,
               road_marker.material,
               road_marker.width,
-              string_2_lane_change_enum(road_marker.lane_change),
+              road_marker.lane_change,
               // @todo: "carla/opendrive/types.h" must be extended to parse the height
               0.0);
           }
@@ -356,7 +339,7 @@ namespace opendrive {
               road_marker.color,
               road_marker.material,
               road_marker.width,
-              string_2_lane_change_enum(road_marker.lane_change),
+              road_marker.lane_change,
               // @todo: "carla/opendrive/types.h" must be extended to parse the height
               0.0);
           }
@@ -383,7 +366,7 @@ namespace opendrive {
               road_marker.color,
               road_marker.material,
               road_marker.width,
-              string_2_lane_change_enum(road_marker.lane_change),
+              road_marker.lane_change,
               // @todo: "carla/opendrive/types.h" must be extended to parse the height
               0.0);
           }
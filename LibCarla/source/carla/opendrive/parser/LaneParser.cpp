@@ -10,13 +10,99 @@ namespace carla {
 namespace opendrive {
 namespace parser {
 
+  using RoadMark = road::element::RoadInfoMarkRecord;
+
+  static road::element::LaneType ParseLaneType(const std::string &str) {
+    using road::element::LaneType;
+    static const std::pair<const char *, LaneType> types[] = {
+      {"driving",       LaneType::Driving},
+      {"stop",          LaneType::Stop},
+      {"shoulder",      LaneType::Shoulder},
+      {"biking",        LaneType::Biking},
+      {"sidewalk",      LaneType::Sidewalk},
+      {"border",        LaneType::Border},
+      {"restricted",    LaneType::Restricted},
+      {"parking",       LaneType::Parking},
+      {"bidirectional", LaneType::Bidirectional},
+      {"median",        LaneType::Median},
+      {"special1",      LaneType::Special1},
+      {"special2",      LaneType::Special2},
+      {"special3",      LaneType::Special3},
+      {"roadWorks",     LaneType::RoadWorks},
+      {"tram",          LaneType::Tram},
+      {"rail",          LaneType::Rail},
+      {"entry",         LaneType::Entry},
+      {"exit",          LaneType::Exit},
+      {"offRamp",       LaneType::OffRamp},
+      {"onRamp",        LaneType::OnRamp}};
+    for (auto &&item : types) {
+      if (str == item.first) {
+        return item.second;
+      }
+    }
+    return LaneType::None;
+  }
+
+  static RoadMark::Type ParseRoadMarkType(const std::string &str) {
+    if (str == "solid") {
+      return RoadMark::Type::Solid;
+    } else if (str == "broken") {
+      return RoadMark::Type::Broken;
+    } else if (str == "solid solid") {
+      return RoadMark::Type::SolidSolid;
+    } else if (str == "solid broken") {
+      return RoadMark::Type::SolidBroken;
+    } else if (str == "broken solid") {
+      return RoadMark::Type::BrokenSolid;
+    } else if (str == "broken broken") {
+      return RoadMark::Type::BrokenBroken;
+    } else if (str == "botts dots") {
+      return RoadMark::Type::BottsDots;
+    } else if (str == "grass") {
+      return RoadMark::Type::Grass;
+    } else if (str == "curb") {
+      return RoadMark::Type::Curb;
+    } else if (str == "none") {
+      return RoadMark::Type::None;
+    }
+    return RoadMark::Type::Other;
+  }
+
+  static RoadMark::Color ParseRoadMarkColor(const std::string &str) {
+    if (str == "standard") {
+      return RoadMark::Color::Standard;
+    } else if (str == "blue") {
+      return RoadMark::Color::Blue;
+    } else if (str == "green") {
+      return RoadMark::Color::Green;
+    } else if (str == "red") {
+      return RoadMark::Color::Red;
+    } else if (str == "white") {
+      return RoadMark::Color::White;
+    } else if (str == "yellow") {
+      return RoadMark::Color::Yellow;
+    }
+    return RoadMark::Color::Other;
+  }
+
+  static RoadMark::LaneChange ParseLaneChange(const std::string &str) {
+    if (str == "increase") {
+      return RoadMark::LaneChange::Increase;
+    } else if (str == "decrease") {
+      return RoadMark::LaneChange::Decrease;
+    } else if (str == "both") {
+      return RoadMark::LaneChange::Both;
+    }
+    return RoadMark::LaneChange::None;
+  }
+
   void LaneParser::ParseLane(
       const pugi::xml_node &xmlNode,
       std::vector<types::LaneInfo> &out_lane) {
     for (pugi::xml_node lane = xmlNode.child("lane"); lane; lane = lane.next_sibling("lane")) {
       types::LaneInfo currentLane;
 
-      currentLane.attributes.type = lane.attribute("type").value();
+      currentLane.attributes.type = ParseLaneType(lane.attribute("type").value());
       currentLane.attributes.level = lane.attribute("level").value();
       currentLane.attributes.id = std::atoi(lane.attribute("id").value());
 
@@ -97,23 +183,25 @@ namespace parser {
       }
 
       if (road_mark.attribute("type") != nullptr) {
-        roadMarker.type = road_mark.attribute("type").value();
+        roadMarker.type = ParseRoadMarkType(road_mark.attribute("type").value());
       }
 
       if (road_mark.attribute("weight") != nullptr) {
-        roadMarker.weigth = road_mark.attribute("weight").value();
+        roadMarker.weigth = std::string(road_mark.attribute("weight").value()) == "bold" ?
+            RoadMark::Weight::Bold :
+            RoadMark::Weight::Standard;
       }
 
       if (road_mark.attribute("material") != nullptr) {
-        roadMarker.color = road_mark.attribute("material").value();
+        roadMarker.material = road_mark.attribute("material").value();
       }
 
       if (road_mark.attribute("color") != nullptr) {
-        roadMarker.color = road_mark.attribute("color").value();
+        roadMarker.color = ParseRoadMarkColor(road_mark.attribute("color").value());
       }
 
       if (road_mark.attribute("laneChange") != nullptr) {
-        roadMarker.lane_change = road_mark.attribute("laneChange").value();
+        roadMarker.lane_change = ParseLaneChange(road_mark.attribute("laneChange").value());
       }
 
       out_lane_mark.emplace_back(roadMarker);
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "carla/road/element/LaneType.h"
+#include "carla/road/element/RoadInfoMarkRecord.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -49,7 +52,7 @@ namespace types {
 
   struct LaneAttributes {
     int id;
-    std::string type;
+    road::element::LaneType type;
     std::string level;
   };
 
@@ -66,15 +69,17 @@ namespace types {
     double soffset = 0.0;
     double width = 0.0;
 
-    std::string type;
-    std::string weigth = "standard";
+    using RoadMark = road::element::RoadInfoMarkRecord;
+
+    RoadMark::Type type = RoadMark::Type::None;
+    RoadMark::Weight weigth = RoadMark::Weight::Standard;
 
     // See OpenDRIVE Format Specification, Rev. 1.4
     // Doc No.: VI2014.107 (5.3.7.2.1.1.4 Road Mark Record)
     std::string material = "standard";
 
-    std::string color = "white";
-    std::string lane_change = "none";
+    RoadMark::Color color = RoadMark::Color::White;
+    RoadMark::LaneChange lane_change = RoadMark::LaneChange::None;
   };
 
   struct LaneOffset {
@@ -0,0 +1,183 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace carla {
+namespace profiler {
+
+  // ===========================================================================
+  // -- Shards -----------------------------------------------------------------
+  // ===========================================================================
+
+namespace detail {
+
+  size_t GetMetricsShardIndex() {
+    static std::atomic_size_t NEXT_INDEX{0u};
+    static thread_local const size_t INDEX =
+        NEXT_INDEX.fetch_add(1u, std::memory_order_relaxed) % METRICS_NUMBER_OF_SHARDS;
+    return INDEX;
+  }
+
+} // namespace detail
+
+  // ===========================================================================
+  // -- Counter ----------------------------------------------------------------
+  // ===========================================================================
+
+  uint64_t Counter::GetValue() const {
+    uint64_t result = 0u;
+    for (auto &&shard : _shards) {
+      result += shard.value.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  void Counter::Reset() {
+    for (auto &&shard : _shards) {
+      shard.value.store(0u, std::memory_order_relaxed);
+    }
+  }
+
+  // ===========================================================================
+  // -- Histogram --------------------------------------------------------------
+  // ===========================================================================
+
+  uint64_t HistogramSnapshot::GetPercentile(const double percentile) const {
+    if (count == 0u) {
+      return 0u;
+    }
+    const auto clamped = std::min(std::max(percentile, 0.0), 1.0);
+    const auto rank = std::max<uint64_t>(
+        1u,
+        static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+    uint64_t accumulated = 0u;
+    for (auto i = 0u; i < NumberOfBuckets; ++i) {
+      accumulated += buckets[i];
+      if (accumulated >= rank) {
+        const uint64_t upper_bound = i == 0u ? 0u :
+            (i >= 64u ? UINT64_MAX : (uint64_t(1u) << i) - 1u);
+        return std::min(upper_bound, max);
+      }
+    }
+    return max;
+  }
+
+  HistogramSnapshot Histogram::GetSnapshot() const {
+    HistogramSnapshot result;
+    for (auto &&shard : _shards) {
+      result.count += shard.count.load(std::memory_order_relaxed);
+      result.sum += shard.sum.load(std::memory_order_relaxed);
+      result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+      for (auto i = 0u; i < result.buckets.size(); ++i) {
+        result.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+
+  void Histogram::Reset() {
+    for (auto &&shard : _shards) {
+      shard.count.store(0u, std::memory_order_relaxed);
+      shard.sum.store(0u, std::memory_order_relaxed);
+      shard.max.store(0u, std::memory_order_relaxed);
+      for (auto &&bucket : shard.buckets) {
+        bucket.store(0u, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // ===========================================================================
+  // -- Metrics ----------------------------------------------------------------
+  // ===========================================================================
+
+  namespace {
+
+    struct Registry {
+
+      std::mutex mutex;
+
+      std::map<std::string, std::unique_ptr<Counter>> counters;
+
+      std::map<std::string, std::unique_ptr<Gauge>> gauges;
+
+      std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    /// Never destroyed, metrics may still be recorded by static objects
+    /// going out of scope at exit.
+    Registry &GetRegistry() {
+      static Registry *REGISTRY = new Registry;
+      return *REGISTRY;
+    }
+
+    template <typename T>
+    T &FindOrAdd(std::map<std::string, std::unique_ptr<T>> &map, const std::string &name) {
+      auto &ptr = map[name];
+      if (ptr == nullptr) {
+        ptr = std::make_unique<T>();
+      }
+      return *ptr;
+    }
+
+  } // namespace
+
+  Counter &Metrics::GetCounter(const std::string &name) {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return FindOrAdd(registry.counters, name);
+  }
+
+  Gauge &Metrics::GetGauge(const std::string &name) {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return FindOrAdd(registry.gauges, name);
+  }
+
+  Histogram &Metrics::GetHistogram(const std::string &name) {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return FindOrAdd(registry.histograms, name);
+  }
+
+  MetricsSnapshot Metrics::GetSnapshot() {
+    MetricsSnapshot result;
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    result.counters.reserve(registry.counters.size());
+    for (auto &&item : registry.counters) {
+      result.counters.emplace_back(item.first, item.second->GetValue());
+    }
+    result.gauges.reserve(registry.gauges.size());
+    for (auto &&item : registry.gauges) {
+      result.gauges.emplace_back(item.first, item.second->GetValue());
+    }
+    result.histograms.reserve(registry.histograms.size());
+    for (auto &&item : registry.histograms) {
+      result.histograms.emplace_back(item.first, item.second->GetSnapshot());
+    }
+    return result;
+  }
+
+  void Metrics::Reset() {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto &&item : registry.counters) {
+      item.second->Reset();
+    }
+    for (auto &&item : registry.histograms) {
+      item.second->Reset();
+    }
+  }
+
+} // namespace profiler
+} // namespace carla
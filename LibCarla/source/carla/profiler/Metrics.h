@@ -0,0 +1,199 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/StopWatch.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+
+  // ===========================================================================
+  // -- Metrics ----------------------------------------------------------------
+  // ===========================================================================
+  //
+  // Always-available runtime metrics. Counters and histograms are split in
+  // shards, each thread writes to its own shard with relaxed atomics and the
+  // shards are merged on read, so recording is a couple of uncontended atomic
+  // additions.
+  //
+  // Metrics are registered by name in a process-wide registry, lookups take a
+  // lock so call sites should keep the returned reference, e.g.
+  //
+  //   static auto &counter = Metrics::GetCounter("streaming.client.messages");
+  //   counter.Increment();
+
+namespace detail {
+
+  static constexpr size_t METRICS_NUMBER_OF_SHARDS = 16u;
+
+  /// Index of the shard the calling thread writes to.
+  size_t GetMetricsShardIndex();
+
+} // namespace detail
+
+  /// Monotonically increasing value.
+  class Counter : private NonCopyable {
+  public:
+
+    void Increment(uint64_t value = 1u) {
+      _shards[detail::GetMetricsShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t GetValue() const;
+
+    void Reset();
+
+  private:
+
+    /// Padded to a cache line so threads do not write to the same one.
+    struct Shard {
+      std::atomic<uint64_t> value{0u};
+      char padding[64u - sizeof(std::atomic<uint64_t>)];
+    };
+
+    std::array<Shard, detail::METRICS_NUMBER_OF_SHARDS> _shards;
+  };
+
+  /// Value that can go up and down, e.g. a queue depth.
+  class Gauge : private NonCopyable {
+  public:
+
+    void Set(int64_t value) {
+      _value.store(value, std::memory_order_relaxed);
+    }
+
+    void Add(int64_t value) {
+      _value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    int64_t GetValue() const {
+      return _value.load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    std::atomic<int64_t> _value{0};
+  };
+
+  /// Merged state of a Histogram. Bucket 0 counts the zeros, bucket i > 0
+  /// counts the values in [2^(i-1), 2^i).
+  struct HistogramSnapshot {
+
+    static constexpr size_t NumberOfBuckets = 65u;
+
+    uint64_t count = 0u;
+
+    uint64_t sum = 0u;
+
+    uint64_t max = 0u;
+
+    std::array<uint64_t, NumberOfBuckets> buckets{};
+
+    double GetMean() const {
+      return count > 0u ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+
+    /// Upper bound of the bucket containing the @a percentile (in [0, 1]) of
+    /// the recorded values, never greater than max.
+    uint64_t GetPercentile(double percentile) const;
+  };
+
+  /// Distribution of unsigned values (usually durations in microseconds) in
+  /// logarithmic buckets.
+  class Histogram : private NonCopyable {
+  public:
+
+    void Record(uint64_t value) {
+      auto &shard = _shards[detail::GetMetricsShardIndex()];
+      shard.count.fetch_add(1u, std::memory_order_relaxed);
+      shard.sum.fetch_add(value, std::memory_order_relaxed);
+      auto max = shard.max.load(std::memory_order_relaxed);
+      while ((value > max) && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+      shard.buckets[GetBucket(value)].fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot GetSnapshot() const;
+
+    void Reset();
+
+    static size_t GetBucket(uint64_t value) {
+      size_t bucket = 0u;
+      for (; value != 0u; value >>= 1u) {
+        ++bucket;
+      }
+      return bucket;
+    }
+
+  private:
+
+    struct Shard {
+      std::atomic<uint64_t> count{0u};
+      std::atomic<uint64_t> sum{0u};
+      std::atomic<uint64_t> max{0u};
+      std::array<std::atomic<uint64_t>, HistogramSnapshot::NumberOfBuckets> buckets{};
+    };
+
+    std::array<Shard, detail::METRICS_NUMBER_OF_SHARDS> _shards;
+  };
+
+  /// Records in @a histogram the microseconds elapsed until it goes out of
+  /// scope.
+  class ScopedMetricsTimer : private NonCopyable {
+  public:
+
+    explicit ScopedMetricsTimer(Histogram &histogram) : _histogram(histogram) {}
+
+    ~ScopedMetricsTimer() {
+      _histogram.Record(static_cast<uint64_t>(
+          _stop_watch.GetElapsedTime<std::chrono::microseconds>()));
+    }
+
+  private:
+
+    Histogram &_histogram;
+
+    StopWatch _stop_watch;
+  };
+
+  /// Values of every registered metric, sorted by name.
+  struct MetricsSnapshot {
+
+    std::vector<std::pair<std::string, uint64_t>> counters;
+
+    std::vector<std::pair<std::string, int64_t>> gauges;
+
+    std::vector<std::pair<std::string, HistogramSnapshot>> histograms;
+  };
+
+  /// Process-wide registry of metrics. Returned references stay valid for the
+  /// lifetime of the process.
+  class Metrics {
+  public:
+
+    static Counter &GetCounter(const std::string &name);
+
+    static Gauge &GetGauge(const std::string &name);
+
+    static Histogram &GetHistogram(const std::string &name);
+
+    static MetricsSnapshot GetSnapshot();
+
+    /// Reset every counter and histogram to zero. Gauges are left untouched
+    /// as they track a current value.
+    static void Reset();
+  };
+
+} // namespace profiler
+} // namespace carla
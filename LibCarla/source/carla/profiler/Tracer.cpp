@@ -0,0 +1,223 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/Tracer.h"
+
+#include "carla/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+namespace detail {
+
+  std::atomic_bool TRACER_IS_ENABLED{false};
+
+  // ===========================================================================
+  // -- TraceBuffer ------------------------------------------------------------
+  // ===========================================================================
+
+  struct TraceEvent {
+    char category[16u];
+    char name[64u];
+    uint64_t begin;
+    uint64_t duration;
+  };
+
+  static void CopyString(char *destination, const char *source, size_t size) {
+    std::strncpy(destination, source, size - 1u);
+    destination[size - 1u] = '\0';
+  }
+
+  /// Ring buffer of the events of a thread. Only the owning thread writes, the
+  /// lock is contended only while dumping.
+  class TraceBuffer : private NonCopyable {
+  public:
+
+    explicit TraceBuffer(size_t thread_id) : _thread_id(thread_id) {}
+
+    size_t GetThreadId() const {
+      return _thread_id;
+    }
+
+    void Record(size_t capacity, const char *category, const char *name, uint64_t begin, uint64_t end) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_events.size() != capacity) {
+        _events.clear();
+        _events.resize(capacity);
+        _next = 0u;
+        _size = 0u;
+      }
+      auto &event = _events[_next];
+      CopyString(event.category, category, sizeof(event.category));
+      CopyString(event.name, name, sizeof(event.name));
+      event.begin = begin;
+      event.duration = end - begin;
+      _next = (_next + 1u) % _events.size();
+      _size = std::min(_size + 1u, _events.size());
+    }
+
+    /// Events in the order they were recorded.
+    std::vector<TraceEvent> GetEvents() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::vector<TraceEvent> result;
+      result.reserve(_size);
+      const size_t first = (_next + _events.size() - _size) % std::max<size_t>(_events.size(), 1u);
+      for (size_t i = 0u; i < _size; ++i) {
+        result.emplace_back(_events[(first + i) % _events.size()]);
+      }
+      return result;
+    }
+
+    void Clear() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _next = 0u;
+      _size = 0u;
+    }
+
+  private:
+
+    const size_t _thread_id;
+
+    mutable std::mutex _mutex;
+
+    std::vector<TraceEvent> _events;
+
+    size_t _next = 0u;
+
+    size_t _size = 0u;
+  };
+
+  // ===========================================================================
+  // -- TraceRegistry ----------------------------------------------------------
+  // ===========================================================================
+
+  class TraceRegistry {
+  public:
+
+    /// Never destroyed, threads may still record events at exit.
+    static TraceRegistry &Get() {
+      static TraceRegistry *REGISTRY = new TraceRegistry;
+      return *REGISTRY;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::atomic_size_t capacity{0u};
+
+    /// Buffer of the calling thread, created on first use. Buffers outlive
+    /// their threads so their events can still be dumped.
+    TraceBuffer &GetThreadBuffer() {
+      static thread_local std::shared_ptr<TraceBuffer> BUFFER;
+      if (BUFFER == nullptr) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        BUFFER = std::make_shared<TraceBuffer>(_buffers.size() + 1u);
+        _buffers.emplace_back(BUFFER);
+      }
+      return *BUFFER;
+    }
+
+    std::vector<std::shared_ptr<TraceBuffer>> GetBuffers() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _buffers;
+    }
+
+  private:
+
+    TraceRegistry() = default;
+
+    mutable std::mutex _mutex;
+
+    std::vector<std::shared_ptr<TraceBuffer>> _buffers;
+  };
+
+  uint64_t GetTraceTime() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - TraceRegistry::Get().start).count());
+  }
+
+  void RecordTraceEvent(const char *category, const char *name, uint64_t begin, uint64_t end) {
+    auto &registry = TraceRegistry::Get();
+    const size_t capacity = registry.capacity;
+    if (capacity > 0u) {
+      registry.GetThreadBuffer().Record(capacity, category, name, begin, end);
+    }
+  }
+
+  static void WriteJsonString(std::ostream &out, const char *str) {
+    out << '"';
+    for (; *str != '\0'; ++str) {
+      const char c = *str;
+      if ((c == '"') || (c == '\\')) {
+        out << '\\' << c;
+      } else if (static_cast<unsigned char>(c) >= 0x20u) {
+        out << c;
+      }
+    }
+    out << '"';
+  }
+
+} // namespace detail
+
+  // ===========================================================================
+  // -- Tracer -----------------------------------------------------------------
+  // ===========================================================================
+
+  void Tracer::Enable(const size_t events_per_thread) {
+    if (events_per_thread == 0u) {
+      throw_exception(std::invalid_argument("tracer needs room for at least one event per thread"));
+    }
+    auto &registry = detail::TraceRegistry::Get();
+    registry.capacity = events_per_thread;
+    Clear();
+    detail::TRACER_IS_ENABLED = true;
+  }
+
+  void Tracer::Disable() {
+    detail::TRACER_IS_ENABLED = false;
+  }
+
+  void Tracer::Clear() {
+    for (auto &&buffer : detail::TraceRegistry::Get().GetBuffers()) {
+      buffer->Clear();
+    }
+  }
+
+  void Tracer::WriteChromeTrace(std::ostream &out) {
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto &&buffer : detail::TraceRegistry::Get().GetBuffers()) {
+      for (auto &&event : buffer->GetEvents()) {
+        out << (first ? "\n" : ",\n") << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->GetThreadId()
+            << ",\"ts\":" << event.begin
+            << ",\"dur\":" << event.duration
+            << ",\"cat\":";
+        detail::WriteJsonString(out, event.category);
+        out << ",\"name\":";
+        detail::WriteJsonString(out, event.name);
+        out << '}';
+        first = false;
+      }
+    }
+    out << "\n]}\n";
+  }
+
+  void Tracer::SaveChromeTrace(const std::string &path) {
+    std::ofstream out(path);
+    if (!out.good()) {
+      throw_exception(std::runtime_error("failed to open " + path + " for writing"));
+    }
+    WriteChromeTrace(out);
+  }
+
+} // namespace profiler
+} // namespace carla
@@ -0,0 +1,106 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace carla {
+namespace profiler {
+
+  // ===========================================================================
+  // -- Tracer -----------------------------------------------------------------
+  // ===========================================================================
+  //
+  // Opt-in timeline of the client. While enabled, every traced scope records
+  // an event with its thread, begin time and duration into a ring buffer of
+  // the calling thread (oldest events are overwritten). The events can be
+  // dumped in Chrome's trace event format, to be opened in chrome://tracing
+  // or Perfetto. While disabled, a traced scope costs a relaxed atomic load.
+
+namespace detail {
+
+  extern std::atomic_bool TRACER_IS_ENABLED;
+
+  /// Microseconds since the process started tracing.
+  uint64_t GetTraceTime();
+
+  void RecordTraceEvent(const char *category, const char *name, uint64_t begin, uint64_t end);
+
+} // namespace detail
+
+  class Tracer {
+  public:
+
+    /// Start recording events, keeping the last @a events_per_thread events
+    /// of each thread. Previously recorded events are discarded.
+    static void Enable(size_t events_per_thread = 16384u);
+
+    /// Stop recording events, the events recorded can still be dumped.
+    static void Disable();
+
+    static bool IsEnabled() {
+      return detail::TRACER_IS_ENABLED.load(std::memory_order_relaxed);
+    }
+
+    /// Discard every recorded event.
+    static void Clear();
+
+    /// Write the recorded events as a Chrome trace event JSON object.
+    static void WriteChromeTrace(std::ostream &out);
+
+    /// Write the recorded events as a Chrome trace event JSON file.
+    static void SaveChromeTrace(const std::string &path);
+  };
+
+  /// Records an event spanning the lifetime of this object if tracing is
+  /// enabled on construction. @a category and @a name must outlive this
+  /// object, they are copied when the event is recorded (names longer than 63
+  /// characters are truncated).
+  class ScopedTrace : private NonCopyable {
+  public:
+
+    ScopedTrace(const char *category, const char *name)
+      : _is_enabled(Tracer::IsEnabled()),
+        _category(category),
+        _name(name),
+        _begin(_is_enabled ? detail::GetTraceTime() : 0u) {}
+
+    ScopedTrace(const char *category, const std::string &name)
+      : ScopedTrace(category, name.c_str()) {}
+
+    ~ScopedTrace() {
+      if (_is_enabled) {
+        detail::RecordTraceEvent(_category, _name, _begin, detail::GetTraceTime());
+      }
+    }
+
+  private:
+
+    const bool _is_enabled;
+
+    const char *_category;
+
+    const char *_name;
+
+    const uint64_t _begin;
+  };
+
+} // namespace profiler
+} // namespace carla
+
+#define CARLA_TRACE_CONCAT_(a, b) a##b
+#define CARLA_TRACE_CONCAT(a, b) CARLA_TRACE_CONCAT_(a, b)
+
+/// Trace the enclosing scope as @a name under @a category.
+#define CARLA_TRACE_SCOPE(category, name) \
+    ::carla::profiler::ScopedTrace CARLA_TRACE_CONCAT(carla_trace_scope_, __LINE__)(#category, name)
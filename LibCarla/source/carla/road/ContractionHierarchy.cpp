@@ -0,0 +1,628 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/ContractionHierarchy.h"
+
+#include "carla/Exception.h"
+#include "carla/road/RoutingSearchSpace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace carla {
+namespace road {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  static constexpr char CH_MAGIC[8u] = {'C', 'A', 'R', 'L', 'A', 'C', 'H', 'I'};
+
+  static constexpr uint32_t CH_VERSION = 1u;
+
+  /// Maximum number of lanes settled by a witness search. Stopping early only
+  /// adds unnecessary shortcuts, never wrong ones.
+  static constexpr size_t MAX_WITNESS_SETTLED_NODES = 500u;
+
+  static constexpr double INF = std::numeric_limits<double>::infinity();
+
+  /// FNV-1a hash of the lanes and edges of @a graph.
+  static uint64_t ComputeFingerprint(const RoutingGraph &graph) {
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const auto &value) {
+      unsigned char bytes[sizeof(value)];
+      std::memcpy(bytes, &value, sizeof(value));
+      for (auto byte : bytes) {
+        hash = (hash ^ byte) * 1099511628211ull;
+      }
+    };
+    add(static_cast<uint64_t>(graph.GetNumberOfLanes()));
+    for (RoutingGraph::node_id_type id = 0u; id < graph.GetNumberOfLanes(); ++id) {
+      const auto &lane = graph.GetLane(id);
+      add(static_cast<uint64_t>(lane.road_id));
+      add(static_cast<int32_t>(lane.lane_id));
+      for (auto &&edge : graph.GetSuccessors(id)) {
+        add(edge.node);
+        add(edge.cost);
+        add(static_cast<int8_t>(edge.option));
+      }
+    }
+    return hash;
+  }
+
+  // ===========================================================================
+  // -- ContractionHierarchyBuilder --------------------------------------------
+  // ===========================================================================
+
+  /// Contracts the lanes of a routing graph in order of importance, estimated
+  /// by the edge difference (shortcuts added minus edges removed), the number
+  /// of neighbours already contracted, and the depth in the hierarchy.
+  class ContractionHierarchyBuilder : private NonCopyable {
+  public:
+
+    using node_id_type = ContractionHierarchy::node_id_type;
+
+    using Edge = ContractionHierarchy::Edge;
+
+    explicit ContractionHierarchyBuilder(const RoutingGraph &graph)
+      : _out(graph.GetNumberOfLanes()),
+        _in(graph.GetNumberOfLanes()),
+        _contracted(graph.GetNumberOfLanes(), false),
+        _contracted_neighbours(graph.GetNumberOfLanes(), 0u),
+        _levels(graph.GetNumberOfLanes(), 0u),
+        _witness(graph.GetNumberOfLanes()) {
+      for (node_id_type id = 0u; id < graph.GetNumberOfLanes(); ++id) {
+        for (auto &&edge : graph.GetSuccessors(id)) {
+          if (edge.node != id) {
+            AddEdge(id, edge.node, edge.cost, edge.node, edge.option);
+          }
+        }
+      }
+    }
+
+    void Build(ContractionHierarchy &result) {
+      const auto size = static_cast<node_id_type>(_out.size());
+      std::vector<std::pair<int, node_id_type>> queue;
+      queue.reserve(size);
+      for (node_id_type id = 0u; id < size; ++id) {
+        queue.emplace_back(ComputePriority(id), id);
+      }
+      std::make_heap(queue.begin(), queue.end(), std::greater<>());
+
+      result._ranks.assign(size, 0u);
+      uint32_t rank = 0u;
+      while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        const auto id = queue.back().second;
+        queue.pop_back();
+        // Lazy update, the priority may have changed since it was queued.
+        const auto priority = ComputePriority(id);
+        if (!queue.empty() && (priority > queue.front().first)) {
+          queue.emplace_back(priority, id);
+          std::push_heap(queue.begin(), queue.end(), std::greater<>());
+          continue;
+        }
+        Contract(id);
+        result._ranks[id] = rank++;
+      }
+
+      // Every edge connects a lane with a lane contracted after it, or the
+      // other way around.
+      std::vector<std::pair<node_id_type, Edge>> up;
+      std::vector<std::pair<node_id_type, Edge>> down;
+      for (node_id_type from = 0u; from < size; ++from) {
+        for (auto &&edge : _out[from]) {
+          if (result._ranks[edge.node] > result._ranks[from]) {
+            up.emplace_back(from, edge);
+          } else {
+            down.emplace_back(edge.node, Edge{from, edge.middle, edge.cost, edge.option});
+          }
+        }
+      }
+      MakeCompressedSparseRows(size, std::move(up), result._up_offsets, result._up_edges);
+      MakeCompressedSparseRows(size, std::move(down), result._down_offsets, result._down_edges);
+    }
+
+  private:
+
+    static void MakeCompressedSparseRows(
+        const size_t size,
+        std::vector<std::pair<node_id_type, Edge>> edges,
+        std::vector<uint32_t> &offsets,
+        std::vector<Edge> &result) {
+      std::stable_sort(edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first < rhs.first;
+      });
+      offsets.assign(size + 1u, 0u);
+      result.clear();
+      result.reserve(edges.size());
+      for (auto &&pair : edges) {
+        ++offsets[pair.first + 1u];
+        result.emplace_back(pair.second);
+      }
+      for (auto i = 1u; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1u];
+      }
+    }
+
+    /// Add an edge, or lower the cost of the existing one.
+    void AddEdge(
+        node_id_type from,
+        node_id_type to,
+        double cost,
+        node_id_type middle,
+        RoadOption option) {
+      auto find = [](std::vector<Edge> &edges, node_id_type node) {
+        return std::find_if(edges.begin(), edges.end(), [=](const Edge &edge) {
+          return edge.node == node;
+        });
+      };
+      auto out = find(_out[from], to);
+      if (out == _out[from].end()) {
+        _out[from].emplace_back(Edge{to, middle, cost, option});
+        _in[to].emplace_back(Edge{from, middle, cost, option});
+      } else if (cost < out->cost) {
+        *out = Edge{to, middle, cost, option};
+        *find(_in[to], from) = Edge{from, middle, cost, option};
+      }
+    }
+
+    /// Search from @a source avoiding @a ignored and the contracted lanes,
+    /// up to @a max_cost; the costs are left in the witness search space.
+    void RunWitnessSearch(node_id_type source, node_id_type ignored, double max_cost) {
+      _witness.Reset();
+      _witness.Relax(source, 0.0, source, RoadOption::Void, 0.0);
+      size_t settled = 0u;
+      while (!_witness.empty() && (settled < MAX_WITNESS_SETTLED_NODES)) {
+        const auto top = _witness.Pop();
+        const auto id = top.second;
+        if (top.first > _witness.GetCost(id)) {
+          continue;
+        }
+        if (top.first > max_cost) {
+          break;
+        }
+        ++settled;
+        for (auto &&edge : _out[id]) {
+          if ((edge.node != ignored) && !_contracted[edge.node]) {
+            const auto cost = top.first + edge.cost;
+            _witness.Relax(edge.node, cost, id, RoadOption::Void, cost);
+          }
+        }
+      }
+    }
+
+    /// Call @a callback for each shortcut needed to contract @a id.
+    template <typename FuncT>
+    void ForEachShortcut(node_id_type id, FuncT &&callback) {
+      double max_out_cost = 0.0;
+      for (auto &&out : _out[id]) {
+        if (!_contracted[out.node]) {
+          max_out_cost = std::max(max_out_cost, out.cost);
+        }
+      }
+      for (auto &&in : _in[id]) {
+        if (_contracted[in.node]) {
+          continue;
+        }
+        RunWitnessSearch(in.node, id, in.cost + max_out_cost);
+        for (auto &&out : _out[id]) {
+          if (_contracted[out.node] || (out.node == in.node)) {
+            continue;
+          }
+          const auto cost = in.cost + out.cost;
+          if (_witness.GetCost(out.node) > cost) {
+            callback(in.node, out.node, cost);
+          }
+        }
+      }
+    }
+
+    int ComputePriority(node_id_type id) {
+      int shortcuts = 0;
+      ForEachShortcut(id, [&](node_id_type, node_id_type, double) { ++shortcuts; });
+      auto count_active = [this](const std::vector<Edge> &edges) {
+        return static_cast<int>(std::count_if(edges.begin(), edges.end(), [this](const Edge &edge) {
+          return !_contracted[edge.node];
+        }));
+      };
+      const int removed = count_active(_out[id]) + count_active(_in[id]);
+      return 2 * (shortcuts - removed) + static_cast<int>(_contracted_neighbours[id]) + static_cast<int>(_levels[id]);
+    }
+
+    void Contract(node_id_type id) {
+      std::vector<std::tuple<node_id_type, node_id_type, double>> shortcuts;
+      ForEachShortcut(id, [&](node_id_type from, node_id_type to, double cost) {
+        shortcuts.emplace_back(from, to, cost);
+      });
+      for (auto &&shortcut : shortcuts) {
+        AddEdge(std::get<0>(shortcut), std::get<1>(shortcut), std::get<2>(shortcut), id, RoadOption::Void);
+      }
+      _contracted[id] = true;
+      for (auto &&edge : _out[id]) {
+        ++_contracted_neighbours[edge.node];
+        _levels[edge.node] = std::max(_levels[edge.node], _levels[id] + 1u);
+      }
+      for (auto &&edge : _in[id]) {
+        ++_contracted_neighbours[edge.node];
+        _levels[edge.node] = std::max(_levels[edge.node], _levels[id] + 1u);
+      }
+    }
+
+    std::vector<std::vector<Edge>> _out;
+
+    std::vector<std::vector<Edge>> _in;
+
+    std::vector<bool> _contracted;
+
+    std::vector<uint32_t> _contracted_neighbours;
+
+    /// Length of the longest chain of contracted lanes below each lane.
+    std::vector<uint32_t> _levels;
+
+    RoutingSearchSpace _witness;
+  };
+
+  // ===========================================================================
+  // -- ContractionHierarchy ---------------------------------------------------
+  // ===========================================================================
+
+  ContractionHierarchy::ContractionHierarchy(const RoutingGraph &graph)
+    : _fingerprint(ComputeFingerprint(graph)) {
+    ContractionHierarchyBuilder builder(graph);
+    builder.Build(*this);
+  }
+
+  template <typename T>
+  static void WriteValue(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  template <typename T>
+  static void ReadValue(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+  }
+
+  template <typename EdgeT>
+  static void WriteEdges(
+      std::ostream &out,
+      const std::vector<uint32_t> &offsets,
+      const std::vector<EdgeT> &edges) {
+    WriteValue(out, static_cast<uint32_t>(edges.size()));
+    out.write(
+        reinterpret_cast<const char *>(offsets.data()),
+        static_cast<std::streamsize>(sizeof(uint32_t) * offsets.size()));
+    for (auto &&edge : edges) {
+      WriteValue(out, edge.node);
+      WriteValue(out, edge.middle);
+      WriteValue(out, edge.cost);
+      WriteValue(out, static_cast<int8_t>(edge.option));
+    }
+  }
+
+  template <typename EdgeT>
+  static void ReadEdges(
+      std::istream &in,
+      const size_t size,
+      std::vector<uint32_t> &offsets,
+      std::vector<EdgeT> &edges) {
+    uint32_t number_of_edges = 0u;
+    ReadValue(in, number_of_edges);
+    offsets.resize(size + 1u);
+    in.read(
+        reinterpret_cast<char *>(offsets.data()),
+        static_cast<std::streamsize>(sizeof(uint32_t) * offsets.size()));
+    if (!in || (offsets.back() != number_of_edges)) {
+      return;
+    }
+    edges.resize(number_of_edges);
+    for (auto &edge : edges) {
+      int8_t option;
+      ReadValue(in, edge.node);
+      ReadValue(in, edge.middle);
+      ReadValue(in, edge.cost);
+      ReadValue(in, option);
+      edge.option = static_cast<RoadOption>(option);
+      if (!in || (edge.node >= size) || (edge.middle >= size)) {
+        in.setstate(std::ios::failbit);
+        return;
+      }
+    }
+  }
+
+  void ContractionHierarchy::Save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+      throw_exception(std::invalid_argument("cannot open " + path + " for writing"));
+    }
+    out.write(CH_MAGIC, sizeof(CH_MAGIC));
+    WriteValue(out, CH_VERSION);
+    WriteValue(out, static_cast<uint32_t>(_ranks.size()));
+    WriteValue(out, _fingerprint);
+    out.write(
+        reinterpret_cast<const char *>(_ranks.data()),
+        static_cast<std::streamsize>(sizeof(uint32_t) * _ranks.size()));
+    WriteEdges(out, _up_offsets, _up_edges);
+    WriteEdges(out, _down_offsets, _down_edges);
+    if (!out) {
+      throw_exception(std::runtime_error("failed to write contraction hierarchy " + path));
+    }
+  }
+
+  ContractionHierarchy ContractionHierarchy::Load(
+      const std::string &path,
+      const RoutingGraph &graph) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+      throw_exception(std::invalid_argument("cannot open contraction hierarchy " + path));
+    }
+    char magic[sizeof(CH_MAGIC)];
+    uint32_t version = 0u;
+    uint32_t size = 0u;
+    ContractionHierarchy result;
+    in.read(magic, sizeof(magic));
+    ReadValue(in, version);
+    ReadValue(in, size);
+    ReadValue(in, result._fingerprint);
+    if (!in || (std::memcmp(magic, CH_MAGIC, sizeof(CH_MAGIC)) != 0) || (version != CH_VERSION)) {
+      throw_exception(std::invalid_argument(path + " is not a contraction hierarchy"));
+    }
+    if ((size != graph.GetNumberOfLanes()) || (result._fingerprint != ComputeFingerprint(graph))) {
+      throw_exception(std::invalid_argument(path + " was built for a different map"));
+    }
+    result._ranks.resize(size);
+    in.read(
+        reinterpret_cast<char *>(result._ranks.data()),
+        static_cast<std::streamsize>(sizeof(uint32_t) * size));
+    ReadEdges(in, size, result._up_offsets, result._up_edges);
+    ReadEdges(in, size, result._down_offsets, result._down_edges);
+    if (!in) {
+      throw_exception(std::invalid_argument(path + ": corrupted contraction hierarchy"));
+    }
+    return result;
+  }
+
+  void ContractionHierarchy::CheckNode(const node_id_type id) const {
+    if (id >= _ranks.size()) {
+      throw_exception(std::out_of_range("contraction hierarchy: invalid lane"));
+    }
+  }
+
+  double ContractionHierarchy::GetDistance(
+      const node_id_type origin,
+      const node_id_type destination) const {
+    CheckNode(origin);
+    CheckNode(destination);
+    RoutingSearchSpace forward(_ranks.size());
+    RoutingSearchSpace backward(_ranks.size());
+    node_id_type meeting_node;
+    return Search(forward, backward, origin, destination, meeting_node);
+  }
+
+  ContractionHierarchy::Route ContractionHierarchy::FindRoute(
+      const node_id_type origin,
+      const node_id_type destination) const {
+    CheckNode(origin);
+    CheckNode(destination);
+    RoutingSearchSpace forward(_ranks.size());
+    RoutingSearchSpace backward(_ranks.size());
+    return FindRoute(forward, backward, origin, destination);
+  }
+
+  std::vector<ContractionHierarchy::Route> ContractionHierarchy::FindRoutes(
+      const std::vector<std::pair<node_id_type, node_id_type>> &queries) const {
+    for (auto &&query : queries) {
+      CheckNode(query.first);
+      CheckNode(query.second);
+    }
+    RoutingSearchSpace forward(_ranks.size());
+    RoutingSearchSpace backward(_ranks.size());
+    std::vector<Route> result;
+    result.reserve(queries.size());
+    for (auto &&query : queries) {
+      result.emplace_back(FindRoute(forward, backward, query.first, query.second));
+    }
+    return result;
+  }
+
+  std::vector<double> ContractionHierarchy::GetDistanceTable(
+      const std::vector<node_id_type> &origins,
+      const std::vector<node_id_type> &destinations) const {
+    for (auto id : origins) {
+      CheckNode(id);
+    }
+    for (auto id : destinations) {
+      CheckNode(id);
+    }
+    RoutingSearchSpace space(_ranks.size());
+
+    // Bucket the full upward search space of each destination by lane.
+    struct BucketEntry {
+      node_id_type node;
+      uint32_t column;
+      double cost;
+    };
+    std::vector<BucketEntry> buckets;
+    for (auto column = 0u; column < destinations.size(); ++column) {
+      space.Reset();
+      space.Relax(destinations[column], 0.0, destinations[column], RoadOption::Void, 0.0);
+      while (!space.empty()) {
+        const auto top = space.Pop();
+        if (top.first > space.GetCost(top.second)) {
+          continue;
+        }
+        buckets.emplace_back(BucketEntry{top.second, column, top.first});
+        for (auto i = _down_offsets[top.second]; i < _down_offsets[top.second + 1u]; ++i) {
+          const auto &edge = _down_edges[i];
+          const auto cost = top.first + edge.cost;
+          space.Relax(edge.node, cost, top.second, RoadOption::Void, cost);
+        }
+      }
+    }
+    std::sort(buckets.begin(), buckets.end(), [](const BucketEntry &lhs, const BucketEntry &rhs) {
+      return lhs.node < rhs.node;
+    });
+
+    // Meet them with the upward search space of each origin.
+    std::vector<double> result(origins.size() * destinations.size(), INF);
+    for (auto row = 0u; row < origins.size(); ++row) {
+      auto *distances = result.data() + row * destinations.size();
+      space.Reset();
+      space.Relax(origins[row], 0.0, origins[row], RoadOption::Void, 0.0);
+      while (!space.empty()) {
+        const auto top = space.Pop();
+        if (top.first > space.GetCost(top.second)) {
+          continue;
+        }
+        auto range = std::equal_range(
+            buckets.begin(),
+            buckets.end(),
+            BucketEntry{top.second, 0u, 0.0},
+            [](const BucketEntry &lhs, const BucketEntry &rhs) { return lhs.node < rhs.node; });
+        for (auto it = range.first; it != range.second; ++it) {
+          distances[it->column] = std::min(distances[it->column], top.first + it->cost);
+        }
+        for (auto i = _up_offsets[top.second]; i < _up_offsets[top.second + 1u]; ++i) {
+          const auto &edge = _up_edges[i];
+          const auto cost = top.first + edge.cost;
+          space.Relax(edge.node, cost, top.second, RoadOption::Void, cost);
+        }
+      }
+    }
+    return result;
+  }
+
+  double ContractionHierarchy::Search(
+      RoutingSearchSpace &forward,
+      RoutingSearchSpace &backward,
+      const node_id_type origin,
+      const node_id_type destination,
+      node_id_type &meeting_node) const {
+    forward.Reset();
+    backward.Reset();
+    forward.Relax(origin, 0.0, origin, RoadOption::LaneFollow, 0.0);
+    backward.Relax(destination, 0.0, destination, RoadOption::LaneFollow, 0.0);
+    auto best_cost = INF;
+    meeting_node = origin;
+
+    auto expand = [&](
+        RoutingSearchSpace &space,
+        const RoutingSearchSpace &other,
+        const std::vector<uint32_t> &offsets,
+        const std::vector<Edge> &edges,
+        const std::vector<uint32_t> &reverse_offsets,
+        const std::vector<Edge> &reverse_edges) {
+      const auto top = space.Pop();
+      const auto id = top.second;
+      if (top.first > space.GetCost(id)) {
+        return;
+      }
+      const auto total_cost = top.first + other.GetCost(id);
+      if (total_cost < best_cost) {
+        best_cost = total_cost;
+        meeting_node = id;
+      }
+      // Stall on demand: if a higher ranked lane already reached offers a
+      // cheaper way to this lane, this is not the cheapest route to it and
+      // there is no need to continue from here.
+      for (auto i = reverse_offsets[id]; i < reverse_offsets[id + 1u]; ++i) {
+        const auto &edge = reverse_edges[i];
+        if (space.GetCost(edge.node) + edge.cost < top.first) {
+          return;
+        }
+      }
+      for (auto i = offsets[id]; i < offsets[id + 1u]; ++i) {
+        const auto &edge = edges[i];
+        const auto cost = top.first + edge.cost;
+        space.Relax(edge.node, cost, id, edge.option, cost);
+      }
+    };
+
+    // Both searches only go upwards, each one has to continue until it
+    // cannot improve the best route found.
+    for (;;) {
+      const bool forward_open = !forward.empty() && (forward.GetTopPriority() < best_cost);
+      const bool backward_open = !backward.empty() && (backward.GetTopPriority() < best_cost);
+      if (forward_open && (!backward_open || (forward.GetTopPriority() <= backward.GetTopPriority()))) {
+        expand(forward, backward, _up_offsets, _up_edges, _down_offsets, _down_edges);
+      } else if (backward_open) {
+        expand(backward, forward, _down_offsets, _down_edges, _up_offsets, _up_edges);
+      } else {
+        break;
+      }
+    }
+    return best_cost;
+  }
+
+  ContractionHierarchy::Route ContractionHierarchy::FindRoute(
+      RoutingSearchSpace &forward,
+      RoutingSearchSpace &backward,
+      const node_id_type origin,
+      const node_id_type destination) const {
+    node_id_type meeting_node;
+    const auto cost = Search(forward, backward, origin, destination, meeting_node);
+    Route route;
+    if (cost == INF) {
+      return route;
+    }
+    route.cost = cost;
+    route.lanes.emplace_back(origin);
+    route.options.emplace_back(RoadOption::LaneFollow);
+    // Lanes of the hierarchy from the origin up to the meeting lane, and down
+    // to the destination.
+    std::vector<node_id_type> path;
+    for (auto id = meeting_node; id != origin; id = forward.GetParent(id)) {
+      path.emplace_back(id);
+    }
+    path.emplace_back(origin);
+    std::reverse(path.begin(), path.end());
+    for (auto id = meeting_node; id != destination; id = backward.GetParent(id)) {
+      path.emplace_back(backward.GetParent(id));
+    }
+    for (auto i = 1u; i < path.size(); ++i) {
+      Unpack(path[i - 1u], path[i], route);
+    }
+    return route;
+  }
+
+  const ContractionHierarchy::Edge &ContractionHierarchy::GetEdge(
+      const node_id_type from,
+      const node_id_type to) const {
+    // Upward edges are stored in the source, downward edges in the target.
+    const bool is_up = _ranks[to] > _ranks[from];
+    const auto &offsets = is_up ? _up_offsets : _down_offsets;
+    const auto &edges = is_up ? _up_edges : _down_edges;
+    const auto owner = is_up ? from : to;
+    const auto other = is_up ? to : from;
+    for (auto i = offsets[owner]; i < offsets[owner + 1u]; ++i) {
+      if (edges[i].node == other) {
+        return edges[i];
+      }
+    }
+    throw_exception(std::logic_error("contraction hierarchy: missing edge"));
+  }
+
+  void ContractionHierarchy::Unpack(
+      const node_id_type from,
+      const node_id_type to,
+      Route &route) const {
+    const auto &edge = GetEdge(from, to);
+    if (edge.middle == to) {
+      route.lanes.emplace_back(to);
+      route.options.emplace_back(edge.option);
+    } else {
+      Unpack(from, edge.middle, route);
+      Unpack(edge.middle, to, route);
+    }
+  }
+
+} // namespace road
+} // namespace carla
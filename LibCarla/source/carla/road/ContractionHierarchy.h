@@ -0,0 +1,126 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/road/RoutingGraph.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Contraction hierarchy of a RoutingGraph, a precomputed index for
+  /// answering many route queries over the same road network.
+  ///
+  /// The lanes are ranked and contracted one by one, adding shortcut edges
+  /// to preserve the cost of the cheapest routes. Queries only explore edges
+  /// towards higher ranked lanes, settling a few dozen lanes regardless of
+  /// the distance between origin and destination.
+  ///
+  /// The index can be saved to disk and loaded back, it is validated against
+  /// a fingerprint of the routing graph it was built from.
+  ///
+  /// Queries do not modify the hierarchy, it can be queried from several
+  /// threads at the same time.
+  class ContractionHierarchy : private MovableNonCopyable {
+  public:
+
+    using node_id_type = RoutingGraph::node_id_type;
+
+    using Route = RoutingGraph::Route;
+
+    /// Preprocess @a graph.
+    explicit ContractionHierarchy(const RoutingGraph &graph);
+
+    /// Load a hierarchy saved with Save. Throw std::invalid_argument if the
+    /// file is not a contraction hierarchy of @a graph.
+    static ContractionHierarchy Load(const std::string &path, const RoutingGraph &graph);
+
+    void Save(const std::string &path) const;
+
+    size_t GetNumberOfLanes() const {
+      return _ranks.size();
+    }
+
+    /// Number of edges of the search graphs, including the shortcuts.
+    size_t GetNumberOfEdges() const {
+      return _up_edges.size() + _down_edges.size();
+    }
+
+    /// Cost of the cheapest route from @a origin to @a destination, infinity
+    /// if the destination cannot be reached.
+    double GetDistance(node_id_type origin, node_id_type destination) const;
+
+    /// Compute the cheapest route from @a origin to @a destination. Same
+    /// result as RoutingGraph::FindRoute, except for ties between routes of
+    /// equal cost.
+    Route FindRoute(node_id_type origin, node_id_type destination) const;
+
+    /// Compute the routes of every origin-destination pair in @a queries.
+    std::vector<Route> FindRoutes(
+        const std::vector<std::pair<node_id_type, node_id_type>> &queries) const;
+
+    /// Cost of the cheapest route between every origin and every
+    /// destination, in row-major order (one row per origin).
+    std::vector<double> GetDistanceTable(
+        const std::vector<node_id_type> &origins,
+        const std::vector<node_id_type> &destinations) const;
+
+  private:
+
+    friend class ContractionHierarchyBuilder;
+
+    struct Edge {
+      node_id_type node;
+      /// Lane bypassed by a shortcut, or the target lane if it is an edge of
+      /// the routing graph.
+      node_id_type middle;
+      double cost;
+      RoadOption option;
+    };
+
+    ContractionHierarchy() = default;
+
+    void CheckNode(node_id_type id) const;
+
+    double Search(
+        RoutingSearchSpace &forward,
+        RoutingSearchSpace &backward,
+        node_id_type origin,
+        node_id_type destination,
+        node_id_type &meeting_node) const;
+
+    Route FindRoute(
+        RoutingSearchSpace &forward,
+        RoutingSearchSpace &backward,
+        node_id_type origin,
+        node_id_type destination) const;
+
+    const Edge &GetEdge(node_id_type from, node_id_type to) const;
+
+    void Unpack(node_id_type from, node_id_type to, Route &route) const;
+
+    uint64_t _fingerprint = 0u;
+
+    std::vector<uint32_t> _ranks;
+
+    /// Edges from each lane to higher ranked lanes.
+    std::vector<uint32_t> _up_offsets;
+
+    std::vector<Edge> _up_edges;
+
+    /// Edges into each lane from higher ranked lanes, Edge::node is the source.
+    std::vector<uint32_t> _down_offsets;
+
+    std::vector<Edge> _down_edges;
+  };
+
+} // namespace road
+} // namespace carla
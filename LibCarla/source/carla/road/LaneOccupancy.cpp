@@ -0,0 +1,264 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/LaneOccupancy.h"
+
+#include "carla/TaskExecutor.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Minimum number of vehicles queried by each task in a batch query.
+  static constexpr size_t MIN_QUERIES_PER_TASK = 32u;
+
+  // ===========================================================================
+  // -- LaneOccupancy ----------------------------------------------------------
+  // ===========================================================================
+
+  LaneOccupancy::LaneOccupancy(SharedPtr<const Map> map)
+    : _map(std::move(map)),
+      _tracker(_map) {}
+
+  uint64_t LaneOccupancy::GetLaneKey(const id_type road_id, const int lane_id) {
+    return (static_cast<uint64_t>(road_id) << 32u) | static_cast<uint32_t>(lane_id);
+  }
+
+  void LaneOccupancy::Sort(LaneIndex &index) {
+    for (auto &&lane : index) {
+      std::sort(lane.second.begin(), lane.second.end(), [](const Entry &lhs, const Entry &rhs) {
+        return lhs.s < rhs.s;
+      });
+    }
+  }
+
+  void LaneOccupancy::Update(
+      const std::vector<Vehicle> &vehicles,
+      const std::vector<TrafficLight> &traffic_lights) {
+    std::unordered_set<ActorId> alive;
+    std::vector<std::pair<ActorId, geom::Location>> locations;
+    locations.reserve(vehicles.size());
+    for (auto &&vehicle : vehicles) {
+      alive.emplace(vehicle.id);
+      locations.emplace_back(vehicle.id, vehicle.location);
+    }
+    for (auto &&vehicle : _vehicles) {
+      if (alive.find(vehicle.first) == alive.end()) {
+        _tracker.Remove(vehicle.first);
+      }
+    }
+    const auto waypoints = _tracker.Update(locations);
+
+    _vehicles.clear();
+    _vehicle_index.clear();
+    for (auto i = 0u; i < vehicles.size(); ++i) {
+      if (!waypoints[i].has_value()) {
+        continue;
+      }
+      const auto &waypoint = *waypoints[i];
+      _vehicles.emplace(vehicles[i].id, ProjectedVehicle{waypoint, vehicles[i].traffic_light_id});
+      _vehicle_index[GetLaneKey(waypoint._road_id, waypoint._lane_id)].push_back(
+          {waypoint._dist, vehicles[i].id});
+    }
+    Sort(_vehicle_index);
+
+    _traffic_light_states.clear();
+    _traffic_light_index.clear();
+    for (auto &&traffic_light : traffic_lights) {
+      _traffic_light_states.emplace(traffic_light.id, traffic_light.state);
+      auto it = _traffic_light_waypoints.find(traffic_light.id);
+      if (it == _traffic_light_waypoints.end()) {
+        it = _traffic_light_waypoints.emplace(
+            traffic_light.id,
+            _map->GetClosestWaypointOnRoad(traffic_light.location)).first;
+      }
+      if (it->second.has_value()) {
+        const auto &waypoint = *it->second;
+        _traffic_light_index[GetLaneKey(waypoint._road_id, waypoint._lane_id)].push_back(
+            {waypoint._dist, traffic_light.id});
+      }
+    }
+    Sort(_traffic_light_index);
+  }
+
+  const LaneOccupancy::Entry *LaneOccupancy::FindFirst(
+      const LaneIndex &index,
+      const uint64_t key,
+      const double s_begin,
+      const double s_end,
+      const bool forward,
+      const ActorId ignore) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+      return nullptr;
+    }
+    const auto &entries = it->second;
+    auto less = [](const Entry &entry, double s) { return entry.s < s; };
+    if (forward) {
+      for (auto entry = std::lower_bound(entries.begin(), entries.end(), s_begin, less);
+           (entry != entries.end()) && (entry->s <= s_end);
+           ++entry) {
+        if (entry->id != ignore) {
+          return &*entry;
+        }
+      }
+    } else {
+      auto end = std::lower_bound(entries.begin(), entries.end(), s_end, less);
+      for (auto entry = std::upper_bound(entries.begin(), entries.end(), s_begin,
+               [](double s, const Entry &entry) { return s < entry.s; });
+           entry != end;) {
+        --entry;
+        if (entry->id != ignore) {
+          return &*entry;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  LaneOccupancy::Hazards LaneOccupancy::Query(
+      const ActorId ego,
+      const double lookahead,
+      const bool expand_branches) const {
+    Hazards result;
+    auto it = _vehicles.find(ego);
+    if (it == _vehicles.end()) {
+      return result;
+    }
+    const auto &start = it->second.waypoint;
+    constexpr auto infinity = std::numeric_limits<double>::infinity();
+    result.vehicle_distance = infinity;
+    result.traffic_light_distance = infinity;
+    if (it->second.traffic_light_id != 0u) {
+      auto state = _traffic_light_states.find(it->second.traffic_light_id);
+      result.traffic_light_id = it->second.traffic_light_id;
+      result.traffic_light_distance = 0.0;
+      if (state != _traffic_light_states.end()) {
+        result.traffic_light_state = state->second;
+      }
+    }
+
+    // Expand the lanes ahead nearest first, so each lane is entered at its
+    // shortest distance.
+    struct Step {
+      id_type road_id;
+      int lane_id;
+      double s;
+      double distance;
+    };
+    auto farther = [](const Step &lhs, const Step &rhs) { return lhs.distance > rhs.distance; };
+    std::vector<Step> pending{{start._road_id, start._lane_id, start._dist, 0.0}};
+    std::unordered_set<uint64_t> visited;
+    const auto &data = _map->GetData();
+    while (!pending.empty()) {
+      std::pop_heap(pending.begin(), pending.end(), farther);
+      const auto step = pending.back();
+      pending.pop_back();
+      // Nothing farther can be closer than what was already found.
+      if (step.distance >= std::min(lookahead, std::max(result.vehicle_distance, result.traffic_light_distance))) {
+        break;
+      }
+      const auto key = GetLaneKey(step.road_id, step.lane_id);
+      const auto road = data.GetRoad(step.road_id);
+      if ((road == nullptr) || !visited.emplace(key).second) {
+        continue;
+      }
+      const bool forward = step.lane_id <= 0;
+      const double length = road->GetLength();
+      const double remaining = lookahead - step.distance;
+      const double s_end = forward ? std::min(length, step.s + remaining) : std::max(0.0, step.s - remaining);
+
+      const auto vehicle = FindFirst(_vehicle_index, key, step.s, s_end, forward, ego);
+      if (vehicle != nullptr) {
+        const auto distance = step.distance + std::abs(vehicle->s - step.s);
+        if (distance < result.vehicle_distance) {
+          result.vehicle_id = vehicle->id;
+          result.vehicle_distance = distance;
+        }
+      }
+      const auto traffic_light = FindFirst(_traffic_light_index, key, step.s, s_end, forward, 0u);
+      if (traffic_light != nullptr) {
+        const auto distance = step.distance + std::abs(traffic_light->s - step.s);
+        if (distance < result.traffic_light_distance) {
+          result.traffic_light_id = traffic_light->id;
+          result.traffic_light_distance = distance;
+          result.traffic_light_state = _traffic_light_states.at(traffic_light->id);
+        }
+      }
+
+      const double lane_end_distance = step.distance + (forward ? length - step.s : step.s);
+      if (lane_end_distance >= lookahead) {
+        continue;
+      }
+      const auto next_lanes = forward ? road->GetNextLane(step.lane_id) : road->GetPrevLane(step.lane_id);
+      std::vector<Step> next_steps;
+      for (auto &&next : next_lanes) {
+        const auto next_road = data.GetRoad(static_cast<id_type>(next.second));
+        if ((next_road == nullptr) || (next.first == 0)) {
+          continue;
+        }
+        const auto s = next.first < 0 ? 0.0 : next_road->GetLength();
+        next_steps.push_back({next_road->GetId(), next.first, s, lane_end_distance});
+      }
+      if (!expand_branches && (next_steps.size() > 1u)) {
+        // Keep only the branch whose exit is closest to the current heading.
+        auto get_exit_direction = [this](id_type road_id, int lane_id, double length) {
+          const Waypoint exit(_map, road_id, lane_id, lane_id <= 0 ? length : 0.0);
+          return geom::Math::GetForwardVector(exit.ComputeTransform().rotation);
+        };
+        const auto direction = get_exit_direction(step.road_id, step.lane_id, length);
+        auto straightest = std::max_element(next_steps.begin(), next_steps.end(),
+            [&](const Step &lhs, const Step &rhs) {
+          const auto lhs_length = data.GetRoad(lhs.road_id)->GetLength();
+          const auto rhs_length = data.GetRoad(rhs.road_id)->GetLength();
+          return geom::Math::Dot2D(direction, get_exit_direction(lhs.road_id, lhs.lane_id, lhs_length)) <
+                 geom::Math::Dot2D(direction, get_exit_direction(rhs.road_id, rhs.lane_id, rhs_length));
+        });
+        next_steps = {*straightest};
+      }
+      for (auto &&next : next_steps) {
+        pending.push_back(next);
+        std::push_heap(pending.begin(), pending.end(), farther);
+      }
+    }
+
+    if (result.vehicle_id == 0u) {
+      result.vehicle_distance = 0.0;
+    }
+    if (result.traffic_light_id == 0u) {
+      result.traffic_light_distance = 0.0;
+    }
+    return result;
+  }
+
+  std::vector<LaneOccupancy::Hazards> LaneOccupancy::Query(
+      const std::vector<ActorId> &egos,
+      const double lookahead,
+      const bool expand_branches) const {
+    std::vector<Hazards> result(egos.size());
+    auto query = [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        result[i] = Query(egos[i], lookahead, expand_branches);
+      }
+    };
+    TaskExecutor::GetDefault().ParallelFor(egos.size(), MIN_QUERIES_PER_TASK, query);
+    return result;
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,129 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/LaneTracker.h"
+#include "carla/road/element/Types.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/TrafficLightState.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+  /// Vehicles and traffic lights of a frame indexed by the lane they are on,
+  /// to find what is ahead of a vehicle along the lanes it can follow.
+  ///
+  /// Vehicles are projected on the driving lanes with a LaneTracker, so
+  /// updating every frame is cheap. Traffic lights are projected once on
+  /// the closest driving lane to their location.
+  class LaneOccupancy : private MovableNonCopyable {
+  public:
+
+    struct Vehicle {
+      ActorId id;
+      geom::Location location;
+      /// Traffic light affecting the vehicle according to the simulator, 0
+      /// if none.
+      ActorId traffic_light_id;
+    };
+
+    struct TrafficLight {
+      ActorId id;
+      geom::Location location;
+      rpc::TrafficLightState state;
+    };
+
+    /// Closest vehicle and traffic light ahead, the ids are 0 if there is
+    /// none within the lookahead distance. Distances are measured along the
+    /// lanes.
+    struct Hazards {
+      ActorId vehicle_id = 0u;
+      double vehicle_distance = 0.0;
+      ActorId traffic_light_id = 0u;
+      double traffic_light_distance = 0.0;
+      rpc::TrafficLightState traffic_light_state = rpc::TrafficLightState::Unknown;
+    };
+
+    explicit LaneOccupancy(SharedPtr<const Map> map);
+
+    /// Replace the actors of the previous update.
+    void Update(const std::vector<Vehicle> &vehicles, const std::vector<TrafficLight> &traffic_lights);
+
+    size_t GetNumberOfVehicles() const {
+      return _vehicles.size();
+    }
+
+    /// Hazards ahead of the vehicle @a ego within @a lookahead meters along
+    /// its lane. Where the lane forks, only the branch closest to going
+    /// straight is followed, unless @a expand_branches is set, in which case
+    /// every lane reachable is searched. The traffic light reported by the
+    /// simulator for @a ego, if any, takes precedence at distance 0. Empty if
+    /// @a ego was not in the last update or is off the driving lanes.
+    Hazards Query(ActorId ego, double lookahead, bool expand_branches = false) const;
+
+    /// Same as above for several vehicles at once, computed in parallel.
+    std::vector<Hazards> Query(
+        const std::vector<ActorId> &egos,
+        double lookahead,
+        bool expand_branches = false) const;
+
+  private:
+
+    struct Entry {
+      double s;
+      ActorId id;
+    };
+
+    struct ProjectedVehicle {
+      element::Waypoint waypoint;
+      ActorId traffic_light_id;
+    };
+
+    /// Actors on each lane sorted by s, keyed by GetLaneKey.
+    using LaneIndex = std::unordered_map<uint64_t, std::vector<Entry>>;
+
+    static uint64_t GetLaneKey(element::id_type road_id, int lane_id);
+
+    static void Sort(LaneIndex &index);
+
+    /// Closest entry of @a index on the lane of @a key in the direction of
+    /// travel, between @a s_begin and @a s_end (in any order).
+    static const Entry *FindFirst(
+        const LaneIndex &index,
+        uint64_t key,
+        double s_begin,
+        double s_end,
+        bool forward,
+        ActorId ignore);
+
+    SharedPtr<const Map> _map;
+
+    LaneTracker _tracker;
+
+    std::unordered_map<ActorId, ProjectedVehicle> _vehicles;
+
+    std::unordered_map<ActorId, rpc::TrafficLightState> _traffic_light_states;
+
+    /// Traffic lights never move, they are projected only once.
+    std::unordered_map<ActorId, boost::optional<element::Waypoint>> _traffic_light_waypoints;
+
+    LaneIndex _vehicle_index;
+
+    LaneIndex _traffic_light_index;
+  };
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,139 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/LanePolylines.h"
+
+#include "carla/Exception.h"
+#include "carla/TaskExecutor.h"
+#include "carla/road/Map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Minimum number of lanes sampled by each task.
+  static constexpr size_t MIN_LANES_PER_TASK = 16u;
+
+  static size_t GetNumberOfSamples(const double length, const double resolution) {
+    return static_cast<size_t>(std::ceil(length / resolution)) + 1u;
+  }
+
+  // ===========================================================================
+  // -- LanePolylines ----------------------------------------------------------
+  // ===========================================================================
+
+  LanePolylines::LanePolylines(
+      const Map &map,
+      const double resolution,
+      const LaneType lane_type)
+    : _resolution(resolution),
+      _lane_type(lane_type) {
+    if (!(resolution > 0.0)) {
+      throw_exception(std::invalid_argument("lane polylines: resolution must be positive"));
+    }
+
+    struct Lane {
+      id_type road_id;
+      int lane_id;
+      double length;
+    };
+    std::vector<Lane> lanes;
+    for (auto &&road : map.GetData().GetRoadSegments()) {
+      const auto info = road.GetInfo<RoadInfoLane>(0.0);
+      if (info == nullptr) {
+        continue;
+      }
+      for (auto &&lane_id : info->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
+        if (IsLaneTypeIn(info->getLane(lane_id)->_type, lane_type)) {
+          lanes.push_back({road.GetId(), lane_id, road.GetLength()});
+        }
+      }
+    }
+    std::sort(lanes.begin(), lanes.end(), [](const Lane &lhs, const Lane &rhs) {
+      return std::tie(lhs.road_id, lhs.lane_id) < std::tie(rhs.road_id, rhs.lane_id);
+    });
+
+    _road_ids.reserve(lanes.size());
+    _lane_ids.reserve(lanes.size());
+    _lane_offsets.reserve(lanes.size() + 1u);
+    size_t number_of_points = 0u;
+    for (auto &&lane : lanes) {
+      _road_ids.emplace_back(static_cast<uint32_t>(lane.road_id));
+      _lane_ids.emplace_back(lane.lane_id);
+      _lane_offsets.emplace_back(static_cast<uint32_t>(number_of_points));
+      number_of_points += GetNumberOfSamples(lane.length, resolution);
+    }
+    _lane_offsets.emplace_back(static_cast<uint32_t>(number_of_points));
+
+    _x.resize(number_of_points);
+    _y.resize(number_of_points);
+    _z.resize(number_of_points);
+    _yaw.resize(number_of_points);
+    _s.resize(number_of_points);
+    _road_ids_per_point.resize(number_of_points);
+    _lane_ids_per_point.resize(number_of_points);
+
+    // Each lane fills its own range of the arrays.
+    TaskExecutor::GetDefault().ParallelFor(lanes.size(), MIN_LANES_PER_TASK, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        SampleLane(map, i, lanes[i].length);
+      }
+    });
+  }
+
+  void LanePolylines::SampleLane(const Map &map, const size_t index, const double length) {
+    const auto begin = _lane_offsets[index];
+    const auto end = _lane_offsets[index + 1u];
+    // A single waypoint moved along the lane, saves a copy of the map
+    // pointer per sample.
+    Waypoint waypoint(map.shared_from_this(), _road_ids[index], _lane_ids[index], 0.0);
+    for (auto i = begin; i < end; ++i) {
+      waypoint._dist = std::min(static_cast<double>(i - begin) * _resolution, length);
+      const auto transform = waypoint.ComputeTransform();
+      _x[i] = transform.location.x;
+      _y[i] = transform.location.y;
+      _z[i] = transform.location.z;
+      _yaw[i] = transform.rotation.yaw;
+      _s[i] = static_cast<float>(waypoint._dist);
+      _road_ids_per_point[i] = _road_ids[index];
+      _lane_ids_per_point[i] = _lane_ids[index];
+    }
+  }
+
+  boost::optional<size_t> LanePolylines::FindLane(const id_type road_id, const int lane_id) const {
+    const auto key = std::make_pair(road_id, lane_id);
+    size_t first = 0u;
+    size_t count = _road_ids.size();
+    while (count > 0u) {
+      const auto step = count / 2u;
+      const auto middle = first + step;
+      if (std::make_pair(static_cast<id_type>(_road_ids[middle]), _lane_ids[middle]) < key) {
+        first = middle + 1u;
+        count -= step + 1u;
+      } else {
+        count = step;
+      }
+    }
+    if ((first < _road_ids.size()) &&
+        (_road_ids[first] == road_id) &&
+        (_lane_ids[first] == lane_id)) {
+      return first;
+    }
+    return {};
+  }
+
+} // namespace road
+} // namespace carla
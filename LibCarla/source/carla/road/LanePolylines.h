@@ -0,0 +1,130 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/road/element/LaneType.h"
+#include "carla/road/element/Types.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+  /// Center lines of the lanes of a Map sampled at a fixed resolution, stored
+  /// as a structure of arrays: the i-th point of the map is (GetX()[i],
+  /// GetY()[i], GetZ()[i]) and so on.
+  ///
+  /// The points of each lane are contiguous and ordered by increasing
+  /// distance from the start of the road, the first and last points lie on
+  /// the ends of the lane. Lanes are ordered by road id and lane id.
+  ///
+  /// The samples are computed in parallel on construction, afterwards the
+  /// polylines are read-only and can be shared between threads.
+  class LanePolylines : private MovableNonCopyable {
+  public:
+
+    /// Sample every lane of @a map whose type is in the @a lane_type mask
+    /// every @a resolution meters.
+    LanePolylines(
+        const Map &map,
+        double resolution,
+        element::LaneType lane_type = element::LaneType::Driving);
+
+    double GetResolution() const {
+      return _resolution;
+    }
+
+    element::LaneType GetLaneType() const {
+      return _lane_type;
+    }
+
+    size_t GetNumberOfLanes() const {
+      return _road_ids.size();
+    }
+
+    size_t GetNumberOfPoints() const {
+      return _x.size();
+    }
+
+    /// Index of the lane @a lane_id of @a road_id, empty if it was not
+    /// sampled.
+    boost::optional<size_t> FindLane(element::id_type road_id, int lane_id) const;
+
+    /// Offset of the first point of each lane, plus the total number of
+    /// points; lane i spans [GetLaneOffsets()[i], GetLaneOffsets()[i + 1]).
+    const std::vector<uint32_t> &GetLaneOffsets() const {
+      return _lane_offsets;
+    }
+
+    const std::vector<float> &GetX() const {
+      return _x;
+    }
+
+    const std::vector<float> &GetY() const {
+      return _y;
+    }
+
+    const std::vector<float> &GetZ() const {
+      return _z;
+    }
+
+    /// Yaw in degrees, pointing in the driving direction of the lane.
+    const std::vector<float> &GetYaw() const {
+      return _yaw;
+    }
+
+    /// Distance from the start of the road.
+    const std::vector<float> &GetS() const {
+      return _s;
+    }
+
+    const std::vector<uint32_t> &GetRoadIds() const {
+      return _road_ids_per_point;
+    }
+
+    const std::vector<int32_t> &GetLaneIds() const {
+      return _lane_ids_per_point;
+    }
+
+  private:
+
+    void SampleLane(const Map &map, size_t index, double length);
+
+    double _resolution;
+
+    element::LaneType _lane_type;
+
+    /// Road and lane id of each lane.
+    std::vector<uint32_t> _road_ids;
+
+    std::vector<int32_t> _lane_ids;
+
+    std::vector<uint32_t> _lane_offsets;
+
+    std::vector<float> _x;
+
+    std::vector<float> _y;
+
+    std::vector<float> _z;
+
+    std::vector<float> _yaw;
+
+    std::vector<float> _s;
+
+    std::vector<uint32_t> _road_ids_per_point;
+
+    std::vector<int32_t> _lane_ids_per_point;
+  };
+
+} // namespace road
+} // namespace carla
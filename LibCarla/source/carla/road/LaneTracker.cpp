@@ -0,0 +1,200 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/LaneTracker.h"
+
+#include "carla/TaskExecutor.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Minimum number of actors assigned to each task in a batch update.
+  static constexpr size_t MIN_ACTORS_PER_TASK = 64u;
+
+  static void Connect(
+      const RoadSegment *lhs,
+      const RoadSegment *rhs,
+      std::unordered_map<id_type, std::vector<const RoadSegment *>> &connections) {
+    if ((lhs == nullptr) || (rhs == nullptr) || (lhs == rhs)) {
+      return;
+    }
+    auto add = [&](const RoadSegment *from, const RoadSegment *to) {
+      auto &roads = connections[from->GetId()];
+      if (std::find(roads.begin(), roads.end(), to) == roads.end()) {
+        roads.emplace_back(to);
+      }
+    };
+    add(lhs, rhs);
+    add(rhs, lhs);
+  }
+
+  // ===========================================================================
+  // -- LaneTracker ------------------------------------------------------------
+  // ===========================================================================
+
+  LaneTracker::LaneTracker(SharedPtr<const Map> map, const LaneType lane_type)
+    : _map(std::move(map)),
+      _lane_type(lane_type) {
+    DEBUG_ASSERT(_map != nullptr);
+    const auto &data = _map->GetData();
+    for (auto &&road : data.GetRoadSegments()) {
+      for (auto &&other : road.GetSuccessors()) {
+        Connect(&road, other, _connected_roads);
+      }
+      for (auto &&other : road.GetPredecessors()) {
+        Connect(&road, other, _connected_roads);
+      }
+      const auto info = road.GetInfo<RoadInfoLane>(0.0);
+      if (info == nullptr) {
+        continue;
+      }
+      for (auto &&lane_id : info->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
+        for (auto &&next : road.GetNextLane(lane_id)) {
+          Connect(&road, data.GetRoad(static_cast<id_type>(next.second)), _connected_roads);
+        }
+        for (auto &&prev : road.GetPrevLane(lane_id)) {
+          Connect(&road, data.GetRoad(static_cast<id_type>(prev.second)), _connected_roads);
+        }
+      }
+    }
+  }
+
+  boost::optional<Waypoint> LaneTracker::Project(
+      const geom::Location &location,
+      const boost::optional<Waypoint> &hint) const {
+    bool hit;
+    return ProjectAndCount(location, hint.has_value() ? hint.get_ptr() : nullptr, hit);
+  }
+
+  boost::optional<Waypoint> LaneTracker::Update(
+      const ActorId actor,
+      const geom::Location &location) {
+    auto it = _hints.find(actor);
+    bool hit = false;
+    auto waypoint = ProjectAndCount(location, it != _hints.end() ? &it->second : nullptr, hit);
+    ++(hit ? _hint_hits : _hint_misses);
+    Store(actor, waypoint);
+    return waypoint;
+  }
+
+  std::vector<boost::optional<Waypoint>> LaneTracker::Update(
+      const std::vector<std::pair<ActorId, geom::Location>> &actors) {
+    std::vector<boost::optional<Waypoint>> result(actors.size());
+    std::vector<char> hits(actors.size(), 0);
+    // The hints are only read while projecting, they are stored afterwards.
+    auto project = [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        auto it = _hints.find(actors[i].first);
+        bool hit = false;
+        result[i] = ProjectAndCount(
+            actors[i].second,
+            it != _hints.end() ? &it->second : nullptr,
+            hit);
+        hits[i] = hit ? 1 : 0;
+      }
+    };
+    TaskExecutor::GetDefault().ParallelFor(actors.size(), MIN_ACTORS_PER_TASK, project);
+    for (auto i = 0u; i < actors.size(); ++i) {
+      ++(hits[i] != 0 ? _hint_hits : _hint_misses);
+      Store(actors[i].first, result[i]);
+    }
+    return result;
+  }
+
+  void LaneTracker::Remove(const ActorId actor) {
+    _hints.erase(actor);
+  }
+
+  void LaneTracker::Clear() {
+    _hints.clear();
+    _hint_hits = 0u;
+    _hint_misses = 0u;
+  }
+
+  boost::optional<Waypoint> LaneTracker::ProjectAndCount(
+      const geom::Location &location,
+      const Waypoint *hint,
+      bool &hit) const {
+    if (hint != nullptr) {
+      auto waypoint = ProjectAround(location, *hint);
+      if (waypoint.has_value()) {
+        hit = true;
+        return waypoint;
+      }
+    }
+    hit = false;
+    return _map->GetClosestWaypointOnRoad(location, _lane_type);
+  }
+
+  boost::optional<Waypoint> LaneTracker::ProjectAround(
+      const geom::Location &location,
+      const Waypoint &hint) const {
+    const auto &road = hint.GetRoadSegment();
+    double distance;
+    auto waypoint = ProjectOnRoad(location, road, distance);
+    if (waypoint.has_value()) {
+      return waypoint;
+    }
+    auto it = _connected_roads.find(road.GetId());
+    if (it == _connected_roads.end()) {
+      return {};
+    }
+    double nearest = std::numeric_limits<double>::max();
+    for (auto &&other : it->second) {
+      auto candidate = ProjectOnRoad(location, *other, distance);
+      if (candidate.has_value() && (distance < nearest)) {
+        nearest = distance;
+        waypoint = std::move(candidate);
+      }
+    }
+    return waypoint;
+  }
+
+  boost::optional<Waypoint> LaneTracker::ProjectOnRoad(
+      const geom::Location &location,
+      const RoadSegment &road,
+      double &distance) const {
+    const auto s = road.GetNearestPoint(location).first;
+    const auto lane_id = road.GetNearestLane(s, location, _lane_type).first;
+    if (lane_id == 0) {
+      return {};
+    }
+    Waypoint waypoint(_map, road.GetId(), lane_id, s);
+    distance = geom::Math::Distance2D(waypoint.ComputeTransform().location, location);
+    // Same criterion as Map::GetWaypoint.
+    const auto info = road.GetInfo<RoadInfoLane>(s);
+    if ((info == nullptr) || (distance >= info->getLane(lane_id)->_width * 0.5)) {
+      return {};
+    }
+    return waypoint;
+  }
+
+  void LaneTracker::Store(const ActorId actor, const boost::optional<Waypoint> &waypoint) {
+    if (!waypoint.has_value()) {
+      _hints.erase(actor);
+      return;
+    }
+    auto it = _hints.find(actor);
+    if (it == _hints.end()) {
+      _hints.emplace(actor, *waypoint);
+    } else {
+      it->second = *waypoint;
+    }
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,114 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/element/LaneType.h"
+#include "carla/road/element/Waypoint.h"
+#include "carla/rpc/ActorId.h"
+
+#include <boost/optional.hpp>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+namespace element {
+  class RoadSegment;
+} // namespace element
+
+  /// Associates moving actors to lanes tick after tick.
+  ///
+  /// The waypoint found for an actor on the previous update is used as a
+  /// hint: the location is first looked up in the road of the hint and the
+  /// roads connected to it, and only if it is not inside any of their lanes
+  /// the whole map is searched. While an actor is inside the lane of its
+  /// hint it keeps that lane, even where lanes overlap as in junctions.
+  class LaneTracker : private MovableNonCopyable {
+  public:
+
+    using Waypoint = element::Waypoint;
+
+    explicit LaneTracker(
+        SharedPtr<const Map> map,
+        element::LaneType lane_type = element::LaneType::Driving);
+
+    /// Closest waypoint to @a location on the lanes of the tracked types,
+    /// searching first around @a hint. Empty if the map has no such lanes.
+    boost::optional<Waypoint> Project(
+        const geom::Location &location,
+        const boost::optional<Waypoint> &hint = boost::none) const;
+
+    /// Project the new @a location of @a actor using its previous waypoint
+    /// as hint, and store the result as the next hint.
+    boost::optional<Waypoint> Update(ActorId actor, const geom::Location &location);
+
+    /// Update several actors at once, the projections are computed in
+    /// parallel. The result has one waypoint per actor, in the same order.
+    std::vector<boost::optional<Waypoint>> Update(
+        const std::vector<std::pair<ActorId, geom::Location>> &actors);
+
+    /// Forget the hint of @a actor.
+    void Remove(ActorId actor);
+
+    void Clear();
+
+    size_t GetNumberOfTrackedActors() const {
+      return _hints.size();
+    }
+
+    /// Number of updates resolved around the hint.
+    size_t GetNumberOfHintHits() const {
+      return _hint_hits;
+    }
+
+    /// Number of updates that needed a search over the whole map.
+    size_t GetNumberOfHintMisses() const {
+      return _hint_misses;
+    }
+
+  private:
+
+    boost::optional<Waypoint> ProjectAround(
+        const geom::Location &location,
+        const Waypoint &hint) const;
+
+    boost::optional<Waypoint> ProjectOnRoad(
+        const geom::Location &location,
+        const element::RoadSegment &road,
+        double &distance) const;
+
+    boost::optional<Waypoint> ProjectAndCount(
+        const geom::Location &location,
+        const Waypoint *hint,
+        bool &hit) const;
+
+    void Store(ActorId actor, const boost::optional<Waypoint> &waypoint);
+
+    SharedPtr<const Map> _map;
+
+    element::LaneType _lane_type;
+
+    /// Roads connected to each road, the road itself is not included.
+    std::unordered_map<element::id_type, std::vector<const element::RoadSegment *>> _connected_roads;
+
+    std::unordered_map<ActorId, Waypoint> _hints;
+
+    size_t _hint_hits = 0u;
+
+    size_t _hint_misses = 0u;
+  };
+
+} // namespace road
+} // namespace carla
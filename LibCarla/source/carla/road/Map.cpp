@@ -13,12 +13,24 @@ namespace road {
 
   using namespace element;
 
-  Waypoint Map::GetClosestWaypointOnRoad(const geom::Location &loc) const {
-    return Waypoint(shared_from_this(), loc);
+  boost::optional<Waypoint> Map::GetClosestWaypointOnRoad(
+      const geom::Location &loc,
+      const LaneType lane_type) const {
+    Waypoint w = Waypoint(shared_from_this(), loc, lane_type);
+    if (w._lane_id == 0) {
+      return {};
+    }
+    return w;
   }
 
-  boost::optional<Waypoint> Map::GetWaypoint(const geom::Location &loc) const {
-    Waypoint w = Waypoint(shared_from_this(), loc);
+  boost::optional<Waypoint> Map::GetWaypoint(
+      const geom::Location &loc,
+      const LaneType lane_type) const {
+    auto closest = GetClosestWaypointOnRoad(loc, lane_type);
+    if (!closest.has_value()) {
+      return {};
+    }
+    const Waypoint &w = *closest;
     auto d = geom::Math::Distance2D(w.ComputeTransform().location, loc);
     const auto inf = _data.GetRoad(w._road_id)->GetInfo<RoadInfoLane>(w._dist);
 
@@ -39,5 +51,12 @@ namespace road {
     return _data;
   }
 
+  const LaneBoundaryIndex &Map::GetLaneBoundaryIndex() const {
+    std::call_once(_lane_boundary_index_flag, [this]() {
+      _lane_boundary_index = std::make_unique<LaneBoundaryIndex>(_data);
+    });
+    return *_lane_boundary_index;
+  }
+
 } // namespace road
 } // namespace carla
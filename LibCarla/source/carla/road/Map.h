@@ -9,11 +9,14 @@
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/road/MapData.h"
+#include "carla/road/element/LaneBoundaryIndex.h"
 #include "carla/road/element/LaneMarking.h"
 #include "carla/road/element/Waypoint.h"
 
 #include <boost/optional.hpp>
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace carla {
@@ -21,26 +24,43 @@ namespace road {
 
   class Map
     : public EnableSharedFromThis<Map>,
-      private MovableNonCopyable {
+      private NonCopyable {
 
   public:
 
     Map(MapData m)
       : _data(std::move(m)) {}
 
-    element::Waypoint GetClosestWaypointOnRoad(const geom::Location &) const;
+    /// Waypoint at the center of the nearest lane whose type is in the
+    /// @a lane_type mask, empty if the map has no lane of these types.
+    boost::optional<element::Waypoint> GetClosestWaypointOnRoad(
+        const geom::Location &,
+        element::LaneType lane_type = element::LaneType::Driving) const;
 
-    boost::optional<element::Waypoint> GetWaypoint(const geom::Location &) const;
+    /// Same as GetClosestWaypointOnRoad, but empty if the location is not
+    /// inside that lane.
+    boost::optional<element::Waypoint> GetWaypoint(
+        const geom::Location &,
+        element::LaneType lane_type = element::LaneType::Driving) const;
 
+    /// Lane markings crossed moving from @a origin to @a destination, in
+    /// the order they are crossed.
     std::vector<element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
         const geom::Location &destination) const;
 
     const MapData &GetData() const;
 
+    /// Index of the marked lane boundaries, built on first use.
+    const element::LaneBoundaryIndex &GetLaneBoundaryIndex() const;
+
   private:
 
     MapData _data;
+
+    mutable std::once_flag _lane_boundary_index_flag;
+
+    mutable std::unique_ptr<element::LaneBoundaryIndex> _lane_boundary_index;
   };
 
 } // namespace road
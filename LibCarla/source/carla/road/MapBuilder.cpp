@@ -60,41 +60,37 @@ namespace road {
     for (auto &&element : _map_data._elements) {
       RoadSegment *road_seg = element.second.get();
 
-      // get all the RoadGeneralInfo given the type and a distance 0.0
-      auto up_bound_g = decltype(road_seg->_info)::reverse_iterator(road_seg->_info.upper_bound(0.0));
-      auto general_info = MakeRoadInfoIterator<RoadGeneralInfo>(up_bound_g, road_seg->_info.rend());
+      // get the RoadGeneralInfo and RoadInfoLane given a distance 0.0
+      const auto *general_info = std::get<RoadInfoArray<RoadGeneralInfo>>(road_seg->_info).GetLast(0.0);
+      auto *lane_info = std::get<RoadInfoArray<RoadInfoLane>>(road_seg->_info).GetLast(0.0);
 
-      // get all the RoadInfoLane given the type and a distance 0.0
-      auto up_bound_l = decltype(road_seg->_info)::reverse_iterator(road_seg->_info.upper_bound(0.0));
-      auto lane_info = MakeRoadInfoIterator<RoadInfoLane>(up_bound_l, road_seg->_info.rend());
-
-      // check that have a RoadGeneralInfo
-      if (!lane_info.IsAtEnd()) {
+      // check that have a RoadInfoLane
+      if (lane_info != nullptr) {
 
         double lane_offset = 0.0;
-        if (!general_info.IsAtEnd()) {
-          lane_offset = (*general_info)->GetLanesOffset().at(0).second;
+        if (general_info != nullptr) {
+          lane_offset = general_info->GetLanesOffset().at(0).second;
         }
 
         double current_width = lane_offset;
 
         for (auto &&current_lane_id :
-            (*lane_info)->getLanesIDs(element::RoadInfoLane::which_lane_e::Left)) {
-          const double half_width = (*lane_info)->getLane(current_lane_id)->_width * 0.5;
+            lane_info->getLanesIDs(element::RoadInfoLane::which_lane_e::Left)) {
+          const double half_width = lane_info->getLane(current_lane_id)->_width * 0.5;
 
           current_width += half_width;
-          (*lane_info)->_lanes[current_lane_id]._lane_center_offset = current_width;
+          lane_info->_lanes[current_lane_id]._lane_center_offset = current_width;
           current_width += half_width;
         }
 
         current_width = lane_offset;
 
         for (auto &&current_lane_id :
-            (*lane_info)->getLanesIDs(element::RoadInfoLane::which_lane_e::Right)) {
-          const double half_width = (*lane_info)->getLane(current_lane_id)->_width * 0.5;
+            lane_info->getLanesIDs(element::RoadInfoLane::which_lane_e::Right)) {
+          const double half_width = lane_info->getLane(current_lane_id)->_width * 0.5;
 
           current_width -= half_width;
-          (*lane_info)->_lanes[current_lane_id]._lane_center_offset = current_width;
+          lane_info->_lanes[current_lane_id]._lane_center_offset = current_width;
           current_width -= half_width;
         }
       }
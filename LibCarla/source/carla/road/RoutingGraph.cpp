@@ -0,0 +1,443 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/RoutingGraph.h"
+
+#include "carla/Exception.h"
+#include "carla/TaskExecutor.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+#include "carla/road/RoutingSearchSpace.h"
+#include "carla/road/WaypointGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  constexpr double RoutingGraph::default_lane_change_cost;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Distance between the samples used to measure the length of a lane.
+  static constexpr double LANE_SAMPLING_STEP = 2.0;
+
+  /// Maximum change of heading, in degrees, of a junction lane considered
+  /// going straight.
+  static constexpr double STRAIGHT_THRESHOLD = 30.0;
+
+  /// Minimum number of queries assigned to each task in a batch.
+  static constexpr size_t MIN_QUERIES_PER_TASK = 32u;
+
+  static double NormalizeAngle(double degrees) {
+    degrees = std::fmod(degrees, 360.0);
+    if (degrees > 180.0) {
+      degrees -= 360.0;
+    } else if (degrees <= -180.0) {
+      degrees += 360.0;
+    }
+    return degrees;
+  }
+
+  /// Classify the maneuver needed to enter @a next from one of its
+  /// predecessors by the change of heading along @a next.
+  static RoadOption ClassifyManeuver(const RoutingGraph::Lane &next) {
+    if (!next.is_junction) {
+      return RoadOption::LaneFollow;
+    }
+    const auto turn = NormalizeAngle(next.end_yaw - next.begin_yaw);
+    if (std::abs(turn) < STRAIGHT_THRESHOLD) {
+      return RoadOption::Straight;
+    }
+    // Yaw increases clockwise.
+    return turn < 0.0 ? RoadOption::Left : RoadOption::Right;
+  }
+
+  /// Same criterion as client::Waypoint::GetLaneChange, the permissions of
+  /// the road mark are relative to the lane ids and must be flipped on
+  /// backward lanes.
+  static bool AllowsLaneChange(const RoadInfoMarkRecord &mark, bool to_the_right) {
+    using LaneChange = RoadInfoMarkRecord::LaneChange;
+    const bool is_backward = mark.GetLaneId() > 0;
+    const auto flag = (to_the_right != is_backward) ? LaneChange::Increase : LaneChange::Decrease;
+    return (static_cast<uint8_t>(mark.GetLaneChange()) & static_cast<uint8_t>(flag)) != 0u;
+  }
+
+  using EdgeList = std::vector<std::pair<RoutingGraph::node_id_type, RoutingGraph::Edge>>;
+
+  /// Sort @a edges by source and store them in compressed sparse row format.
+  static void MakeCompressedSparseRows(
+      const size_t number_of_nodes,
+      EdgeList edges,
+      std::vector<uint32_t> &offsets,
+      std::vector<RoutingGraph::Edge> &result) {
+    std::stable_sort(edges.begin(), edges.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.first < rhs.first;
+    });
+    offsets.assign(number_of_nodes + 1u, 0u);
+    result.clear();
+    result.reserve(edges.size());
+    for (auto &&pair : edges) {
+      ++offsets[pair.first + 1u];
+      result.emplace_back(pair.second);
+    }
+    for (auto i = 1u; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1u];
+    }
+  }
+
+  // ===========================================================================
+  // -- RoutingGraph -----------------------------------------------------------
+  // ===========================================================================
+
+  RoutingGraph::RoutingGraph(const Map &map)
+    : RoutingGraph(map, default_lane_change_cost) {}
+
+  RoutingGraph::RoutingGraph(const Map &map, const double lane_change_cost) {
+    for (auto &&road : map.GetData().GetRoadSegments()) {
+      // A lane is drivable if it is in any of the lane sections of the road,
+      // it spans from the first of them to the last.
+      std::map<int, std::pair<double, double>> lane_ranges;
+      for (auto &&section : road.GetLaneSections()) {
+        if (section.begin >= section.end) {
+          continue;
+        }
+        for (auto &&lane_id : section.lanes->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
+          if (section.lanes->getLane(lane_id)->_type != element::LaneType::Driving) {
+            continue;
+          }
+          auto it = lane_ranges.emplace(lane_id, std::make_pair(section.begin, section.end)).first;
+          it->second.first = std::min(it->second.first, section.begin);
+          it->second.second = std::max(it->second.second, section.end);
+        }
+      }
+      for (auto &&pair : lane_ranges) {
+        _lanes.emplace_back(MakeLane(map, road, pair.first, pair.second.first, pair.second.second));
+      }
+    }
+    // Sorted for a deterministic numbering and for looking up the lanes.
+    std::sort(_lanes.begin(), _lanes.end(), [](const Lane &lhs, const Lane &rhs) {
+      return std::make_pair(lhs.road_id, lhs.lane_id) < std::make_pair(rhs.road_id, rhs.lane_id);
+    });
+
+    EdgeList edges;
+    auto add_lane_change = [&](node_id_type id, const boost::optional<Waypoint> &neighbour, RoadOption option) {
+      if (!neighbour.has_value()) {
+        return;
+      }
+      const auto neighbour_id = FindLane(*neighbour);
+      // Only to drivable lanes in the same direction.
+      if (neighbour_id.has_value() &&
+          ((neighbour->GetLaneId() < 0) == (_lanes[id].lane_id < 0))) {
+        const auto distance = geom::Math::Distance(
+            _lanes[id].begin_location,
+            _lanes[*neighbour_id].begin_location);
+        edges.emplace_back(id, Edge{*neighbour_id, option, std::max<double>(lane_change_cost, distance)});
+      }
+    };
+
+    for (node_id_type id = 0u; id < _lanes.size(); ++id) {
+      const auto &lane = _lanes[id];
+      const auto &road = *map.GetData().GetRoad(lane.road_id);
+      const auto next_lanes = lane.lane_id <= 0 ?
+          road.GetNextLane(lane.lane_id) :
+          road.GetPrevLane(lane.lane_id);
+      for (auto &&pair : next_lanes) {
+        const auto next_id = FindLane(static_cast<id_type>(pair.second), pair.first);
+        if (next_id.has_value()) {
+          edges.emplace_back(id, Edge{*next_id, ClassifyManeuver(_lanes[*next_id]), lane.length});
+        }
+      }
+      if (!lane.is_junction) {
+        // Lane changes are checked halfway along the lane.
+        const Waypoint middle(
+            map.shared_from_this(),
+            lane.road_id,
+            lane.lane_id,
+            0.5 * (lane.begin_distance + lane.end_distance));
+        const auto marks = middle.GetMarkRecord();
+        if (AllowsLaneChange(marks.first, true)) {
+          add_lane_change(id, WaypointGenerator::GetRight(middle), RoadOption::ChangeLaneRight);
+        }
+        if (AllowsLaneChange(marks.second, false)) {
+          add_lane_change(id, WaypointGenerator::GetLeft(middle), RoadOption::ChangeLaneLeft);
+        }
+      }
+    }
+
+    EdgeList reverse_edges;
+    reverse_edges.reserve(edges.size());
+    for (auto &&pair : edges) {
+      reverse_edges.emplace_back(pair.second.node, Edge{pair.first, pair.second.option, pair.second.cost});
+    }
+    MakeCompressedSparseRows(_lanes.size(), std::move(edges), _offsets, _edges);
+    MakeCompressedSparseRows(_lanes.size(), std::move(reverse_edges), _reverse_offsets, _reverse_edges);
+  }
+
+  RoutingGraph::Lane RoutingGraph::MakeLane(
+      const Map &map,
+      const RoadSegment &road,
+      const int lane_id,
+      const double first_distance,
+      const double last_distance) {
+    Lane lane;
+    lane.road_id = road.GetId();
+    lane.lane_id = lane_id;
+    lane.begin_distance = lane_id < 0 ? first_distance : last_distance;
+    lane.end_distance = lane_id < 0 ? last_distance : first_distance;
+    auto make_waypoint = [&](double distance) {
+      return Waypoint(map.shared_from_this(), lane.road_id, lane_id, distance);
+    };
+    const auto begin = make_waypoint(lane.begin_distance);
+    const auto begin_transform = begin.ComputeTransform();
+    const auto end_transform = make_waypoint(lane.end_distance).ComputeTransform();
+    lane.is_junction = begin.IsIntersection();
+    lane.begin_location = begin_transform.location;
+    lane.end_location = end_transform.location;
+    lane.begin_yaw = begin_transform.rotation.yaw;
+    lane.end_yaw = end_transform.rotation.yaw;
+    // The lane is longer than the road in the outer side of the curves, measure
+    // it along a polyline through the center of the lane.
+    const auto steps = std::max(1.0, std::ceil((last_distance - first_distance) / LANE_SAMPLING_STEP));
+    lane.length = 0.0;
+    auto previous = lane.begin_location;
+    for (auto i = 1.0; i < steps; i += 1.0) {
+      const auto distance = lane.begin_distance + (lane.end_distance - lane.begin_distance) * (i / steps);
+      const auto location = make_waypoint(distance).ComputeTransform().location;
+      lane.length += geom::Math::Distance(previous, location);
+      previous = location;
+    }
+    lane.length += geom::Math::Distance(previous, lane.end_location);
+    return lane;
+  }
+
+  boost::optional<RoutingGraph::node_id_type> RoutingGraph::FindLane(
+      const id_type road_id,
+      const int lane_id) const {
+    const auto key = std::make_pair(road_id, lane_id);
+    auto it = std::lower_bound(_lanes.begin(), _lanes.end(), key, [](const Lane &lane, const auto &value) {
+      return std::make_pair(lane.road_id, lane.lane_id) < value;
+    });
+    if ((it == _lanes.end()) || (it->road_id != road_id) || (it->lane_id != lane_id)) {
+      return boost::none;
+    }
+    return static_cast<node_id_type>(std::distance(_lanes.begin(), it));
+  }
+
+  Waypoint RoutingGraph::GetLaneBegin(const Map &map, const node_id_type id) const {
+    const auto &lane = GetLane(id);
+    return Waypoint(map.shared_from_this(), lane.road_id, lane.lane_id, lane.begin_distance);
+  }
+
+  RoutingGraph::Route RoutingGraph::FindRoute(
+      const node_id_type origin,
+      const node_id_type destination,
+      const Algorithm algorithm) const {
+    if ((origin >= _lanes.size()) || (destination >= _lanes.size())) {
+      throw_exception(std::out_of_range("routing graph: invalid lane"));
+    }
+    SearchSpace forward(_lanes.size());
+    SearchSpace backward(algorithm == Algorithm::BidirectionalDijkstra ? _lanes.size() : 0u);
+    return FindRoute(forward, backward, origin, destination, algorithm);
+  }
+
+  RoutingGraph::Route RoutingGraph::FindRouteAround(
+      const node_id_type id,
+      const Algorithm algorithm) const {
+    if (id >= _lanes.size()) {
+      throw_exception(std::out_of_range("routing graph: invalid lane"));
+    }
+    SearchSpace forward(_lanes.size());
+    SearchSpace backward(algorithm == Algorithm::BidirectionalDijkstra ? _lanes.size() : 0u);
+    Route result;
+    result.cost = std::numeric_limits<double>::infinity();
+    for (auto &&edge : GetSuccessors(id)) {
+      auto route = FindRoute(forward, backward, edge.node, id, algorithm);
+      if (route.empty() || ((edge.cost + route.cost) >= result.cost)) {
+        continue;
+      }
+      route.lanes.insert(route.lanes.begin(), id);
+      route.options.insert(route.options.begin(), RoadOption::LaneFollow);
+      route.options[1u] = edge.option;
+      route.cost += edge.cost;
+      result = std::move(route);
+    }
+    return result.empty() ? Route{} : result;
+  }
+
+  bool RoutingGraph::IsBehind(const Waypoint &origin, const Waypoint &destination) {
+    if ((origin.GetRoadId() != destination.GetRoadId()) ||
+        (origin.GetLaneId() != destination.GetLaneId())) {
+      return false;
+    }
+    // Lanes with negative id go in the direction of the road.
+    return origin.GetLaneId() < 0 ?
+        (destination._dist < origin._dist) :
+        (destination._dist > origin._dist);
+  }
+
+  std::vector<RoutingGraph::Route> RoutingGraph::FindRoutes(
+      const std::vector<std::pair<node_id_type, node_id_type>> &queries,
+      const Algorithm algorithm) const {
+    for (auto &&query : queries) {
+      if ((query.first >= _lanes.size()) || (query.second >= _lanes.size())) {
+        throw_exception(std::out_of_range("routing graph: invalid lane"));
+      }
+    }
+    std::vector<Route> result(queries.size());
+    auto solve = [&](size_t begin, size_t end) {
+      SearchSpace forward(_lanes.size());
+      SearchSpace backward(algorithm == Algorithm::BidirectionalDijkstra ? _lanes.size() : 0u);
+      for (auto i = begin; i < end; ++i) {
+        result[i] = FindRoute(forward, backward, queries[i].first, queries[i].second, algorithm);
+      }
+    };
+    TaskExecutor::GetDefault().ParallelFor(queries.size(), MIN_QUERIES_PER_TASK, solve);
+    return result;
+  }
+
+  RoutingGraph::Route RoutingGraph::FindRoute(
+      SearchSpace &forward,
+      SearchSpace &backward,
+      const node_id_type origin,
+      const node_id_type destination,
+      const Algorithm algorithm) const {
+    if (origin == destination) {
+      Route route;
+      route.lanes.emplace_back(origin);
+      route.options.emplace_back(RoadOption::LaneFollow);
+      return route;
+    }
+    switch (algorithm) {
+      case Algorithm::AStar:
+        return AStar(forward, origin, destination);
+      case Algorithm::BidirectionalDijkstra:
+        return BidirectionalDijkstra(forward, backward, origin, destination);
+    }
+    return Route{};
+  }
+
+  /// Append to @a route the path found by @a space from its root to @a last.
+  static void AppendForwardPath(
+      const RoutingSearchSpace &space,
+      RoutingGraph::node_id_type last,
+      RoutingGraph::Route &route) {
+    const auto begin = route.lanes.size();
+    for (auto id = last;; id = space.GetParent(id)) {
+      route.lanes.emplace_back(id);
+      route.options.emplace_back(space.GetOption(id));
+      if (space.GetParent(id) == id) {
+        break;
+      }
+    }
+    std::reverse(route.lanes.begin() + begin, route.lanes.end());
+    std::reverse(route.options.begin() + begin, route.options.end());
+    route.options[begin] = RoadOption::LaneFollow;
+  }
+
+  RoutingGraph::Route RoutingGraph::AStar(
+      SearchSpace &space,
+      const node_id_type origin,
+      const node_id_type destination) const {
+    // Straight line distance between the entrances of the lanes, never greater
+    // than the length of the lanes in between.
+    const auto &target = _lanes[destination].begin_location;
+    auto heuristic = [&](node_id_type id) -> double {
+      return geom::Math::Distance(_lanes[id].begin_location, target);
+    };
+
+    space.Reset();
+    space.Relax(origin, 0.0, origin, RoadOption::LaneFollow, heuristic(origin));
+    while (!space.empty()) {
+      const auto top = space.Pop();
+      const auto id = top.second;
+      const auto cost = space.GetCost(id);
+      if (top.first > (cost + heuristic(id))) {
+        continue; // Outdated entry.
+      }
+      if (id == destination) {
+        Route route;
+        AppendForwardPath(space, destination, route);
+        route.cost = cost;
+        return route;
+      }
+      for (auto &&edge : GetSuccessors(id)) {
+        const auto new_cost = cost + edge.cost;
+        if (new_cost < space.GetCost(edge.node)) {
+          space.Relax(edge.node, new_cost, id, edge.option, new_cost + heuristic(edge.node));
+        }
+      }
+    }
+    return Route{};
+  }
+
+  RoutingGraph::Route RoutingGraph::BidirectionalDijkstra(
+      SearchSpace &forward,
+      SearchSpace &backward,
+      const node_id_type origin,
+      const node_id_type destination) const {
+    forward.Reset();
+    backward.Reset();
+    forward.Relax(origin, 0.0, origin, RoadOption::LaneFollow, 0.0);
+    backward.Relax(destination, 0.0, destination, RoadOption::LaneFollow, 0.0);
+
+    auto best_cost = std::numeric_limits<double>::infinity();
+    auto meeting_node = origin;
+
+    auto expand = [&](SearchSpace &space, const SearchSpace &other, auto &&get_edges) {
+      const auto top = space.Pop();
+      const auto id = top.second;
+      const auto cost = space.GetCost(id);
+      if (top.first > cost) {
+        return; // Outdated entry.
+      }
+      for (auto &&edge : get_edges(id)) {
+        const auto new_cost = cost + edge.cost;
+        if (space.Relax(edge.node, new_cost, id, edge.option, new_cost)) {
+          const auto total_cost = new_cost + other.GetCost(edge.node);
+          if (total_cost < best_cost) {
+            best_cost = total_cost;
+            meeting_node = edge.node;
+          }
+        }
+      }
+    };
+
+    // Stop when no path through the unsettled nodes can be cheaper than the
+    // best one found so far.
+    while (!forward.empty() && !backward.empty() &&
+           ((forward.GetTopPriority() + backward.GetTopPriority()) < best_cost)) {
+      if (forward.GetTopPriority() <= backward.GetTopPriority()) {
+        expand(forward, backward, [this](node_id_type id) { return GetSuccessors(id); });
+      } else {
+        expand(backward, forward, [this](node_id_type id) { return GetPredecessors(id); });
+      }
+    }
+
+    if (best_cost == std::numeric_limits<double>::infinity()) {
+      return Route{};
+    }
+    Route route;
+    AppendForwardPath(forward, meeting_node, route);
+    // The backward search stores the maneuver to enter the next lane.
+    for (auto id = meeting_node; backward.GetParent(id) != id; id = backward.GetParent(id)) {
+      route.lanes.emplace_back(backward.GetParent(id));
+      route.options.emplace_back(backward.GetOption(id));
+    }
+    route.cost = best_cost;
+    return route;
+  }
+
+} // namespace road
+} // namespace carla
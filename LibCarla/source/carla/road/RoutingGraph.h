@@ -0,0 +1,206 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/ListView.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/element/Types.h"
+#include "carla/road/element/Waypoint.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+  class RoutingSearchSpace;
+
+  /// Maneuver needed to enter a lane of a route. Values extend the RoadOption
+  /// enum of the Python navigation agents.
+  enum class RoadOption : int8_t {
+    Void            = -1,
+    Left            =  1,
+    Right           =  2,
+    Straight        =  3,
+    LaneFollow      =  4,
+    ChangeLaneLeft  =  5,
+    ChangeLaneRight =  6
+  };
+
+  /// Lane-level graph of the drivable lanes of a map, used for computing
+  /// routes.
+  ///
+  /// Each node is a drivable lane of a road, the edges connect each lane with
+  /// its successors (including junction connections) and with its neighbour
+  /// lanes of the same direction where the road marks allow a lane change.
+  /// The edges are stored in compressed sparse row format, in both directions.
+  ///
+  /// The graph is immutable once built, and can be queried from several
+  /// threads at the same time.
+  class RoutingGraph : private MovableNonCopyable {
+  public:
+
+    using node_id_type = uint32_t;
+
+    struct Lane {
+      element::id_type road_id;
+      int lane_id;
+      bool is_junction;
+      /// Length of the lane, measured along the center of the lane.
+      double length;
+      /// Distance along the road at which vehicles enter the lane.
+      double begin_distance;
+      /// Distance along the road at which vehicles leave the lane.
+      double end_distance;
+      geom::Location begin_location;
+      geom::Location end_location;
+      /// Yaw in degrees at the entrance and at the exit of the lane.
+      double begin_yaw;
+      double end_yaw;
+    };
+
+    struct Edge {
+      node_id_type node;
+      RoadOption option;
+      double cost;
+    };
+
+    struct Route {
+      /// Lanes to traverse, from origin to destination; empty if the
+      /// destination cannot be reached.
+      std::vector<node_id_type> lanes;
+      /// Maneuver needed to enter each of the lanes.
+      std::vector<RoadOption> options;
+      /// Cost of the route, the length of every lane but the last one plus
+      /// the lane changes.
+      double cost = 0.0;
+
+      bool empty() const {
+        return lanes.empty();
+      }
+    };
+
+    enum class Algorithm {
+      AStar,
+      BidirectionalDijkstra
+    };
+
+    /// Minimum cost of a lane change, in meters.
+    static constexpr double default_lane_change_cost = 5.0;
+
+    explicit RoutingGraph(const Map &map);
+
+    RoutingGraph(const Map &map, double lane_change_cost);
+
+    size_t GetNumberOfLanes() const {
+      return _lanes.size();
+    }
+
+    size_t GetNumberOfEdges() const {
+      return _edges.size();
+    }
+
+    const Lane &GetLane(node_id_type id) const {
+      return _lanes.at(id);
+    }
+
+    /// Return the node of the lane @a lane_id of road @a road_id, if it is a
+    /// drivable lane.
+    boost::optional<node_id_type> FindLane(element::id_type road_id, int lane_id) const;
+
+    /// Return the node of the lane of @a waypoint.
+    boost::optional<node_id_type> FindLane(const element::Waypoint &waypoint) const {
+      return FindLane(waypoint.GetRoadId(), waypoint.GetLaneId());
+    }
+
+    /// Outgoing edges of @a id.
+    auto GetSuccessors(node_id_type id) const {
+      DEBUG_ASSERT(id < _lanes.size());
+      return MakeListView(_edges.begin() + _offsets[id], _edges.begin() + _offsets[id + 1u]);
+    }
+
+    /// Incoming edges of @a id, Edge::node is the source of the edge.
+    auto GetPredecessors(node_id_type id) const {
+      DEBUG_ASSERT(id < _lanes.size());
+      return MakeListView(
+          _reverse_edges.begin() + _reverse_offsets[id],
+          _reverse_edges.begin() + _reverse_offsets[id + 1u]);
+    }
+
+    /// Waypoint at the entrance of lane @a id. @a map must be the map this
+    /// graph was built from.
+    element::Waypoint GetLaneBegin(const Map &map, node_id_type id) const;
+
+    /// Compute the cheapest route from @a origin to @a destination.
+    Route FindRoute(
+        node_id_type origin,
+        node_id_type destination,
+        Algorithm algorithm = Algorithm::AStar) const;
+
+    /// Compute the cheapest route leaving lane @a id and coming back to it,
+    /// for destinations behind the origin on the same lane; empty if there is
+    /// none.
+    Route FindRouteAround(node_id_type id, Algorithm algorithm = Algorithm::AStar) const;
+
+    /// Whether @a destination is on the lane of @a origin but behind it, in
+    /// which case the route has to go around, see FindRouteAround.
+    static bool IsBehind(const element::Waypoint &origin, const element::Waypoint &destination);
+
+    /// Compute the routes of every origin-destination pair in @a queries.
+    /// Large batches are split among the workers of the process-wide
+    /// TaskExecutor.
+    std::vector<Route> FindRoutes(
+        const std::vector<std::pair<node_id_type, node_id_type>> &queries,
+        Algorithm algorithm = Algorithm::AStar) const;
+
+  private:
+
+    using SearchSpace = RoutingSearchSpace;
+
+    /// Lane @a lane_id of @a road, present in its lane sections from
+    /// @a first_distance to @a last_distance.
+    static Lane MakeLane(
+        const Map &map,
+        const element::RoadSegment &road,
+        int lane_id,
+        double first_distance,
+        double last_distance);
+
+    Route FindRoute(
+        SearchSpace &forward,
+        SearchSpace &backward,
+        node_id_type origin,
+        node_id_type destination,
+        Algorithm algorithm) const;
+
+    Route AStar(SearchSpace &forward, node_id_type origin, node_id_type destination) const;
+
+    Route BidirectionalDijkstra(
+        SearchSpace &forward,
+        SearchSpace &backward,
+        node_id_type origin,
+        node_id_type destination) const;
+
+    std::vector<Lane> _lanes;
+
+    std::vector<uint32_t> _offsets;
+
+    std::vector<Edge> _edges;
+
+    std::vector<uint32_t> _reverse_offsets;
+
+    std::vector<Edge> _reverse_edges;
+  };
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/road/RoutingGraph.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// State of a single direction of a shortest path search over the lanes of
+  /// a RoutingGraph: cost and parent of each reached lane, and the priority
+  /// queue. Reusable between queries without clearing its arrays.
+  class RoutingSearchSpace : private NonCopyable {
+  public:
+
+    using node_id_type = RoutingGraph::node_id_type;
+
+    explicit RoutingSearchSpace(size_t size) : _nodes(size) {}
+
+    void Reset() {
+      _queue.clear();
+      if (++_current_stamp == 0u) {
+        for (auto &node : _nodes) {
+          node.stamp = 0u;
+        }
+        _current_stamp = 1u;
+      }
+    }
+
+    /// Cost of the cheapest path found to @a id, infinity if not reached.
+    double GetCost(node_id_type id) const {
+      const auto &node = _nodes[id];
+      return node.stamp == _current_stamp ? node.cost : std::numeric_limits<double>::infinity();
+    }
+
+    node_id_type GetParent(node_id_type id) const {
+      return _nodes[id].parent;
+    }
+
+    RoadOption GetOption(node_id_type id) const {
+      return _nodes[id].option;
+    }
+
+    /// Set the cost of @a id if lower than the current one, and queue @a id
+    /// with @a priority. Return whether the cost was updated.
+    bool Relax(
+        node_id_type id,
+        double cost,
+        node_id_type parent,
+        RoadOption option,
+        double priority) {
+      auto &node = _nodes[id];
+      if ((node.stamp == _current_stamp) && (node.cost <= cost)) {
+        return false;
+      }
+      node.cost = cost;
+      node.parent = parent;
+      node.option = option;
+      node.stamp = _current_stamp;
+      _queue.emplace_back(priority, id);
+      std::push_heap(_queue.begin(), _queue.end(), std::greater<>());
+      return true;
+    }
+
+    bool empty() const {
+      return _queue.empty();
+    }
+
+    double GetTopPriority() const {
+      return _queue.front().first;
+    }
+
+    /// Pop the entry with lowest priority. The queue is never updated in
+    /// place, outdated entries have to be skipped by the caller.
+    std::pair<double, node_id_type> Pop() {
+      std::pop_heap(_queue.begin(), _queue.end(), std::greater<>());
+      auto top = _queue.back();
+      _queue.pop_back();
+      return top;
+    }
+
+  private:
+
+    struct Node {
+      double cost;
+      node_id_type parent;
+      RoadOption option;
+      uint32_t stamp = 0u;
+    };
+
+    std::vector<Node> _nodes;
+
+    std::vector<std::pair<double, node_id_type>> _queue;
+
+    uint32_t _current_stamp = 0u;
+  };
+
+} // namespace road
+} // namespace carla
@@ -17,34 +17,28 @@ namespace road {
   // -- Static local methods ---------------------------------------------------
   // ===========================================================================
 
-  template <typename T>
-  static std::vector<T> ConcatVectors(std::vector<T> dst, std::vector<T> src) {
-    if (src.size() > dst.size()) {
-      return ConcatVectors(src, dst);
-    }
-    dst.insert(
-        dst.end(),
-        std::make_move_iterator(src.begin()),
-        std::make_move_iterator(src.end()));
-    return dst;
-  }
-
   template <typename FuncT>
-  static void ForEachDrivableLane(const RoadSegment &road, double s, FuncT &&func) {
+  static void ForEachLane(const RoadSegment &road, double s, LaneType lane_type, FuncT &&func) {
     const auto info = road.GetInfo<RoadInfoLane>(s);
     DEBUG_ASSERT(info != nullptr);
     for (auto &&lane_id : info->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
-      if (info->getLane(lane_id)->_type == "driving") {
+      if (IsLaneTypeIn(info->getLane(lane_id)->_type, lane_type)) {
         func(lane_id);
       }
     }
   }
 
+  template <typename FuncT>
+  static void ForEachDrivableLane(const RoadSegment &road, double s, FuncT &&func) {
+    ForEachLane(road, s, LaneType::Driving, std::forward<FuncT>(func));
+  }
+
   // ===========================================================================
   // -- WaypointGenerator ------------------------------------------------------
   // ===========================================================================
 
-  std::vector<Waypoint> WaypointGenerator::GetSuccessors(const Waypoint &waypoint) {
+  template <typename FuncT>
+  void WaypointGenerator::ForEachSuccessor(const Waypoint &waypoint, FuncT &&func) {
     auto &map = waypoint._map;
     const auto this_lane_id = waypoint.GetLaneId();
     const auto this_road_id = waypoint.GetRoadId();
@@ -58,8 +52,6 @@ namespace road {
       log_error("road id =", this_road_id, "lane id =", this_lane_id, ": missing next lanes");
     }
 
-    std::vector<Waypoint> result;
-    result.reserve(next_lanes.size());
     for (auto &&pair : next_lanes) {
       const auto lane_id = pair.first;
       const auto road_id = pair.second;
@@ -67,14 +59,30 @@ namespace road {
       DEBUG_ASSERT(lane_id != 0);
       DEBUG_ASSERT(road != nullptr);
       const auto distance = lane_id < 0 ? 0.0 : road->GetLength();
-      result.push_back(Waypoint(map, road_id, lane_id, distance));
+      func(Waypoint(map, road_id, lane_id, distance));
     }
+  }
+
+  std::vector<Waypoint> WaypointGenerator::GetSuccessors(const Waypoint &waypoint) {
+    std::vector<Waypoint> result;
+    ForEachSuccessor(waypoint, [&](Waypoint &&successor) {
+      result.emplace_back(std::move(successor));
+    });
     return result;
   }
 
   std::vector<Waypoint> WaypointGenerator::GetNext(
       const Waypoint &waypoint,
       double distance) {
+    std::vector<Waypoint> result;
+    AppendNext(waypoint, distance, result);
+    return result;
+  }
+
+  void WaypointGenerator::AppendNext(
+      const Waypoint &waypoint,
+      const double distance,
+      std::vector<Waypoint> &result) {
     auto &map = waypoint._map;
     const auto this_road_id = waypoint.GetRoadId();
     const auto this_lane_id = waypoint.GetLaneId();
@@ -88,23 +96,23 @@ namespace road {
       const auto total_distance = waypoint._dist + distance;
       const auto road_length = waypoint.GetRoadSegment().GetLength();
       if (total_distance <= road_length) {
-        return { Waypoint(map, this_road_id, this_lane_id, total_distance) };
+        result.push_back(Waypoint(map, this_road_id, this_lane_id, total_distance));
+        return;
       }
       distance_on_next_segment = total_distance - road_length;
     } else {
       // road goes backward.
       const auto total_distance = waypoint._dist - distance;
       if (total_distance >= 0.0) {
-        return { Waypoint(map, this_road_id, this_lane_id, total_distance) };
+        result.push_back(Waypoint(map, this_road_id, this_lane_id, total_distance));
+        return;
       }
       distance_on_next_segment = std::abs(total_distance);
     }
 
-    std::vector<Waypoint> result;
-    for (auto &&next_waypoint : GetSuccessors(waypoint)) {
-      result = ConcatVectors(result, GetNext(next_waypoint, distance_on_next_segment));
-    }
-    return result;
+    ForEachSuccessor(waypoint, [&](const Waypoint &next_waypoint) {
+      AppendNext(next_waypoint, distance_on_next_segment, result);
+    });
   }
 
   boost::optional<Waypoint> WaypointGenerator::GetRight(const Waypoint &waypoint) {
@@ -118,12 +126,8 @@ namespace road {
 
     // check if that lane id exists on this distance
     const auto road = map->GetData().GetRoad(this_road_id);
-    const auto mark_record_vector = road->GetRoadInfoMarkRecord(waypoint._dist);
-    for (auto &&mark_record : mark_record_vector) {
-      // find if the lane id exists
-      if (mark_record->GetLaneId() == new_lane_id) {
-        return Waypoint(map, this_road_id, new_lane_id, waypoint._dist);
-      }
+    if (road->GetInfo<RoadInfoMarkRecord>(new_lane_id, waypoint._dist) != nullptr) {
+      return Waypoint(map, this_road_id, new_lane_id, waypoint._dist);
     }
     return boost::optional<Waypoint>();
   }
@@ -146,24 +150,21 @@ namespace road {
 
     // check if that lane id exists on this distance
     const auto road = map->GetData().GetRoad(this_road_id);
-    const auto mark_record_vector = road->GetRoadInfoMarkRecord(waypoint._dist);
-    for (auto &&mark_record : mark_record_vector) {
-      // find if the lane id exists
-      if (mark_record->GetLaneId() == new_lane_id) {
-        return Waypoint(map, this_road_id, new_lane_id, waypoint._dist);
-      }
+    if (road->GetInfo<RoadInfoMarkRecord>(new_lane_id, waypoint._dist) != nullptr) {
+      return Waypoint(map, this_road_id, new_lane_id, waypoint._dist);
     }
     return boost::optional<Waypoint>();
   }
 
   std::vector<Waypoint> WaypointGenerator::GenerateAll(
       const Map &map,
-      const double distance) {
+      const double distance,
+      const LaneType lane_type) {
     std::vector<Waypoint> result;
     for (auto &&road_segment : map.GetData().GetRoadSegments()) {
       /// @todo Should distribute them equally along the segment?
       for (double s = 0.0; s < road_segment.GetLength(); s += distance) {
-        ForEachDrivableLane(road_segment, s, [&](auto lane_id) {
+        ForEachLane(road_segment, s, lane_type, [&](auto lane_id) {
           result.push_back(Waypoint(map.shared_from_this(), road_segment.GetId(), lane_id, s));
         });
       }
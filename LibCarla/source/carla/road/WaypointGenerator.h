@@ -43,10 +43,12 @@ namespace road {
     static boost::optional<Waypoint> GetLeft(
         const Waypoint &waypoint);
 
-    /// Generate all the waypoints in @a map separated by @a approx_distance.
+    /// Generate all the waypoints in @a map separated by @a approx_distance,
+    /// only on the lanes whose type is in the @a lane_type mask.
     static std::vector<Waypoint> GenerateAll(
         const Map &map,
-        double approx_distance);
+        double approx_distance,
+        element::LaneType lane_type = element::LaneType::Driving);
 
     /// Returns a list of waypoints at the beginning of each lane of the map.
     static std::vector<Waypoint> GenerateLaneBegin(
@@ -61,6 +63,18 @@ namespace road {
     static std::vector<std::pair<Waypoint, Waypoint>> GenerateTopology(
         const Map &map);
 
+  private:
+
+    /// Call @a func with each waypoint GetSuccessors would return.
+    template <typename FuncT>
+    static void ForEachSuccessor(const Waypoint &waypoint, FuncT &&func);
+
+    /// Append to @a result the waypoints GetNext would return, the whole
+    /// search fills a single vector.
+    static void AppendNext(
+        const Waypoint &waypoint,
+        double distance,
+        std::vector<Waypoint> &result);
   };
 
 } // namespace road
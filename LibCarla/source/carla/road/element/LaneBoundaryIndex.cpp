@@ -0,0 +1,256 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/element/LaneBoundaryIndex.h"
+
+#include "carla/road/MapData.h"
+#include "carla/road/element/RoadInfoLaneOffset.h"
+#include "carla/road/element/RoadInfoLaneWidth.h"
+#include "carla/road/element/RoadInfoMarkRecord.h"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  /// Maximum distance along the road between the samples of a boundary.
+  static constexpr double SAMPLING_STEP = 1.0;
+
+  /// Side of the cells of the grid, in meters.
+  static constexpr float CELL_SIZE = 8.0f;
+
+  static boost::optional<LaneMarking> GetLaneMarking(const RoadInfoMarkRecord::Type type) {
+    using Type = RoadInfoMarkRecord::Type;
+    switch (type) {
+      case Type::None:         return boost::none;
+      case Type::Solid:        return LaneMarking::Solid;
+      case Type::Broken:       return LaneMarking::Broken;
+      case Type::SolidSolid:   return LaneMarking::SolidSolid;
+      case Type::SolidBroken:  return LaneMarking::SolidBroken;
+      case Type::BrokenSolid:  return LaneMarking::BrokenSolid;
+      case Type::BrokenBroken: return LaneMarking::BrokenBroken;
+      case Type::BottsDots:    return LaneMarking::BottsDots;
+      case Type::Grass:        return LaneMarking::Grass;
+      case Type::Curb:         return LaneMarking::Curb;
+      default:                 return LaneMarking::Other;
+    }
+  }
+
+  /// Lateral offset of the outer boundary of @a lane_id from the reference
+  /// line, placing the lanes the same way as Waypoint::ComputeTransform.
+  static double GetBoundaryOffset(const RoadSegment &road, const int lane_id, const double s) {
+    const auto general_info = road.GetInfo<RoadGeneralInfo>(s);
+    if ((general_info != nullptr) && general_info->IsJunction()) {
+      // Junction lanes use the offsets precomputed by the MapBuilder.
+      const auto info = road.GetInfo<RoadInfoLane>(0.0);
+      const auto lane = info != nullptr ? info->getLane(lane_id) : nullptr;
+      if (lane == nullptr) {
+        const auto offsets = general_info->GetLanesOffset();
+        return offsets.empty() ? 0.0 : offsets.front().second;
+      }
+      return lane->_lane_center_offset + (lane_id < 0 ? -0.5 : 0.5) * lane->_width;
+    }
+    const auto lane_offset = road.GetInfo<RoadInfoLaneOffset>(s);
+    double offset = lane_offset != nullptr ? lane_offset->GetPolynomial().Evaluate(s) : 0.0;
+    const int inc = lane_id < 0 ? -1 : 1;
+    for (int id = inc; (lane_id != 0) && (id != lane_id + inc); id += inc) {
+      const auto width = road.GetInfo<RoadInfoLaneWidth>(id, s);
+      if (width != nullptr) {
+        offset += static_cast<double>(inc) * width->GetPolynomial().Evaluate(s);
+      }
+    }
+    return offset;
+  }
+
+  static int64_t GetCellIndex(const float coordinate) {
+    return static_cast<int64_t>(std::floor(coordinate / CELL_SIZE));
+  }
+
+  /// Pack the cell indices in a key, shifting a negative index is undefined
+  /// so both are converted to unsigned first.
+  static uint64_t GetCellKey(const int64_t i, const int64_t j) {
+    return (static_cast<uint64_t>(i) << 32) | static_cast<uint32_t>(j);
+  }
+
+  static float Cross(float ax, float ay, float bx, float by) {
+    return ax * by - ay * bx;
+  }
+
+  // ===========================================================================
+  // -- LaneBoundaryIndex ------------------------------------------------------
+  // ===========================================================================
+
+  LaneBoundaryIndex::LaneBoundaryIndex(const MapData &map) {
+    for (auto &&road : map.GetRoadSegments()) {
+      // A lane keeps the same boundary across the lane sections, so moving
+      // through the point where two sections meet crosses it once.
+      std::map<int, uint32_t> boundaries;
+      auto get_boundary = [&](int lane_id) {
+        auto it = boundaries.emplace(lane_id, _number_of_boundaries).first;
+        if (it->second == _number_of_boundaries) {
+          ++_number_of_boundaries;
+        }
+        return it->second;
+      };
+      for (auto &&section : road.GetLaneSections()) {
+        if (section.begin >= section.end) {
+          continue;
+        }
+        AddBoundary(road, 0, section.begin, section.end, get_boundary(0));
+        for (auto &&lane_id : section.lanes->getLanesIDs(RoadInfoLane::which_lane_e::Both)) {
+          AddBoundary(road, lane_id, section.begin, section.end, get_boundary(lane_id));
+        }
+      }
+    }
+    BuildGrid();
+  }
+
+  void LaneBoundaryIndex::AddBoundary(
+      const RoadSegment &road,
+      const int lane_id,
+      const double begin,
+      const double end,
+      const uint32_t boundary) {
+    const auto records = road.GetLaneInfos<RoadInfoMarkRecord>(lane_id);
+    if (records == nullptr) {
+      return;
+    }
+    // Sample regularly plus at the start of every road mark record, so each
+    // segment has a single road mark.
+    std::vector<double> samples;
+    for (double s = begin; s < end; s += SAMPLING_STEP) {
+      samples.emplace_back(s);
+    }
+    samples.emplace_back(end);
+    for (auto &&record : records->GetAllBefore(end)) {
+      if ((record->d > begin) && (record->d < end)) {
+        samples.emplace_back(record->d);
+      }
+    }
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    auto get_point = [&](double s) {
+      auto point = road.GetDirectedPointIn(s);
+      point.ApplyLateralOffset(GetBoundaryOffset(road, lane_id, s));
+      return point.location;
+    };
+    auto previous = get_point(samples.front());
+    for (auto i = 1u; i < samples.size(); ++i) {
+      const auto next = get_point(samples[i]);
+      const auto record = road.GetInfo<RoadInfoMarkRecord>(lane_id, samples[i - 1u]);
+      const auto marking = record != nullptr ?
+          GetLaneMarking(record->GetType()) :
+          boost::optional<LaneMarking>{};
+      if (marking.has_value()) {
+        _segments.push_back({previous.x, previous.y, next.x, next.y, boundary, *marking});
+      }
+      previous = next;
+    }
+  }
+
+  void LaneBoundaryIndex::BuildGrid() {
+    // Each segment goes in every cell of its bounding box.
+    std::vector<std::pair<uint64_t, uint32_t>> entries;
+    for (auto id = 0u; id < _segments.size(); ++id) {
+      const auto &segment = _segments[id];
+      const auto i0 = GetCellIndex(std::min(segment.x0, segment.x1));
+      const auto i1 = GetCellIndex(std::max(segment.x0, segment.x1));
+      const auto j0 = GetCellIndex(std::min(segment.y0, segment.y1));
+      const auto j1 = GetCellIndex(std::max(segment.y0, segment.y1));
+      for (auto i = i0; i <= i1; ++i) {
+        for (auto j = j0; j <= j1; ++j) {
+          entries.emplace_back(GetCellKey(i, j), id);
+        }
+      }
+    }
+    std::sort(entries.begin(), entries.end());
+    _cell_segments.reserve(entries.size());
+    for (auto &&entry : entries) {
+      if (_cells.empty() || (_cells.back() != entry.first)) {
+        _cells.emplace_back(entry.first);
+        _cell_offsets.emplace_back(static_cast<uint32_t>(_cell_segments.size()));
+      }
+      _cell_segments.emplace_back(entry.second);
+    }
+    _cell_offsets.emplace_back(static_cast<uint32_t>(_cell_segments.size()));
+  }
+
+  std::vector<LaneMarking> LaneBoundaryIndex::FindCrossings(
+      const geom::Location &origin,
+      const geom::Location &destination) const {
+    const auto i0 = GetCellIndex(std::min(origin.x, destination.x));
+    const auto i1 = GetCellIndex(std::max(origin.x, destination.x));
+    const auto j0 = GetCellIndex(std::min(origin.y, destination.y));
+    const auto j1 = GetCellIndex(std::max(origin.y, destination.y));
+
+    const float dx = destination.x - origin.x;
+    const float dy = destination.y - origin.y;
+
+    struct Crossing {
+      float t;
+      uint32_t boundary;
+      LaneMarking marking;
+    };
+    std::vector<Crossing> crossings;
+    for (auto i = i0; i <= i1; ++i) {
+      for (auto j = j0; j <= j1; ++j) {
+        const auto key = GetCellKey(i, j);
+        const auto it = std::lower_bound(_cells.begin(), _cells.end(), key);
+        if ((it == _cells.end()) || (*it != key)) {
+          continue;
+        }
+        const auto cell = static_cast<size_t>(it - _cells.begin());
+        for (auto k = _cell_offsets[cell]; k < _cell_offsets[cell + 1u]; ++k) {
+          const auto &segment = _segments[_cell_segments[k]];
+          const float ex = segment.x1 - segment.x0;
+          const float ey = segment.y1 - segment.y0;
+          const float denominator = Cross(dx, dy, ex, ey);
+          if (denominator == 0.0f) {
+            // Parallel, moving along a boundary does not cross it.
+            continue;
+          }
+          const float qx = segment.x0 - origin.x;
+          const float qy = segment.y0 - origin.y;
+          const float t = Cross(qx, qy, ex, ey) / denominator;
+          const float u = Cross(qx, qy, dx, dy) / denominator;
+          if ((t >= 0.0f) && (t <= 1.0f) && (u >= 0.0f) && (u <= 1.0f)) {
+            crossings.push_back({t, segment.boundary, segment.marking});
+          }
+        }
+      }
+    }
+    // A segment can be in several cells, and a movement through the common
+    // point of two segments of a boundary hits both; count it once.
+    std::sort(crossings.begin(), crossings.end(), [](const Crossing &lhs, const Crossing &rhs) {
+      return lhs.t < rhs.t;
+    });
+    std::vector<LaneMarking> result;
+    for (auto i = 0u; i < crossings.size(); ++i) {
+      bool duplicate = false;
+      for (auto j = i; (j > 0u) && (crossings[i].t - crossings[j - 1u].t < 1e-4f); --j) {
+        duplicate = duplicate || (crossings[j - 1u].boundary == crossings[i].boundary);
+      }
+      if (!duplicate) {
+        result.emplace_back(crossings[i].marking);
+      }
+    }
+    return result;
+  }
+
+} // namespace element
+} // namespace road
+} // namespace carla
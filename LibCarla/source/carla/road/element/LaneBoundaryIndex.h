@@ -0,0 +1,88 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/Types.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class MapData;
+
+namespace element {
+
+  class RoadSegment;
+
+  /// The marked lane boundaries of a map as 2D polylines, with a uniform
+  /// grid over their segments to find the ones crossed by a movement.
+  ///
+  /// Every lane contributes its outer boundary along the lane sections it is
+  /// in, and the center lane the boundary between left and right lanes, with
+  /// the type of the road mark records of the lane. Boundaries without road
+  /// mark, or with a road mark of type "none", are left out.
+  class LaneBoundaryIndex : private MovableNonCopyable {
+  public:
+
+    explicit LaneBoundaryIndex(const MapData &map);
+
+    size_t GetNumberOfSegments() const {
+      return _segments.size();
+    }
+
+    /// Lane markings crossed by the straight movement from @a origin to
+    /// @a destination, in the order they are crossed. The height is
+    /// ignored.
+    std::vector<LaneMarking> FindCrossings(
+        const geom::Location &origin,
+        const geom::Location &destination) const;
+
+  private:
+
+    struct Segment {
+      float x0;
+      float y0;
+      float x1;
+      float y1;
+      /// Index of the boundary this segment belongs to.
+      uint32_t boundary;
+      LaneMarking marking;
+    };
+
+    /// Add the segments of the outer boundary of @a lane_id from @a begin to
+    /// @a end along the road, the part of a lane section.
+    void AddBoundary(
+        const RoadSegment &road,
+        int lane_id,
+        double begin,
+        double end,
+        uint32_t boundary);
+
+    void BuildGrid();
+
+    std::vector<Segment> _segments;
+
+    uint32_t _number_of_boundaries = 0u;
+
+    /// Cells of the grid holding at least one segment, sorted.
+    std::vector<uint64_t> _cells;
+
+    /// Segments of each cell, _cells[i] spans
+    /// [_cell_offsets[i], _cell_offsets[i + 1]) of _cell_segments.
+    std::vector<uint32_t> _cell_offsets;
+
+    std::vector<uint32_t> _cell_segments;
+  };
+
+} // namespace element
+} // namespace road
+} // namespace carla
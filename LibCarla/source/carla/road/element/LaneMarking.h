@@ -10,10 +10,18 @@ namespace carla {
 namespace road {
 namespace element {
 
+  /// Type of the road mark on a lane boundary, see RoadInfoMarkRecord::Type.
   enum class LaneMarking {
     Other,
     Broken,
-    Solid
+    Solid,
+    SolidSolid,
+    SolidBroken,
+    BrokenSolid,
+    BrokenBroken,
+    BottsDots,
+    Grass,
+    Curb
   };
 
 } // namespace element
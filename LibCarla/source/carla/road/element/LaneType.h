@@ -0,0 +1,58 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// Lane types of the OpenDRIVE specification, can be used as flags to build
+  /// a mask of several types, e.g. `LaneType::Driving | LaneType::Parking`.
+  enum class LaneType : uint32_t {
+    None          = 0x1,
+    Driving       = 0x1 << 1,
+    Stop          = 0x1 << 2,
+    Shoulder      = 0x1 << 3,
+    Biking        = 0x1 << 4,
+    Sidewalk      = 0x1 << 5,
+    Border        = 0x1 << 6,
+    Restricted    = 0x1 << 7,
+    Parking       = 0x1 << 8,
+    Bidirectional = 0x1 << 9,
+    Median        = 0x1 << 10,
+    Special1      = 0x1 << 11,
+    Special2      = 0x1 << 12,
+    Special3      = 0x1 << 13,
+    RoadWorks     = 0x1 << 14,
+    Tram          = 0x1 << 15,
+    Rail          = 0x1 << 16,
+    Entry         = 0x1 << 17,
+    Exit          = 0x1 << 18,
+    OffRamp       = 0x1 << 19,
+    OnRamp        = 0x1 << 20,
+    /// Every type except None.
+    Any           = 0xFFFFFFFE
+  };
+
+  constexpr LaneType operator|(LaneType lhs, LaneType rhs) {
+    return static_cast<LaneType>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+  }
+
+  constexpr LaneType operator&(LaneType lhs, LaneType rhs) {
+    return static_cast<LaneType>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+  }
+
+  /// Whether @a type is one of the types in @a mask.
+  constexpr bool IsLaneTypeIn(LaneType type, LaneType mask) {
+    return (static_cast<uint32_t>(type) & static_cast<uint32_t>(mask)) != 0u;
+  }
+
+} // namespace element
+} // namespace road
+} // namespace carla
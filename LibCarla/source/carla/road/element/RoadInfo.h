@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include "carla/road/element/LaneType.h"
 #include "carla/road/element/RoadInfoVisitor.h"
 
+#include <algorithm>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace carla {
 namespace road {
@@ -156,16 +159,17 @@ namespace element {
     double _width;
     double _lane_center_offset;
 
-    std::string _type;
+    LaneType _type;
     std::vector<int> _successor;
     std::vector<int> _predecessor;
 
     LaneInfo()
       : _id(0),
         _width(0.0),
-        _lane_center_offset(0.0) {}
+        _lane_center_offset(0.0),
+        _type(LaneType::None) {}
 
-    LaneInfo(int id, double width, const std::string &type)
+    LaneInfo(int id, double width, LaneType type)
       : _id(id),
         _width(width),
         _lane_center_offset(0.0),
@@ -193,7 +197,7 @@ namespace element {
       Both
     };
 
-    void addLaneInfo(int id, double width, const std::string &type) {
+    void addLaneInfo(int id, double width, LaneType type) {
       _lanes[id] = LaneInfo(id, width, type);
     }
 
@@ -0,0 +1,125 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/ListView.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// RoadInfo of a single type sorted by the distance from the start of the
+  /// road, infos at the same distance keep their insertion order. Lookups are
+  /// binary searches that do not allocate.
+  template <typename T>
+  class RoadInfoArray {
+  public:
+
+    using value_type = std::shared_ptr<T>;
+
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    using const_reverse_iterator = typename std::vector<value_type>::const_reverse_iterator;
+
+    void Add(value_type info) {
+      auto it = std::upper_bound(_infos.begin(), _infos.end(), info->d, LessComp{});
+      _infos.insert(it, std::move(info));
+    }
+
+    bool empty() const {
+      return _infos.empty();
+    }
+
+    size_t size() const {
+      return _infos.size();
+    }
+
+    /// Last info starting at or before @a dist, nullptr if none.
+    T *GetLast(double dist) const {
+      auto it = UpperBound(dist);
+      return it == _infos.begin() ? nullptr : std::prev(it)->get();
+    }
+
+    /// First info starting at or after @a dist, nullptr if none.
+    T *GetFirst(double dist) const {
+      auto it = LowerBound(dist);
+      return it == _infos.end() ? nullptr : it->get();
+    }
+
+    /// Infos starting at or before @a dist, nearest first.
+    auto GetAllBefore(double dist) const {
+      return MakeListView(const_reverse_iterator(UpperBound(dist)), _infos.crend());
+    }
+
+    /// Infos starting at or after @a dist, nearest first.
+    auto GetAllAfter(double dist) const {
+      return MakeListView(LowerBound(dist), _infos.cend());
+    }
+
+  private:
+
+    struct LessComp {
+      bool operator()(double lhs, const value_type &rhs) const {
+        return lhs < rhs->d;
+      }
+      bool operator()(const value_type &lhs, double rhs) const {
+        return lhs->d < rhs;
+      }
+    };
+
+    const_iterator UpperBound(double dist) const {
+      return std::upper_bound(_infos.begin(), _infos.end(), dist, LessComp{});
+    }
+
+    const_iterator LowerBound(double dist) const {
+      return std::lower_bound(_infos.begin(), _infos.end(), dist, LessComp{});
+    }
+
+    std::vector<value_type> _infos;
+  };
+
+  /// RoadInfo of a single per-lane type (it must provide GetLaneId), one
+  /// RoadInfoArray for each lane sorted by lane id.
+  template <typename T>
+  class RoadInfoLaneArray {
+  public:
+
+    void Add(std::shared_ptr<T> info) {
+      const int lane_id = info->GetLaneId();
+      auto it = std::lower_bound(_lanes.begin(), _lanes.end(), lane_id, LessComp{});
+      if ((it == _lanes.end()) || (it->first != lane_id)) {
+        it = _lanes.emplace(it, lane_id, RoadInfoArray<T>{});
+      }
+      it->second.Add(std::move(info));
+    }
+
+    /// Infos of @a lane_id, nullptr if the lane has none.
+    const RoadInfoArray<T> *GetLane(int lane_id) const {
+      auto it = std::lower_bound(_lanes.begin(), _lanes.end(), lane_id, LessComp{});
+      return ((it == _lanes.end()) || (it->first != lane_id)) ? nullptr : &it->second;
+    }
+
+  private:
+
+    struct LessComp {
+      bool operator()(const std::pair<int, RoadInfoArray<T>> &lhs, int rhs) const {
+        return lhs.first < rhs;
+      }
+    };
+
+    std::vector<std::pair<int, RoadInfoArray<T>>> _lanes;
+  };
+
+} // namespace element
+} // namespace road
+} // namespace carla
@@ -8,7 +8,9 @@
 
 #include "carla/road/element/RoadInfo.h"
 
+#include <cstdint>
 #include <string>
+#include <utility>
 
 namespace carla {
 namespace road {
@@ -34,12 +36,41 @@ namespace element {
       Both     = 0x03  //11
     };
 
+    enum class Type : uint8_t {
+      None,
+      Solid,
+      Broken,
+      SolidSolid,   // for double solid line
+      SolidBroken,  // from inside to outside, exception: center lane - from left to right
+      BrokenSolid,  // from inside to outside, exception: center lane - from left to right
+      BrokenBroken, // from inside to outside, exception: center lane - from left to right
+      BottsDots,
+      Grass,        // meaning a grass edge
+      Curb,
+      Other
+    };
+
+    enum class Color : uint8_t {
+      Standard, // equivalent to white
+      Blue,
+      Green,
+      Red,
+      White,
+      Yellow,
+      Other
+    };
+
+    enum class Weight : uint8_t {
+      Standard,
+      Bold
+    };
+
     RoadInfoMarkRecord(double d, int lane_id)
       : RoadInfo(d),
         _lane_id(lane_id),
-        _type(""),
-        _weight(""),
-        _color("white"),
+        _type(Type::None),
+        _weight(Weight::Standard),
+        _color(Color::White),
         _material("standard"),
         _width(0.15),
         _lane_change(LaneChange::None),
@@ -48,9 +79,9 @@ namespace element {
     RoadInfoMarkRecord(
         double d,
         int lane_id,
-        std::string type,
-        std::string weight,
-        std::string color,
+        Type type,
+        Weight weight,
+        Color color,
         std::string material,
         double width,
         LaneChange lane_change,
@@ -60,7 +91,7 @@ namespace element {
         _type(type),
         _weight(weight),
         _color(color),
-        _material(material),
+        _material(std::move(material)),
         _width(width),
         _lane_change(lane_change),
         _height(height) {}
@@ -69,15 +100,15 @@ namespace element {
       return _lane_id;
     }
 
-    const std::string &GetType() const {
+    Type GetType() const {
       return _type;
     }
 
-    const std::string &GetWeight() const {
+    Weight GetWeight() const {
       return _weight;
     }
 
-    const std::string &GetColor() const {
+    Color GetColor() const {
       return _color;
     }
 
@@ -103,9 +134,9 @@ namespace element {
 
     signed_id _lane_id = 0;
 
-    std::string _type;       // Type of the road mark
-    std::string _weight;     // Weight of the road mark
-    std::string _color;      // Color of the road mark
+    Type _type;              // Type of the road mark
+    Weight _weight;          // Weight of the road mark
+    Color _color;            // Color of the road mark
     std::string _material;   // Material of the road mark (identifiers to be
                              // defined, use "standard" for the moment
     double _width;           // Width of the road mark –optional
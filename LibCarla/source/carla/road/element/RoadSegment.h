@@ -12,11 +12,12 @@
 #include "carla/road/element/RoadInfoLaneWidth.h"
 #include "carla/road/element/RoadInfoLaneOffset.h"
 #include "carla/road/element/RoadInfo.h"
+#include "carla/road/element/RoadInfoArray.h"
 #include "carla/road/element/Types.h"
 
 #include <limits>
 #include <memory>
-#include <set>
+#include <tuple>
 #include <vector>
 #include <algorithm>
 
@@ -30,6 +31,13 @@ namespace element {
   class RoadSegment : private NonCopyable {
   public:
 
+    /// The lanes of a lane section of the road, from @a begin to @a end.
+    struct LaneSection {
+      const RoadInfoLane *lanes;
+      double begin;
+      double end;
+    };
+
     RoadSegment(id_type id) : _id(id) {}
 
     RoadSegment(RoadSegmentDefinition &&def)
@@ -39,8 +47,9 @@ namespace element {
         _geom(std::move(def._geom)),
         _next_lane(std::move(def._next_lane)),
         _prev_lane(std::move(def._prev_lane)) {
+      InfoInserter inserter(*this);
       for (auto &&a : def._info) {
-        _info.insert(std::move(a));
+        inserter.Insert(std::move(a));
       }
     }
 
@@ -51,102 +60,57 @@ namespace element {
     /// Returns single info given a type and a distance from
     /// the start of the road (negative lanes)
     template <typename T>
-    std::shared_ptr<const T> GetInfo(double dist) const {
-      auto up_bound = decltype(_info)::reverse_iterator(_info.upper_bound(dist));
-      auto it = MakeRoadInfoIterator<T>(up_bound, _info.rend());
-      return it.IsAtEnd() ? nullptr : *it;
+    const T *GetInfo(double dist) const {
+      return std::get<RoadInfoArray<T>>(_info).GetLast(dist);
     }
 
     /// Returns single info given a type and a distance from
     /// the end of the road (positive lanes)
     template <typename T>
-    std::shared_ptr<const T> GetInfoReverse(double dist) const {
-      auto lo_bound = _info.lower_bound(dist);
-      auto it = MakeRoadInfoIterator<T>(lo_bound, _info.end());
-      return it.IsAtEnd() ? nullptr : *it;
+    const T *GetInfoReverse(double dist) const {
+      return std::get<RoadInfoArray<T>>(_info).GetFirst(dist);
     }
 
-    /// Returns info vector given a type and a distance from
-    /// the start of the road (negative lanes)
+    /// Returns single info of lane @a lane_id given a type and a distance
+    /// from the start of the road. Only for the types with lane id info
+    /// (RoadInfoLaneWidth and RoadInfoMarkRecord).
     template <typename T>
-    std::vector<std::shared_ptr<const T>> GetInfos(double dist) const {
-      auto up_bound = decltype(_info)::reverse_iterator(_info.upper_bound(dist));
-      auto it = MakeRoadInfoIterator<T>(up_bound, _info.rend());
-
-      std::vector<std::shared_ptr<const T>> result;
-      for (; !it.IsAtEnd(); ++it) {
-        result.emplace_back(*it);
-      }
-      return result;
+    const T *GetInfo(int lane_id, double dist) const {
+      const auto *lane = GetLaneInfos<T>(lane_id);
+      return lane != nullptr ? lane->GetLast(dist) : nullptr;
     }
 
-    /// Returns info vector given a type and a distance from
-    /// the end of the road (positive lanes)
+    /// Returns all the infos of lane @a lane_id given a type, nullptr if
+    /// the lane has none.
     template <typename T>
-    std::vector<std::shared_ptr<const T>> GetInfosReverse(double dist) const {
-      auto lo_bound = _info.lower_bound(dist);
-      auto it = MakeRoadInfoIterator<T>(lo_bound, _info.end());
-
-      std::vector<std::shared_ptr<const T>> result;
-      for (; !it.IsAtEnd(); ++it) {
-        result.emplace_back(*it);
-      }
-      return result;
+    const RoadInfoArray<T> *GetLaneInfos(int lane_id) const {
+      return std::get<RoadInfoLaneArray<T>>(_lane_info).GetLane(lane_id);
     }
 
-    /// Workaround where we must find a specific (RoadInfoMarkRecord) RoadInfo
-    /// that must have lane_id info. In this case this info is used for selecting
-    /// only the nearest RoadInfos to the "dist" input.
-    std::vector<std::shared_ptr<const RoadInfoMarkRecord>> GetRoadInfoMarkRecord(
-        double dist) const {
-      auto mark_record_info = GetInfos<RoadInfoMarkRecord>(dist);
-      std::vector<std::shared_ptr<const RoadInfoMarkRecord>> result;
-      std::unordered_set<int> inserted_lanes;
-
-      for (auto &&mark_record : mark_record_info) {
-        const int lane_id = mark_record->GetLaneId();
-        const bool is_new_lane = inserted_lanes.insert(lane_id).second;
-        if (is_new_lane) {
-          result.emplace_back(mark_record);
-        }
-      }
-      return result;
+    /// Returns a view of the infos given a type and a distance from
+    /// the start of the road (negative lanes), nearest first
+    template <typename T>
+    auto GetInfos(double dist) const {
+      return std::get<RoadInfoArray<T>>(_info).GetAllBefore(dist);
     }
 
-    /// Workaround where we must find a specific (RoadInfoMarkRecord) RoadInfo
-    /// that must have lane_id info. In this case this info is used for selecting
-    /// only the nearest RoadInfos to the "dist" input. But reversed!
-    std::vector<std::shared_ptr<const RoadInfoMarkRecord>> GetRoadInfoMarkRecordReverse(
-        double dist) const {
-      auto mark_record_info = GetInfosReverse<RoadInfoMarkRecord>(dist);
-      std::vector<std::shared_ptr<const RoadInfoMarkRecord>> result;
-      std::unordered_set<int> inserted_lanes;
-
-      for (auto &&mark_record : mark_record_info) {
-        const int lane_id = mark_record->GetLaneId();
-        const bool is_new_lane = inserted_lanes.insert(lane_id).second;
-        if (is_new_lane) {
-          result.emplace_back(mark_record);
-        }
-      }
-      return result;
+    /// Returns a view of the infos given a type and a distance from
+    /// the end of the road (positive lanes), nearest first
+    template <typename T>
+    auto GetInfosReverse(double dist) const {
+      return std::get<RoadInfoArray<T>>(_info).GetAllAfter(dist);
     }
 
-    /// Workaround where we must find a specific (RoadInfoLaneWidth) RoadInfo
-    /// that must have lane_id info. In this case this info is used for selecting
-    /// only the nearest RoadInfos to the "dist" input.
-    std::vector<std::shared_ptr<const RoadInfoLaneWidth>> GetRoadInfoLaneWidth(
-        double dist) const {
-      auto lane_offset_info = GetInfos<RoadInfoLaneWidth>(dist);
-      std::vector<std::shared_ptr<const RoadInfoLaneWidth>> result;
-      std::unordered_set<int> inserted_lanes;
-
-      for (auto &&lane_offset : lane_offset_info) {
-        const int lane_id = lane_offset->GetLaneId();
-        const bool is_new_lane = inserted_lanes.insert(lane_id).second;
-        if (is_new_lane) {
-          result.emplace_back(lane_offset);
+    /// Returns the lane sections of the road in increasing distance, each one
+    /// ends where the next one begins and the last one at the end of the
+    /// road. A lane may only be in some of them.
+    std::vector<LaneSection> GetLaneSections() const {
+      std::vector<LaneSection> result;
+      for (auto &&info : GetInfosReverse<RoadInfoLane>(0.0)) {
+        if (!result.empty()) {
+          result.back().end = info->d;
         }
+        result.push_back({info.get(), info->d, _length});
       }
       return result;
     }
@@ -291,7 +255,12 @@ namespace element {
     ///   @param dist distance from the begining of the road to the point you
     ///          want to calculate the distance
     ///   @param loc point to calculate the distance
-    std::pair<int, double> GetNearestLane(double dist, const geom::Location &loc) const {
+    ///   @param lane_type mask of the lane types to consider, the lane id is 0
+    ///          if the road has no lane of these types
+    std::pair<int, double> GetNearestLane(
+        double dist,
+        const geom::Location &loc,
+        LaneType lane_type = LaneType::Driving) const {
       const DirectedPoint dp_center_road = GetDirectedPointIn(dist);
       auto info = GetInfo<RoadInfoLane>(0.0);
 
@@ -302,7 +271,7 @@ namespace element {
           info->getLanesIDs(carla::road::element::RoadInfoLane::which_lane_e::Both)) {
         const auto current_lane_info = info->getLane(current_lane_id);
 
-        if (current_lane_info->_type == "driving") {
+        if (IsLaneTypeIn(current_lane_info->_type, lane_type)) {
           DirectedPoint dp_center_lane = dp_center_road;
           dp_center_lane.ApplyLateralOffset(current_lane_info->_lane_center_offset);
 
@@ -336,23 +305,52 @@ namespace element {
 
     friend class carla::road::MapBuilder;
 
-    struct LessComp {
-      using is_transparent = void;
-      bool operator()(
-          const std::shared_ptr<RoadInfo> &a,
-          const std::shared_ptr<RoadInfo> &b) const {
-        return a->d < b->d;
+    /// Sorts each RoadInfo into the array of its type.
+    class InfoInserter : private RoadInfoVisitor {
+    public:
+
+      explicit InfoInserter(RoadSegment &road) : _road(road) {}
+
+      void Insert(std::shared_ptr<RoadInfo> info) {
+        _current = std::move(info);
+        _current->AcceptVisitor(*this);
+      }
+
+    private:
+
+      template <typename T>
+      void Add(T &) {
+        std::get<RoadInfoArray<T>>(_road._info).Add(std::static_pointer_cast<T>(_current));
       }
-      bool operator()(
-          const double &a,
-          const std::shared_ptr<RoadInfo> &b) const {
-        return a < b->d;
+
+      template <typename T>
+      void AddToLane(T &) {
+        std::get<RoadInfoLaneArray<T>>(_road._lane_info).Add(std::static_pointer_cast<T>(_current));
+      }
+
+      void Visit(RoadInfoLane &info) final { Add(info); }
+
+      void Visit(RoadGeneralInfo &info) final { Add(info); }
+
+      void Visit(RoadInfoVelocity &info) final { Add(info); }
+
+      void Visit(RoadElevationInfo &info) final { Add(info); }
+
+      void Visit(RoadInfoLaneOffset &info) final { Add(info); }
+
+      void Visit(RoadInfoLaneWidth &info) final {
+        Add(info);
+        AddToLane(info);
       }
-      bool operator()(
-          const std::shared_ptr<RoadInfo> &a,
-          const double &b) const {
-        return a->d < b;
+
+      void Visit(RoadInfoMarkRecord &info) final {
+        Add(info);
+        AddToLane(info);
       }
+
+      RoadSegment &_road;
+
+      std::shared_ptr<RoadInfo> _current;
     };
 
   private:
@@ -365,7 +363,22 @@ namespace element {
     std::vector<bool> _successors_is_start;
     std::vector<bool> _predecessors_is_start;
     std::vector<std::unique_ptr<Geometry>> _geom;
-    std::multiset<std::shared_ptr<RoadInfo>, LessComp> _info;
+
+    /// One array per RoadInfo type, sorted by distance.
+    std::tuple<
+        RoadInfoArray<RoadInfoLane>,
+        RoadInfoArray<RoadGeneralInfo>,
+        RoadInfoArray<RoadInfoVelocity>,
+        RoadInfoArray<RoadElevationInfo>,
+        RoadInfoArray<RoadInfoLaneWidth>,
+        RoadInfoArray<RoadInfoMarkRecord>,
+        RoadInfoArray<RoadInfoLaneOffset>> _info;
+
+    /// Same as above, split by lane for the types with lane id info.
+    std::tuple<
+        RoadInfoLaneArray<RoadInfoLaneWidth>,
+        RoadInfoLaneArray<RoadInfoMarkRecord>> _lane_info;
+
     double _length = -1.0;
 
     // first  int     current lane
@@ -10,14 +10,16 @@
 #include "carla/geom/CubicPolynomial.h"
 #include "carla/geom/Math.h"
 
-#include <unordered_map>
 #include <algorithm>
 
 namespace carla {
 namespace road {
 namespace element {
 
-  Waypoint::Waypoint(SharedPtr<const Map> m, const geom::Location &loc)
+  Waypoint::Waypoint(
+      SharedPtr<const Map> m,
+      const geom::Location &loc,
+      const LaneType lane_type)
     : _map(m) {
     DEBUG_ASSERT(_map != nullptr);
     // max_nearests represents the max nearests roads
@@ -63,7 +65,7 @@ namespace element {
     // search for the nearest lane in nearest_dist
     auto nearest_lane_dist = std::numeric_limits<double>::max();
     for (int i = 0; i < max_nearest_allowed; ++i) {
-      auto lane_dist = _map->GetData().GetRoad(ids[i])->GetNearestLane(dists[i], loc);
+      auto lane_dist = _map->GetData().GetRoad(ids[i])->GetNearestLane(dists[i], loc, lane_type);
 
       if (lane_dist.second < nearest_lane_dist) {
         nearest_lane_dist = lane_dist.second;
@@ -73,8 +75,9 @@ namespace element {
       }
     }
 
-    DEBUG_ASSERT(_dist <= _map->GetData().GetRoad(_road_id)->GetLength());
-    DEBUG_ASSERT(_lane_id != 0);
+    DEBUG_ASSERT(
+        (_lane_id == 0) ||
+        (_dist <= _map->GetData().GetRoad(_road_id)->GetLength()));
   }
 
   Waypoint::Waypoint(
@@ -118,33 +121,26 @@ namespace element {
       const auto lane_offset_info = road_segment->GetInfo<RoadInfoLaneOffset>(_dist);
       geom::CubicPolynomial final_polynomial = lane_offset_info->GetPolynomial();
 
-      // fill a map (lane_info_map) with first lane id <id, RoadInfoLaneWidth> found
-      // because will be the nearest one that is affecting at this dist (t)
-      const auto lane_width_info = road_segment->GetInfos<RoadInfoLaneWidth>(_dist);
-      std::unordered_map<int, std::shared_ptr<const RoadInfoLaneWidth>> lane_info_map;
-      std::unordered_set<int> inserted_lanes;
-
-      for (auto &&lane_offset : lane_width_info) {
-        const int current_lane_id = lane_offset->GetLaneId();
-        lane_info_map.emplace(
-            std::pair<int, std::shared_ptr<const RoadInfoLaneWidth>>(
-              current_lane_id,
-              lane_offset));
-      }
-
       DEBUG_ASSERT(_lane_id != 0);
 
+      // the nearest RoadInfoLaneWidth of each lane is the one affecting at
+      // this dist (t)
+      auto get_lane_width = [&](int lane_id) {
+        const auto *lane_width = road_segment->GetInfo<RoadInfoLaneWidth>(lane_id, _dist);
+        DEBUG_ASSERT(lane_width != nullptr);
+        return lane_width->GetPolynomial();
+      };
+
       // iterate over the previous lanes until lane_id is 0 and add the polynomial info
       const int inc = _lane_id < 0 ? - 1 : + 1;
       // increase or decrease the lane_id depending on if _lane_id is
       // positive or negative in order to get closer to that id
       for (int lane_id = inc; lane_id != _lane_id; lane_id += inc) {
-        // final_polynomial += geom::CubicPolynomial();
-        final_polynomial += lane_info_map[lane_id]->GetPolynomial() * (_lane_id < 0 ? -1.0 : 1.0);
+        final_polynomial += get_lane_width(lane_id) * (_lane_id < 0 ? -1.0 : 1.0);
       }
 
       // use half of the last polynomial to get the center of the road
-      final_polynomial += lane_info_map[_lane_id]->GetPolynomial() * (_lane_id < 0 ? -0.5 : 0.5);
+      final_polynomial += get_lane_width(_lane_id) * (_lane_id < 0 ? -0.5 : 0.5);
 
       // compute the final lane offset
       dp.ApplyLateralOffset(final_polynomial.Evaluate(_dist));
@@ -156,7 +152,7 @@ namespace element {
     return geom::Transform(dp.location, rot);
   }
 
-  const std::string &Waypoint::GetType() const {
+  LaneType Waypoint::GetType() const {
     return _map->GetData().GetRoad(_road_id)->GetInfo<RoadInfoLane>(_dist)->getLane(_lane_id)->_type;
   }
 
@@ -172,14 +168,8 @@ namespace element {
   }
 
   double Waypoint::GetLaneWidth() const {
-    const auto *road_segment = _map->GetData().GetRoad(_road_id);
-    const auto lane_width_info = road_segment->GetInfos<RoadInfoLaneWidth>(_dist);
-    for (auto &&lane : lane_width_info) {
-      if (lane->GetLaneId() == _lane_id) {
-        return lane->GetPolynomial().Evaluate(_dist);
-      }
-    }
-    return 0.0;
+    const auto *lane_width = GetRoadSegment().GetInfo<RoadInfoLaneWidth>(_lane_id, _dist);
+    return lane_width != nullptr ? lane_width->GetPolynomial().Evaluate(_dist) : 0.0;
   }
 
   std::pair<RoadInfoMarkRecord, RoadInfoMarkRecord> Waypoint::GetMarkRecord() const {
@@ -188,21 +178,13 @@ namespace element {
     // so the inner lane marking is the opposite one
     const auto lane_id_left = _lane_id <= 0 ? _lane_id + 1 : _lane_id - 1;
 
-    const auto mark_record_list = GetRoadSegment().GetRoadInfoMarkRecord(_dist);
-
-    std::pair<RoadInfoMarkRecord, RoadInfoMarkRecord> result = std::make_pair(
-        RoadInfoMarkRecord(_dist, lane_id_right),
-        RoadInfoMarkRecord(_dist, lane_id_left));
-
-    for (auto &&i : mark_record_list) {
-      if (i->GetLaneId() == lane_id_right) {
-        result.first = *i;
-      } else if (i->GetLaneId() == lane_id_left) {
-        result.second = *i;
-      }
-    }
+    const auto &road_segment = GetRoadSegment();
+    const auto *right = road_segment.GetInfo<RoadInfoMarkRecord>(lane_id_right, _dist);
+    const auto *left = road_segment.GetInfo<RoadInfoMarkRecord>(lane_id_left, _dist);
 
-    return result;
+    return std::make_pair(
+        right != nullptr ? *right : RoadInfoMarkRecord(_dist, lane_id_right),
+        left != nullptr ? *left : RoadInfoMarkRecord(_dist, lane_id_left));
   }
 
 } // namespace element
@@ -8,6 +8,7 @@
 
 #include "carla/geom/Transform.h"
 #include "carla/Memory.h"
+#include "carla/road/element/LaneType.h"
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/RoadInfoList.h"
 #include "carla/road/element/Types.h"
@@ -15,7 +16,11 @@
 namespace carla {
 namespace road {
 
+  class LaneOccupancy;
+  class LanePolylines;
+  class LaneTracker;
   class Map;
+  class RoutingGraph;
   class WaypointGenerator;
 
 namespace element {
@@ -37,7 +42,7 @@ namespace element {
       return _lane_id;
     }
 
-    const std::string &GetType() const;
+    LaneType GetType() const;
 
     const RoadSegment &GetRoadSegment() const;
 
@@ -50,10 +55,16 @@ namespace element {
 
   private:
 
+    friend carla::road::LaneOccupancy;
+    friend carla::road::LanePolylines;
+    friend carla::road::LaneTracker;
     friend carla::road::Map;
+    friend carla::road::RoutingGraph;
     friend carla::road::WaypointGenerator;
 
-    Waypoint(SharedPtr<const Map>, const geom::Location &location);
+    /// Nearest lane of a type in the @a lane_type mask, the lane id is 0 if
+    /// there is none.
+    Waypoint(SharedPtr<const Map>, const geom::Location &location, LaneType lane_type);
 
     Waypoint(
         SharedPtr<const Map> map,
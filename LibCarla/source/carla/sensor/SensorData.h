@@ -23,12 +23,19 @@ namespace sensor {
       private NonCopyable {
   protected:
 
-    SensorData(size_t frame_number, const rpc::Transform &sensor_transform)
+    SensorData(
+        size_t frame_number,
+        double timestamp,
+        const rpc::Transform &sensor_transform)
       : _frame_number(frame_number),
+        _timestamp(timestamp),
         _sensor_transform(sensor_transform) {}
 
     explicit SensorData(const RawData &data)
-      : SensorData(data.GetFrameNumber(), data.GetSensorTransform()) {}
+      : SensorData(
+            data.GetFrameNumber(),
+            data.GetTimestamp(),
+            data.GetSensorTransform()) {}
 
   public:
 
@@ -39,6 +46,12 @@ namespace sensor {
       return _frame_number;
     }
 
+    /// Simulated seconds elapsed since the beginning of the current episode
+    /// when the data was generated.
+    double GetTimestamp() const {
+      return _timestamp;
+    }
+
     /// Sensor's transform when the data was generated.
     const rpc::Transform &GetSensorTransform() const {
       return _sensor_transform;
@@ -58,6 +71,8 @@ namespace sensor {
 
     const size_t _frame_number;
 
+    const double _timestamp;
+
     const rpc::Transform _sensor_transform;
   };
 
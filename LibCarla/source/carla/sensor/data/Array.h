@@ -47,11 +47,11 @@ namespace data {
     }
 
     iterator end() {
-     return reinterpret_cast<iterator>(_data.end());
+     return reinterpret_cast<iterator>(_data.begin() + _end);
     }
 
     const_iterator cend() const {
-     return reinterpret_cast<const_iterator>(_data.end());
+     return reinterpret_cast<const_iterator>(_data.begin() + _end);
     }
 
     const_iterator end() const {
@@ -128,13 +128,26 @@ namespace data {
       SetOffset(offset);
     }
 
+    /// The array spans the whole data unchecked, derived classes with a header
+    /// restrict it with SetOffset or SetRange.
     explicit Array(RawData data)
-      : Array(0u, std::move(data)) {}
+      : SensorData(data),
+        _offset(0u),
+        _end(data.size()),
+        _data(std::move(data)) {}
 
     void SetOffset(size_t offset) {
-      DEBUG_ASSERT(_data.size() >= _offset);
-      DEBUG_ASSERT((_data.size() - _offset) % sizeof(T) == 0u);
-      _offset = offset;
+      SetRange(offset, _data.size());
+    }
+
+    /// Restrict the array to the bytes [offset, end) of the raw data, for
+    /// data that stores more information after the array.
+    void SetRange(size_t begin_offset, size_t end_offset) {
+      DEBUG_ASSERT(_data.size() >= end_offset);
+      DEBUG_ASSERT(end_offset >= begin_offset);
+      DEBUG_ASSERT((end_offset - begin_offset) % sizeof(T) == 0u);
+      _offset = begin_offset;
+      _end = end_offset;
       DEBUG_ASSERT(begin() <= end());
     }
 
@@ -146,6 +159,8 @@ namespace data {
 
     size_t _offset;
 
+    size_t _end;
+
     RawData _data;
   };
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/Debug.h"
+#include "carla/ListView.h"
 #include "carla/rpc/Location.h"
 #include "carla/sensor/data/Array.h"
 #include "carla/sensor/s11n/LidarSerializer.h"
@@ -17,6 +18,10 @@ namespace data {
 
   /// Measurement produced by a Lidar. Consists of an array of 3D points plus
   /// some extra meta-information about the Lidar.
+  ///
+  /// Depending on the Lidar settings, each point may also have a time, an
+  /// intensity and a ring (channel index), these are stored in separated
+  /// arrays and are empty if not present.
   class LidarMeasurement : public Array<rpc::Location>  {
     static_assert(sizeof(rpc::Location) == 3u * sizeof(float), "Location size missmatch");
     using Super = Array<rpc::Location>;
@@ -28,15 +33,43 @@ namespace data {
 
     explicit LidarMeasurement(RawData data)
       : Super(std::move(data)) {
-      Super::SetOffset(Serializer::GetHeaderOffset(Super::GetRawData()));
+      const auto header = GetHeader();
+      size_t point_count = 0u;
+      for (auto i = 0u; i < header.GetChannelCount(); ++i) {
+        point_count += header.GetPointCount(i);
+      }
+      const auto offset = Serializer::GetHeaderOffset(Super::GetRawData());
+      const s11n::LidarMeasurement::Layout layout(header.GetAttributes(), point_count);
+      DEBUG_ASSERT(offset + layout.size <= Super::GetRawData().size());
+      Super::SetRange(offset, offset + layout.time_offset);
+      _layout = layout;
+      _point_data = Super::GetRawData().begin() + offset;
     }
 
   private:
 
-    auto GetHeader() const {
+    s11n::LidarHeaderView GetHeader() const {
       return Serializer::DeserializeHeader(Super::GetRawData());
     }
 
+    template <typename T>
+    const T *GetAttributeData(
+        s11n::LidarMeasurement::Attribute attribute,
+        size_t offset) const {
+      return HasAttribute(attribute) ?
+          reinterpret_cast<const T *>(_point_data + offset) :
+          nullptr;
+    }
+
+    template <typename T>
+    auto MakeAttributeView(const T *data) const {
+      return MakeListView(data, data == nullptr ? data : data + Super::size());
+    }
+
+    s11n::LidarMeasurement::Layout _layout{0u, 0u};
+
+    const unsigned char *_point_data = nullptr;
+
   public:
 
     /// Horizontal angle of the Lidar at the time of the measurement.
@@ -55,6 +88,46 @@ namespace data {
     auto GetPointCount(size_t channel) const {
       return GetHeader().GetPointCount(channel);
     }
+
+    /// Pointer to an array of GetChannelCount() elements with the number of
+    /// points generated by each channel.
+    const uint32_t *GetPointCountData() const {
+      return GetHeader().GetPointCountData();
+    }
+
+    /// Whether the points of this measurement have @a attribute.
+    bool HasAttribute(s11n::LidarMeasurement::Attribute attribute) const {
+      return (GetHeader().GetAttributes() & attribute) != 0u;
+    }
+
+    /// Pointer to the time of each point, in seconds since the beginning of
+    /// the scan; nullptr if not present.
+    const float *GetTimeData() const {
+      return GetAttributeData<float>(s11n::LidarMeasurement::Time, _layout.time_offset);
+    }
+
+    /// Pointer to the intensity of each point; nullptr if not present.
+    const float *GetIntensityData() const {
+      return GetAttributeData<float>(s11n::LidarMeasurement::Intensity, _layout.intensity_offset);
+    }
+
+    /// Pointer to the ring (channel index) of each point; nullptr if not
+    /// present.
+    const uint16_t *GetRingData() const {
+      return GetAttributeData<uint16_t>(s11n::LidarMeasurement::Ring, _layout.ring_offset);
+    }
+
+    auto GetTimes() const {
+      return MakeAttributeView(GetTimeData());
+    }
+
+    auto GetIntensities() const {
+      return MakeAttributeView(GetIntensityData());
+    }
+
+    auto GetRings() const {
+      return MakeAttributeView(GetRingData());
+    }
   };
 
 } // namespace data
@@ -5,6 +5,8 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "carla/sensor/data/CollisionEvent.h"
+
+#include "carla/RecyclingAllocator.h"
 #include "carla/sensor/s11n/CollisionEventSerializer.h"
 
 namespace carla {
@@ -12,7 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> CollisionEventSerializer::Deserialize(RawData data) {
-    return SharedPtr<SensorData>(new data::CollisionEvent(std::move(data)));
+    return MakeRecycledShared<data::CollisionEvent>([&](void *memory) {
+      return new (memory) data::CollisionEvent(std::move(data));
+    });
   }
 
 } // namespace s11n
@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/ImageSerializer.h"
 
+#include "carla/RecyclingAllocator.h"
 #include "carla/sensor/data/Image.h"
 
 namespace carla {
@@ -13,7 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> ImageSerializer::Deserialize(RawData data) {
-    return SharedPtr<data::Image>(new data::Image{std::move(data)});
+    return MakeRecycledShared<data::Image>([&](void *memory) {
+      return new (memory) data::Image{std::move(data)};
+    });
   }
 
 } // namespace s11n
@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
+#include "carla/Debug.h"
 #include "carla/rpc/Location.h"
 
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace carla {
@@ -22,7 +25,7 @@ namespace s11n {
   ///
   ///    {
   ///      Horizontal angle (float),
-  ///      Channel count,
+  ///      Channel count (lower 16 bits) | Attribute flags (upper 16 bits),
   ///      Point count of channel 0,
   ///      ...
   ///      Point count of channel n,
@@ -36,9 +39,23 @@ namespace s11n {
   ///      Xn, Yn, Zn,
   ///    }
   ///
-  /// @warning WritePoint should be called sequentially in the order in which
-  /// the points are going to be stored, i.e., starting at channel zero and
-  /// increasing steadily.
+  /// followed, in this order, by one array per optional attribute present in
+  /// the attribute flags
+  ///
+  ///    Time:      float[n],    seconds since the beginning of the scan.
+  ///    Intensity: float[n],    intensity of the received ray.
+  ///    Ring:      uint16_t[n], index of the channel that fired the ray.
+  ///
+  /// If no attribute is present the layout is the same as the one used by
+  /// previous versions.
+  ///
+  /// The points are written directly into a Buffer (usually taken from a
+  /// pool), with each array placed at the maximum capacity given in Reset. The
+  /// arrays are compacted only once, when the Buffer is popped.
+  ///
+  /// @warning If the Ring attribute is not present, WritePoint should be
+  /// called sequentially in the order in which the points are going to be
+  /// stored, i.e., starting at channel zero and increasing steadily.
   class LidarMeasurement {
     static_assert(sizeof(float) == sizeof(uint32_t), "Invalid float size");
 
@@ -53,9 +70,38 @@ namespace s11n {
 
   public:
 
-    explicit LidarMeasurement(uint32_t ChannelCount = 0u)
+    /// Optional per-point attributes, stored as flags in the upper half of
+    /// the channel count entry of the header.
+    enum Attribute : uint32_t {
+      Time      = 1u << 16u,
+      Intensity = 1u << 17u,
+      Ring      = 1u << 18u
+    };
+
+    static constexpr uint32_t channel_count_mask = 0xFFFFu;
+
+    /// Layout of the point data for a given number of points, offsets in bytes
+    /// from the end of the header.
+    struct Layout {
+      Layout(uint32_t attributes, size_t number_of_points) {
+        const auto n = number_of_points;
+        time_offset = 3u * sizeof(float) * n;
+        intensity_offset = time_offset + ((attributes & Time) ? sizeof(float) * n : 0u);
+        ring_offset = intensity_offset + ((attributes & Intensity) ? sizeof(float) * n : 0u);
+        size = ring_offset + ((attributes & Ring) ? sizeof(uint16_t) * n : 0u);
+      }
+
+      size_t time_offset;
+      size_t intensity_offset;
+      size_t ring_offset;
+      size_t size;
+    };
+
+    explicit LidarMeasurement(uint32_t ChannelCount = 0u, uint32_t Attributes = 0u)
       : _header(Index::SIZE + ChannelCount, 0u) {
-      _header[Index::ChannelCount] = ChannelCount;
+      DEBUG_ASSERT(ChannelCount <= channel_count_mask);
+      DEBUG_ASSERT((Attributes & channel_count_mask) == 0u);
+      _header[Index::ChannelCount] = ChannelCount | Attributes;
     }
 
     LidarMeasurement &operator=(LidarMeasurement &&) = default;
@@ -69,28 +115,123 @@ namespace s11n {
     }
 
     uint32_t GetChannelCount() const {
-      return _header[Index::ChannelCount];
+      return _header[Index::ChannelCount] & channel_count_mask;
+    }
+
+    uint32_t GetAttributes() const {
+      return _header[Index::ChannelCount] & ~channel_count_mask;
     }
 
-    void Reset(uint32_t total_point_count) {
+    /// Start a new measurement of up to @a max_point_count points, the points
+    /// are written into @a buffer.
+    void Reset(uint32_t max_point_count, Buffer buffer) {
       std::memset(_header.data() + Index::SIZE, 0, sizeof(uint32_t) * GetChannelCount());
-      _points.clear();
-      _points.reserve(3u * total_point_count);
+      _buffer = std::move(buffer);
+      _point_count = 0u;
+      ResetCapacity(max_point_count);
+    }
+
+    /// @copydoc Reset(uint32_t, Buffer)
+    ///
+    /// Allocates its own buffer.
+    void Reset(uint32_t max_point_count) {
+      Reset(max_point_count, Buffer{});
     }
 
-    void WritePoint(uint32_t channel, rpc::Location point) {
+    void WritePoint(
+        uint32_t channel,
+        rpc::Location point,
+        float time = 0.0f,
+        float intensity = 0.0f) {
       DEBUG_ASSERT(GetChannelCount() > channel);
+      if (_point_count == _capacity) {
+        Grow();
+      }
       _header[Index::SIZE + channel] += 1u;
-      _points.emplace_back(point.x);
-      _points.emplace_back(point.y);
-      _points.emplace_back(point.z);
+      const auto attributes = GetAttributes();
+      const Layout layout(attributes, _capacity);
+      const auto i = _point_count++;
+      auto *points = GetPointData();
+      float xyz[3u] = {point.x, point.y, point.z};
+      std::memcpy(points + 3u * sizeof(float) * i, xyz, sizeof(xyz));
+      if (attributes & Time) {
+        std::memcpy(points + layout.time_offset + sizeof(float) * i, &time, sizeof(float));
+      }
+      if (attributes & Intensity) {
+        std::memcpy(points + layout.intensity_offset + sizeof(float) * i, &intensity, sizeof(float));
+      }
+      if (attributes & Ring) {
+        const auto ring = static_cast<uint16_t>(channel);
+        std::memcpy(points + layout.ring_offset + sizeof(uint16_t) * i, &ring, sizeof(uint16_t));
+      }
+    }
+
+    /// Write the header, compact the point data and return the resulting
+    /// buffer. The measurement needs to be reset before writing new points.
+    Buffer PopBuffer() {
+      if (_buffer.size() < GetHeaderSize()) {
+        Reset(0u);
+      }
+      const auto attributes = GetAttributes();
+      const Layout from(attributes, _capacity);
+      const Layout to(attributes, _point_count);
+      auto *points = GetPointData();
+      auto move_array = [&](size_t to_offset, size_t from_offset, size_t size) {
+        if (size > 0u) {
+          std::memmove(points + to_offset, points + from_offset, size);
+        }
+      };
+      move_array(to.time_offset, from.time_offset, to.intensity_offset - to.time_offset);
+      move_array(to.intensity_offset, from.intensity_offset, to.ring_offset - to.intensity_offset);
+      move_array(to.ring_offset, from.ring_offset, to.size - to.ring_offset);
+      std::memcpy(_buffer.data(), _header.data(), GetHeaderSize());
+      _buffer.reset(static_cast<Buffer::size_type>(GetHeaderSize() + to.size));
+      _capacity = 0u;
+      _point_count = 0u;
+      return std::move(_buffer);
     }
 
   private:
 
+    size_t GetHeaderSize() const {
+      return sizeof(uint32_t) * _header.size();
+    }
+
+    unsigned char *GetPointData() {
+      return _buffer.data() + GetHeaderSize();
+    }
+
+    void ResetCapacity(uint32_t capacity) {
+      _capacity = capacity;
+      _buffer.reset(static_cast<uint64_t>(
+          GetHeaderSize() + Layout(GetAttributes(), _capacity).size));
+    }
+
+    /// Double the capacity, moving the points already written to a new
+    /// buffer.
+    void Grow() {
+      const auto attributes = GetAttributes();
+      const Layout from(attributes, _capacity);
+      const auto new_capacity = _capacity > 0u ? 2u * _capacity : 64u;
+      const Layout to(attributes, new_capacity);
+      Buffer old_buffer = std::move(_buffer);
+      _buffer = Buffer(static_cast<uint64_t>(GetHeaderSize() + to.size));
+      const auto *src = old_buffer.data() + GetHeaderSize();
+      auto *dst = GetPointData();
+      std::memcpy(dst, src, from.time_offset);
+      std::memcpy(dst + to.time_offset, src + from.time_offset, from.intensity_offset - from.time_offset);
+      std::memcpy(dst + to.intensity_offset, src + from.intensity_offset, from.ring_offset - from.intensity_offset);
+      std::memcpy(dst + to.ring_offset, src + from.ring_offset, from.size - from.ring_offset);
+      _capacity = new_capacity;
+    }
+
     std::vector<uint32_t> _header;
 
-    std::vector<float> _points;
+    Buffer _buffer;
+
+    uint32_t _capacity = 0u;
+
+    uint32_t _point_count = 0u;
   };
 
 } // namespace s11n
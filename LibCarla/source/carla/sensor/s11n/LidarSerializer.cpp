@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/LidarSerializer.h"
 
+#include "carla/RecyclingAllocator.h"
 #include "carla/sensor/data/LidarMeasurement.h"
 
 namespace carla {
@@ -13,8 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> LidarSerializer::Deserialize(RawData data) {
-    return SharedPtr<data::LidarMeasurement>(
-        new data::LidarMeasurement{std::move(data)});
+    return MakeRecycledShared<data::LidarMeasurement>([&](void *memory) {
+      return new (memory) data::LidarMeasurement{std::move(data)};
+    });
   }
 
 } // namespace s11n
@@ -32,7 +32,13 @@ namespace s11n {
     }
 
     uint32_t GetChannelCount() const {
-      return _begin[Index::ChannelCount];
+      return _begin[Index::ChannelCount] & LidarMeasurement::channel_count_mask;
+    }
+
+    /// Flags of the optional per-point attributes present in the data, see
+    /// LidarMeasurement::Attribute.
+    uint32_t GetAttributes() const {
+      return _begin[Index::ChannelCount] & ~LidarMeasurement::channel_count_mask;
     }
 
     uint32_t GetPointCount(size_t channel) const {
@@ -40,6 +46,11 @@ namespace s11n {
       return _begin[Index::SIZE + channel];
     }
 
+    /// Pointer to the array with the number of points of each channel.
+    const uint32_t *GetPointCountData() const {
+      return _begin + Index::SIZE;
+    }
+
   private:
 
     friend class LidarSerializer;
@@ -68,11 +79,10 @@ namespace s11n {
       return sizeof(uint32_t) * (View.GetChannelCount() + LidarMeasurement::Index::SIZE);
     }
 
+    /// Serialize @a measurement, its buffer is moved into the message without
+    /// copying the points.
     template <typename Sensor>
-    static Buffer Serialize(
-        const Sensor &sensor,
-        const LidarMeasurement &measurement,
-        Buffer bitmap);
+    static Buffer Serialize(const Sensor &sensor, LidarMeasurement &measurement);
 
     static SharedPtr<SensorData> Deserialize(RawData data);
   };
@@ -84,13 +94,8 @@ namespace s11n {
   template <typename Sensor>
   inline Buffer LidarSerializer::Serialize(
       const Sensor &,
-      const LidarMeasurement &measurement,
-      Buffer output) {
-    std::array<boost::asio::const_buffer, 2u> seq = {
-        boost::asio::buffer(measurement._header),
-        boost::asio::buffer(measurement._points)};
-    output.copy_from(seq);
-    return output;
+      LidarMeasurement &measurement) {
+    return measurement.PopBuffer();
   }
 
 } // namespace s11n
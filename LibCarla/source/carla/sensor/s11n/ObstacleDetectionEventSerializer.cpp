@@ -5,6 +5,8 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "carla/sensor/data/ObstacleDetectionEvent.h"
+
+#include "carla/RecyclingAllocator.h"
 #include "carla/sensor/s11n/ObstacleDetectionEventSerializer.h"
 
 namespace carla {
@@ -12,7 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> ObstacleDetectionEventSerializer::Deserialize(RawData data) {
-    return SharedPtr<SensorData>(new data::ObstacleDetectionEvent(std::move(data)));
+    return MakeRecycledShared<data::ObstacleDetectionEvent>([&](void *memory) {
+      return new (memory) data::ObstacleDetectionEvent(std::move(data));
+    });
   }
 
 } // namespace s11n
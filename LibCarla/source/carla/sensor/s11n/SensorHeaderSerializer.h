@@ -21,13 +21,18 @@ namespace s11n {
     struct Header {
       uint64_t sensor_type;
       uint64_t frame_number;
+      double timestamp;
       rpc::Transform sensor_transform;
     };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(Header);
 
-    static Buffer Serialize(uint64_t index, uint64_t frame, rpc::Transform transform);
+    static Buffer Serialize(
+        uint64_t index,
+        uint64_t frame,
+        double timestamp,
+        rpc::Transform transform);
 
     static const Header &Deserialize(const Buffer &message) {
       return *reinterpret_cast<const Header *>(message.data());
@@ -11,6 +11,8 @@
 #include "carla/Exception.h"
 #include "carla/Logging.h"
 #include "carla/Time.h"
+#include "carla/profiler/Metrics.h"
+#include "carla/profiler/Tracer.h"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/read.hpp>
@@ -23,6 +25,8 @@ namespace streaming {
 namespace detail {
 namespace tcp {
 
+  using profiler::Metrics;
+
   // ===========================================================================
   // -- IncomingMessage --------------------------------------------------------
   // ===========================================================================
@@ -124,6 +128,8 @@ namespace tcp {
           }));
         } else {
           log_info("streaming client: connection failed:", ec.message());
+          static auto &failed_connections = Metrics::GetCounter("streaming.client.failed_connections");
+          failed_connections.Increment();
           Reconnect();
         }
       };
@@ -167,17 +173,31 @@ namespace tcp {
 
       auto handle_read_data = [this, self, message](boost::system::error_code ec, size_t DEBUG_ONLY(bytes)) {
         DEBUG_ONLY(log_debug("streaming client: Client::ReadData.handle_read_data", bytes, "bytes"));
+        static auto &received_messages = Metrics::GetCounter("streaming.client.received_messages");
+        static auto &received_bytes = Metrics::GetCounter("streaming.client.received_bytes");
+        static auto &read_errors = Metrics::GetCounter("streaming.client.read_errors");
+        static auto &pending_callbacks = Metrics::GetGauge("streaming.client.pending_callbacks");
+        static auto &callback_time = Metrics::GetHistogram("streaming.client.callback_us");
         if (!ec) {
           DEBUG_ASSERT_EQ(bytes, message->size());
           DEBUG_ASSERT_NE(bytes, 0u);
+          received_messages.Increment();
+          received_bytes.Increment(message->size());
           // Move the buffer to the callback function and start reading the next
           // piece of data.
           log_debug("streaming client: success reading data, calling the callback");
-          _socket.get_io_service().post([self, message]() { self->_callback(message->pop()); });
+          pending_callbacks.Add(1);
+          _socket.get_io_service().post([self, message]() {
+            pending_callbacks.Add(-1);
+            CARLA_TRACE_SCOPE(streaming, "callback");
+            profiler::ScopedMetricsTimer timer(callback_time);
+            self->_callback(message->pop());
+          });
           ReadData();
         } else {
           // As usual, if anything fails start over from the very top.
           log_info("streaming client: failed to read data:", ec.message());
+          read_errors.Increment();
           Connect();
         }
       };
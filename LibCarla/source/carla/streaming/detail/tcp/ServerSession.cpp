@@ -8,6 +8,7 @@
 
 #include "carla/Debug.h"
 #include "carla/Logging.h"
+#include "carla/profiler/Metrics.h"
 
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
@@ -19,6 +20,8 @@ namespace streaming {
 namespace detail {
 namespace tcp {
 
+  using profiler::Metrics;
+
   static std::atomic_size_t SESSION_COUNTER{0u};
 
   ServerSession::ServerSession(
@@ -66,6 +69,11 @@ namespace tcp {
   void ServerSession::Write(std::shared_ptr<const Message> message) {
     DEBUG_ASSERT(message != nullptr);
     DEBUG_ASSERT(!message->empty());
+    static auto &sent_messages = Metrics::GetCounter("streaming.server.sent_messages");
+    static auto &sent_bytes = Metrics::GetCounter("streaming.server.sent_bytes");
+    static auto &dropped_messages = Metrics::GetCounter("streaming.server.dropped_messages");
+    static auto &write_errors = Metrics::GetCounter("streaming.server.write_errors");
+    static auto &write_time = Metrics::GetHistogram("streaming.server.write_us");
     auto self = shared_from_this();
     _strand.post([=]() {
       if (!_socket.is_open()) {
@@ -73,18 +81,25 @@ namespace tcp {
       }
       if (_is_writing) {
         log_debug("session", _session_id, ": connection too slow: message discarded");
+        dropped_messages.Increment();
         return;
       }
       _is_writing = true;
 
-      auto handle_sent = [this, self, message](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+      auto handle_sent = [this, self, message, stop_watch=StopWatch()](
+          const boost::system::error_code &ec,
+          size_t DEBUG_ONLY(bytes)) {
         _is_writing = false;
         if (ec) {
           log_info("session", _session_id, ": error sending data :", ec.message());
+          write_errors.Increment();
           CloseNow();
         } else {
           DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
           DEBUG_ASSERT_EQ(bytes, sizeof(message_size_type) + message->size());
+          sent_messages.Increment();
+          sent_bytes.Increment(message->size());
+          write_time.Record(stop_watch.GetElapsedTime<std::chrono::microseconds>());
         }
       };
 
@@ -0,0 +1,144 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Road.h"
+
+#include <carla/geom/Math.h>
+#include <carla/road/MapBuilder.h>
+
+#include <vector>
+
+namespace util {
+namespace road {
+
+  using namespace carla::road::element;
+  using carla::geom::Location;
+  using carla::geom::Math;
+
+  static void AddLane(
+      RoadSegmentDefinition &def,
+      RoadInfoLane &lanes,
+      int lane_id,
+      RoadInfoMarkRecord::LaneChange lane_change,
+      LaneType lane_type = LaneType::Driving,
+      double s = 0.0) {
+    using Mark = RoadInfoMarkRecord;
+    lanes.addLaneInfo(lane_id, 3.5, lane_type);
+    def.MakeInfo<RoadInfoLaneWidth>(s, lane_id, 3.5, 0.0, 0.0, 0.0);
+    def.MakeInfo<Mark>(s, lane_id, Mark::Type::Broken, Mark::Weight::Standard, Mark::Color::White, "standard", 0.15, lane_change, 0.0);
+  }
+
+  static RoadSegmentDefinition MakeStraightRoad(id_type id, const Location &start, double heading, double length) {
+    RoadSegmentDefinition def(id);
+    def.MakeGeometry<GeometryLine>(0.0, length, heading, start);
+    def.MakeInfo<RoadInfoLaneOffset>(0.0, 0.0, 0.0, 0.0, 0.0);
+    return def;
+  }
+
+  SharedPtr<Map> make_ring_map() {
+    carla::road::MapBuilder builder;
+    const Location corners[] = {{0.0f, 0.0f, 0.0f}, {100.0f, 0.0f, 0.0f}, {100.0f, 100.0f, 0.0f}, {0.0f, 100.0f, 0.0f}};
+    for (auto i = 0; i <= 4; ++i) {
+      const auto start = i < 4 ? corners[i] : Location(0.0f, -500.0f, 0.0f);
+      auto def = MakeStraightRoad(static_cast<id_type>(i), start, Math::pi_half() * (i % 4), 100.0);
+      auto lanes = def.MakeInfo<RoadInfoLane>();
+      AddLane(def, *lanes, -1, RoadInfoMarkRecord::LaneChange::Increase);
+      if (i == 0) {
+        AddLane(def, *lanes, -2, RoadInfoMarkRecord::LaneChange::None);
+      }
+      if (i == 4) {
+        AddLane(def, *lanes, -2, RoadInfoMarkRecord::LaneChange::None, LaneType::Sidewalk);
+      }
+      if (i == 1) {
+        auto general = def.MakeInfo<RoadGeneralInfo>();
+        general->SetJunctionId(1);
+        general->SetLanesOffset(0.0, 0.0);
+      }
+      if (i < 4) {
+        def.AddNextLaneInfo(-1, -1, (i + 1) % 4);
+      }
+      builder.AddRoadSegmentDefinition(def);
+    }
+    return builder.Build();
+  }
+
+  SharedPtr<Map> make_two_section_map() {
+    using Mark = RoadInfoMarkRecord;
+    auto def = MakeStraightRoad(0u, Location(0.0f, 0.0f, 0.0f), 0.0, 100.0);
+    def.MakeInfo<Mark>(0.0, 0, Mark::Type::SolidSolid, Mark::Weight::Standard, Mark::Color::Yellow, "standard", 0.15, Mark::LaneChange::None, 0.0);
+    auto first = def.MakeInfo<RoadInfoLane>();
+    AddLane(def, *first, 1, Mark::LaneChange::None);
+    AddLane(def, *first, -1, Mark::LaneChange::Increase);
+    auto second = def.MakeInfo<RoadInfoLane>();
+    second->d = 50.0;
+    // Lane -1 goes on with the records of the first section.
+    second->addLaneInfo(-1, 3.5, LaneType::Driving);
+    AddLane(def, *second, -2, Mark::LaneChange::None, LaneType::Driving, 50.0);
+    carla::road::MapBuilder builder;
+    builder.AddRoadSegmentDefinition(def);
+    return builder.Build();
+  }
+
+  SharedPtr<Map> make_grid_map(const size_t size, const double road_length) {
+    struct Road {
+      size_t start;
+      size_t end;
+    };
+    std::vector<Road> roads;
+    std::vector<RoadSegmentDefinition> defs;
+    auto add_road = [&](size_t start, size_t end, double heading) {
+      const auto id = static_cast<id_type>(defs.size());
+      const Location location(
+          static_cast<float>(road_length * static_cast<double>(start % size)),
+          static_cast<float>(road_length * static_cast<double>(start / size)),
+          0.0f);
+      defs.emplace_back(MakeStraightRoad(id, location, heading, road_length));
+      auto lanes = defs.back().MakeInfo<RoadInfoLane>();
+      AddLane(defs.back(), *lanes, -1, RoadInfoMarkRecord::LaneChange::None);
+      AddLane(defs.back(), *lanes, 1, RoadInfoMarkRecord::LaneChange::None);
+      roads.push_back({start, end});
+    };
+    for (auto y = 0u; y < size; ++y) {
+      for (auto x = 0u; x < size; ++x) {
+        const auto node = y * size + x;
+        if (x + 1u < size) {
+          add_road(node, node + 1u, 0.0);
+        }
+        if (y + 1u < size) {
+          add_road(node, node + size, Math::pi_half());
+        }
+      }
+    }
+    // Lane -1 drives from the start to the end of the road, lane 1 backwards.
+    for (auto in = 0u; in < roads.size(); ++in) {
+      for (auto out = 0u; out < roads.size(); ++out) {
+        if (in == out) {
+          continue;
+        }
+        const int out_road = static_cast<int>(out);
+        if (roads[in].end == roads[out].start) {
+          defs[in].AddNextLaneInfo(-1, -1, out_road);
+        }
+        if (roads[in].end == roads[out].end) {
+          defs[in].AddNextLaneInfo(-1, 1, out_road);
+        }
+        if (roads[in].start == roads[out].start) {
+          defs[in].AddPrevLaneInfo(1, -1, out_road);
+        }
+        if (roads[in].start == roads[out].end) {
+          defs[in].AddPrevLaneInfo(1, 1, out_road);
+        }
+      }
+    }
+    carla::road::MapBuilder builder;
+    for (auto &def : defs) {
+      builder.AddRoadSegmentDefinition(def);
+    }
+    return builder.Build();
+  }
+
+} // namespace road
+} // namespace util
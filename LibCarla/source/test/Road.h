@@ -0,0 +1,35 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/Memory.h>
+#include <carla/road/Map.h>
+
+namespace util {
+namespace road {
+
+  using carla::SharedPtr;
+  using carla::road::Map;
+
+  /// A square ring of four 100 m one-lane roads, road 1 is a junction. Road 0
+  /// has a second lane that can be entered but not left with a lane change,
+  /// and road 4 is disconnected from the rest and has a sidewalk.
+  SharedPtr<Map> make_ring_map();
+
+  /// A straight 100 m road with two lane sections. Lane -1 runs the whole
+  /// road, lane 1 only the first half and lane -2 only the second half; lane
+  /// -1 can change to lane -2. The center line is solid solid, the lanes
+  /// broken.
+  SharedPtr<Map> make_two_section_map();
+
+  /// A grid of @a size x @a size intersections joined by two-way roads of @a
+  /// road_length meters, every incoming lane of an intersection connects to
+  /// every outgoing lane except for U-turns.
+  SharedPtr<Map> make_grid_map(size_t size, double road_length = 100.0);
+
+} // namespace road
+} // namespace util
@@ -0,0 +1,123 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/ActorListIndex.h>
+#include <carla/client/detail/ActorRegistry.h>
+
+using carla::client::detail::ActorListIndex;
+using carla::client::detail::ActorRegistry;
+using carla::client::detail::ActorVariant;
+using carla::rpc::ActorId;
+
+static carla::rpc::Actor MakeActor(ActorId id, std::string type_id) {
+  carla::rpc::Actor actor;
+  actor.id = id;
+  actor.description.id = std::move(type_id);
+  return actor;
+}
+
+static std::vector<ActorId> GetIds(const ActorRegistry &registry) {
+  std::vector<ActorId> result;
+  for (auto &&actor : registry.GetActors()) {
+    result.emplace_back(actor.id);
+  }
+  return result;
+}
+
+TEST(client, actor_registry) {
+  ActorRegistry registry;
+
+  auto missing = registry.Update(std::vector<ActorId>{1u, 2u, 3u});
+  std::sort(missing.begin(), missing.end());
+  ASSERT_EQ(missing, (std::vector<ActorId>{1u, 2u, 3u}));
+  registry.InsertRange({
+      MakeActor(1u, "vehicle.tesla.model3"),
+      MakeActor(2u, "traffic.traffic_light"),
+      MakeActor(3u, "vehicle.audi.tt")});
+  ASSERT_TRUE(registry.Update(std::vector<ActorId>{1u, 2u, 3u}).empty());
+  // Sorted by type id.
+  ASSERT_EQ(GetIds(registry), (std::vector<ActorId>{2u, 3u, 1u}));
+
+  // Spawned actors are kept until they appear in the episode.
+  registry.Insert(MakeActor(4u, "vehicle.audi.a2"));
+  ASSERT_EQ(registry.size(), 4u);
+  ASSERT_EQ(GetIds(registry), (std::vector<ActorId>{2u, 3u, 1u}));
+  ASSERT_TRUE(registry.Update(std::vector<ActorId>{1u, 2u, 3u}).empty());
+  ASSERT_EQ(registry.size(), 4u);
+  ASSERT_TRUE(registry.Update(std::vector<ActorId>{1u, 2u, 3u, 4u}).empty());
+  ASSERT_EQ(GetIds(registry), (std::vector<ActorId>{2u, 4u, 3u, 1u}));
+
+  // Destroyed actors are evicted.
+  ASSERT_TRUE(registry.Update(std::vector<ActorId>{1u, 4u}).empty());
+  ASSERT_EQ(registry.size(), 2u);
+  ASSERT_EQ(GetIds(registry), (std::vector<ActorId>{4u, 1u}));
+  ASSERT_EQ(registry.Update(std::vector<ActorId>{1u, 3u}), (std::vector<ActorId>{3u}));
+  ASSERT_EQ(registry.size(), 1u);
+
+  registry.Clear();
+  ASSERT_EQ(registry.size(), 0u);
+  ASSERT_TRUE(registry.GetActors().empty());
+}
+
+/// Ids of the actors in @a ranges, in order.
+static std::vector<ActorId> GetIds(
+    const std::vector<ActorVariant> &actors,
+    const std::vector<ActorListIndex::Range> &ranges) {
+  std::vector<ActorId> result;
+  for (auto &&range : ranges) {
+    for (auto i = range.first; i < range.second; ++i) {
+      result.emplace_back(actors[i].GetId());
+    }
+  }
+  return result;
+}
+
+TEST(client, actor_list_index) {
+  std::vector<ActorVariant> actors{
+      MakeActor(7u, "vehicle.tesla.model3"),
+      MakeActor(2u, "traffic.traffic_light"),
+      MakeActor(5u, "vehicle.audi.tt"),
+      MakeActor(3u, "vehicle.tesla.model3"),
+      MakeActor(9u, "walker.pedestrian.0001"),
+      MakeActor(4u, "vehicle.audi.a2")};
+  ActorListIndex index(actors);
+
+  // Sorted by type id, then by id.
+  std::vector<ActorId> ids;
+  for (auto &&actor : actors) {
+    ids.emplace_back(actor.GetId());
+  }
+  ASSERT_EQ(ids, (std::vector<ActorId>{2u, 4u, 5u, 3u, 7u, 9u}));
+
+  for (auto i = 0u; i < actors.size(); ++i) {
+    const auto pos = index.Find(actors[i].GetId());
+    ASSERT_TRUE(pos.has_value());
+    ASSERT_EQ(*pos, i);
+  }
+  ASSERT_FALSE(index.Find(1u).has_value());
+  ASSERT_FALSE(index.Find(6u).has_value());
+  ASSERT_FALSE(index.Find(42u).has_value());
+
+  // Prefix patterns take every type id with the prefix.
+  ASSERT_EQ(GetIds(actors, index.Filter("vehicle.*")), (std::vector<ActorId>{4u, 5u, 3u, 7u}));
+  ASSERT_EQ(GetIds(actors, index.Filter("*")), ids);
+  // Other patterns are matched against each type id.
+  ASSERT_EQ(GetIds(actors, index.Filter("vehicle.*.model3")), (std::vector<ActorId>{3u, 7u}));
+  ASSERT_EQ(GetIds(actors, index.Filter("*audi*")), (std::vector<ActorId>{4u, 5u}));
+  ASSERT_EQ(GetIds(actors, index.Filter("vehicle.audi.?2")), (std::vector<ActorId>{4u}));
+  ASSERT_EQ(GetIds(actors, index.Filter("traffic.traffic_light")), (std::vector<ActorId>{2u}));
+  // A type id is not matched by a prefix of it.
+  ASSERT_TRUE(index.Filter("vehicle.audi").empty());
+  ASSERT_TRUE(index.Filter("sensor.*").empty());
+  ASSERT_TRUE(index.Filter("zzz*").empty());
+
+  std::vector<ActorVariant> none;
+  ActorListIndex empty_index(none);
+  ASSERT_FALSE(empty_index.Find(1u).has_value());
+  ASSERT_TRUE(empty_index.Filter("*").empty());
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/ClientSideSensorExecutor.h>
+#include <carla/client/detail/EpisodeState.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using carla::TaskExecutor;
+using carla::client::detail::ClientSideSensorExecutor;
+using carla::client::detail::EpisodeState;
+
+TEST(client, client_side_sensor_executor) {
+  constexpr auto number_of_sensors = 100u;
+  TaskExecutor task_executor{TaskExecutor::Options{4u}};
+  ClientSideSensorExecutor executor{task_executor};
+  std::array<std::atomic_size_t, number_of_sensors> ticks;
+  for (auto i = 0u; i < number_of_sensors; ++i) {
+    ticks[i] = 0u;
+    executor.Register(i + 1u, "sensor." + std::to_string(i), [&ticks, i](const EpisodeState &) {
+      ++ticks[i];
+    });
+  }
+  const EpisodeState state{1u};
+  for (auto i = 0u; i < 10u; ++i) {
+    executor.Tick(state);
+  }
+  for (auto &&count : ticks) {
+    ASSERT_EQ(count, 10u);
+  }
+  const auto stats = executor.GetStats();
+  ASSERT_EQ(stats.size(), number_of_sensors);
+  for (auto i = 0u; i < stats.size(); ++i) {
+    ASSERT_EQ(stats[i].sensor_id, i + 1u);
+    ASSERT_EQ(stats[i].display_id, "sensor." + std::to_string(i));
+    ASSERT_EQ(stats[i].tick_count, 10u);
+  }
+
+  executor.Unregister(1u);
+  executor.Tick(state);
+  ASSERT_EQ(ticks[0u], 10u);
+  ASSERT_EQ(ticks[1u], 11u);
+  ASSERT_EQ(executor.GetStats().size(), number_of_sensors - 1u);
+
+  executor.Clear();
+  executor.Tick(state);
+  ASSERT_EQ(ticks[1u], 11u);
+  ASSERT_TRUE(executor.GetStats().empty());
+}
+
+TEST(client, client_side_sensor_executor_parallel) {
+  constexpr auto number_of_sensors = 4u;
+  TaskExecutor task_executor{TaskExecutor::Options{number_of_sensors}};
+  ClientSideSensorExecutor executor{task_executor};
+  std::atomic_size_t running{0u};
+  std::atomic_size_t max_running{0u};
+  for (auto i = 0u; i < number_of_sensors; ++i) {
+    executor.Register(i + 1u, "sensor", [&](const EpisodeState &) {
+      const auto now = ++running;
+      auto max = max_running.load();
+      while ((now > max) && !max_running.compare_exchange_weak(max, now));
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      --running;
+    });
+  }
+  executor.Tick(EpisodeState{1u});
+  ASSERT_EQ(running, 0u);
+  ASSERT_GT(max_running, 1u);
+  for (auto &&stats : executor.GetStats()) {
+    ASSERT_GE(stats.last_tick_seconds, 0.04);
+    ASSERT_EQ(stats.max_tick_seconds, stats.last_tick_seconds);
+    ASSERT_EQ(stats.total_tick_seconds, stats.last_tick_seconds);
+  }
+}
+
+TEST(client, client_side_sensor_executor_exception) {
+  TaskExecutor task_executor{TaskExecutor::Options{2u}};
+  ClientSideSensorExecutor executor{task_executor};
+  std::atomic_size_t ticks{0u};
+  executor.Register(1u, "throwing", [](const EpisodeState &) {
+    throw std::runtime_error("failed");
+  });
+  executor.Register(2u, "counting", [&](const EpisodeState &) { ++ticks; });
+  executor.Tick(EpisodeState{1u});
+  executor.Tick(EpisodeState{1u});
+  ASSERT_EQ(ticks, 2u);
+  for (auto &&stats : executor.GetStats()) {
+    ASSERT_EQ(stats.tick_count, 2u);
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/EpisodeStateHistory.h>
+#include <carla/sensor/CompositeSerializer.h>
+#include <carla/sensor/data/RawEpisodeState.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace carla;
+using client::detail::EpisodeState;
+using client::detail::EpisodeStateHistory;
+using sensor::data::ActorDynamicState;
+using sensor::data::RawEpisodeState;
+
+using Serializer = sensor::CompositeSerializer<
+    std::pair<void *, sensor::s11n::EpisodeStateSerializer>>;
+
+static constexpr double DELTA_SECONDS = 0.05;
+
+/// Episode state at @a frame with one actor per yaw in @a yaws, with ids
+/// starting at 1 and moving along x one meter per frame.
+static std::shared_ptr<const EpisodeState> MakeState(
+    uint64_t episode_id,
+    uint64_t frame,
+    const std::vector<float> &yaws) {
+  using SensorHeader = sensor::s11n::SensorHeaderSerializer::Header;
+  using EpisodeHeader = sensor::s11n::EpisodeStateSerializer::Header;
+  const auto elapsed_seconds = static_cast<double>(frame) * DELTA_SECONDS;
+  Buffer buffer(sizeof(SensorHeader) + sizeof(EpisodeHeader) + yaws.size() * sizeof(ActorDynamicState));
+  std::memset(buffer.data(), 0, buffer.size());
+  auto *sensor_header = reinterpret_cast<SensorHeader *>(buffer.data());
+  sensor_header->frame_number = frame;
+  sensor_header->timestamp = elapsed_seconds;
+  auto *episode_header = reinterpret_cast<EpisodeHeader *>(buffer.data() + sizeof(SensorHeader));
+  episode_header->episode_id = episode_id;
+  episode_header->game_timestamp = elapsed_seconds;
+  episode_header->delta_seconds = static_cast<float>(DELTA_SECONDS);
+  auto *actors = reinterpret_cast<ActorDynamicState *>(
+      buffer.data() + sizeof(SensorHeader) + sizeof(EpisodeHeader));
+  for (auto i = 0u; i < yaws.size(); ++i) {
+    actors[i].id = i + 1u;
+    actors[i].transform.location.x = static_cast<float>(frame);
+    actors[i].transform.rotation.yaw = yaws[i];
+  }
+  auto data = Serializer::Deserialize(std::move(buffer));
+  return std::make_shared<EpisodeState>(
+      boost::static_pointer_cast<const RawEpisodeState>(std::move(data)));
+}
+
+TEST(episode_state_history, access_by_frame) {
+  EpisodeStateHistory history{4u};
+  for (auto frame = 10u; frame < 20u; ++frame) {
+    history.Push(MakeState(1u, frame, {0.0f}));
+  }
+  ASSERT_EQ(history.GetState(15u), nullptr);
+  for (auto frame = 16u; frame < 20u; ++frame) {
+    auto state = history.GetState(frame);
+    ASSERT_NE(state, nullptr);
+    ASSERT_EQ(state->GetFrameCount(), frame);
+  }
+  ASSERT_EQ(history.GetState(20u), nullptr);
+  // A skipped frame leaves its slot empty.
+  history.Push(MakeState(1u, 21u, {0.0f}));
+  ASSERT_EQ(history.GetState(17u), nullptr);
+  ASSERT_EQ(history.GetState(20u), nullptr);
+  const auto states = history.GetStates();
+  ASSERT_EQ(states.size(), 3u);
+  ASSERT_EQ(states[0u]->GetFrameCount(), 18u);
+  ASSERT_EQ(states[2u]->GetFrameCount(), 21u);
+  // A new episode drops the previous one.
+  history.Push(MakeState(2u, 22u, {0.0f}));
+  ASSERT_EQ(history.GetState(21u), nullptr);
+  ASSERT_EQ(history.GetStates().size(), 1u);
+}
+
+TEST(episode_state_history, disabled_by_default) {
+  EpisodeStateHistory history;
+  history.Push(MakeState(1u, 1u, {0.0f}));
+  ASSERT_EQ(history.GetState(1u), nullptr);
+  ASSERT_TRUE(history.GetStates().empty());
+}
+
+TEST(episode_state_history, interpolation) {
+  EpisodeStateHistory history{8u};
+  history.Push(MakeState(1u, 1u, {170.0f}));
+  history.Push(MakeState(1u, 2u, {-170.0f}));
+  const auto t1 = 1.0 * DELTA_SECONDS;
+  auto transform = history.GetInterpolatedTransform(1u, t1 + 0.25 * DELTA_SECONDS);
+  ASSERT_TRUE(transform.has_value());
+  ASSERT_NEAR(transform->location.x, 1.25f, 1e-4f);
+  // Rotations take the shortest way around.
+  ASSERT_NEAR(transform->rotation.yaw, 175.0f, 1e-3f);
+  transform = history.GetInterpolatedTransform(1u, t1);
+  ASSERT_TRUE(transform.has_value());
+  ASSERT_EQ(transform->location.x, 1.0f);
+  ASSERT_FALSE(history.GetInterpolatedTransform(1u, 0.5 * DELTA_SECONDS).has_value());
+  ASSERT_FALSE(history.GetInterpolatedTransform(1u, 3.0 * DELTA_SECONDS).has_value());
+  ASSERT_FALSE(history.GetInterpolatedTransform(2u, t1).has_value());
+}
+
+TEST(episode_state_history, actor_history) {
+  EpisodeStateHistory history{16u};
+  for (auto frame = 0u; frame < 10u; ++frame) {
+    // The second actor is only present in even frames.
+    history.Push(MakeState(1u, frame, frame % 2u == 0u ? std::vector<float>{0.0f, 0.0f} : std::vector<float>{0.0f}));
+  }
+  auto samples = history.GetActorHistory(1u, 2.0 * DELTA_SECONDS, 5.0 * DELTA_SECONDS + 1e-6);
+  ASSERT_EQ(samples.size(), 4u);
+  for (auto i = 0u; i < samples.size(); ++i) {
+    ASSERT_EQ(samples[i].frame_count, i + 2u);
+    ASSERT_EQ(samples[i].transform.location.x, static_cast<float>(i + 2u));
+  }
+  samples = history.GetActorHistory(2u, 0.0, 10.0);
+  ASSERT_EQ(samples.size(), 5u);
+  ASSERT_EQ(samples.back().frame_count, 8u);
+}
+
+TEST(episode_state_history, actor_states) {
+  const auto state = MakeState(1u, 3u, {10.0f, 20.0f, 30.0f});
+  const auto states = state->GetActorStates({3u, 42u, 1u, 0u, 3u});
+  ASSERT_EQ(states.size(), 5u);
+  // In the order requested, repeated ids included.
+  ASSERT_EQ(states[0u].id, 3u);
+  ASSERT_EQ(states[0u].transform.rotation.yaw, 30.0f);
+  ASSERT_EQ(states[2u].id, 1u);
+  ASSERT_EQ(states[2u].transform.rotation.yaw, 10.0f);
+  ASSERT_EQ(states[2u].transform.location.x, 3.0f);
+  ASSERT_EQ(states[4u].id, 3u);
+  // Missing ids are zeroed, padding included.
+  ActorDynamicState zero;
+  std::memset(static_cast<void *>(&zero), 0, sizeof(zero));
+  for (auto i : {1u, 3u}) {
+    ASSERT_EQ(std::memcmp(&states[i], &zero, sizeof(zero)), 0);
+  }
+  ASSERT_TRUE(state->GetActorStates({}).empty());
+}
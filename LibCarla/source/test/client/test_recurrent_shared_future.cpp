@@ -6,9 +6,14 @@
 
 #include "test.h"
 
+#include <carla/Logging.h>
 #include <carla/RecurrentSharedFuture.h>
+#include <carla/StopWatch.h>
 #include <carla/ThreadGroup.h>
 
+#include <atomic>
+#include <stdexcept>
+
 TEST(recurrent_shared_future, use_case) {
   using namespace carla;
   ThreadGroup threads;
@@ -64,3 +69,108 @@ TEST(recurrent_shared_future, exception) {
     ASSERT_STREQ(e.what(), message.c_str());
   }
 }
+
+TEST(recurrent_shared_future, wait_for_newer_than) {
+  using namespace carla;
+  RecurrentSharedFuture<int> future;
+  ASSERT_EQ(future.GetSequenceNumber(), 0u);
+  ASSERT_FALSE(future.WaitForNewerThan(0u, 1ns).has_value());
+  future.SetValue(1);
+  future.SetValue(2);
+  ASSERT_EQ(future.GetSequenceNumber(), 2u);
+  // Already set, returns the latest value without waiting.
+  auto result = future.WaitForNewerThan(0u, 0ns);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(*result, 2);
+  ASSERT_FALSE(future.WaitForNewerThan(2u, 1ms).has_value());
+  // The next value is not the stale one.
+  ASSERT_FALSE(future.WaitFor(1ms).has_value());
+}
+
+TEST(recurrent_shared_future, stress_many_waiters) {
+  using namespace carla;
+  ThreadGroup threads;
+  RecurrentSharedFuture<uint64_t> future;
+
+  constexpr size_t number_of_threads = 16u;
+  constexpr uint64_t number_of_values = 20000u;
+
+  std::atomic_size_t finished{0u};
+
+  threads.CreateThreads(number_of_threads, [&]() {
+    uint64_t last = 0u;
+    while (last < number_of_values) {
+      auto result = future.WaitForNewerThan(last, 1s);
+      ASSERT_TRUE(result.has_value());
+      // Values are set in order, a waiter never sees one twice or goes back.
+      ASSERT_GT(*result, last);
+      last = *result;
+    }
+    ++finished;
+  });
+
+  for (uint64_t i = 1u; i <= number_of_values; ++i) {
+    future.SetValue(i);
+  }
+  threads.JoinAll();
+  ASSERT_EQ(finished, number_of_threads);
+  ASSERT_EQ(future.GetSequenceNumber(), number_of_values);
+}
+
+TEST(recurrent_shared_future, stress_exception) {
+  using namespace carla;
+  ThreadGroup threads;
+  RecurrentSharedFuture<int> future;
+
+  constexpr size_t number_of_threads = 8u;
+  std::atomic_size_t exceptions{0u};
+
+  threads.CreateThreads(number_of_threads, [&]() {
+    try {
+      future.WaitForNewerThan(0u, 1s);
+    } catch (const std::runtime_error &) {
+      ASSERT_FALSE(true) << "exception should be a SharedException";
+    } catch (const std::exception &e) {
+      ASSERT_STREQ(e.what(), "failed");
+      ++exceptions;
+    }
+  });
+
+  std::this_thread::sleep_for(10ms);
+  future.SetException(std::runtime_error("failed"));
+  threads.JoinAll();
+  ASSERT_EQ(exceptions, number_of_threads);
+  // Values set later are delivered normally.
+  future.SetValue(3);
+  ASSERT_EQ(*future.WaitForNewerThan(1u, 0ns), 3);
+}
+
+TEST(benchmark_recurrent_shared_future, set_value) {
+  using namespace carla;
+  constexpr uint64_t number_of_values = 10000u;
+  for (auto number_of_waiters : {0u, 4u, 32u}) {
+    ThreadGroup threads;
+    RecurrentSharedFuture<uint64_t> future;
+    std::atomic_size_t received{0u};
+    threads.CreateThreads(number_of_waiters, [&]() {
+      uint64_t last = 0u;
+      while (last < number_of_values) {
+        auto result = future.WaitForNewerThan(last, 1s);
+        ASSERT_TRUE(result.has_value());
+        last = *result;
+        ++received;
+      }
+    });
+    StopWatch stop_watch;
+    for (uint64_t i = 1u; i <= number_of_values; ++i) {
+      future.SetValue(i);
+    }
+    stop_watch.Stop();
+    threads.JoinAll();
+    const auto ns = stop_watch.GetElapsedTime<std::chrono::nanoseconds>();
+    logging::log(
+        "recurrent shared future:", number_of_waiters, "waiters,",
+        ns / number_of_values, "ns per value set,",
+        received, "wake ups");
+  }
+}
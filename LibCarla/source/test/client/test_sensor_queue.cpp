@@ -0,0 +1,149 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/SensorQueue.h>
+#include <carla/sensor/CompositeSerializer.h>
+#include <carla/sensor/SensorData.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace carla;
+using client::SensorQueue;
+using Policy = SensorQueue::OverflowPolicy;
+
+using Serializer = sensor::CompositeSerializer<
+    std::pair<void *, sensor::s11n::EpisodeStateSerializer>>;
+
+/// Pushes measurements as if they came from the sensor streams.
+class TestSensorQueue : public SensorQueue {
+public:
+
+  using SensorQueue::SensorQueue;
+
+  using SensorQueue::Push;
+};
+
+/// Any sensor data will do, only the frame number matters.
+static SharedPtr<sensor::SensorData> MakeData(uint64_t frame) {
+  using SensorHeader = sensor::s11n::SensorHeaderSerializer::Header;
+  using EpisodeHeader = sensor::s11n::EpisodeStateSerializer::Header;
+  Buffer buffer(sizeof(SensorHeader) + sizeof(EpisodeHeader));
+  std::memset(buffer.data(), 0, buffer.size());
+  reinterpret_cast<SensorHeader *>(buffer.data())->frame_number = frame;
+  return Serializer::Deserialize(std::move(buffer));
+}
+
+static std::vector<size_t> GetFrames(const std::vector<SensorQueue::DataPtr> &batch) {
+  std::vector<size_t> result;
+  for (auto &&data : batch) {
+    result.emplace_back(data->GetFrameNumber());
+  }
+  return result;
+}
+
+TEST(sensor_queue, get) {
+  auto queue = MakeShared<TestSensorQueue>(4u);
+  ASSERT_EQ(queue->Get(time_duration::milliseconds(1u)), nullptr);
+  queue->Push(MakeData(1u));
+  queue->Push(MakeData(2u));
+  ASSERT_EQ(queue->size(), 2u);
+  ASSERT_EQ(queue->Get(time_duration::milliseconds(1u))->GetFrameNumber(), 1u);
+  ASSERT_EQ(queue->Get(time_duration::milliseconds(1u))->GetFrameNumber(), 2u);
+  ASSERT_EQ(queue->size(), 0u);
+
+  // A consumer waiting is woken up by the producer.
+  std::thread producer([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue->Push(MakeData(3u));
+  });
+  auto data = queue->Get(time_duration::seconds(10u));
+  producer.join();
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->GetFrameNumber(), 3u);
+}
+
+TEST(sensor_queue, drop_oldest) {
+  auto queue = MakeShared<TestSensorQueue>(2u, Policy::DropOldest);
+  for (auto frame = 1u; frame <= 5u; ++frame) {
+    queue->Push(MakeData(frame));
+  }
+  ASSERT_EQ(queue->size(), 2u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 3u);
+  ASSERT_EQ(GetFrames(queue->GetBatch(0u, time_duration::milliseconds(1u))), (std::vector<size_t>{4u, 5u}));
+}
+
+TEST(sensor_queue, drop_newest) {
+  auto queue = MakeShared<TestSensorQueue>(2u, Policy::DropNewest);
+  for (auto frame = 1u; frame <= 5u; ++frame) {
+    queue->Push(MakeData(frame));
+  }
+  ASSERT_EQ(queue->size(), 2u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 3u);
+  ASSERT_EQ(GetFrames(queue->GetBatch(0u, time_duration::milliseconds(1u))), (std::vector<size_t>{1u, 2u}));
+}
+
+TEST(sensor_queue, get_frame) {
+  auto queue = MakeShared<TestSensorQueue>(8u);
+  for (auto frame : {1u, 2u, 4u, 5u}) {
+    queue->Push(MakeData(frame));
+  }
+  // Older frames are discarded.
+  auto data = queue->GetFrame(2u, time_duration::milliseconds(1u));
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->GetFrameNumber(), 2u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 1u);
+
+  // A newer frame arrives first, it is kept as pending.
+  ASSERT_EQ(queue->GetFrame(3u, time_duration::milliseconds(1u)), nullptr);
+  ASSERT_EQ(queue->size(), 2u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 1u);
+
+  // The pending frame is returned before the queue.
+  data = queue->GetFrame(4u, time_duration::milliseconds(1u));
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->GetFrameNumber(), 4u);
+  queue->Push(MakeData(6u));
+  ASSERT_EQ(queue->GetFrame(6u, time_duration::milliseconds(1u))->GetFrameNumber(), 6u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 2u);
+  ASSERT_EQ(queue->size(), 0u);
+  ASSERT_EQ(queue->GetFrame(7u, time_duration::milliseconds(1u)), nullptr);
+
+  // The pending frame counts in the batch and the latest too.
+  queue->Push(MakeData(8u));
+  queue->Push(MakeData(9u));
+  ASSERT_EQ(queue->GetFrame(7u, time_duration::milliseconds(1u)), nullptr);
+  ASSERT_EQ(GetFrames(queue->GetBatch(1u, time_duration::milliseconds(1u))), (std::vector<size_t>{8u}));
+  queue->Push(MakeData(10u));
+  ASSERT_EQ(queue->GetFrame(7u, time_duration::milliseconds(1u)), nullptr);
+  ASSERT_EQ(queue->GetLatest()->GetFrameNumber(), 10u);
+}
+
+TEST(sensor_queue, get_batch) {
+  auto queue = MakeShared<TestSensorQueue>(8u);
+  ASSERT_TRUE(queue->GetBatch(0u, time_duration::milliseconds(1u)).empty());
+  for (auto frame = 1u; frame <= 5u; ++frame) {
+    queue->Push(MakeData(frame));
+  }
+  ASSERT_EQ(GetFrames(queue->GetBatch(2u, time_duration::milliseconds(1u))), (std::vector<size_t>{1u, 2u}));
+  ASSERT_EQ(GetFrames(queue->GetBatch(0u, time_duration::milliseconds(1u))), (std::vector<size_t>{3u, 4u, 5u}));
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 0u);
+}
+
+TEST(sensor_queue, get_latest) {
+  auto queue = MakeShared<TestSensorQueue>(8u);
+  ASSERT_EQ(queue->GetLatest(), nullptr);
+  for (auto frame = 1u; frame <= 5u; ++frame) {
+    queue->Push(MakeData(frame));
+  }
+  ASSERT_EQ(queue->GetLatest()->GetFrameNumber(), 5u);
+  ASSERT_EQ(queue->GetNumberOfDroppedMeasurements(), 4u);
+  ASSERT_EQ(queue->size(), 0u);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/SensorRecorder.h>
+#include <carla/client/SensorRecording.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using carla::Buffer;
+using carla::client::SensorRecorder;
+using carla::client::SensorRecording;
+using carla::time_duration;
+using Header = carla::sensor::s11n::SensorHeaderSerializer::Header;
+
+static Buffer MakeMessage(uint64_t frame, size_t payload_size) {
+  Buffer buffer(sizeof(Header) + payload_size);
+  Header header{};
+  header.frame_number = frame;
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  for (auto i = 0u; i < payload_size; ++i) {
+    buffer.data()[sizeof(header) + i] = static_cast<unsigned char>(frame + i);
+  }
+  return buffer;
+}
+
+/// Removes the recording folder when going out of scope.
+class ScopedFolder {
+public:
+
+  explicit ScopedFolder(std::string path) : _path(std::move(path)) {}
+
+  ~ScopedFolder() {
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(_path, ec);
+  }
+
+  const std::string &path() const {
+    return _path;
+  }
+
+private:
+
+  const std::string _path;
+};
+
+static void TestRecording(const std::string &path, bool direct_io) {
+  const ScopedFolder folder{path};
+  constexpr uint64_t number_of_messages = 200u;
+  auto message_size = [](uint64_t frame) { return 1000u + 37u * frame; };
+  {
+    SensorRecorder::Options options;
+    options.segment_size = 64u * 1024u;
+    options.direct_io = direct_io;
+    auto recorder = carla::MakeShared<SensorRecorder>(folder.path(), options);
+    for (auto frame = 0u; frame < number_of_messages; ++frame) {
+      recorder->Record(MakeMessage(frame, message_size(frame)));
+    }
+    recorder->Close();
+    ASSERT_EQ(recorder->GetNumberOfRecordedMessages(), number_of_messages);
+    ASSERT_EQ(recorder->GetNumberOfDroppedMessages(), 0u);
+  }
+  SensorRecording recording(folder.path());
+  ASSERT_EQ(recording.size(), number_of_messages);
+  for (auto frame = 0u; frame < number_of_messages; ++frame) {
+    auto pos = recording.Find(frame);
+    ASSERT_TRUE(pos.has_value());
+    ASSERT_EQ(recording.GetFrameNumber(*pos), frame);
+    auto buffer = recording.Read(*pos);
+    auto expected = MakeMessage(frame, message_size(frame));
+    ASSERT_EQ(buffer.size(), expected.size());
+    ASSERT_EQ(std::memcmp(buffer.data(), expected.data(), buffer.size()), 0);
+  }
+  ASSERT_FALSE(recording.Find(number_of_messages).has_value());
+}
+
+TEST(sensor_recorder, buffered_io) {
+  TestRecording("_test_sensor_recording_buffered", false);
+}
+
+TEST(sensor_recorder, direct_io) {
+  TestRecording("_test_sensor_recording_direct", true);
+}
+
+TEST(sensor_recorder, drops_when_queue_is_full) {
+  SensorRecorder::Options options;
+  options.max_queue_size = 0u;
+  const ScopedFolder folder{"_test_sensor_recording_drop"};
+  auto recorder = carla::MakeShared<SensorRecorder>(folder.path(), options);
+  recorder->Record(MakeMessage(0u, 100u));
+  recorder->Close();
+  ASSERT_EQ(recorder->GetNumberOfDroppedMessages(), 1u);
+  SensorRecording recording(recorder->GetFolder());
+  ASSERT_TRUE(recording.empty());
+}
+
+TEST(sensor_recorder, find_out_of_order_frames) {
+  const ScopedFolder folder{"_test_sensor_recording_order"};
+  const std::vector<uint64_t> frames = {5u, 3u, 4u, 3u, 9u, 1u};
+  {
+    auto recorder = carla::MakeShared<SensorRecorder>(folder.path(), SensorRecorder::Options{});
+    for (auto frame : frames) {
+      recorder->Record(MakeMessage(frame, 10u));
+    }
+    recorder->Close();
+  }
+  SensorRecording recording(folder.path());
+  ASSERT_EQ(recording.size(), frames.size());
+  for (auto frame : frames) {
+    auto pos = recording.Find(frame);
+    ASSERT_TRUE(pos.has_value());
+    ASSERT_EQ(recording.GetFrameNumber(*pos), frame);
+  }
+  // The first message of the frame in recording order.
+  ASSERT_EQ(*recording.Find(3u), 1u);
+  ASSERT_FALSE(recording.Find(0u).has_value());
+  ASSERT_FALSE(recording.Find(2u).has_value());
+  ASSERT_FALSE(recording.Find(10u).has_value());
+}
+
+TEST(sensor_recorder, flush_size) {
+  const ScopedFolder folder{"_test_sensor_recording_flush_size"};
+  SensorRecorder::Options options;
+  options.flush_size = 1000u;
+  options.flush_interval = time_duration::seconds(3600u);
+  auto recorder = carla::MakeShared<SensorRecorder>(folder.path(), options);
+  recorder->Record(MakeMessage(0u, 100u));
+  recorder->Record(MakeMessage(1u, 1000u));
+  recorder->Record(MakeMessage(2u, 100u));
+  for (auto i = 0; (i < 100) && (recorder->GetNumberOfRecordedMessages() < 3u); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(recorder->GetNumberOfRecordedMessages(), 3u);
+  // Only the messages up to the one crossing the flush size are visible.
+  ASSERT_EQ(SensorRecording(folder.path()).size(), 2u);
+  recorder->Close();
+  ASSERT_EQ(SensorRecording(folder.path()).size(), 3u);
+}
+
+TEST(sensor_recorder, flush_interval) {
+  const ScopedFolder folder{"_test_sensor_recording_flush_interval"};
+  SensorRecorder::Options options;
+  options.flush_interval = time_duration::milliseconds(20u);
+  auto recorder = carla::MakeShared<SensorRecorder>(folder.path(), options);
+  recorder->Record(MakeMessage(0u, 100u));
+  size_t size = 0u;
+  for (auto i = 0; (i < 100) && (size == 0u); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    size = SensorRecording(folder.path()).size();
+  }
+  ASSERT_EQ(size, 1u);
+  recorder->Close();
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/SensorFrameAssembler.h>
+#include <carla/sensor/CompositeSerializer.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace carla;
+using client::Timestamp;
+using client::detail::SensorFrameAssembler;
+using Policy = SensorFrameAssembler::IncompleteFramePolicy;
+
+using Serializer = sensor::CompositeSerializer<
+    std::pair<void *, sensor::s11n::EpisodeStateSerializer>>;
+
+/// Any sensor data will do, only the frame number matters.
+static SharedPtr<sensor::SensorData> MakeData(uint64_t frame) {
+  using SensorHeader = sensor::s11n::SensorHeaderSerializer::Header;
+  using EpisodeHeader = sensor::s11n::EpisodeStateSerializer::Header;
+  Buffer buffer(sizeof(SensorHeader) + sizeof(EpisodeHeader));
+  std::memset(buffer.data(), 0, buffer.size());
+  reinterpret_cast<SensorHeader *>(buffer.data())->frame_number = frame;
+  return Serializer::Deserialize(std::move(buffer));
+}
+
+static Timestamp MakeTick(size_t frame) {
+  return Timestamp{frame, 0.05 * frame, 0.05, 0.0};
+}
+
+TEST(sensor_synchronizer, matches_frames_across_sensors) {
+  SensorFrameAssembler assembler{2u, 8u, time_duration::seconds(10u), Policy::Drop};
+  // Each stream in order, but interleaved differently.
+  assembler.AddData(0u, MakeData(1u));
+  assembler.AddData(0u, MakeData(2u));
+  assembler.AddTick(MakeTick(1u), nullptr);
+  assembler.AddData(1u, MakeData(1u));
+  auto bundle = assembler.PopReady();
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_EQ(bundle->GetFrameNumber(), 1u);
+  ASSERT_TRUE(bundle->IsComplete());
+  ASSERT_EQ(bundle->at(0u)->GetFrameNumber(), 1u);
+  ASSERT_EQ(bundle->at(1u)->GetFrameNumber(), 1u);
+  ASSERT_EQ(bundle->GetTimestamp()->frame_count, 1u);
+  ASSERT_EQ(assembler.PopReady(), nullptr);
+  assembler.AddTick(MakeTick(2u), nullptr);
+  ASSERT_FALSE(assembler.HasReady());
+  assembler.AddData(1u, MakeData(2u));
+  bundle = assembler.PopReady();
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_EQ(bundle->GetFrameNumber(), 2u);
+  ASSERT_TRUE(bundle->IsComplete());
+  ASSERT_EQ(assembler.GetNumberOfDroppedFrames(), 0u);
+}
+
+TEST(sensor_synchronizer, complete_frame_evicts_older_frames) {
+  SensorFrameAssembler assembler{1u, 8u, time_duration::seconds(10u), Policy::Drop};
+  assembler.AddData(0u, MakeData(1u));
+  assembler.AddData(0u, MakeData(2u));
+  assembler.AddTick(MakeTick(2u), nullptr);
+  auto bundle = assembler.PopReady();
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_EQ(bundle->GetFrameNumber(), 2u);
+  ASSERT_EQ(assembler.PopReady(), nullptr);
+  ASSERT_EQ(assembler.GetNumberOfDroppedFrames(), 1u);
+  // The tick of frame 1 arrives too late.
+  assembler.AddTick(MakeTick(1u), nullptr);
+  ASSERT_FALSE(assembler.HasReady());
+}
+
+TEST(sensor_synchronizer, window_drops_incomplete_frames) {
+  SensorFrameAssembler assembler{1u, 2u, time_duration::seconds(10u), Policy::Drop};
+  for (auto frame = 1u; frame <= 5u; ++frame) {
+    assembler.AddData(0u, MakeData(frame));
+  }
+  ASSERT_FALSE(assembler.HasReady());
+  ASSERT_EQ(assembler.GetNumberOfDroppedFrames(), 3u);
+  assembler.AddTick(MakeTick(4u), nullptr);
+  auto bundle = assembler.PopReady();
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_EQ(bundle->GetFrameNumber(), 4u);
+}
+
+TEST(sensor_synchronizer, window_delivers_incomplete_frames) {
+  SensorFrameAssembler assembler{2u, 2u, time_duration::seconds(10u), Policy::Deliver};
+  for (auto frame = 1u; frame <= 4u; ++frame) {
+    assembler.AddData(0u, MakeData(frame));
+  }
+  for (auto frame = 1u; frame <= 2u; ++frame) {
+    auto bundle = assembler.PopReady();
+    ASSERT_NE(bundle, nullptr);
+    ASSERT_EQ(bundle->GetFrameNumber(), frame);
+    ASSERT_FALSE(bundle->IsComplete());
+    ASSERT_NE(bundle->at(0u), nullptr);
+    ASSERT_EQ(bundle->at(1u), nullptr);
+    ASSERT_FALSE(bundle->GetTimestamp().has_value());
+  }
+  ASSERT_EQ(assembler.PopReady(), nullptr);
+  ASSERT_EQ(assembler.GetNumberOfDroppedFrames(), 0u);
+}
+
+TEST(sensor_synchronizer, timeout_drops_incomplete_frames) {
+  SensorFrameAssembler assembler{1u, 8u, time_duration::milliseconds(10u), Policy::Drop};
+  assembler.AddData(0u, MakeData(1u));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // Eviction is checked with every piece received.
+  assembler.AddData(0u, MakeData(2u));
+  ASSERT_EQ(assembler.GetNumberOfDroppedFrames(), 1u);
+  assembler.AddTick(MakeTick(1u), nullptr);
+  ASSERT_FALSE(assembler.HasReady());
+  assembler.AddTick(MakeTick(2u), nullptr);
+  auto bundle = assembler.PopReady();
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_EQ(bundle->GetFrameNumber(), 2u);
+}
+
+TEST(sensor_synchronizer, clear) {
+  SensorFrameAssembler assembler{1u, 8u, time_duration::seconds(10u), Policy::Drop};
+  assembler.AddData(0u, MakeData(1u));
+  assembler.AddTick(MakeTick(1u), nullptr);
+  assembler.AddData(0u, MakeData(2u));
+  ASSERT_TRUE(assembler.HasReady());
+  assembler.Clear();
+  ASSERT_FALSE(assembler.HasReady());
+  assembler.AddTick(MakeTick(2u), nullptr);
+  ASSERT_FALSE(assembler.HasReady());
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/VehiclePIDController.h>
+
+#include <cmath>
+
+using carla::client::VehiclePIDController;
+using carla::geom::Location;
+using carla::geom::Rotation;
+using carla::geom::Transform;
+using carla::geom::Vector3D;
+
+static constexpr float EPSILON = 1e-5f;
+
+TEST(client, vehicle_pid_controller_steer) {
+  VehiclePIDController controller;
+  const Transform transform{Location{0.0f, 0.0f, 0.0f}, Rotation{0.0f, 0.0f, 0.0f}};
+  const auto controls = controller.Compute(
+      {{1u, Location{10.0f, 5.0f, 0.0f}, 0.0},
+       {2u, Location{10.0f, -5.0f, 0.0f}, 0.0},
+       {3u, Location{10.0f, 0.0f, 0.0f}, 0.0},
+       {4u, Location{-10.0f, 1.0f, 0.0f}, 0.0}},
+      {{transform, Vector3D{}},
+       {transform, Vector3D{}},
+       {transform, Vector3D{}},
+       {transform, Vector3D{}}});
+  ASSERT_EQ(controls.size(), 4u);
+  EXPECT_NEAR(controls[0u].steer, std::atan2(5.0, 10.0), EPSILON);
+  EXPECT_NEAR(controls[1u].steer, -std::atan2(5.0, 10.0), EPSILON);
+  EXPECT_NEAR(controls[2u].steer, 0.0f, EPSILON);
+  EXPECT_EQ(controls[3u].steer, 1.0f);
+  ASSERT_EQ(controller.GetNumberOfVehicles(), 4u);
+  controller.Remove(4u);
+  ASSERT_EQ(controller.GetNumberOfVehicles(), 3u);
+}
+
+TEST(client, vehicle_pid_controller_throttle) {
+  const double dt = 0.1;
+  const VehiclePIDController::Gains gains{0.01, 0.0001, 0.01};
+  VehiclePIDController controller{VehiclePIDController::Gains{}, gains, dt};
+  const Transform transform{Location{0.0f, 0.0f, 0.0f}, Rotation{0.0f, 90.0f, 0.0f}};
+  const VehiclePIDController::Target target{1u, Location{0.0f, 10.0f, 0.0f}, 20.0};
+
+  // First step, only the proportional term.
+  auto control = controller.Compute({target}, {{transform, Vector3D{}}}).front();
+  EXPECT_NEAR(control.throttle, 0.01 * 20.0, EPSILON);
+  EXPECT_NEAR(control.steer, 0.0f, EPSILON);
+  EXPECT_EQ(control.brake, 0.0f);
+  EXPECT_FALSE(control.hand_brake);
+
+  // Moving at 1 m/s, 3.6 km/h.
+  control = controller.Compute({target}, {{transform, Vector3D{0.0f, 1.0f, 0.0f}}}).front();
+  const double e = 20.0 - 3.6;
+  const double de = (e - 20.0) / dt;
+  const double ie = (20.0 + e) * dt;
+  EXPECT_NEAR(control.throttle, 0.01 * e + 0.0001 * de / dt + 0.01 * ie * dt, EPSILON);
+
+  // Faster than the target speed, never negative.
+  control = controller.Compute({target}, {{transform, Vector3D{0.0f, 10.0f, 0.0f}}}).front();
+  EXPECT_EQ(control.throttle, 0.0f);
+
+  // A vehicle forgotten starts over.
+  controller.Clear();
+  control = controller.Compute({target}, {{transform, Vector3D{}}}).front();
+  EXPECT_NEAR(control.throttle, 0.01 * 20.0, EPSILON);
+}
+
+TEST(client, vehicle_pid_controller_error_history) {
+  // Only the last 30 longitudinal errors are integrated.
+  const double dt = 1.0;
+  VehiclePIDController controller{VehiclePIDController::Gains{}, {0.0, 0.0, 0.001}, dt};
+  const Transform transform;
+  double throttle = 0.0;
+  for (auto i = 0u; i < 100u; ++i) {
+    throttle = controller.Compute({{1u, Location{}, 10.0}}, {{transform, Vector3D{}}}).front().throttle;
+  }
+  EXPECT_NEAR(throttle, 0.001 * 30.0 * 10.0, EPSILON);
+}
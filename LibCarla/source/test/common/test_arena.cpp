@@ -0,0 +1,105 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/Arena.h>
+#include <carla/RecyclingAllocator.h>
+#include <carla/ThreadGroup.h>
+#include <carla/profiler/Metrics.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using namespace carla;
+using profiler::Metrics;
+
+using ArenaMap = std::unordered_map<
+    uint32_t,
+    double,
+    std::hash<uint32_t>,
+    std::equal_to<uint32_t>,
+    ArenaAllocator<std::pair<const uint32_t, double>>>;
+
+static void FillMap(MonotonicArena &arena, size_t size) {
+  ArenaMap map(size, ArenaMap::hasher(), ArenaMap::key_equal(), ArenaMap::allocator_type(&arena));
+  for (auto i = 0u; i < size; ++i) {
+    map.emplace(i, static_cast<double>(i));
+  }
+  for (auto i = 0u; i < size; ++i) {
+    ASSERT_EQ(map.at(i), static_cast<double>(i));
+  }
+}
+
+TEST(arena, alignment_and_reset) {
+  MonotonicArena arena{128u};
+  auto *a = arena.Allocate(1u, 1u);
+  auto *b = arena.Allocate(8u, 8u);
+  auto *c = arena.Allocate(200u, 16u);
+  ASSERT_NE(a, b);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % 8u, 0u);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(c) % 16u, 0u);
+  ASSERT_GT(arena.GetCapacity(), 128u);
+  const auto capacity = arena.GetCapacity();
+  arena.Reset();
+  ASSERT_EQ(arena.GetUsedSize(), 0u);
+  // The blocks are merged into one as large as all of them.
+  ASSERT_EQ(arena.GetCapacity(), capacity);
+  arena.Allocate(capacity, 1u);
+  ASSERT_EQ(arena.GetUsedSize(), capacity);
+  ASSERT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(arena, steady_state_does_not_allocate) {
+  auto &heap_allocations = Metrics::GetCounter("memory.arena.heap_allocations");
+  MonotonicArena arena{256u};
+  FillMap(arena, 1000u);
+  arena.Reset();
+  const auto warm = heap_allocations.GetValue();
+  for (auto i = 0u; i < 10u; ++i) {
+    FillMap(arena, 1000u);
+    arena.Reset();
+  }
+  ASSERT_EQ(heap_allocations.GetValue(), warm);
+}
+
+TEST(arena, pool_recycles_arenas) {
+  MonotonicArena *first;
+  {
+    auto arena = ArenaPool::Acquire();
+    first = arena.get();
+    FillMap(*arena, 100u);
+  }
+  auto arena = ArenaPool::Acquire();
+  ASSERT_EQ(arena.get(), first);
+  ASSERT_EQ(arena->GetUsedSize(), 0u);
+}
+
+TEST(arena, recycling_allocator) {
+  auto &heap_allocations = Metrics::GetCounter("memory.recycling.heap_allocations");
+  struct Data {
+    explicit Data(int v) : value(v) {}
+    int value;
+    char padding[60u];
+  };
+  auto make = [](int value) {
+    return MakeRecycledShared<Data>([=](void *memory) { return new (memory) Data(value); });
+  };
+  make(1);
+  const auto warm = heap_allocations.GetValue();
+  {
+    ThreadGroup threads;
+    threads.CreateThreads(4u, [&]() {
+      for (auto i = 0; i < 1000; ++i) {
+        auto data = make(i);
+        ASSERT_EQ(data->value, i);
+      }
+    });
+  }
+  // At most one object and one reference count alive per thread.
+  ASSERT_LE(heap_allocations.GetValue(), warm + 8u);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/BoundedQueue.h>
+#include <carla/ThreadGroup.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using carla::BoundedQueue;
+
+TEST(bounded_queue, push_and_pop) {
+  BoundedQueue<int> queue{3u};
+  ASSERT_EQ(queue.capacity(), 3u);
+  ASSERT_TRUE(queue.empty());
+  int value = 0;
+  ASSERT_FALSE(queue.TryPop(value));
+  for (int i = 1; i <= 3; ++i) {
+    value = i;
+    ASSERT_TRUE(queue.TryPush(value));
+  }
+  ASSERT_EQ(queue.size(), 3u);
+  value = 4;
+  ASSERT_FALSE(queue.TryPush(value));
+  ASSERT_EQ(value, 4);
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, i);
+    value = i + 3;
+    ASSERT_TRUE(queue.TryPush(value));
+  }
+  for (int i = 4; i <= 6; ++i) {
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(bounded_queue, releases_popped_values) {
+  BoundedQueue<std::shared_ptr<int>> queue{2u};
+  auto ptr = std::make_shared<int>(42);
+  auto copy = ptr;
+  ASSERT_TRUE(queue.TryPush(copy));
+  ASSERT_EQ(ptr.use_count(), 2);
+  std::shared_ptr<int> popped;
+  ASSERT_TRUE(queue.TryPop(popped));
+  popped.reset();
+  ASSERT_EQ(ptr.use_count(), 1);
+}
+
+TEST(bounded_queue, multiple_producers_and_consumers) {
+  constexpr size_t number_of_producers = 4u;
+  constexpr size_t number_of_consumers = 4u;
+  constexpr size_t messages_per_producer = 10000u;
+  constexpr size_t total = number_of_producers * messages_per_producer;
+
+  BoundedQueue<size_t> queue{64u};
+  std::vector<std::atomic_size_t> received(total);
+  for (auto &&count : received) {
+    count = 0u;
+  }
+  std::atomic_size_t consumed{0u};
+
+  {
+    carla::ThreadGroup threads;
+    threads.CreateThreads(number_of_consumers, [&]() {
+      size_t value;
+      while (consumed < total) {
+        if (queue.TryPop(value)) {
+          ++received[value];
+          ++consumed;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for (size_t p = 0u; p < number_of_producers; ++p) {
+      threads.CreateThread([&queue, p]() {
+        for (size_t i = 0u; i < messages_per_producer; ++i) {
+          size_t value = p * messages_per_producer + i;
+          while (!queue.TryPush(value)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+  }
+
+  ASSERT_EQ(consumed, total);
+  for (auto &&count : received) {
+    ASSERT_EQ(count, 1u);
+  }
+  ASSERT_TRUE(queue.empty());
+}
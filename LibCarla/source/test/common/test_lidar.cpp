@@ -0,0 +1,71 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/sensor/s11n/LidarMeasurement.h>
+
+#include <cstring>
+
+using carla::sensor::s11n::LidarMeasurement;
+
+template <typename T>
+static T read_at(const carla::Buffer &buffer, size_t offset) {
+  T result;
+  std::memcpy(&result, buffer.data() + offset, sizeof(T));
+  return result;
+}
+
+TEST(lidar, default_layout) {
+  LidarMeasurement measurement(2u);
+  measurement.Reset(4u);
+  measurement.WritePoint(0u, {1.0f, 2.0f, 3.0f});
+  measurement.WritePoint(1u, {4.0f, 5.0f, 6.0f});
+  auto buffer = measurement.PopBuffer();
+  constexpr size_t header = 4u * sizeof(uint32_t);
+  ASSERT_EQ(buffer.size(), header + 6u * sizeof(float));
+  ASSERT_EQ(read_at<uint32_t>(buffer, sizeof(uint32_t)), 2u);
+  ASSERT_EQ(read_at<uint32_t>(buffer, 2u * sizeof(uint32_t)), 1u);
+  ASSERT_EQ(read_at<uint32_t>(buffer, 3u * sizeof(uint32_t)), 1u);
+  for (auto i = 0u; i < 6u; ++i) {
+    ASSERT_EQ(read_at<float>(buffer, header + i * sizeof(float)), static_cast<float>(i + 1u));
+  }
+}
+
+TEST(lidar, attributes_are_compacted) {
+  constexpr uint32_t attributes =
+      LidarMeasurement::Time |
+      LidarMeasurement::Intensity |
+      LidarMeasurement::Ring;
+  LidarMeasurement measurement(3u, attributes);
+  // Start with a small capacity to force the buffer to grow.
+  measurement.Reset(1u);
+  constexpr size_t number_of_points = 100u;
+  for (auto i = 0u; i < number_of_points; ++i) {
+    const auto value = static_cast<float>(i);
+    measurement.WritePoint(i % 3u, {value, value, value}, value, -value);
+  }
+  auto buffer = measurement.PopBuffer();
+  constexpr size_t header = 5u * sizeof(uint32_t);
+  const LidarMeasurement::Layout layout(attributes, number_of_points);
+  ASSERT_EQ(buffer.size(), header + layout.size);
+  ASSERT_EQ(read_at<uint32_t>(buffer, sizeof(uint32_t)), 3u | attributes);
+  for (auto i = 0u; i < number_of_points; ++i) {
+    const auto value = static_cast<float>(i);
+    ASSERT_EQ(read_at<float>(buffer, header + 3u * sizeof(float) * i), value);
+    ASSERT_EQ(read_at<float>(buffer, header + layout.time_offset + sizeof(float) * i), value);
+    ASSERT_EQ(read_at<float>(buffer, header + layout.intensity_offset + sizeof(float) * i), -value);
+    ASSERT_EQ(read_at<uint16_t>(buffer, header + layout.ring_offset + sizeof(uint16_t) * i), i % 3u);
+  }
+}
+
+TEST(lidar, empty_measurement) {
+  LidarMeasurement measurement(1u, LidarMeasurement::Time);
+  measurement.Reset(32u);
+  auto buffer = measurement.PopBuffer();
+  ASSERT_EQ(buffer.size(), 3u * sizeof(uint32_t));
+  ASSERT_EQ(read_at<uint32_t>(buffer, 2u * sizeof(uint32_t)), 0u);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/Logging.h>
+#include <carla/ThreadGroup.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace logging = carla::logging;
+
+using carla::log_info;
+
+/// Redirects std::cout to a string while in scope. Messages are written by
+/// the calling thread meanwhile, so the background thread never touches the
+/// stream being replaced.
+class CaptureOutput {
+public:
+
+  CaptureOutput() {
+    logging::SetSynchronous(true);
+    _previous = std::cout.rdbuf(_stream.rdbuf());
+  }
+
+  ~CaptureOutput() {
+    logging::Flush();
+    std::cout.rdbuf(_previous);
+    logging::SetSynchronous(false);
+  }
+
+  std::string str() {
+    logging::Flush();
+    return _stream.str();
+  }
+
+private:
+
+  std::ostringstream _stream;
+
+  std::streambuf *_previous;
+};
+
+TEST(logging, text_format) {
+  CaptureOutput output;
+  log_info("text format", 42, true, logging::kv("key", "value"), logging::kv("number", 3));
+  ASSERT_EQ(output.str(), "INFO: text format 42 true key=value number=3\n");
+}
+
+TEST(logging, json_format) {
+  CaptureOutput output;
+  logging::SetFormat(logging::Format::Json);
+  log_info("a \"quoted\" word", logging::kv("key", 1));
+  const auto str = output.str();
+  logging::SetFormat(logging::Format::Text);
+  ASSERT_NE(str.find("\"level\":\"INFO\""), std::string::npos);
+  ASSERT_NE(str.find("\"message\":\"a \\\"quoted\\\" word\""), std::string::npos);
+  ASSERT_NE(str.find("\"key\":\"1\"}\n"), std::string::npos);
+}
+
+TEST(logging, runtime_level) {
+  CaptureOutput output;
+  const auto level = logging::GetLevel();
+  logging::SetLevel(LIBCARLA_LOG_LEVEL_WARNING);
+  log_info("discarded");
+  logging::SetLevel(level);
+  log_info("runtime level");
+  ASSERT_EQ(output.str(), "INFO: runtime level\n");
+}
+
+TEST(logging, repeated_messages) {
+  CaptureOutput output;
+  for (auto i = 0u; i < 5u; ++i) {
+    log_info("repeated message");
+  }
+  log_info("different message");
+  ASSERT_EQ(
+      output.str(),
+      "INFO: repeated message\n"
+      "INFO: last message repeated 4 times\n"
+      "INFO: different message\n");
+}
+
+TEST(logging, repeated_messages_on_flush) {
+  CaptureOutput output;
+  for (auto i = 0u; i < 3u; ++i) {
+    log_info("repeated until exit");
+  }
+  ASSERT_EQ(
+      output.str(),
+      "INFO: repeated until exit\n"
+      "INFO: last message repeated 2 times\n");
+}
+
+TEST(logging, from_many_threads) {
+  CaptureOutput output;
+  {
+    carla::ThreadGroup threads;
+    threads.CreateThreads(4u, []() {
+      for (auto i = 0u; i < 100u; ++i) {
+        log_info("message", i);
+      }
+    });
+  }
+  std::istringstream lines(output.str());
+  std::string line;
+  size_t count = 0u;
+  while (std::getline(lines, line)) {
+    ASSERT_EQ(line.find("INFO: message "), 0u);
+    ++count;
+  }
+  // Consecutive identical messages from different threads may be collapsed.
+  ASSERT_LE(count, 400u);
+  ASSERT_GE(count, 200u);
+}
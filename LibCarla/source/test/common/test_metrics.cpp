@@ -0,0 +1,84 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/ThreadGroup.h>
+#include <carla/profiler/Metrics.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace carla::profiler;
+
+TEST(metrics, counter_from_many_threads) {
+  auto &counter = Metrics::GetCounter("test.counter");
+  ASSERT_EQ(&counter, &Metrics::GetCounter("test.counter"));
+  counter.Reset();
+  {
+    carla::ThreadGroup threads;
+    threads.CreateThreads(8u, [&]() {
+      for (auto i = 0u; i < 10000u; ++i) {
+        counter.Increment();
+      }
+    });
+  }
+  ASSERT_EQ(counter.GetValue(), 80000u);
+  counter.Increment(20000u);
+  ASSERT_EQ(counter.GetValue(), 100000u);
+  counter.Reset();
+  ASSERT_EQ(counter.GetValue(), 0u);
+}
+
+TEST(metrics, histogram) {
+  ASSERT_EQ(Histogram::GetBucket(0u), 0u);
+  ASSERT_EQ(Histogram::GetBucket(1u), 1u);
+  ASSERT_EQ(Histogram::GetBucket(2u), 2u);
+  ASSERT_EQ(Histogram::GetBucket(3u), 2u);
+  ASSERT_EQ(Histogram::GetBucket(1024u), 11u);
+  ASSERT_EQ(Histogram::GetBucket(UINT64_MAX), 64u);
+
+  Histogram histogram;
+  for (auto i = 1u; i <= 100u; ++i) {
+    histogram.Record(i);
+  }
+  const auto snapshot = histogram.GetSnapshot();
+  ASSERT_EQ(snapshot.count, 100u);
+  ASSERT_EQ(snapshot.sum, 5050u);
+  ASSERT_EQ(snapshot.max, 100u);
+  ASSERT_DOUBLE_EQ(snapshot.GetMean(), 50.5);
+  // 50 falls in [32, 64), 99 in [64, 128) capped by the maximum.
+  ASSERT_EQ(snapshot.GetPercentile(0.5), 63u);
+  ASSERT_EQ(snapshot.GetPercentile(0.99), 100u);
+  ASSERT_EQ(snapshot.GetPercentile(0.0), 1u);
+
+  histogram.Reset();
+  ASSERT_EQ(histogram.GetSnapshot().count, 0u);
+  ASSERT_EQ(histogram.GetSnapshot().GetPercentile(0.5), 0u);
+}
+
+TEST(metrics, snapshot) {
+  Metrics::GetCounter("test.snapshot.b").Increment(2u);
+  Metrics::GetCounter("test.snapshot.a").Increment(1u);
+  Metrics::GetGauge("test.snapshot.gauge").Set(-3);
+  Metrics::GetHistogram("test.snapshot.histogram").Record(42u);
+  const auto snapshot = Metrics::GetSnapshot();
+  ASSERT_TRUE(std::is_sorted(snapshot.counters.begin(), snapshot.counters.end()));
+  auto find = [](const auto &list, const std::string &name) {
+    return std::find_if(list.begin(), list.end(), [&](const auto &item) {
+      return item.first == name;
+    });
+  };
+  ASSERT_EQ(find(snapshot.counters, "test.snapshot.a")->second, 1u);
+  ASSERT_EQ(find(snapshot.counters, "test.snapshot.b")->second, 2u);
+  ASSERT_EQ(find(snapshot.gauges, "test.snapshot.gauge")->second, -3);
+  ASSERT_EQ(find(snapshot.histograms, "test.snapshot.histogram")->second.max, 42u);
+
+  Metrics::Reset();
+  ASSERT_EQ(Metrics::GetCounter("test.snapshot.a").GetValue(), 0u);
+  ASSERT_EQ(Metrics::GetGauge("test.snapshot.gauge").GetValue(), -3);
+  ASSERT_EQ(Metrics::GetHistogram("test.snapshot.histogram").GetSnapshot().count, 0u);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/NumericBuffer.h>
+
+#include <cstring>
+#include <vector>
+
+using carla::NumericBuffer;
+
+/// Buffer over @a items as numpy exports a 1-dimensional array.
+template <typename U>
+static NumericBuffer MakeBuffer(const std::vector<U> &items, const char *format) {
+  NumericBuffer buffer;
+  buffer.data = items.data();
+  buffer.format = format;
+  buffer.item_size = sizeof(U);
+  buffer.length = items.size() * sizeof(U);
+  buffer.stride = sizeof(U);
+  return buffer;
+}
+
+TEST(numeric_buffer, native_numbers) {
+  const std::vector<float> floats = {1.5f, -2.0f, 3.0f};
+  for (auto format : {"f", "@f", "=f", "<f"}) {
+    std::vector<double> result;
+    ASSERT_TRUE(MakeBuffer(floats, format).CopyTo(result)) << format;
+    ASSERT_EQ(result, (std::vector<double>{1.5, -2.0, 3.0}));
+  }
+  // Converted to the type requested.
+  const std::vector<int64_t> ids = {1, 42, 7};
+  std::vector<uint32_t> result;
+  ASSERT_TRUE(MakeBuffer(ids, "q").CopyTo(result));
+  ASSERT_EQ(result, (std::vector<uint32_t>{1u, 42u, 7u}));
+  const std::vector<uint8_t> bools = {1u, 0u, 1u};
+  std::vector<bool> flags;
+  ASSERT_TRUE(MakeBuffer(bools, "?").CopyTo(flags));
+  ASSERT_EQ(flags, (std::vector<bool>{true, false, true}));
+  // Empty arrays too.
+  ASSERT_TRUE(MakeBuffer(std::vector<int32_t>{}, "i").CopyTo(result));
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(numeric_buffer, unaligned_items) {
+  std::vector<uint8_t> bytes(1u + 2u * sizeof(double));
+  const double values[] = {0.25, -8.0};
+  std::memcpy(bytes.data() + 1u, values, sizeof(values));
+  NumericBuffer buffer;
+  buffer.data = bytes.data() + 1u;
+  buffer.format = "d";
+  buffer.item_size = sizeof(double);
+  buffer.length = sizeof(values);
+  buffer.stride = sizeof(double);
+  std::vector<double> result;
+  ASSERT_TRUE(buffer.CopyTo(result));
+  ASSERT_EQ(result, (std::vector<double>{0.25, -8.0}));
+}
+
+TEST(numeric_buffer, wrong_dtype) {
+  const std::vector<uint16_t> halfs = {1u, 2u};
+  const std::vector<int32_t> ints = {1, 2};
+  const std::vector<int64_t> longs = {1, 2};
+  const std::vector<double> result_before = {9.0};
+  auto rejects = [&](const NumericBuffer &buffer) {
+    auto result = result_before;
+    const bool copied = buffer.CopyTo(result);
+    // Left untouched.
+    return !copied && (result == result_before);
+  };
+  // Half floats, structs and non-native byte order are not native numbers.
+  ASSERT_TRUE(rejects(MakeBuffer(halfs, "e")));
+  ASSERT_TRUE(rejects(MakeBuffer(ints, "ii")));
+  ASSERT_TRUE(rejects(MakeBuffer(ints, "T{i:x:}")));
+  ASSERT_TRUE(rejects(MakeBuffer(ints, ">i")));
+  ASSERT_TRUE(rejects(MakeBuffer(ints, "")));
+  ASSERT_TRUE(rejects(MakeBuffer(ints, nullptr)));
+  // The item size must match the format, "=l" is 4 bytes, not a native long.
+  ASSERT_TRUE(rejects(MakeBuffer(ints, "d")));
+  if (sizeof(long) != sizeof(int32_t)) {
+    ASSERT_TRUE(rejects(MakeBuffer(ints, "=l")));
+  }
+  ASSERT_TRUE(rejects(MakeBuffer(longs, "i")));
+}
+
+TEST(numeric_buffer, wrong_length) {
+  const std::vector<int32_t> ints = {1, 2, 3};
+  std::vector<int32_t> result;
+  auto buffer = MakeBuffer(ints, "i");
+  buffer.length -= 1u;
+  ASSERT_FALSE(buffer.CopyTo(result));
+  buffer = MakeBuffer(ints, "i");
+  buffer.item_size = 0u;
+  ASSERT_FALSE(buffer.CopyTo(result));
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(numeric_buffer, wrong_stride) {
+  const std::vector<int32_t> ints = {1, 2, 3, 4};
+  std::vector<int32_t> result;
+  // Every other item, a reversed array, and a broadcast one.
+  for (std::ptrdiff_t stride : {8, -4, 0}) {
+    auto buffer = MakeBuffer(ints, "i");
+    buffer.length = 2u * sizeof(int32_t);
+    buffer.stride = stride;
+    ASSERT_FALSE(buffer.CopyTo(result)) << stride;
+  }
+  ASSERT_TRUE(result.empty());
+  // A single item can have any stride.
+  auto buffer = MakeBuffer(ints, "i");
+  buffer.length = sizeof(int32_t);
+  buffer.stride = 1234;
+  ASSERT_TRUE(buffer.CopyTo(result));
+  ASSERT_EQ(result, (std::vector<int32_t>{1}));
+}
+
+TEST(numeric_buffer, not_one_dimensional) {
+  const std::vector<int32_t> ints = {1, 2, 3, 4};
+  std::vector<int32_t> result;
+  for (size_t ndim : {0u, 2u}) {
+    auto buffer = MakeBuffer(ints, "i");
+    buffer.ndim = ndim;
+    ASSERT_FALSE(buffer.CopyTo(result)) << ndim;
+  }
+  ASSERT_TRUE(result.empty());
+}
@@ -5,8 +5,14 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 #include "test.h"
+#include "test/Road.h"
 
+#include <carla/opendrive/OpenDrive.h>
+#include <carla/road/LaneOccupancy.h>
+#include <carla/road/LanePolylines.h>
+#include <carla/road/LaneTracker.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/WaypointGenerator.h>
 #include <carla/geom/Location.h>
 #include <carla/geom/Math.h>
 #include <carla/road/element/RoadInfoVisitor.h>
@@ -201,3 +207,460 @@ TEST(road, get_information) {
   const auto r = m.GetData().GetRoad(0)->GetInfo<RoadInfoVelocity>(0.0);
   (void)r;
 }
+
+TEST(road, get_lane_information) {
+  MapBuilder builder;
+  RoadSegmentDefinition def(0);
+
+  def.MakeGeometry<GeometryLine>(0, 10, 0, carla::geom::Location());
+  def.MakeInfo<element::RoadInfoLane>();
+  def.MakeInfo<element::RoadInfoLaneWidth>(0, -1, 3.0, 0.0, 0.0, 0.0);
+  def.MakeInfo<element::RoadInfoLaneWidth>(0, -2, 2.0, 0.0, 0.0, 0.0);
+  def.MakeInfo<element::RoadInfoLaneWidth>(4, -1, 3.5, 0.0, 0.0, 0.0);
+  def.MakeInfo<element::RoadInfoLaneWidth>(8, -2, 2.5, 0.0, 0.0, 0.0);
+
+  builder.AddRoadSegmentDefinition(def);
+  auto map_ptr = builder.Build();
+  const auto &road = *map_ptr->GetData().GetRoad(0);
+
+  auto width = [&](int lane_id, double s) {
+    const auto *info = road.GetInfo<RoadInfoLaneWidth>(lane_id, s);
+    return info != nullptr ? info->GetPolynomial().Evaluate(s) : 0.0;
+  };
+  ASSERT_EQ(width(-1, 2.0), 3.0);
+  ASSERT_EQ(width(-1, 4.0), 3.5);
+  ASSERT_EQ(width(-2, 6.0), 2.0);
+  ASSERT_EQ(width(-2, 9.0), 2.5);
+  ASSERT_EQ(road.GetInfo<RoadInfoLaneWidth>(-3, 5.0), nullptr);
+
+  // All lanes, nearest first.
+  std::vector<double> widths;
+  for (auto &&info : road.GetInfos<RoadInfoLaneWidth>(5.0)) {
+    widths.emplace_back(info->GetPolynomial().Evaluate(5.0));
+  }
+  ASSERT_EQ(widths, (std::vector<double>{3.5, 2.0, 3.0}));
+  ASSERT_EQ(road.GetInfosReverse<RoadInfoLaneWidth>(5.0).size(), 1);
+}
+
+TEST(road, lane_type_mask) {
+  auto map = util::road::make_ring_map();
+  const auto sidewalks = WaypointGenerator::GenerateAll(*map, 50.0, LaneType::Sidewalk);
+  ASSERT_EQ(sidewalks.size(), 2u);
+  for (auto &&waypoint : sidewalks) {
+    ASSERT_EQ(waypoint.GetRoadId(), 4u);
+    ASSERT_EQ(waypoint.GetLaneId(), -2);
+    ASSERT_EQ(waypoint.GetType(), LaneType::Sidewalk);
+  }
+  ASSERT_EQ(WaypointGenerator::GenerateAll(*map, 50.0).size(), 12u);
+  ASSERT_EQ(WaypointGenerator::GenerateAll(*map, 50.0, LaneType::Driving | LaneType::Sidewalk).size(), 14u);
+  ASSERT_EQ(WaypointGenerator::GenerateAll(*map, 50.0, LaneType::Parking).size(), 0u);
+
+  const auto location = sidewalks.front().ComputeTransform().location;
+  auto driving = map->GetClosestWaypointOnRoad(location);
+  ASSERT_TRUE(driving.has_value());
+  ASSERT_EQ(driving->GetLaneId(), -1);
+  ASSERT_FALSE(map->GetWaypoint(location).has_value());
+  auto sidewalk = map->GetWaypoint(location, LaneType::Any);
+  ASSERT_TRUE(sidewalk.has_value());
+  ASSERT_EQ(sidewalk->GetLaneId(), -2);
+  ASSERT_FALSE(map->GetClosestWaypointOnRoad(location, LaneType::Parking).has_value());
+}
+
+TEST(road, parse_lane_types) {
+  const std::string xodr = R"(<?xml version="1.0" standalone="yes"?>
+<OpenDRIVE>
+  <road name="road" length="50.0" id="0" junction="-1">
+    <planView>
+      <geometry s="0.0" x="0.0" y="0.0" hdg="0.0" length="50.0"><line/></geometry>
+    </planView>
+    <lanes>
+      <laneOffset s="0.0" a="0.0" b="0.0" c="0.0" d="0.0"/>
+      <laneSection s="0.0">
+        <center>
+          <lane id="0" type="none" level="false">
+            <roadMark sOffset="0.0" type="solid solid" weight="bold" color="yellow" material="asphalt" width="0.2" laneChange="none"/>
+          </lane>
+        </center>
+        <right>
+          <lane id="-1" type="driving" level="false">
+            <width sOffset="0.0" a="3.5" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="broken" color="white" width="0.15" laneChange="both"/>
+          </lane>
+          <lane id="-2" type="sidewalk" level="false">
+            <width sOffset="0.0" a="2.0" b="0.0" c="0.0" d="0.0"/>
+            <roadMark sOffset="0.0" type="curb" width="0.15"/>
+          </lane>
+        </right>
+      </laneSection>
+    </lanes>
+  </road>
+</OpenDRIVE>)";
+  auto map = carla::opendrive::OpenDrive::Load(xodr, XmlInputType::CONTENT);
+  ASSERT_NE(map, nullptr);
+  const auto &road = *map->GetData().GetRoad(0);
+  const auto lanes = road.GetInfo<RoadInfoLane>(0.0);
+  ASSERT_NE(lanes, nullptr);
+  ASSERT_EQ(lanes->getLane(-1)->_type, LaneType::Driving);
+  ASSERT_EQ(lanes->getLane(-2)->_type, LaneType::Sidewalk);
+
+  using Mark = RoadInfoMarkRecord;
+  auto mark = [&](int lane_id) {
+    const auto *info = road.GetInfo<Mark>(lane_id, 0.0);
+    EXPECT_NE(info, nullptr);
+    return info;
+  };
+  ASSERT_EQ(mark(0)->GetType(), Mark::Type::SolidSolid);
+  ASSERT_EQ(mark(0)->GetWeight(), Mark::Weight::Bold);
+  ASSERT_EQ(mark(0)->GetColor(), Mark::Color::Yellow);
+  ASSERT_EQ(mark(0)->GetMaterial(), "asphalt");
+  ASSERT_EQ(mark(-1)->GetType(), Mark::Type::Broken);
+  ASSERT_EQ(mark(-1)->GetLaneChange(), Mark::LaneChange::Both);
+  ASSERT_EQ(mark(-2)->GetType(), Mark::Type::Curb);
+  ASSERT_EQ(mark(-2)->GetLaneChange(), Mark::LaneChange::None);
+}
+
+TEST(road, lane_polylines) {
+  auto map = util::road::make_grid_map(4u, 50.0);
+  const double resolution = 3.0;
+  LanePolylines polylines(*map, resolution);
+  ASSERT_GT(polylines.GetNumberOfLanes(), 16u);
+  const auto &offsets = polylines.GetLaneOffsets();
+  ASSERT_EQ(offsets.size(), polylines.GetNumberOfLanes() + 1u);
+  ASSERT_EQ(offsets.back(), polylines.GetNumberOfPoints());
+  ASSERT_EQ(polylines.GetX().size(), polylines.GetNumberOfPoints());
+  ASSERT_EQ(polylines.GetLaneIds().size(), polylines.GetNumberOfPoints());
+
+  // Every sample of GenerateAll is a point of the polylines.
+  size_t count = 0u;
+  for (auto &&waypoint : WaypointGenerator::GenerateAll(*map, resolution)) {
+    const auto lane = polylines.FindLane(waypoint.GetRoadId(), waypoint.GetLaneId());
+    ASSERT_TRUE(lane.has_value());
+    const auto transform = waypoint.ComputeTransform();
+    auto i = offsets[*lane];
+    while ((i < offsets[*lane + 1u]) &&
+        (std::abs(polylines.GetX()[i] - transform.location.x) > 1e-3 ||
+         std::abs(polylines.GetY()[i] - transform.location.y) > 1e-3)) {
+      ++i;
+    }
+    ASSERT_LT(i, offsets[*lane + 1u]);
+    ASSERT_NEAR(polylines.GetX()[i], transform.location.x, 1e-3);
+    ASSERT_NEAR(polylines.GetY()[i], transform.location.y, 1e-3);
+    ASSERT_NEAR(polylines.GetZ()[i], transform.location.z, 1e-3);
+    ASSERT_NEAR(polylines.GetYaw()[i], transform.rotation.yaw, 1e-3);
+    ASSERT_EQ(polylines.GetRoadIds()[i], waypoint.GetRoadId());
+    ASSERT_EQ(polylines.GetLaneIds()[i], waypoint.GetLaneId());
+    ++count;
+  }
+  // Plus the end of each lane.
+  ASSERT_EQ(count + polylines.GetNumberOfLanes(), polylines.GetNumberOfPoints());
+  for (auto i = 0u; i < polylines.GetNumberOfLanes(); ++i) {
+    ASSERT_NEAR(polylines.GetS()[offsets[i + 1u] - 1u], 50.0, 1e-3);
+  }
+
+  ASSERT_FALSE(polylines.FindLane(1000u, -1).has_value());
+  ASSERT_EQ(LanePolylines(*map, resolution, LaneType::Sidewalk).GetNumberOfPoints(), 0u);
+  ASSERT_THROW(LanePolylines(*map, 0.0), std::invalid_argument);
+}
+
+TEST(road, lane_tracker) {
+  auto map = util::road::make_grid_map(4u, 50.0);
+  LaneTracker tracker(map);
+  LaneTracker sequential_tracker(map);
+
+  const auto starts = WaypointGenerator::GenerateLaneBegin(*map);
+  ASSERT_GE(starts.size(), 16u);
+  std::vector<Waypoint> actors(starts.begin(), starts.begin() + 16u);
+
+  // Drive the actors along their lanes half a meter per tick.
+  constexpr size_t number_of_ticks = 300u;
+  for (auto tick = 0u; tick < number_of_ticks; ++tick) {
+    std::vector<std::pair<carla::ActorId, Location>> batch;
+    for (auto i = 0u; i < actors.size(); ++i) {
+      batch.emplace_back(i, actors[i].ComputeTransform().location);
+    }
+    const auto result = tracker.Update(batch);
+    ASSERT_EQ(result.size(), actors.size());
+    for (auto i = 0u; i < actors.size(); ++i) {
+      ASSERT_TRUE(result[i].has_value());
+      const auto &waypoint = *result[i];
+      const auto &location = batch[i].second;
+      ASSERT_LT(Math::Distance2D(waypoint.ComputeTransform().location, location), 0.5 * waypoint.GetLaneWidth());
+      // Roads overlap where they meet, elsewhere the lane is unambiguous.
+      const auto node_x = 50.0f * std::round(location.x / 50.0f);
+      const auto node_y = 50.0f * std::round(location.y / 50.0f);
+      if (Math::Distance2D(location, Location(node_x, node_y, 0.0f)) > 4.0) {
+        ASSERT_EQ(waypoint.GetRoadId(), actors[i].GetRoadId());
+        ASSERT_EQ(waypoint.GetLaneId(), actors[i].GetLaneId());
+      }
+      const auto sequential = sequential_tracker.Update(batch[i].first, location);
+      ASSERT_TRUE(sequential.has_value());
+      ASSERT_EQ(sequential->GetRoadId(), waypoint.GetRoadId());
+      ASSERT_EQ(sequential->GetLaneId(), waypoint.GetLaneId());
+
+      const auto next = WaypointGenerator::GetNext(actors[i], 0.5);
+      ASSERT_FALSE(next.empty());
+      actors[i] = next[(tick + i) % next.size()];
+    }
+  }
+  const auto updates = number_of_ticks * actors.size();
+  ASSERT_EQ(tracker.GetNumberOfTrackedActors(), actors.size());
+  ASSERT_EQ(tracker.GetNumberOfHintHits() + tracker.GetNumberOfHintMisses(), updates);
+  ASSERT_EQ(sequential_tracker.GetNumberOfHintHits(), tracker.GetNumberOfHintHits());
+  // Only the first update of each actor, plus a few where overlapping roads
+  // meet, need a search over the whole map.
+  ASSERT_LT(tracker.GetNumberOfHintMisses(), updates / 50u);
+
+  const Location far_away(1e4f, 1e4f, 0.0f);
+  const auto projected = tracker.Project(far_away, actors.front());
+  const auto expected = map->GetClosestWaypointOnRoad(far_away);
+  ASSERT_TRUE(projected.has_value());
+  ASSERT_EQ(projected->GetRoadId(), expected->GetRoadId());
+  ASSERT_EQ(projected->GetLaneId(), expected->GetLaneId());
+
+  tracker.Remove(0u);
+  ASSERT_EQ(tracker.GetNumberOfTrackedActors(), actors.size() - 1u);
+  tracker.Clear();
+  ASSERT_EQ(tracker.GetNumberOfTrackedActors(), 0u);
+}
+
+TEST(road, lane_tracker_parallel_batch) {
+  auto map = util::road::make_grid_map(4u, 50.0);
+  LaneTracker tracker(map);
+  LaneTracker sequential_tracker(map);
+
+  // Several actors per lane, enough to split the batch in a few tasks.
+  const auto starts = WaypointGenerator::GenerateLaneBegin(*map);
+  std::vector<Waypoint> actors;
+  for (auto distance : {5.0, 15.0, 25.0, 35.0, 45.0}) {
+    for (auto &&start : starts) {
+      actors.emplace_back(WaypointGenerator::GetNext(start, distance).front());
+    }
+  }
+  ASSERT_GT(actors.size(), 3u * 64u);
+
+  for (auto tick = 0u; tick < 20u; ++tick) {
+    std::vector<std::pair<carla::ActorId, Location>> batch;
+    for (auto i = 0u; i < actors.size(); ++i) {
+      batch.emplace_back(i, actors[i].ComputeTransform().location);
+    }
+    const auto result = tracker.Update(batch);
+    ASSERT_EQ(result.size(), actors.size());
+    for (auto i = 0u; i < actors.size(); ++i) {
+      const auto sequential = sequential_tracker.Update(batch[i].first, batch[i].second);
+      ASSERT_TRUE(result[i].has_value());
+      ASSERT_TRUE(sequential.has_value());
+      ASSERT_EQ(result[i]->GetRoadId(), sequential->GetRoadId());
+      ASSERT_EQ(result[i]->GetLaneId(), sequential->GetLaneId());
+      const auto next = WaypointGenerator::GetNext(actors[i], 0.5);
+      ASSERT_FALSE(next.empty());
+      actors[i] = next[(tick + i) % next.size()];
+    }
+  }
+  ASSERT_EQ(tracker.GetNumberOfTrackedActors(), actors.size());
+  ASSERT_EQ(tracker.GetNumberOfHintHits(), sequential_tracker.GetNumberOfHintHits());
+  ASSERT_EQ(tracker.GetNumberOfHintMisses(), sequential_tracker.GetNumberOfHintMisses());
+}
+
+TEST(road, lane_crossings) {
+  // Two consecutive straight roads with a lane to the left and two to the
+  // right, the road marks of the first one change in the middle.
+  using Mark = RoadInfoMarkRecord;
+  auto add_mark = [](RoadSegmentDefinition &def, double s, int lane_id, Mark::Type type) {
+    def.MakeInfo<Mark>(s, lane_id, type, Mark::Weight::Standard, Mark::Color::White, "standard", 0.15, Mark::LaneChange::None, 0.0);
+  };
+  MapBuilder builder;
+  for (auto id = 0u; id < 2u; ++id) {
+    RoadSegmentDefinition def(id);
+    def.MakeGeometry<GeometryLine>(0.0, 100.0, 0.0, Location(100.0f * static_cast<float>(id), 0.0f, 0.0f));
+    def.MakeInfo<RoadInfoLaneOffset>(0.0, 0.0, 0.0, 0.0, 0.0);
+    auto lanes = def.MakeInfo<RoadInfoLane>();
+    for (auto lane_id : {1, -1, -2}) {
+      lanes->addLaneInfo(lane_id, 3.5, LaneType::Driving);
+      def.MakeInfo<RoadInfoLaneWidth>(0.0, lane_id, 3.5, 0.0, 0.0, 0.0);
+    }
+    if (id == 0u) {
+      add_mark(def, 0.0, 0, Mark::Type::SolidSolid);
+      add_mark(def, 0.0, 1, Mark::Type::Curb);
+      add_mark(def, 0.0, -1, Mark::Type::Broken);
+      add_mark(def, 50.0, -1, Mark::Type::Solid);
+      add_mark(def, 0.0, -2, Mark::Type::Grass);
+    } else {
+      add_mark(def, 0.0, 0, Mark::Type::Broken);
+      add_mark(def, 0.0, 1, Mark::Type::None);
+      add_mark(def, 0.0, -1, Mark::Type::BottsDots);
+      add_mark(def, 0.0, -2, Mark::Type::Curb);
+    }
+    builder.AddRoadSegmentDefinition(def);
+  }
+  auto map = builder.Build();
+  ASSERT_GT(map->GetLaneBoundaryIndex().GetNumberOfSegments(), 0u);
+
+  LanePolylines polylines(*map, 1.0);
+  auto center = [&](id_type road_id, int lane_id, size_t s) {
+    const auto lane = polylines.FindLane(road_id, lane_id);
+    EXPECT_TRUE(lane.has_value());
+    const auto i = polylines.GetLaneOffsets()[*lane] + s;
+    return Location(polylines.GetX()[i], polylines.GetY()[i], 0.0f);
+  };
+  auto crossed = [&](const Location &origin, const Location &destination) {
+    return map->CalculateCrossedLanes(origin, destination);
+  };
+  using LM = LaneMarking;
+  using LMs = std::vector<LaneMarking>;
+
+  ASSERT_EQ(crossed(center(0u, -1, 10u), center(0u, -1, 90u)), LMs{});
+  ASSERT_EQ(crossed(center(0u, 1, 20u), center(0u, -2, 20u)), (LMs{LM::SolidSolid, LM::Broken}));
+  ASSERT_EQ(crossed(center(0u, -2, 20u), center(0u, 1, 20u)), (LMs{LM::Broken, LM::SolidSolid}));
+  ASSERT_EQ(crossed(center(0u, -1, 70u), center(0u, -2, 70u)), LMs{LM::Solid});
+  // Diagonally across the change of road mark.
+  ASSERT_EQ(crossed(center(0u, -1, 40u), center(0u, -2, 56u)), LMs{LM::Broken});
+  ASSERT_EQ(crossed(center(0u, -1, 46u), center(0u, -2, 62u)), LMs{LM::Solid});
+
+  // Off the road on both sides.
+  const auto right = center(0u, -2, 20u) - center(0u, -1, 20u);
+  ASSERT_EQ(crossed(center(0u, -2, 20u), center(0u, -2, 20u) + right), LMs{LM::Grass});
+  ASSERT_EQ(crossed(center(0u, 1, 20u), center(0u, 1, 20u) - right), LMs{LM::Curb});
+  ASSERT_EQ(crossed(center(1u, 1, 20u), center(1u, 1, 20u) - right), LMs{});
+
+  // Across the end of the first road, the center line is crossed on the
+  // second one.
+  ASSERT_EQ(crossed(center(0u, 1, 95u), center(1u, -1, 20u)), LMs{LM::Broken});
+  ASSERT_EQ(crossed(center(0u, -1, 80u), center(1u, -2, 5u)), LMs{LM::Solid});
+  ASSERT_EQ(crossed(center(0u, -2, 98u), center(1u, -1, 8u)), LMs{LM::BottsDots});
+}
+
+TEST(road, lane_crossings_across_lane_sections) {
+  // Lane 1 is only in the first half of the road and lane -2 in the second
+  // half, each one has a boundary only along its half.
+  auto map = util::road::make_two_section_map();
+  LanePolylines polylines(*map, 1.0);
+  auto center = [&](int lane_id, size_t s) {
+    const auto lane = polylines.FindLane(0u, lane_id);
+    EXPECT_TRUE(lane.has_value());
+    const auto i = polylines.GetLaneOffsets()[*lane] + s;
+    return Location(polylines.GetX()[i], polylines.GetY()[i], 0.0f);
+  };
+  auto crossed = [&](const Location &origin, const Location &destination) {
+    return map->CalculateCrossedLanes(origin, destination);
+  };
+  using LM = LaneMarking;
+  using LMs = std::vector<LaneMarking>;
+  // One lane to the right.
+  const auto right = center(-1, 20u) - center(1, 20u);
+
+  ASSERT_EQ(crossed(center(-1, 25u), center(-1, 25u) - 2.0f * right), (LMs{LM::SolidSolid, LM::Broken}));
+  ASSERT_EQ(crossed(center(-1, 75u), center(-1, 75u) - 2.0f * right), LMs{LM::SolidSolid});
+  ASSERT_EQ(crossed(center(-1, 25u), center(-1, 25u) + 2.0f * right), LMs{LM::Broken});
+  ASSERT_EQ(crossed(center(-1, 75u), center(-1, 75u) + 2.0f * right), (LMs{LM::Broken, LM::Broken}));
+  // Along the lane through the start of the second section, and across the
+  // center line right where the sections meet.
+  ASSERT_EQ(crossed(center(-1, 40u), center(-1, 60u)), LMs{});
+  ASSERT_EQ(crossed(center(-1, 45u), center(-1, 55u) - right), LMs{LM::SolidSolid});
+}
+
+TEST(road, lane_crossings_in_junction) {
+  // Road 1 of the ring is a junction, its lane only has the outer boundary.
+  auto map = util::road::make_ring_map();
+  LanePolylines polylines(*map, 1.0);
+  const auto lane = polylines.FindLane(1u, -1);
+  ASSERT_TRUE(lane.has_value());
+  const auto i = polylines.GetLaneOffsets()[*lane] + 50u;
+  const Location location(polylines.GetX()[i], polylines.GetY()[i], 0.0f);
+  const auto yaw = Math::to_radians(polylines.GetYaw()[i]);
+  const Location side(3.0f * std::sin(yaw), -3.0f * std::cos(yaw), 0.0f);
+  auto one = map->CalculateCrossedLanes(location, location + side);
+  auto other = map->CalculateCrossedLanes(location, location - side);
+  ASSERT_EQ(one.size() + other.size(), 1u);
+  ASSERT_EQ(one.empty() ? other.front() : one.front(), LaneMarking::Broken);
+}
+
+TEST(road, lane_occupancy) {
+  auto map = util::road::make_grid_map(3u, 50.0);
+  LaneOccupancy occupancy(map);
+
+  // A lane with successors at least 60 m ahead.
+  const auto starts = WaypointGenerator::GenerateLaneBegin(*map);
+  auto start = std::find_if(starts.begin(), starts.end(), [](const Waypoint &waypoint) {
+    return !WaypointGenerator::GetNext(waypoint, 60.0).empty();
+  });
+  ASSERT_NE(start, starts.end());
+  auto at = [&](double distance) {
+    return WaypointGenerator::GetNext(*start, distance).front().ComputeTransform().location;
+  };
+  const auto left = WaypointGenerator::GetLeft(WaypointGenerator::GetNext(*start, 30.0).front());
+  ASSERT_TRUE(left.has_value());
+
+  using Vehicle = LaneOccupancy::Vehicle;
+  using TrafficLight = LaneOccupancy::TrafficLight;
+  using State = carla::rpc::TrafficLightState;
+  const carla::ActorId ego = 1u;
+
+  occupancy.Update({
+      Vehicle{ego, at(5.0), 0u},
+      Vehicle{2u, at(30.0), 0u},
+      Vehicle{3u, left->ComputeTransform().location, 0u}}, {});
+  ASSERT_EQ(occupancy.GetNumberOfVehicles(), 3u);
+  auto hazards = occupancy.Query(ego, 100.0);
+  ASSERT_EQ(hazards.vehicle_id, 2u);
+  ASSERT_NEAR(hazards.vehicle_distance, 25.0, 1e-3);
+  ASSERT_EQ(hazards.traffic_light_id, 0u);
+  ASSERT_EQ(occupancy.Query(ego, 20.0).vehicle_id, 0u);
+  // Vehicle 2 sees nothing ahead, the ego is behind it.
+  ASSERT_EQ(occupancy.Query(2u, 100.0).vehicle_id, 0u);
+  ASSERT_EQ(occupancy.Query(42u, 100.0).vehicle_id, 0u);
+
+  // On the next road.
+  occupancy.Update({Vehicle{ego, at(5.0), 0u}, Vehicle{4u, at(60.0), 0u}}, {
+      TrafficLight{10u, at(40.0), State::Red}});
+  ASSERT_EQ(occupancy.GetNumberOfVehicles(), 2u);
+  hazards = occupancy.Query(ego, 100.0);
+  ASSERT_EQ(hazards.vehicle_id, 4u);
+  ASSERT_NEAR(hazards.vehicle_distance, 55.0, 1e-3);
+  ASSERT_EQ(hazards.traffic_light_id, 10u);
+  ASSERT_NEAR(hazards.traffic_light_distance, 35.0, 1e-3);
+  ASSERT_EQ(hazards.traffic_light_state, State::Red);
+  ASSERT_EQ(occupancy.Query(ego, 50.0).vehicle_id, 0u);
+
+  // Only the straightest branch is followed unless asked for every branch.
+  auto fork = std::find_if(starts.begin(), starts.end(), [](const Waypoint &waypoint) {
+    return WaypointGenerator::GetNext(waypoint, 60.0).size() > 1u;
+  });
+  ASSERT_NE(fork, starts.end());
+  const auto ego_location = WaypointGenerator::GetNext(*fork, 5.0).front().ComputeTransform().location;
+  size_t straight_branches = 0u;
+  for (auto &&branch : WaypointGenerator::GetNext(*fork, 60.0)) {
+    occupancy.Update({Vehicle{ego, ego_location, 0u}, Vehicle{4u, branch.ComputeTransform().location, 0u}}, {});
+    ASSERT_EQ(occupancy.Query(ego, 100.0, true).vehicle_id, 4u);
+    straight_branches += occupancy.Query(ego, 100.0).vehicle_id == 4u ? 1u : 0u;
+  }
+  ASSERT_EQ(straight_branches, 1u);
+
+  // The traffic light reported by the simulator comes first.
+  occupancy.Update({Vehicle{ego, at(5.0), 11u}}, {
+      TrafficLight{10u, at(40.0), State::Red},
+      TrafficLight{11u, at(1000.0), State::Green}});
+  hazards = occupancy.Query(ego, 100.0);
+  ASSERT_EQ(hazards.vehicle_id, 0u);
+  ASSERT_EQ(hazards.traffic_light_id, 11u);
+  ASSERT_EQ(hazards.traffic_light_distance, 0.0);
+  ASSERT_EQ(hazards.traffic_light_state, State::Green);
+
+  // The batch query gives the same result as querying one by one.
+  std::vector<Vehicle> vehicles;
+  std::vector<carla::ActorId> ids;
+  for (auto i = 0u; i < starts.size(); ++i) {
+    vehicles.push_back({i + 1u, starts[i].ComputeTransform().location, 0u});
+    ids.emplace_back(i + 1u);
+  }
+  occupancy.Update(vehicles, {});
+  const auto batch = occupancy.Query(ids, 150.0);
+  ASSERT_EQ(batch.size(), ids.size());
+  size_t found = 0u;
+  for (auto i = 0u; i < ids.size(); ++i) {
+    const auto single = occupancy.Query(ids[i], 150.0);
+    ASSERT_EQ(batch[i].vehicle_id, single.vehicle_id);
+    ASSERT_EQ(batch[i].vehicle_distance, single.vehicle_distance);
+    found += single.vehicle_id != 0u ? 1u : 0u;
+  }
+  ASSERT_GT(found, 0u);
+}
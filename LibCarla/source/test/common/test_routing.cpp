@@ -0,0 +1,235 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "test/Road.h"
+
+#include <carla/road/ContractionHierarchy.h>
+#include <carla/road/RoutingGraph.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace carla::road;
+using namespace carla::road::element;
+using util::road::make_grid_map;
+using util::road::make_ring_map;
+using util::road::make_two_section_map;
+
+using Algorithm = RoutingGraph::Algorithm;
+
+static void CheckRoute(
+    const RoutingGraph &graph,
+    const RoutingGraph::Route &route,
+    const std::vector<std::pair<id_type, int>> &expected) {
+  ASSERT_EQ(route.lanes.size(), expected.size());
+  ASSERT_EQ(route.options.size(), expected.size());
+  for (auto i = 0u; i < expected.size(); ++i) {
+    const auto &lane = graph.GetLane(route.lanes[i]);
+    ASSERT_EQ(lane.road_id, expected[i].first);
+    ASSERT_EQ(lane.lane_id, expected[i].second);
+  }
+}
+
+TEST(routing, graph) {
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  ASSERT_EQ(graph.GetNumberOfLanes(), 6u);
+  ASSERT_FALSE(graph.FindLane(0u, 1).has_value());
+  const auto lane = graph.FindLane(2u, -1);
+  ASSERT_TRUE(lane.has_value());
+  ASSERT_NEAR(graph.GetLane(*lane).length, 100.0, 0.01);
+  auto waypoint = graph.GetLaneBegin(*map, *lane);
+  ASSERT_EQ(waypoint.GetRoadId(), 2u);
+  ASSERT_EQ(waypoint.GetLaneId(), -1);
+  // Four successors plus the lane change of road 0.
+  ASSERT_EQ(graph.GetNumberOfEdges(), 5u);
+}
+
+TEST(routing, lane_sections) {
+  // Each lane spans only the lane sections it is in.
+  auto map = make_two_section_map();
+  RoutingGraph graph(*map);
+  ASSERT_EQ(graph.GetNumberOfLanes(), 3u);
+  auto check_lane = [&](int lane_id, double begin, double end) {
+    const auto id = graph.FindLane(0u, lane_id);
+    ASSERT_TRUE(id.has_value());
+    const auto &lane = graph.GetLane(*id);
+    ASSERT_EQ(lane.begin_distance, begin);
+    ASSERT_EQ(lane.end_distance, end);
+    ASSERT_NEAR(lane.length, std::abs(end - begin), 0.01);
+    ASSERT_NEAR(lane.begin_location.x, begin, 0.01);
+    ASSERT_NEAR(lane.end_location.x, end, 0.01);
+  };
+  check_lane(-1, 0.0, 100.0);
+  check_lane(1, 50.0, 0.0);
+  check_lane(-2, 50.0, 100.0);
+  // The lane change is checked in the middle of lane -1, where lane -2
+  // already exists.
+  ASSERT_EQ(graph.GetNumberOfEdges(), 1u);
+  const auto edge = *graph.GetSuccessors(*graph.FindLane(0u, -1)).begin();
+  ASSERT_EQ(edge.node, *graph.FindLane(0u, -2));
+  ASSERT_EQ(edge.option, RoadOption::ChangeLaneRight);
+}
+
+TEST(routing, find_route) {
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  const auto origin = *graph.FindLane(0u, -1);
+  const auto destination = *graph.FindLane(3u, -1);
+  for (auto algorithm : {Algorithm::AStar, Algorithm::BidirectionalDijkstra}) {
+    const auto route = graph.FindRoute(origin, destination, algorithm);
+    CheckRoute(graph, route, {{0u, -1}, {1u, -1}, {2u, -1}, {3u, -1}});
+    ASSERT_NEAR(route.cost, 300.0, 0.01);
+    ASSERT_EQ(route.options[0u], RoadOption::LaneFollow);
+    ASSERT_EQ(route.options[1u], RoadOption::Straight);
+    ASSERT_EQ(route.options[2u], RoadOption::LaneFollow);
+  }
+  // The outer lane of road 0 can only be entered by a lane change.
+  const auto outer = *graph.FindLane(0u, -2);
+  for (auto algorithm : {Algorithm::AStar, Algorithm::BidirectionalDijkstra}) {
+    const auto route = graph.FindRoute(destination, outer, algorithm);
+    CheckRoute(graph, route, {{3u, -1}, {0u, -1}, {0u, -2}});
+    ASSERT_EQ(route.options[2u], RoadOption::ChangeLaneRight);
+    ASSERT_NEAR(route.cost, 100.0 + RoutingGraph::default_lane_change_cost, 0.01);
+    // The road marks do not allow coming back.
+    ASSERT_TRUE(graph.FindRoute(outer, origin, algorithm).empty());
+  }
+  const auto isolated = *graph.FindLane(4u, -1);
+  ASSERT_TRUE(graph.FindRoute(origin, isolated).empty());
+  ASSERT_EQ(graph.FindRoute(origin, origin).lanes.size(), 1u);
+}
+
+TEST(routing, find_route_around) {
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  const auto origin = *graph.FindLane(0u, -1);
+  for (auto algorithm : {Algorithm::AStar, Algorithm::BidirectionalDijkstra}) {
+    const auto route = graph.FindRouteAround(origin, algorithm);
+    CheckRoute(graph, route, {{0u, -1}, {1u, -1}, {2u, -1}, {3u, -1}, {0u, -1}});
+    ASSERT_NEAR(route.cost, 400.0, 0.01);
+    ASSERT_EQ(route.options[1u], RoadOption::Straight);
+  }
+  // The outer lane of road 0 leads nowhere.
+  ASSERT_TRUE(graph.FindRouteAround(*graph.FindLane(0u, -2)).empty());
+  ASSERT_TRUE(graph.FindRouteAround(*graph.FindLane(4u, -1)).empty());
+
+  const auto w0 = map->GetClosestWaypointOnRoad({20.0f, 0.0f, 0.0f});
+  ASSERT_TRUE(w0.has_value());
+  auto location = w0->ComputeTransform().location;
+  location.x = 70.0f;
+  const auto w1 = map->GetClosestWaypointOnRoad(location);
+  ASSERT_TRUE(w1.has_value());
+  ASSERT_EQ(w0->GetLaneId(), w1->GetLaneId());
+  ASSERT_FALSE(RoutingGraph::IsBehind(*w0, *w1));
+  ASSERT_TRUE(RoutingGraph::IsBehind(*w1, *w0));
+  ASSERT_FALSE(RoutingGraph::IsBehind(*w0, *w0));
+}
+
+TEST(routing, find_routes) {
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  std::vector<std::pair<RoutingGraph::node_id_type, RoutingGraph::node_id_type>> queries;
+  for (auto i = 0u; i < 500u; ++i) {
+    const auto size = static_cast<RoutingGraph::node_id_type>(graph.GetNumberOfLanes());
+    queries.emplace_back(i % size, (i / size) % size);
+  }
+  for (auto algorithm : {Algorithm::AStar, Algorithm::BidirectionalDijkstra}) {
+    const auto routes = graph.FindRoutes(queries, algorithm);
+    ASSERT_EQ(routes.size(), queries.size());
+    for (auto i = 0u; i < queries.size(); ++i) {
+      const auto expected = graph.FindRoute(queries[i].first, queries[i].second, Algorithm::AStar);
+      ASSERT_EQ(routes[i].lanes, expected.lanes);
+      ASSERT_NEAR(routes[i].cost, expected.cost, 1e-6);
+    }
+  }
+}
+
+TEST(routing, contraction_hierarchy) {
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  ContractionHierarchy hierarchy(graph);
+  ASSERT_EQ(hierarchy.GetNumberOfLanes(), graph.GetNumberOfLanes());
+  const auto size = static_cast<RoutingGraph::node_id_type>(graph.GetNumberOfLanes());
+  std::vector<RoutingGraph::node_id_type> lanes;
+  for (auto id = 0u; id < size; ++id) {
+    lanes.emplace_back(id);
+  }
+  const auto table = hierarchy.GetDistanceTable(lanes, lanes);
+  ASSERT_EQ(table.size(), lanes.size() * lanes.size());
+  for (auto origin = 0u; origin < size; ++origin) {
+    for (auto destination = 0u; destination < size; ++destination) {
+      const auto expected = graph.FindRoute(origin, destination);
+      const auto route = hierarchy.FindRoute(origin, destination);
+      const auto distance = hierarchy.GetDistance(origin, destination);
+      ASSERT_EQ(route.lanes, expected.lanes);
+      ASSERT_EQ(route.options, expected.options);
+      if (expected.empty()) {
+        ASSERT_EQ(distance, std::numeric_limits<double>::infinity());
+      } else {
+        ASSERT_NEAR(route.cost, expected.cost, 1e-6);
+        ASSERT_NEAR(distance, expected.cost, 1e-6);
+      }
+      ASSERT_EQ(table[origin * size + destination], distance);
+    }
+  }
+}
+
+TEST(routing, contraction_hierarchy_on_grid) {
+  auto map = make_grid_map(8u);
+  RoutingGraph graph(*map);
+  ContractionHierarchy hierarchy(graph);
+  const auto size = static_cast<RoutingGraph::node_id_type>(graph.GetNumberOfLanes());
+  std::mt19937 random_engine(42u);
+  std::uniform_int_distribution<RoutingGraph::node_id_type> random_lane(0u, size - 1u);
+  std::vector<RoutingGraph::node_id_type> origins;
+  std::vector<RoutingGraph::node_id_type> destinations;
+  for (auto i = 0u; i < 20u; ++i) {
+    origins.emplace_back(random_lane(random_engine));
+    destinations.emplace_back(random_lane(random_engine));
+  }
+  const auto table = hierarchy.GetDistanceTable(origins, destinations);
+  for (auto i = 0u; i < origins.size(); ++i) {
+    for (auto j = 0u; j < destinations.size(); ++j) {
+      const auto expected = graph.FindRoute(origins[i], destinations[j], Algorithm::BidirectionalDijkstra);
+      const auto route = hierarchy.FindRoute(origins[i], destinations[j]);
+      ASSERT_FALSE(route.empty());
+      ASSERT_NEAR(route.cost, expected.cost, 1e-6);
+      ASSERT_NEAR(table[i * destinations.size() + j], expected.cost, 1e-6);
+      // The unpacked route has to be a path of the routing graph.
+      double cost = 0.0;
+      for (auto k = 1u; k < route.lanes.size(); ++k) {
+        auto edges = graph.GetSuccessors(route.lanes[k - 1u]);
+        auto edge = std::find_if(edges.begin(), edges.end(), [&](const auto &e) {
+          return e.node == route.lanes[k];
+        });
+        ASSERT_NE(edge, edges.end());
+        ASSERT_EQ(edge->option, route.options[k]);
+        cost += edge->cost;
+      }
+      ASSERT_NEAR(cost, route.cost, 1e-6);
+    }
+  }
+}
+
+TEST(routing, contraction_hierarchy_save_and_load) {
+  const std::string filename = "_test_contraction_hierarchy.bin";
+  auto map = make_ring_map();
+  RoutingGraph graph(*map);
+  ContractionHierarchy hierarchy(graph);
+  hierarchy.Save(filename);
+  auto loaded = ContractionHierarchy::Load(filename, graph);
+  ASSERT_EQ(loaded.GetNumberOfEdges(), hierarchy.GetNumberOfEdges());
+  const auto origin = *graph.FindLane(0u, -1);
+  const auto destination = *graph.FindLane(0u, -2);
+  ASSERT_EQ(loaded.FindRoute(origin, destination).lanes, hierarchy.FindRoute(origin, destination).lanes);
+  // A hierarchy is only valid for the map it was built from.
+  auto other_map = make_grid_map(2u);
+  RoutingGraph other_graph(*other_map);
+  ASSERT_THROW(ContractionHierarchy::Load(filename, other_graph), std::invalid_argument);
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/TaskExecutor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using carla::TaskExecutor;
+
+TEST(task_executor, post) {
+  constexpr size_t number_of_tasks = 10000u;
+  std::atomic_size_t count{0u};
+  {
+    TaskExecutor executor{TaskExecutor::Options{4u}};
+    ASSERT_EQ(executor.GetNumberOfWorkers(), 4u);
+    for (auto i = 0u; i < number_of_tasks; ++i) {
+      executor.Post([&]() { ++count; });
+    }
+  } // Runs the pending tasks before joining.
+  ASSERT_EQ(count, number_of_tasks);
+}
+
+TEST(task_executor, parallel_for) {
+  TaskExecutor executor{TaskExecutor::Options{3u}};
+  for (size_t count : {0u, 1u, 7u, 100u, 12345u}) {
+    std::vector<std::atomic_int> visits(count);
+    for (auto &&visit : visits) {
+      visit = 0;
+    }
+    executor.ParallelFor(count, 10u, [&](size_t begin, size_t end) {
+      ASSERT_LT(begin, end);
+      ASSERT_LE(end, count);
+      for (auto i = begin; i < end; ++i) {
+        ++visits[i];
+      }
+    });
+    for (auto &&visit : visits) {
+      ASSERT_EQ(visit, 1);
+    }
+  }
+}
+
+TEST(task_executor, nested_parallel_for) {
+  // Every worker blocks on an inner loop, they must help each other instead
+  // of waiting forever.
+  TaskExecutor executor{TaskExecutor::Options{2u}};
+  std::atomic_size_t count{0u};
+  executor.ParallelFor(16u, 1u, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      executor.ParallelFor(100u, 1u, [&](size_t b, size_t e) {
+        count += e - b;
+        std::this_thread::yield();
+      });
+    }
+  });
+  ASSERT_EQ(count, 1600u);
+}
+
+TEST(task_executor, parallel_for_exception) {
+  TaskExecutor executor{TaskExecutor::Options{2u}};
+  ASSERT_THROW(
+      executor.ParallelFor(1000u, 1u, [](size_t begin, size_t) {
+        if (begin == 0u) {
+          throw std::runtime_error("failed");
+        }
+      }),
+      std::runtime_error);
+  // Still usable afterwards.
+  std::atomic_size_t count{0u};
+  executor.ParallelFor(1000u, 1u, [&](size_t begin, size_t end) { count += end - begin; });
+  ASSERT_EQ(count, 1000u);
+}
+
+TEST(task_executor, parallel_for_runs_no_other_task) {
+  // With the only worker busy, the caller runs every range itself, nested
+  // loops included, and leaves the unrelated task queued; running it here
+  // would lock the mutex we are holding.
+  TaskExecutor executor{TaskExecutor::Options{1u}};
+  std::mutex busy_mutex;
+  std::condition_variable busy_condition;
+  bool busy = true;
+  executor.Post([&]() {
+    std::unique_lock<std::mutex> lock(busy_mutex);
+    busy_condition.wait(lock, [&]() { return !busy; });
+  });
+  std::mutex mutex;
+  std::atomic_bool unrelated_task_done{false};
+  std::atomic_size_t count{0u};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    executor.Post([&]() {
+      std::lock_guard<std::mutex> unrelated_lock(mutex);
+      unrelated_task_done = true;
+    });
+    executor.ParallelFor(8u, 1u, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        executor.ParallelFor(100u, 1u, [&](size_t b, size_t e) { count += e - b; });
+      }
+    });
+    ASSERT_EQ(count, 800u);
+    ASSERT_FALSE(unrelated_task_done);
+  }
+  {
+    std::lock_guard<std::mutex> lock(busy_mutex);
+    busy = false;
+  }
+  busy_condition.notify_all();
+  while (!unrelated_task_done) {
+    std::this_thread::yield();
+  }
+}
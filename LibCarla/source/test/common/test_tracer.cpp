@@ -0,0 +1,71 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/ThreadGroup.h>
+#include <carla/profiler/Tracer.h>
+
+#include <sstream>
+#include <string>
+
+using carla::profiler::Tracer;
+
+static size_t CountOccurrences(const std::string &str, const std::string &substr) {
+  size_t count = 0u;
+  for (auto pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + 1u)) {
+    ++count;
+  }
+  return count;
+}
+
+static std::string DumpTrace() {
+  std::ostringstream out;
+  Tracer::WriteChromeTrace(out);
+  return out.str();
+}
+
+TEST(tracer, disabled) {
+  Tracer::Disable();
+  Tracer::Clear();
+  {
+    CARLA_TRACE_SCOPE(test, "disabled");
+  }
+  ASSERT_EQ(CountOccurrences(DumpTrace(), "\"name\":\"disabled\""), 0u);
+}
+
+TEST(tracer, chrome_trace) {
+  Tracer::Enable(16u);
+  {
+    CARLA_TRACE_SCOPE(test, "outer");
+    const std::string name = "inner \"quoted\"";
+    CARLA_TRACE_SCOPE(test, name);
+  }
+  Tracer::Disable();
+  const auto trace = DumpTrace();
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  ASSERT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 2u);
+  ASSERT_EQ(CountOccurrences(trace, "\"cat\":\"test\",\"name\":\"outer\""), 1u);
+  ASSERT_EQ(CountOccurrences(trace, "\"name\":\"inner \\\"quoted\\\"\""), 1u);
+}
+
+TEST(tracer, ring_buffer_per_thread) {
+  constexpr size_t number_of_threads = 4u;
+  Tracer::Enable(10u);
+  {
+    carla::ThreadGroup threads;
+    threads.CreateThreads(number_of_threads, []() {
+      for (auto i = 0u; i < 100u; ++i) {
+        CARLA_TRACE_SCOPE(test, "loop");
+      }
+    });
+  }
+  Tracer::Disable();
+  // Only the last 10 events of each thread are kept.
+  ASSERT_EQ(CountOccurrences(DumpTrace(), "\"name\":\"loop\""), 10u * number_of_threads);
+  Tracer::Clear();
+  ASSERT_EQ(CountOccurrences(DumpTrace(), "\"ph\""), 0u);
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "test/Road.h"
+
+#include <carla/geom/Math.h>
+#include <carla/road/LaneOccupancy.h>
+#include <carla/road/LanePolylines.h>
+#include <carla/road/LaneTracker.h>
+#include <carla/road/WaypointGenerator.h>
+
+#include <chrono>
+
+using namespace carla::road;
+
+static void benchmark_compute_transform(const size_t grid_size, const double distance) {
+  constexpr size_t number_of_rounds = 10u;
+
+  auto map = util::road::make_grid_map(grid_size);
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, distance);
+  ASSERT_FALSE(waypoints.empty());
+
+  const auto start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < number_of_rounds; ++i) {
+    for (auto &&waypoint : waypoints) {
+      waypoint.ComputeTransform();
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  const auto calls = static_cast<double>(number_of_rounds * waypoints.size());
+  carla::logging::log(
+      waypoints.size(), "waypoints,", calls / elapsed.count(), "ComputeTransform calls per second,",
+      1e9 * elapsed.count() / calls, "ns per call");
+}
+
+TEST(benchmark_road, compute_transform) {
+  benchmark_compute_transform(20u, 2.0);
+}
+
+TEST(benchmark_road, lane_polylines) {
+  constexpr double resolution = 1.0;
+  auto map = util::road::make_grid_map(20u);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<carla::geom::Transform> transforms;
+  for (auto &&waypoint : WaypointGenerator::GenerateAll(*map, resolution)) {
+    transforms.emplace_back(waypoint.ComputeTransform());
+  }
+  const std::chrono::duration<double> waypoints_elapsed = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  LanePolylines polylines(*map, resolution);
+  const std::chrono::duration<double> polylines_elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_GE(polylines.GetNumberOfPoints(), transforms.size());
+  carla::logging::log(
+      transforms.size(), "waypoints and transforms in", 1e3 * waypoints_elapsed.count(), "ms,",
+      polylines.GetNumberOfPoints(), "polyline points in", 1e3 * polylines_elapsed.count(), "ms");
+}
+
+TEST(benchmark_road, lane_tracker) {
+  constexpr size_t number_of_actors = 2000u;
+  constexpr size_t number_of_ticks = 20u;
+  auto map = util::road::make_grid_map(20u);
+
+  // Sample the locations of every actor on every tick beforehand.
+  const auto starts = WaypointGenerator::GenerateAll(*map, 3.0);
+  ASSERT_GE(starts.size(), number_of_actors);
+  std::vector<element::Waypoint> actors(starts.begin(), starts.begin() + number_of_actors);
+  std::vector<std::vector<std::pair<carla::ActorId, carla::geom::Location>>> ticks(number_of_ticks);
+  for (auto &&tick : ticks) {
+    for (auto i = 0u; i < actors.size(); ++i) {
+      tick.emplace_back(i, actors[i].ComputeTransform().location);
+      actors[i] = WaypointGenerator::GetNext(actors[i], 0.5).front();
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto &&tick : ticks) {
+    for (auto &&actor : tick) {
+      map->GetClosestWaypointOnRoad(actor.second);
+    }
+  }
+  const std::chrono::duration<double> global_elapsed = std::chrono::steady_clock::now() - start;
+
+  LaneTracker tracker(map);
+  start = std::chrono::steady_clock::now();
+  for (auto &&tick : ticks) {
+    tracker.Update(tick);
+  }
+  const std::chrono::duration<double> tracker_elapsed = std::chrono::steady_clock::now() - start;
+
+  const auto updates = static_cast<double>(number_of_actors * number_of_ticks);
+  carla::logging::log(
+      "global search:", 1e9 * global_elapsed.count() / updates, "ns per actor, lane tracker:",
+      1e9 * tracker_elapsed.count() / updates, "ns per actor,",
+      tracker.GetNumberOfHintMisses(), "misses out of", updates, "updates");
+  ASSERT_LT(tracker_elapsed.count(), global_elapsed.count());
+}
+
+TEST(benchmark_road, lane_crossings) {
+  constexpr size_t number_of_movements = 100000u;
+  auto map = util::road::make_grid_map(20u);
+
+  auto start = std::chrono::steady_clock::now();
+  const auto &index = map->GetLaneBoundaryIndex();
+  const std::chrono::duration<double> build_elapsed = std::chrono::steady_clock::now() - start;
+
+  // Movements of a vehicle at 30 m/s ticking at 60 Hz, drifting sideways.
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, 1.0);
+  ASSERT_FALSE(waypoints.empty());
+  std::vector<std::pair<carla::geom::Location, carla::geom::Location>> movements;
+  for (auto i = 0u; i < number_of_movements; ++i) {
+    const auto transform = waypoints[(i * 7919u) % waypoints.size()].ComputeTransform();
+    const auto forward = transform.GetForwardVector();
+    const carla::geom::Location step(0.5f * forward.x - 0.5f * forward.y, 0.5f * forward.y + 0.5f * forward.x, 0.0f);
+    movements.emplace_back(transform.location, transform.location + step);
+  }
+
+  size_t crossings = 0u;
+  start = std::chrono::steady_clock::now();
+  for (auto &&movement : movements) {
+    crossings += map->CalculateCrossedLanes(movement.first, movement.second).size();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_GT(crossings, 0u);
+  carla::logging::log(
+      index.GetNumberOfSegments(), "boundary segments indexed in", 1e3 * build_elapsed.count(), "ms,",
+      1e9 * elapsed.count() / static_cast<double>(movements.size()), "ns per movement,",
+      crossings, "crossings");
+}
+
+TEST(benchmark_road, lane_occupancy) {
+  constexpr size_t number_of_vehicles = 500u;
+  constexpr size_t number_of_egos = 50u;
+  constexpr double lookahead = 30.0;
+  auto map = util::road::make_grid_map(20u);
+
+  const auto waypoints = WaypointGenerator::GenerateAll(*map, 2.0);
+  ASSERT_GE(waypoints.size(), number_of_vehicles);
+  std::vector<LaneOccupancy::Vehicle> vehicles;
+  std::vector<carla::ActorId> egos;
+  for (auto i = 0u; i < number_of_vehicles; ++i) {
+    const auto id = static_cast<carla::ActorId>(i + 1u);
+    vehicles.push_back({id, waypoints[(i * 7919u) % waypoints.size()].ComputeTransform().location, 0u});
+    if (i < number_of_egos) {
+      egos.emplace_back(id);
+    }
+  }
+
+  // What a Python agent does: project every vehicle for every ego.
+  size_t naive_found = 0u;
+  auto start = std::chrono::steady_clock::now();
+  for (auto &&ego : egos) {
+    const auto &ego_location = vehicles[ego - 1u].location;
+    const auto ego_waypoint = map->GetWaypoint(ego_location);
+    for (auto &&vehicle : vehicles) {
+      if (vehicle.id == ego) {
+        continue;
+      }
+      const auto waypoint = map->GetWaypoint(vehicle.location);
+      if (ego_waypoint.has_value() && waypoint.has_value() &&
+          (waypoint->GetRoadId() == ego_waypoint->GetRoadId()) &&
+          (waypoint->GetLaneId() == ego_waypoint->GetLaneId()) &&
+          (carla::geom::Math::Distance2D(ego_location, vehicle.location) < lookahead)) {
+        ++naive_found;
+        break;
+      }
+    }
+  }
+  const std::chrono::duration<double> naive_elapsed = std::chrono::steady_clock::now() - start;
+
+  LaneOccupancy occupancy(map);
+  occupancy.Update(vehicles, {});
+  start = std::chrono::steady_clock::now();
+  occupancy.Update(vehicles, {});
+  const auto hazards = occupancy.Query(egos, lookahead);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  size_t found = 0u;
+  for (auto &&hazard : hazards) {
+    found += hazard.vehicle_id != 0u ? 1u : 0u;
+  }
+  carla::logging::log(
+      "per-ego search:", 1e3 * naive_elapsed.count(), "ms,", naive_found, "blocked;",
+      "lane occupancy update and batch query:", 1e3 * elapsed.count(), "ms,", found, "blocked");
+  ASSERT_LT(elapsed.count(), naive_elapsed.count());
+}
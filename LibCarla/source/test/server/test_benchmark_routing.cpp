@@ -0,0 +1,120 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "test/Road.h"
+
+#include <carla/road/ContractionHierarchy.h>
+#include <carla/road/RoutingGraph.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace carla::road;
+
+using clock_type = std::chrono::steady_clock;
+using node_id_type = RoutingGraph::node_id_type;
+
+template <typename F>
+static double time_us(F &&functor) {
+  const auto start = clock_type::now();
+  functor();
+  return std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+}
+
+static std::vector<std::pair<node_id_type, node_id_type>> make_random_queries(
+    const RoutingGraph &graph,
+    const size_t number_of_queries) {
+  std::mt19937 random_engine(42u);
+  std::uniform_int_distribution<node_id_type> random_lane(
+      0u,
+      static_cast<node_id_type>(graph.GetNumberOfLanes() - 1u));
+  std::vector<std::pair<node_id_type, node_id_type>> queries;
+  queries.reserve(number_of_queries);
+  for (auto i = 0u; i < number_of_queries; ++i) {
+    queries.emplace_back(random_lane(random_engine), random_lane(random_engine));
+  }
+  return queries;
+}
+
+static void benchmark_routing(const size_t grid_size) {
+  constexpr size_t number_of_queries = 1000u;
+  constexpr size_t table_size = 100u;
+
+  auto map = util::road::make_grid_map(grid_size);
+  std::unique_ptr<RoutingGraph> graph;
+  const auto graph_us = time_us([&]() { graph = std::make_unique<RoutingGraph>(*map); });
+  std::unique_ptr<ContractionHierarchy> hierarchy;
+  const auto preprocessing_us = time_us([&]() { hierarchy = std::make_unique<ContractionHierarchy>(*graph); });
+  carla::logging::log(
+      "routing graph:", graph->GetNumberOfLanes(), "lanes,",
+      graph->GetNumberOfEdges(), "edges, built in", graph_us / 1e3, "ms;",
+      "contraction hierarchy:", hierarchy->GetNumberOfEdges(), "edges, built in",
+      preprocessing_us / 1e3, "ms");
+
+  const auto queries = make_random_queries(*graph, number_of_queries);
+  std::vector<double> costs;
+  costs.reserve(queries.size());
+  const auto dijkstra_us = time_us([&]() {
+    for (auto &query : queries) {
+      costs.emplace_back(graph->FindRoute(query.first, query.second, RoutingGraph::Algorithm::BidirectionalDijkstra).cost);
+    }
+  });
+  const auto astar_us = time_us([&]() {
+    for (auto &query : queries) {
+      graph->FindRoute(query.first, query.second, RoutingGraph::Algorithm::AStar);
+    }
+  });
+  std::vector<double> distances;
+  distances.reserve(queries.size());
+  const auto distance_us = time_us([&]() {
+    for (auto &query : queries) {
+      distances.emplace_back(hierarchy->GetDistance(query.first, query.second));
+    }
+  });
+  const auto route_us = time_us([&]() {
+    for (auto &query : queries) {
+      hierarchy->FindRoute(query.first, query.second);
+    }
+  });
+  for (auto i = 0u; i < queries.size(); ++i) {
+    ASSERT_NEAR(distances[i], costs[i], 1e-6);
+  }
+  const auto n = static_cast<double>(number_of_queries);
+  carla::logging::log(
+      "per query: bidirectional dijkstra", dijkstra_us / n, "us,",
+      "a*", astar_us / n, "us,",
+      "contraction hierarchy", route_us / n, "us (distance only", distance_us / n, "us)");
+
+  std::vector<node_id_type> origins;
+  std::vector<node_id_type> destinations;
+  for (auto i = 0u; i < table_size; ++i) {
+    origins.emplace_back(queries[i].first);
+    destinations.emplace_back(queries[i].second);
+  }
+  std::vector<double> table;
+  const auto table_us = time_us([&]() { table = hierarchy->GetDistanceTable(origins, destinations); });
+  ASSERT_EQ(table.size(), table_size * table_size);
+  ASSERT_NEAR(table[0u * table_size + 0u], costs[0u], 1e-6);
+  ASSERT_NEAR(table[1u * table_size + 1u], costs[1u], 1e-6);
+  // Compared against running one Dijkstra search per cell of the table.
+  const auto dijkstra_table_us = dijkstra_us / n * static_cast<double>(table_size * table_size);
+  carla::logging::log(
+      table_size, 'x', table_size, "distance table in", table_us / 1e3, "ms, dijkstra estimate",
+      dijkstra_table_us / 1e3, "ms, speed-up", dijkstra_table_us / table_us);
+  if (table_us > dijkstra_table_us) {
+    carla::log_warning("distance table slower than dijkstra:", table_us, '/', dijkstra_table_us);
+  }
+}
+
+TEST(benchmark_routing, grid_10x10) {
+  benchmark_routing(10u);
+}
+
+TEST(benchmark_routing, grid_30x30) {
+  benchmark_routing(30u);
+}
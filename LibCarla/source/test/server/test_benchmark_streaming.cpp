@@ -6,119 +6,373 @@
 
 #include "test.h"
 
+#include <carla/ThreadGroup.h>
+#include <carla/Version.h>
 #include <carla/streaming/Client.h>
 #include <carla/streaming/Server.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 using namespace carla::streaming;
 
-static auto make_special_message(size_t size) {
-  std::vector<uint32_t> v(size/sizeof(uint32_t), 42u);
-  carla::Buffer msg(v);
-  EXPECT_EQ(msg.size(), size);
-  return msg;
+// =============================================================================
+// -- Benchmark results --------------------------------------------------------
+// =============================================================================
+
+namespace benchmark {
+
+  using clock = std::chrono::steady_clock;
+
+  struct Latency {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+  };
+
+  /// Result of sending messages through every stream during a fixed time.
+  struct Run {
+    /// Messages per second per stream, zero if sending as fast as possible.
+    double target_fps = 0.0;
+    double duration = 0.0;
+    size_t sent = 0u;
+    size_t received = 0u;
+    /// Process CPU time (server, client, and senders) per message received.
+    double cpu_us_per_message = 0.0;
+    /// End-to-end latency in microseconds.
+    Latency latency_us;
+
+    double drop_rate() const {
+      return sent > 0u ? 1.0 - static_cast<double>(received) / static_cast<double>(sent) : 0.0;
+    }
+
+    double throughput() const {
+      return duration > 0.0 ? static_cast<double>(received) / duration : 0.0;
+    }
+  };
+
+  struct Result {
+    std::string name;
+    size_t number_of_streams = 0u;
+    size_t message_size = 0u;
+    /// Highest paced rate (per stream) with a drop rate below the threshold.
+    double max_sustainable_fps = 0.0;
+    std::vector<Run> runs;
+  };
+
+  /// Nearest-rank percentile of @a sorted_samples.
+  static double percentile(const std::vector<uint64_t> &sorted_samples, double p) {
+    if (sorted_samples.empty()) {
+      return 0.0;
+    }
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted_samples.size())));
+    return static_cast<double>(sorted_samples[std::max<size_t>(rank, 1u) - 1u]);
+  }
+
+  static Latency compute_latency_us(std::vector<uint64_t> samples_ns) {
+    Latency result;
+    if (samples_ns.empty()) {
+      return result;
+    }
+    std::sort(samples_ns.begin(), samples_ns.end());
+    double sum = 0.0;
+    for (auto sample : samples_ns) {
+      sum += static_cast<double>(sample);
+    }
+    result.mean = 1e-3 * sum / static_cast<double>(samples_ns.size());
+    result.p50 = 1e-3 * percentile(samples_ns, 0.5);
+    result.p99 = 1e-3 * percentile(samples_ns, 0.99);
+    result.p999 = 1e-3 * percentile(samples_ns, 0.999);
+    result.max = 1e-3 * static_cast<double>(samples_ns.back());
+    return result;
+  }
+
+  /// Collects the results of every benchmark and writes them as JSON when
+  /// the test program finishes. The output file can be set with the
+  /// environment variable CARLA_BENCHMARK_OUTPUT.
+  class Report : public ::testing::Environment {
+  public:
+
+    static void Add(Result result) {
+      std::lock_guard<std::mutex> lock(mutex());
+      results().emplace_back(std::move(result));
+    }
+
+    void TearDown() override {
+      std::lock_guard<std::mutex> lock(mutex());
+      if (results().empty()) {
+        return;
+      }
+      const char *env = std::getenv("CARLA_BENCHMARK_OUTPUT");
+      const std::string filename = env != nullptr ? env : "benchmark_streaming.json";
+      std::ofstream out(filename);
+      Write(out);
+      carla::logging::log("benchmark results written to", filename);
+    }
+
+  private:
+
+    static std::mutex &mutex() {
+      static std::mutex instance;
+      return instance;
+    }
+
+    static std::vector<Result> &results() {
+      static std::vector<Result> instance;
+      return instance;
+    }
+
+    static void Write(std::ostream &out) {
+      out << "{\n"
+          << "  \"benchmark\": \"streaming\",\n"
+          << "  \"version\": \"" << carla::version() << "\",\n"
+#ifdef NDEBUG
+          << "  \"build\": \"release\",\n"
+#else
+          << "  \"build\": \"debug\",\n"
+#endif // NDEBUG
+          << "  \"results\": [";
+      const char *separator = "\n";
+      for (auto &result : results()) {
+        out << separator;
+        separator = ",\n";
+        out << "    {\n"
+            << "      \"name\": \"" << result.name << "\",\n"
+            << "      \"streams\": " << result.number_of_streams << ",\n"
+            << "      \"message_size\": " << result.message_size << ",\n"
+            << "      \"max_sustainable_fps\": " << result.max_sustainable_fps << ",\n"
+            << "      \"runs\": [";
+        const char *run_separator = "\n";
+        for (auto &run : result.runs) {
+          out << run_separator;
+          run_separator = ",\n";
+          out << "        {"
+              << "\"target_fps\": " << run.target_fps
+              << ", \"duration_s\": " << run.duration
+              << ", \"sent\": " << run.sent
+              << ", \"received\": " << run.received
+              << ", \"drop_rate\": " << run.drop_rate()
+              << ", \"messages_per_s\": " << run.throughput()
+              << ", \"mb_per_s\": " << 1e-6 * run.throughput() * static_cast<double>(result.message_size)
+              << ", \"cpu_us_per_message\": " << run.cpu_us_per_message
+              << ", \"latency_us\": {"
+              << "\"mean\": " << run.latency_us.mean
+              << ", \"p50\": " << run.latency_us.p50
+              << ", \"p99\": " << run.latency_us.p99
+              << ", \"p999\": " << run.latency_us.p999
+              << ", \"max\": " << run.latency_us.max
+              << "}}";
+        }
+        out << "\n      ]\n    }";
+      }
+      out << "\n  ]\n}\n";
+    }
+  };
+
+  static auto *const report = ::testing::AddGlobalTestEnvironment(new Report);
+
+} // namespace benchmark
+
+// =============================================================================
+// -- Benchmark ----------------------------------------------------------------
+// =============================================================================
+
+/// Every message carries the time it was sent and the run it belongs to.
+struct MessageHeader {
+  int64_t send_time_ns;
+  uint64_t run_id;
+};
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      benchmark::clock::now().time_since_epoch()).count();
 }
 
 class Benchmark {
 public:
 
-  Benchmark(uint16_t port, size_t message_size, double success_ratio)
+  Benchmark(uint16_t port, size_t message_size, size_t number_of_streams)
     : _server(port),
       _client(),
-      _message(make_special_message(message_size)),
-      _client_callback(),
-      _work_to_do(_client_callback),
-      _success_ratio(success_ratio) {}
-
-  void AddStream() {
-    Stream stream = _server.MakeStream();
-
-    _client.Subscribe(stream.token(), [this](carla::Buffer DEBUG_ONLY(msg)) {
-      DEBUG_ASSERT_EQ(msg.size(), _message.size());
-      DEBUG_ASSERT(msg == _message);
-      _client_callback.post([this]() {
-        CARLA_PROFILE_FPS(client, listen_callback);
-        ++_number_of_messages_received;
-      });
-    });
-
-    _streams.push_back(stream);
+      _message(std::max(message_size, sizeof(MessageHeader))) {
+    std::memset(_message.data(), 42, _message.size());
+    for (auto i = 0u; i < number_of_streams; ++i) {
+      AddStream();
+    }
+    _server.AsyncRun(number_of_streams);
+    _client.AsyncRun(number_of_streams);
   }
 
-  void AddStreams(size_t count) {
-    for (auto i = 0u; i < count; ++i) {
-      AddStream();
+  ~Benchmark() {
+    // Unsubscribe first, otherwise the client keeps trying to reconnect to
+    // the streams being destroyed.
+    for (auto &stream : _streams) {
+      _client.UnSubscribe(stream.token());
     }
   }
 
-  void Run(size_t number_of_messages) {
-    _threads.CreateThread([this]() { _client_callback.run(); });
-    _server.AsyncRun(_streams.size());
-    _client.AsyncRun(_streams.size());
+  size_t message_size() const {
+    return _message.size();
+  }
 
-    std::this_thread::sleep_for(1s); // the client needs to be ready so we make
-                                     // sure we get all the messages.
+  /// Send messages until every stream has received at least one.
+  void Connect() {
+    constexpr auto timeout = 10s;
+    const auto start = benchmark::clock::now();
+    while (!IsConnected()) {
+      ASSERT_LT(benchmark::clock::now() - start, timeout) << "streams failed to connect";
+      for (auto &stream : _streams) {
+        Send(stream, 0u);
+      }
+      std::this_thread::sleep_for(10ms);
+    }
+  }
 
-    for (auto &&stream : _streams) {
-      _threads.CreateThread([=]() mutable {
-        for (auto i = 0u; i < number_of_messages; ++i) {
-          std::this_thread::sleep_for(11ms); // ~90FPS.
+  /// Send through every stream at @a fps messages per second (or as fast as
+  /// possible if zero) during @a duration, and wait for the messages to
+  /// arrive.
+  benchmark::Run Run(double fps, benchmark::clock::duration duration) {
+    const auto run_id = ++_run_id;
+    for (auto &stats : _stats) {
+      std::lock_guard<std::mutex> lock(stats->mutex);
+      stats->samples.clear();
+      stats->samples.reserve(
+          fps > 0.0 ? static_cast<size_t>(fps * 1e-9 * std::chrono::nanoseconds(duration).count()) + 1u : 0u);
+    }
+    _received = 0u;
+    std::atomic_size_t sent{0u};
+
+    const auto cpu_start = std::clock();
+    const auto start = benchmark::clock::now();
+    const auto end = start + duration;
+    carla::ThreadGroup senders;
+    for (auto &stream : _streams) {
+      senders.CreateThread([&, stream]() mutable {
+        const auto period = fps > 0.0 ?
+            std::chrono::duration_cast<benchmark::clock::duration>(std::chrono::duration<double>(1.0 / fps)) :
+            benchmark::clock::duration::zero();
+        auto next = start;
+        while (next < end) {
           {
             CARLA_PROFILE_SCOPE(game, write_to_stream);
-            stream << _message.buffer();
+            Send(stream, run_id);
+          }
+          ++sent;
+          if (fps > 0.0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+          } else {
+            next = benchmark::clock::now();
           }
         }
       });
     }
-
-    const auto expected_number_of_messages = _streams.size() * number_of_messages;
-    const auto threshold =
-        static_cast<size_t>(_success_ratio * static_cast<double>(expected_number_of_messages));
-
-    for (auto i = 0u; i < 10; ++i) {
-      std::cout << "received " << _number_of_messages_received
-                << " of " << expected_number_of_messages
-                << " messages,";
-      if (_number_of_messages_received >= expected_number_of_messages) {
-        break;
+    senders.JoinAll();
+    const auto send_end = benchmark::clock::now();
+
+    // Wait for the messages in flight, until no more messages arrive.
+    size_t received = 0u;
+    auto last_progress = benchmark::clock::now();
+    while ((_received < sent) && (benchmark::clock::now() - last_progress < 200ms)) {
+      std::this_thread::sleep_for(1ms);
+      if (_received != received) {
+        received = _received;
+        last_progress = benchmark::clock::now();
       }
-      std::cout << " waiting..." << std::endl;
-      std::this_thread::sleep_for(1s);
     }
-
-    _client_callback.stop();
-    _threads.JoinAll();
-    std::cout << " done." << std::endl;
-
-#ifdef NDEBUG
-    ASSERT_GE(_number_of_messages_received, threshold);
-#else
-    if (_number_of_messages_received < threshold) {
-      carla::log_warning("threshold unmet:", _number_of_messages_received, '/', threshold);
+    const auto cpu_end = std::clock();
+
+    benchmark::Run result;
+    result.target_fps = fps;
+    result.duration = std::chrono::duration<double>(send_end - start).count();
+    result.sent = sent;
+    result.received = _received;
+    result.cpu_us_per_message = result.received > 0u ?
+        1e6 * static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC / static_cast<double>(result.received) :
+        0.0;
+    std::vector<uint64_t> samples;
+    for (auto &stats : _stats) {
+      std::lock_guard<std::mutex> lock(stats->mutex);
+      samples.insert(samples.end(), stats->samples.begin(), stats->samples.end());
     }
-#endif // NDEBUG
+    result.latency_us = benchmark::compute_latency_us(std::move(samples));
+    ++_run_id; // Ignore any message of this run arriving late.
+    return result;
   }
 
 private:
 
-  carla::ThreadGroup _threads;
+  struct StreamStats {
+    std::mutex mutex;
+    std::vector<uint64_t> samples;
+    std::atomic_bool connected{false};
+  };
 
-  Server _server;
+  void AddStream() {
+    Stream stream = _server.MakeStream();
+    const auto index = _stats.size();
+    _stats.emplace_back(std::make_unique<StreamStats>());
+    _client.Subscribe(stream.token(), [this, index](carla::Buffer msg) {
+      OnMessage(index, msg);
+    });
+    _streams.push_back(stream);
+  }
 
-  Client _client;
+  bool IsConnected() const {
+    return std::all_of(_stats.begin(), _stats.end(), [](const auto &stats) {
+      return stats->connected.load();
+    });
+  }
 
-  const carla::Buffer _message;
+  void Send(Stream &stream, uint64_t run_id) {
+    auto buffer = stream.MakeBuffer();
+    buffer.copy_from(_message);
+    const MessageHeader header{now_ns(), run_id};
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    stream.Write(std::move(buffer));
+  }
 
-  boost::asio::io_service _client_callback;
+  void OnMessage(size_t index, const carla::Buffer &msg) {
+    CARLA_PROFILE_FPS(client, listen_callback);
+    const auto received_time = now_ns();
+    DEBUG_ASSERT_EQ(msg.size(), _message.size());
+    MessageHeader header;
+    std::memcpy(&header, msg.data(), sizeof(header));
+    auto &stats = *_stats[index];
+    stats.connected = true;
+    if (header.run_id != _run_id) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(stats.mutex);
+      stats.samples.emplace_back(static_cast<uint64_t>(std::max<int64_t>(0, received_time - header.send_time_ns)));
+    }
+    ++_received;
+  }
 
-  boost::asio::io_service::work _work_to_do;
+  Server _server;
 
-  const double _success_ratio;
+  Client _client;
+
+  carla::Buffer _message;
 
   std::vector<Stream> _streams;
 
-  std::atomic_size_t _number_of_messages_received{0u};
+  std::vector<std::unique_ptr<StreamStats>> _stats;
+
+  std::atomic<uint64_t> _run_id{0u};
+
+  std::atomic_size_t _received{0u};
 };
 
 static size_t get_max_concurrency() {
@@ -130,11 +384,53 @@ static void benchmark_image(
     const size_t dimensions,
     const size_t number_of_streams = 1u,
     const double success_ratio = 1.0) {
-  constexpr auto number_of_messages = 100u;
-  carla::logging::log("Benchmark:", number_of_streams, "streams at 90FPS.");
-  Benchmark benchmark(TESTING_PORT, 4u * dimensions, success_ratio);
-  benchmark.AddStreams(number_of_streams);
-  benchmark.Run(number_of_messages);
+  constexpr auto duration = 1s;
+  constexpr double max_drop_rate = 0.01;
+  constexpr double paced_fps[] = {90.0, 360.0, 1440.0};
+
+  benchmark::Result result;
+  result.name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  result.number_of_streams = number_of_streams;
+
+  Benchmark benchmark(TESTING_PORT, 4u * dimensions, number_of_streams);
+  result.message_size = benchmark.message_size();
+  benchmark.Connect();
+
+  // Rates are increasing, stop at the first one the streams cannot sustain.
+  for (auto fps : paced_fps) {
+    result.runs.emplace_back(benchmark.Run(fps, duration));
+    if (result.runs.back().drop_rate() > max_drop_rate) {
+      break;
+    }
+    result.max_sustainable_fps = fps;
+  }
+  // Saturate the streams to find the throughput ceiling.
+  result.runs.emplace_back(benchmark.Run(0.0, duration));
+
+  for (auto &run : result.runs) {
+    carla::logging::log(
+        "Benchmark:", number_of_streams, "streams at",
+        (run.target_fps > 0.0 ? std::to_string(static_cast<int>(run.target_fps)) : std::string("max")), "FPS:",
+        run.received, '/', run.sent, "messages,",
+        "p50", run.latency_us.p50, "us,",
+        "p99", run.latency_us.p99, "us,",
+        "p999", run.latency_us.p999, "us,",
+        run.cpu_us_per_message, "CPU us/msg.");
+  }
+
+  // Check the 90 FPS run against the success ratio.
+  const auto reference = result.runs.front();
+  const auto threshold =
+      static_cast<size_t>(success_ratio * static_cast<double>(reference.sent));
+  benchmark::Report::Add(std::move(result));
+
+#ifdef NDEBUG
+  ASSERT_GE(reference.received, threshold);
+#else
+  if (reference.received < threshold) {
+    carla::log_warning("threshold unmet:", reference.received, '/', threshold);
+  }
+#endif // NDEBUG
 }
 
 TEST(benchmark_streaming, image_200x200) {
@@ -0,0 +1,53 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/TaskExecutor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using carla::TaskExecutor;
+
+/// Time to run uneven chunks of floating point work on @a number_of_threads,
+/// the calling thread plus the workers.
+static double benchmark_parallel_for(const size_t number_of_threads) {
+  constexpr size_t number_of_items = 20000u;
+  constexpr size_t number_of_rounds = 5u;
+  TaskExecutor executor{TaskExecutor::Options{std::max<size_t>(number_of_threads - 1u, 1u)}};
+  // A single range runs on the calling thread only.
+  const size_t grain_size = number_of_threads > 1u ? 64u : number_of_items;
+  std::vector<double> result(number_of_items);
+  const auto start = std::chrono::steady_clock::now();
+  for (auto round = 0u; round < number_of_rounds; ++round) {
+    executor.ParallelFor(number_of_items, grain_size, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        // Later items take longer, so the ranges must be balanced.
+        double value = 0.0;
+        for (auto j = 0u; j < 100u + i / 100u; ++j) {
+          value += std::sqrt(static_cast<double>(i + j));
+        }
+        result[i] = value;
+      }
+    });
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+TEST(benchmark_task_executor, scaling) {
+  const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+  const auto serial = benchmark_parallel_for(1u);
+  carla::logging::log("1 thread(s):", serial, "s");
+  for (size_t threads = 2u; threads <= max_threads; threads *= 2u) {
+    const auto elapsed = benchmark_parallel_for(threads);
+    carla::logging::log(threads, "thread(s):", elapsed, "s, speedup", serial / elapsed);
+  }
+}
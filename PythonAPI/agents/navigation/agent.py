@@ -29,15 +29,18 @@ class Agent(object):
     Base class to define agents in CARLA
     """
 
-    def __init__(self, vehicle):
+    def __init__(self, vehicle, hazard_detector=None):
         """
 
         :param vehicle: actor to apply to local planner logic onto
+        :param hazard_detector: optional carla.HazardDetector, can be shared
+               among every agent of the world
         """
         self._vehicle = vehicle
         self._world = self._vehicle.get_world()
         self._map = self._vehicle.get_world().get_map()
         self._last_traffic_light = None
+        self._hazard_detector = hazard_detector
 
 
     def run_step(self, debug=False):
@@ -149,6 +152,32 @@ class Agent(object):
 
         return (False, None)
 
+    def _detect_hazards(self):
+        """
+        Check for vehicles blocking us and red traffic lights affecting us.
+
+        If the agent has a hazard detector, the lanes ahead of us are searched
+        natively; otherwise every vehicle and traffic light in the world is
+        checked with _is_vehicle_hazard and _is_light_red.
+
+        :return: a tuple given by (vehicle, traffic_light), where
+                 - vehicle is the vehicle blocking us or None
+                 - traffic_light is the red traffic light affecting us or None
+        """
+        if self._hazard_detector is not None:
+            hazards = self._hazard_detector.query(self._vehicle, self._proximity_threshold)
+            traffic_light = None
+            if hazards.traffic_light_state == carla.libcarla.TrafficLightState.Red:
+                traffic_light = hazards.traffic_light
+            return (hazards.vehicle, traffic_light)
+
+        actor_list = self._world.get_actors()
+        vehicle_list = actor_list.filter("*vehicle*")
+        lights_list = actor_list.filter("*traffic_light*")
+        _, vehicle = self._is_vehicle_hazard(vehicle_list)
+        _, traffic_light = self._is_light_red(lights_list)
+        return (vehicle, traffic_light)
+
     def _is_vehicle_hazard(self, vehicle_list):
         """
         Check if a given vehicle is an obstacle in our way. To this end we take
@@ -28,12 +28,13 @@ class BasicAgent(Agent):
     target destination. This agent respects traffic lights and other vehicles.
     """
 
-    def __init__(self, vehicle, target_speed=20):
+    def __init__(self, vehicle, target_speed=20, hazard_detector=None):
         """
 
         :param vehicle: actor to apply to local planner logic onto
+        :param hazard_detector: optional carla.HazardDetector, see Agent
         """
-        super(BasicAgent, self).__init__(vehicle)
+        super(BasicAgent, self).__init__(vehicle, hazard_detector)
 
         self._proximity_threshold = 10.0 # meters
         self._state = AgentState.NAVIGATING
@@ -134,13 +135,10 @@ class BasicAgent(Agent):
 
         # retrieve relevant elements for safe navigation, i.e.: traffic lights
         # and other vehicles
-        actor_list = self._world.get_actors()
-        vehicle_list = actor_list.filter("*vehicle*")
-        lights_list = actor_list.filter("*traffic_light*")
+        vehicle, traffic_light = self._detect_hazards()
 
         # check possible obstacles
-        vehicle_state, vehicle = self._is_vehicle_hazard(vehicle_list)
-        if vehicle_state:
+        if vehicle is not None:
             if debug:
                 print('!!! VEHICLE BLOCKING AHEAD [{}])'.format(vehicle.id))
 
@@ -148,8 +146,7 @@ class BasicAgent(Agent):
             hazard_detected = True
 
         # check for the state of the traffic lights
-        light_state, traffic_light = self._is_light_red(lights_list)
-        if light_state:
+        if traffic_light is not None:
             if debug:
                 print('=== RED LIGHT AHEAD [{}])'.format(traffic_light.id))
 
@@ -20,6 +20,9 @@ class VehiclePIDController():
     """
     VehiclePIDController is the combination of two PID controllers (lateral and longitudinal) to perform the
     low level control a vehicle from client side
+
+    To control many vehicles at once, carla.VehiclePIDController computes the same controls natively from the last
+    world tick and applies them all in a single batch.
     """
 
     def __init__(self, vehicle,
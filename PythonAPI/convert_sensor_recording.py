@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma de
+# Barcelona (UAB).
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+"""Convert a sensor recording written by carla.SensorRecorder to images (for
+cameras) or PLY files (for lidars)."""
+
+import glob
+import os
+import sys
+
+try:
+    sys.path.append(glob.glob('**/*%d.%d-%s.egg' % (
+        sys.version_info.major,
+        sys.version_info.minor,
+        'win-amd64' if os.name == 'nt' else 'linux-x86_64'))[0])
+except IndexError:
+    pass
+
+import carla
+
+import argparse
+
+
+COLOR_CONVERTERS = {
+    'raw': carla.ColorConverter.Raw,
+    'depth': carla.ColorConverter.Depth,
+    'logdepth': carla.ColorConverter.LogarithmicDepth,
+    'cityscapes': carla.ColorConverter.CityScapesPalette
+}
+
+
+def main():
+    argparser = argparse.ArgumentParser(
+        description=__doc__)
+    argparser.add_argument(
+        'recording',
+        help='folder of the sensor recording')
+    argparser.add_argument(
+        '-o', '--output',
+        metavar='DIR',
+        default='_out',
+        help='output folder (default: _out)')
+    argparser.add_argument(
+        '-c', '--color-converter',
+        choices=sorted(COLOR_CONVERTERS.keys()),
+        default='raw',
+        help='color converter applied to images (default: raw)')
+    argparser.add_argument(
+        '--format',
+        metavar='EXT',
+        default='png',
+        help='image file format (default: png)')
+    args = argparser.parse_args()
+
+    recording = carla.SensorRecording(args.recording)
+    print('%d messages found in %s' % (len(recording), recording.folder))
+
+    converted = 0
+    for index in range(len(recording)):
+        data = recording[index]
+        if isinstance(data, carla.Image):
+            path = os.path.join(args.output, '%06d.%s' % (data.frame_number, args.format))
+            data.save_to_disk(path, COLOR_CONVERTERS[args.color_converter])
+        elif isinstance(data, carla.LidarMeasurement):
+            path = os.path.join(args.output, '%06d.ply' % data.frame_number)
+            data.save_to_disk(path)
+        else:
+            print('skipping message %d: cannot convert %s' % (index, type(data).__name__))
+            continue
+        converted += 1
+
+    print('%d messages converted to %s' % (converted, args.output))
+
+
+if __name__ == '__main__':
+
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
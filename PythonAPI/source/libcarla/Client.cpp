@@ -10,6 +10,8 @@
 
 #include <boost/python/stl_iterator.hpp>
 
+#include <stdexcept>
+
 static void SetTimeout(carla::client::Client &client, double seconds) {
   client.SetTimeout(TimeDurationFromSeconds(seconds));
 }
@@ -34,6 +36,55 @@ static void ApplyBatchCommands(
   self.ApplyBatch(std::move(result), do_tick);
 }
 
+/// Read @a values as a sequence of one value per actor, or return an empty
+/// vector if None.
+template <typename T>
+static std::vector<T> ReadControlValues(
+    const boost::python::object &values,
+    const size_t number_of_actors,
+    const char *name) {
+  if (values.is_none()) {
+    return {};
+  }
+  auto result = ReadSequence<T>(values);
+  if (result.size() != number_of_actors) {
+    throw std::invalid_argument(
+        std::string(name) + " must have one value per actor, got " +
+        std::to_string(result.size()) + " values for " +
+        std::to_string(number_of_actors) + " actors");
+  }
+  return result;
+}
+
+static void ApplyVehicleControls(
+    const carla::client::Client &self,
+    const boost::python::object &actor_ids,
+    const boost::python::object &throttle,
+    const boost::python::object &steer,
+    const boost::python::object &brake,
+    const boost::python::object &hand_brake,
+    const boost::python::object &reverse,
+    bool do_tick) {
+  const auto ids = ReadSequence<carla::ActorId>(actor_ids);
+  const auto throttles = ReadControlValues<float>(throttle, ids.size(), "throttle");
+  const auto steers = ReadControlValues<float>(steer, ids.size(), "steer");
+  const auto brakes = ReadControlValues<float>(brake, ids.size(), "brake");
+  const auto hand_brakes = ReadControlValues<bool>(hand_brake, ids.size(), "hand_brake");
+  const auto reverses = ReadControlValues<bool>(reverse, ids.size(), "reverse");
+  std::vector<carla::rpc::Command> commands;
+  commands.reserve(ids.size());
+  for (auto i = 0u; i < ids.size(); ++i) {
+    carla::rpc::VehicleControl control;
+    control.throttle = throttles.empty() ? 0.0f : throttles[i];
+    control.steer = steers.empty() ? 0.0f : steers[i];
+    control.brake = brakes.empty() ? 0.0f : brakes[i];
+    control.hand_brake = hand_brakes.empty() ? false : hand_brakes[i];
+    control.reverse = reverses.empty() ? false : reverses[i];
+    commands.emplace_back(carla::rpc::Command::ApplyVehicleControl{ids[i], control});
+  }
+  self.ApplyBatch(std::move(commands), do_tick);
+}
+
 void export_client() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -54,5 +105,13 @@ void export_client() {
     .def("show_recorder_actors_blocked", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderActorsBlocked, std::string, float, float), (arg("name"), arg("min_time"), arg("min_distance")))
     .def("replay_file", CALL_WITHOUT_GIL_4(cc::Client, ReplayFile, std::string, float, float, int), (arg("name"), arg("time_start"), arg("duration"), arg("follow_id")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
+    .def("apply_vehicle_controls", &ApplyVehicleControls,
+        (arg("actor_ids"),
+         arg("throttle")=object(),
+         arg("steer")=object(),
+         arg("brake")=object(),
+         arg("hand_brake")=object(),
+         arg("reverse")=object(),
+         arg("do_tick")=false))
   ;
 }
@@ -4,11 +4,18 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <carla/PythonUtil.h>
+#include <carla/client/Actor.h>
+#include <carla/client/Client.h>
+#include <carla/client/VehiclePIDController.h>
+#include <carla/client/World.h>
 #include <carla/rpc/VehicleControl.h>
 #include <carla/rpc/VehiclePhysicsControl.h>
 #include <carla/rpc/WheelPhysicsControl.h>
 #include <carla/rpc/WalkerControl.h>
 
+#include <boost/python/stl_iterator.hpp>
+
 #include <ostream>
 
 namespace carla {
@@ -161,8 +168,64 @@ boost::python::object VehiclePhysicsControl_init(boost::python::tuple args, boos
     return res;
 }
 
+static carla::client::VehiclePIDController::Gains GetPIDGains(const boost::python::object &args) {
+  carla::client::VehiclePIDController::Gains gains;
+  if (!args.is_none()) {
+    const boost::python::dict dict{args};
+    gains.k_p = boost::python::extract<double>(dict.get("K_P", gains.k_p));
+    gains.k_d = boost::python::extract<double>(dict.get("K_D", gains.k_d));
+    gains.k_i = boost::python::extract<double>(dict.get("K_I", gains.k_i));
+  }
+  return gains;
+}
+
+/// Targets are (vehicle, location, speed) tuples, vehicle being an actor or
+/// an actor id.
+static auto GetPIDTargets(const boost::python::object &targets) {
+  using Target = carla::client::VehiclePIDController::Target;
+  std::vector<Target> result;
+  for (boost::python::stl_input_iterator<boost::python::object> it(targets), end; it != end; ++it) {
+    const boost::python::object vehicle = (*it)[0];
+    boost::python::extract<carla::rpc::ActorId> id(vehicle);
+    result.push_back(Target{
+        id.check() ? id() : boost::python::extract<const carla::client::Actor &>(vehicle)().GetId(),
+        boost::python::extract<carla::geom::Location>((*it)[1]),
+        boost::python::extract<double>((*it)[2])});
+  }
+  return result;
+}
+
+static void StepPIDController(
+    carla::client::VehiclePIDController &self,
+    const carla::client::Client &client,
+    const carla::client::World &world,
+    const boost::python::object &targets) {
+  auto target_list = GetPIDTargets(targets);
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Step(client, world, target_list);
+}
+
+static boost::python::list GetPIDCommands(
+    carla::client::VehiclePIDController &self,
+    const carla::client::World &world,
+    const boost::python::object &targets) {
+  using ApplyVehicleControl = carla::rpc::Command::ApplyVehicleControl;
+  auto target_list = GetPIDTargets(targets);
+  std::vector<carla::rpc::Command> commands;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    commands = self.ComputeCommands(world, target_list);
+  }
+  boost::python::list result;
+  for (auto &&command : commands) {
+    result.append(boost::get<ApplyVehicleControl>(command.command));
+  }
+  return result;
+}
+
 void export_control() {
   using namespace boost::python;
+  namespace cc = carla::client;
   namespace cr = carla::rpc;
   namespace cg = carla::geom;
 
@@ -247,4 +310,18 @@ void export_control() {
     .def("__ne__", &cr::VehiclePhysicsControl::operator!=)
     .def(self_ns::str(self_ns::self))
   ;
+
+  class_<cc::VehiclePIDController, boost::noncopyable, boost::shared_ptr<cc::VehiclePIDController>>("VehiclePIDController", no_init)
+    .def("__init__", make_constructor(+[](const object &args_lateral, const object &args_longitudinal, double dt) {
+      return carla::MakeShared<cc::VehiclePIDController>(
+          GetPIDGains(args_lateral),
+          GetPIDGains(args_longitudinal),
+          dt);
+    }, default_call_policies(), (arg("args_lateral")=object(), arg("args_longitudinal")=object(), arg("dt")=0.03)))
+    .def("step", &StepPIDController, (arg("client"), arg("world"), arg("targets")))
+    .def("get_commands", &GetPIDCommands, (arg("world"), arg("targets")))
+    .def("remove", &cc::VehiclePIDController::Remove, (arg("actor_id")))
+    .def("clear", &cc::VehiclePIDController::Clear)
+    .def("__len__", &cc::VehiclePIDController::GetNumberOfVehicles)
+  ;
 }
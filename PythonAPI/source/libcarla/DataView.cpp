@@ -0,0 +1,154 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <carla/Memory.h>
+#include <carla/NonCopyable.h>
+#include <carla/NumericBuffer.h>
+
+#include <boost/python/stl_iterator.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Exports a block of memory through the Python buffer protocol with the
+/// given format and shape, keeping alive the object that owns the memory.
+/// The memory is assumed to be C-contiguous and is exported read-only.
+class DataView : private carla::NonCopyable {
+public:
+
+  DataView(
+      carla::SharedPtr<const void> owner,
+      const void *data,
+      std::string format,
+      size_t itemsize,
+      std::vector<Py_ssize_t> shape)
+    : _owner(std::move(owner)),
+      _data(data),
+      _format(std::move(format)),
+      _itemsize(static_cast<Py_ssize_t>(itemsize)),
+      _shape(std::move(shape)),
+      _strides(_shape.size()) {
+    Py_ssize_t stride = _itemsize;
+    for (auto i = _shape.size(); i > 0u; --i) {
+      _strides[i - 1u] = stride;
+      stride *= _shape[i - 1u];
+    }
+    _length = stride;
+  }
+
+  static int GetBuffer(PyObject *exporter, Py_buffer *view, int flags);
+
+private:
+
+  carla::SharedPtr<const void> _owner;
+
+  const void *_data;
+
+  std::string _format;
+
+  Py_ssize_t _itemsize;
+
+  std::vector<Py_ssize_t> _shape;
+
+  std::vector<Py_ssize_t> _strides;
+
+  Py_ssize_t _length;
+};
+
+int DataView::GetBuffer(PyObject *exporter, Py_buffer *view, int flags) {
+  view->obj = nullptr;
+  boost::python::extract<DataView &> extractor(exporter);
+  if (!extractor.check()) {
+    PyErr_SetString(PyExc_BufferError, "invalid data view");
+    return -1;
+  }
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "data view is read-only");
+    return -1;
+  }
+  DataView &self = extractor();
+  view->buf = const_cast<void *>(self._data);
+  view->len = self._length;
+  view->readonly = 1;
+  view->itemsize = self._itemsize;
+  view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ?
+      const_cast<char *>(self._format.c_str()) :
+      nullptr;
+  view->ndim = static_cast<int>(self._shape.size());
+  view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? self._shape.data() : nullptr;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self._strides.data() : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  view->obj = exporter;
+  Py_INCREF(exporter);
+  return 0;
+}
+
+/// Return a memoryview of @a data, the memoryview keeps @a owner alive.
+template <typename OwnerT>
+static boost::python::object MakeMemoryView(
+    carla::SharedPtr<OwnerT> owner,
+    const void *data,
+    std::string format,
+    size_t itemsize,
+    std::vector<Py_ssize_t> shape) {
+  namespace py = boost::python;
+  auto view = carla::MakeShared<DataView>(
+      std::move(owner),
+      data,
+      std::move(format),
+      itemsize,
+      std::move(shape));
+  py::object exporter(view);
+  return py::object(py::handle<>(PyMemoryView_FromObject(exporter.ptr())));
+}
+
+/// Copy the items of @a sequence into a vector. Buffers of native numbers,
+/// like numpy arrays, are read directly, anything else is iterated.
+template <typename T>
+static std::vector<T> ReadSequence(const boost::python::object &sequence) {
+  std::vector<T> result;
+  if (PyObject_CheckBuffer(sequence.ptr())) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(sequence.ptr(), &view, PyBUF_FORMAT | PyBUF_STRIDES) == 0) {
+      carla::NumericBuffer buffer;
+      buffer.data = view.buf;
+      buffer.format = view.format;
+      buffer.item_size = static_cast<size_t>(view.itemsize);
+      buffer.length = static_cast<size_t>(view.len);
+      buffer.ndim = static_cast<size_t>(view.ndim);
+      buffer.stride = (view.ndim > 0) ? view.strides[0u] : view.itemsize;
+      const bool copied = buffer.CopyTo(result);
+      PyBuffer_Release(&view);
+      if (copied) {
+        return result;
+      }
+    } else {
+      PyErr_Clear();
+    }
+  }
+  result.assign(
+      boost::python::stl_input_iterator<T>(sequence),
+      boost::python::stl_input_iterator<T>());
+  return result;
+}
+
+void export_data_view() {
+  using namespace boost::python;
+
+  class_<DataView, boost::noncopyable, boost::shared_ptr<DataView>>("DataView", no_init);
+
+  // Boost.Python classes are heap types, install the buffer protocol slots
+  // in the type object created above.
+  auto *type = const_cast<PyTypeObject *>(
+      converter::registered<DataView>::converters.get_class_object());
+  type->tp_as_buffer->bf_getbuffer = &DataView::GetBuffer;
+  type->tp_as_buffer->bf_releasebuffer = nullptr;
+#if PY_MAJOR_VERSION < 3
+  type->tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <carla/Logging.h>
+
+#include <stdexcept>
+#include <string>
+
+static void SetLogLevel(const std::string &level) {
+  if (level == "debug") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_DEBUG);
+  } else if (level == "info") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_INFO);
+  } else if (level == "warning") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_WARNING);
+  } else if (level == "error") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_ERROR);
+  } else if (level == "critical") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_CRITICAL);
+  } else if (level == "none") {
+    carla::logging::SetLevel(LIBCARLA_LOG_LEVEL_NONE);
+  } else {
+    throw std::invalid_argument(
+        "invalid log level, use 'debug', 'info', 'warning', 'error', 'critical', or 'none'");
+  }
+}
+
+static void SetLogFormat(const std::string &format) {
+  if (format == "text") {
+    carla::logging::SetFormat(carla::logging::Format::Text);
+  } else if (format == "json") {
+    carla::logging::SetFormat(carla::logging::Format::Json);
+  } else {
+    throw std::invalid_argument("invalid log format, use 'text' or 'json'");
+  }
+}
+
+static void FlushLog() {
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::logging::Flush();
+}
+
+void export_logging() {
+  using namespace boost::python;
+
+  def("set_log_level", &SetLogLevel, (arg("level")));
+  def("set_log_format", &SetLogFormat, (arg("format")));
+  def("flush_log", &FlushLog);
+}
@@ -8,6 +8,8 @@
 #include <carla/PythonUtil.h>
 #include <carla/client/Map.h>
 #include <carla/client/Waypoint.h>
+#include <carla/road/LanePolylines.h>
+#include <carla/road/RoutingGraph.h>
 
 #include <fstream>
 
@@ -47,17 +49,232 @@ static auto GetTopology(const carla::client::Map &self) {
   return result;
 }
 
+// Lane types are taken as a plain integer so several carla.LaneType flags can
+// be combined with "|".
+static auto GetWaypoint(
+    const carla::client::Map &self,
+    const carla::geom::Location &location,
+    bool project_to_road,
+    uint32_t lane_type) {
+  return self.GetWaypoint(
+      location,
+      project_to_road,
+      static_cast<carla::road::element::LaneType>(lane_type));
+}
+
+static auto GenerateWaypoints(
+    const carla::client::Map &self,
+    double distance,
+    uint32_t lane_type) {
+  namespace py = boost::python;
+  std::vector<carla::SharedPtr<carla::client::Waypoint>> waypoints;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    waypoints = self.GenerateWaypoints(
+        distance,
+        static_cast<carla::road::element::LaneType>(lane_type));
+  }
+  py::list result;
+  for (auto &&waypoint : waypoints) {
+    result.append(waypoint);
+  }
+  return result;
+}
+
+static auto GetLanePolylines(
+    const carla::client::Map &self,
+    double resolution,
+    uint32_t lane_type) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.GetLanePolylines(
+      resolution,
+      static_cast<carla::road::element::LaneType>(lane_type));
+}
+
+/// Read-only memoryview of one of the arrays of the polylines, it keeps the
+/// polylines alive.
+template <typename T>
+static boost::python::object MakePolylineArray(
+    const carla::SharedPtr<carla::road::LanePolylines> &self,
+    const std::vector<T> &array,
+    const char *format) {
+  return MakeMemoryView(
+      self,
+      array.data(),
+      format,
+      sizeof(T),
+      {static_cast<Py_ssize_t>(array.size())});
+}
+
+#define POLYLINE_ARRAY(fn, format) +[](const carla::SharedPtr<carla::road::LanePolylines> &self) { \
+      return MakePolylineArray(self, self->fn(), format); \
+    }
+
+static auto MakeRouteList(const carla::client::Map::Route &route) {
+  namespace py = boost::python;
+  py::list result;
+  for (auto &&pair : route) {
+    result.append(py::make_tuple(pair.first, pair.second));
+  }
+  return result;
+}
+
+static auto ComputeRoute(
+    const carla::client::Map &self,
+    const carla::geom::Location &origin,
+    const carla::geom::Location &destination,
+    bool bidirectional) {
+  carla::client::Map::Route route;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    route = self.ComputeRoute(origin, destination, bidirectional);
+  }
+  return MakeRouteList(route);
+}
+
+static auto ComputeRoutes(
+    const carla::client::Map &self,
+    const boost::python::object &queries,
+    bool bidirectional) {
+  namespace py = boost::python;
+  std::vector<std::pair<carla::geom::Location, carla::geom::Location>> pairs;
+  for (auto it = py::stl_input_iterator<py::object>(queries); it != py::stl_input_iterator<py::object>(); ++it) {
+    pairs.emplace_back(
+        py::extract<carla::geom::Location>((*it)[0u]),
+        py::extract<carla::geom::Location>((*it)[1u]));
+  }
+  std::vector<carla::client::Map::Route> routes;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    routes = self.ComputeRoutes(pairs, bidirectional);
+  }
+  py::list result;
+  for (auto &&route : routes) {
+    result.append(MakeRouteList(route));
+  }
+  return result;
+}
+
+static auto ComputeRouteDistances(
+    const carla::client::Map &self,
+    const boost::python::object &origins,
+    const boost::python::object &destinations) {
+  namespace py = boost::python;
+  const std::vector<carla::geom::Location> origin_list{
+      py::stl_input_iterator<carla::geom::Location>(origins),
+      py::stl_input_iterator<carla::geom::Location>()};
+  const std::vector<carla::geom::Location> destination_list{
+      py::stl_input_iterator<carla::geom::Location>(destinations),
+      py::stl_input_iterator<carla::geom::Location>()};
+  std::vector<std::vector<double>> distances;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    distances = self.ComputeRouteDistances(origin_list, destination_list);
+  }
+  py::list result;
+  for (auto &&row : distances) {
+    py::list list;
+    for (auto distance : row) {
+      list.append(distance);
+    }
+    result.append(list);
+  }
+  return result;
+}
+
+static void BuildRoutingIndex(const carla::client::Map &self) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.BuildRoutingIndex();
+}
+
+static void SaveRoutingIndex(const carla::client::Map &self, std::string path) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  if (path.empty()) {
+    path = self.GetName();
+  }
+  self.SaveRoutingIndex(path);
+}
+
+static void LoadRoutingIndex(const carla::client::Map &self, const std::string &path) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.LoadRoutingIndex(path);
+}
+
 void export_map() {
   using namespace boost::python;
   namespace cc = carla::client;
   namespace cg = carla::geom;
+  namespace cr = carla::road;
+  namespace cre = carla::road::element;
+
+  enum_<cr::RoadOption>("RoadOption")
+    .value("VOID", cr::RoadOption::Void)
+    .value("LEFT", cr::RoadOption::Left)
+    .value("RIGHT", cr::RoadOption::Right)
+    .value("STRAIGHT", cr::RoadOption::Straight)
+    .value("LANEFOLLOW", cr::RoadOption::LaneFollow)
+    .value("CHANGELANELEFT", cr::RoadOption::ChangeLaneLeft)
+    .value("CHANGELANERIGHT", cr::RoadOption::ChangeLaneRight)
+  ;
+
+  enum_<cre::LaneType>("LaneType")
+    .value("None", cre::LaneType::None)
+    .value("Driving", cre::LaneType::Driving)
+    .value("Stop", cre::LaneType::Stop)
+    .value("Shoulder", cre::LaneType::Shoulder)
+    .value("Biking", cre::LaneType::Biking)
+    .value("Sidewalk", cre::LaneType::Sidewalk)
+    .value("Border", cre::LaneType::Border)
+    .value("Restricted", cre::LaneType::Restricted)
+    .value("Parking", cre::LaneType::Parking)
+    .value("Bidirectional", cre::LaneType::Bidirectional)
+    .value("Median", cre::LaneType::Median)
+    .value("Special1", cre::LaneType::Special1)
+    .value("Special2", cre::LaneType::Special2)
+    .value("Special3", cre::LaneType::Special3)
+    .value("RoadWorks", cre::LaneType::RoadWorks)
+    .value("Tram", cre::LaneType::Tram)
+    .value("Rail", cre::LaneType::Rail)
+    .value("Entry", cre::LaneType::Entry)
+    .value("Exit", cre::LaneType::Exit)
+    .value("OffRamp", cre::LaneType::OffRamp)
+    .value("OnRamp", cre::LaneType::OnRamp)
+    .value("Any", cre::LaneType::Any)
+  ;
+
+  const auto driving = static_cast<uint32_t>(cre::LaneType::Driving);
+
+  class_<cr::LanePolylines, boost::noncopyable, boost::shared_ptr<cr::LanePolylines>>("LanePolylines", no_init)
+    .add_property("resolution", &cr::LanePolylines::GetResolution)
+    .add_property("number_of_lanes", &cr::LanePolylines::GetNumberOfLanes)
+    .add_property("lane_offsets", POLYLINE_ARRAY(GetLaneOffsets, "I"))
+    .add_property("x", POLYLINE_ARRAY(GetX, "f"))
+    .add_property("y", POLYLINE_ARRAY(GetY, "f"))
+    .add_property("z", POLYLINE_ARRAY(GetZ, "f"))
+    .add_property("yaw", POLYLINE_ARRAY(GetYaw, "f"))
+    .add_property("s", POLYLINE_ARRAY(GetS, "f"))
+    .add_property("road_id", POLYLINE_ARRAY(GetRoadIds, "I"))
+    .add_property("lane_id", POLYLINE_ARRAY(GetLaneIds, "i"))
+    .def("__len__", &cr::LanePolylines::GetNumberOfPoints)
+  ;
+
+  register_ptr_to_python<carla::SharedPtr<const cr::LanePolylines>>();
+
+#undef POLYLINE_ARRAY
 
   class_<cc::Map, boost::noncopyable, boost::shared_ptr<cc::Map>>("Map", no_init)
     .add_property("name", CALL_RETURNING_COPY(cc::Map, GetName))
     .def("get_spawn_points", CALL_RETURNING_LIST(cc::Map, GetRecommendedSpawnPoints))
-    .def("get_waypoint", &cc::Map::GetWaypoint, (arg("location"), arg("project_to_road")=true))
+    .def("get_waypoint", &GetWaypoint, (arg("location"), arg("project_to_road")=true, arg("lane_type")=driving))
     .def("get_topology", &GetTopology)
-    .def("generate_waypoints", CALL_RETURNING_LIST_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("generate_waypoints", &GenerateWaypoints, (arg("distance"), arg("lane_type")=driving))
+    .def("compute_route", &ComputeRoute, (arg("origin"), arg("destination"), arg("bidirectional")=false))
+    .def("compute_routes", &ComputeRoutes, (arg("queries"), arg("bidirectional")=false))
+    .def("compute_route_distances", &ComputeRouteDistances, (arg("origins"), arg("destinations")))
+    .def("build_routing_index", &BuildRoutingIndex)
+    .def("save_routing_index", &SaveRoutingIndex, (arg("path")=""))
+    .def("load_routing_index", &LoadRoutingIndex, (arg("path")))
+    .def("get_lane_polylines", &GetLanePolylines, (arg("resolution")=2.0, arg("lane_type")=driving))
     .def("to_opendrive", CALL_RETURNING_COPY(cc::Map, GetOpenDrive))
     .def("save_to_disk", &SaveOpenDriveToDisk, (arg("path")=""))
     .def(self_ns::str(self_ns::self))
@@ -0,0 +1,52 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <carla/profiler/Metrics.h>
+
+static boost::python::dict HistogramToDict(const carla::profiler::HistogramSnapshot &histogram) {
+  boost::python::dict result;
+  result["count"] = histogram.count;
+  result["sum"] = histogram.sum;
+  result["mean"] = histogram.GetMean();
+  result["max"] = histogram.max;
+  result["p50"] = histogram.GetPercentile(0.5);
+  result["p90"] = histogram.GetPercentile(0.9);
+  result["p99"] = histogram.GetPercentile(0.99);
+  boost::python::list buckets;
+  for (auto &&count : histogram.buckets) {
+    buckets.append(count);
+  }
+  result["buckets"] = buckets;
+  return result;
+}
+
+static boost::python::dict GetMetrics() {
+  const auto snapshot = carla::profiler::Metrics::GetSnapshot();
+  boost::python::dict counters;
+  for (auto &&item : snapshot.counters) {
+    counters[item.first] = item.second;
+  }
+  boost::python::dict gauges;
+  for (auto &&item : snapshot.gauges) {
+    gauges[item.first] = item.second;
+  }
+  boost::python::dict histograms;
+  for (auto &&item : snapshot.histograms) {
+    histograms[item.first] = HistogramToDict(item.second);
+  }
+  boost::python::dict result;
+  result["counters"] = counters;
+  result["gauges"] = gauges;
+  result["histograms"] = histograms;
+  return result;
+}
+
+void export_metrics() {
+  using namespace boost::python;
+
+  def("get_metrics", &GetMetrics);
+  def("reset_metrics", &carla::profiler::Metrics::Reset);
+}
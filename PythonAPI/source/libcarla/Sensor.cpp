@@ -9,12 +9,169 @@
 #include <carla/client/GnssSensor.h>
 #include <carla/client/LaneDetector.h>
 #include <carla/client/Sensor.h>
+#include <carla/client/SensorQueue.h>
+#include <carla/client/SensorRecorder.h>
+#include <carla/client/SensorRecording.h>
+#include <carla/client/SensorSynchronizer.h>
 #include <carla/client/ServerSideSensor.h>
 
+#include <boost/python/stl_iterator.hpp>
+
+namespace carla {
+namespace client {
+
+  std::ostream &operator<<(std::ostream &out, const SensorBundle &bundle) {
+    out << "SensorBundle(frame=" << bundle.GetFrameNumber()
+        << ",size=" << bundle.size()
+        << ",complete=" << (bundle.IsComplete() ? "True" : "False") << ')';
+    return out;
+  }
+
+} // namespace client
+} // namespace carla
+
 static void SubscribeToStream(carla::client::Sensor &self, boost::python::object callback) {
   self.Listen(MakeCallback(std::move(callback)));
 }
 
+static auto MakeSensorSynchronizer(
+    const carla::client::World &world,
+    const boost::python::object &sensors,
+    size_t window,
+    double timeout,
+    bool deliver_incomplete) {
+  namespace cc = carla::client;
+  using SensorPtr = carla::SharedPtr<cc::Sensor>;
+  std::vector<SensorPtr> sensor_list{
+      boost::python::stl_input_iterator<SensorPtr>(sensors),
+      boost::python::stl_input_iterator<SensorPtr>()};
+  return carla::MakeShared<cc::SensorSynchronizer>(
+      world,
+      std::move(sensor_list),
+      window,
+      TimeDurationFromSeconds(timeout),
+      deliver_incomplete ?
+          cc::SensorSynchronizer::IncompleteFramePolicy::Deliver :
+          cc::SensorSynchronizer::IncompleteFramePolicy::Drop);
+}
+
+static void ListenToSynchronizer(
+    carla::client::SensorSynchronizer &self,
+    boost::python::object callback) {
+  self.Listen(MakeCallback(std::move(callback)));
+}
+
+static boost::python::object GetBundleTimestamp(const carla::client::SensorBundle &self) {
+  const auto &timestamp = self.GetTimestamp();
+  return timestamp.has_value() ?
+      boost::python::object(*timestamp) :
+      boost::python::object();
+}
+
+static auto MakeSensorQueue(size_t capacity, bool drop_oldest) {
+  namespace cc = carla::client;
+  return carla::MakeShared<cc::SensorQueue>(
+      capacity,
+      drop_oldest ?
+          cc::SensorQueue::OverflowPolicy::DropOldest :
+          cc::SensorQueue::OverflowPolicy::DropNewest);
+}
+
+static boost::python::object GetFromSensorQueue(
+    carla::client::SensorQueue &self,
+    double timeout,
+    boost::python::object frame) {
+  carla::SharedPtr<carla::sensor::SensorData> data;
+  if (frame.is_none()) {
+    carla::PythonUtil::ReleaseGIL unlock;
+    data = self.Get(TimeDurationFromSeconds(timeout));
+  } else {
+    const size_t frame_number = boost::python::extract<size_t>(frame);
+    carla::PythonUtil::ReleaseGIL unlock;
+    data = self.GetFrame(frame_number, TimeDurationFromSeconds(timeout));
+  }
+  return data != nullptr ? boost::python::object(data) : boost::python::object();
+}
+
+static boost::python::list GetBatchFromSensorQueue(
+    carla::client::SensorQueue &self,
+    size_t max_count,
+    double timeout) {
+  std::vector<carla::SharedPtr<carla::sensor::SensorData>> batch;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    batch = self.GetBatch(max_count, TimeDurationFromSeconds(timeout));
+  }
+  boost::python::list result;
+  for (auto &&data : batch) {
+    result.append(data);
+  }
+  return result;
+}
+
+static boost::python::object GetLatestFromSensorQueue(carla::client::SensorQueue &self) {
+  auto data = self.GetLatest();
+  return data != nullptr ? boost::python::object(data) : boost::python::object();
+}
+
+static auto MakeSensorRecorder(
+    std::string folder,
+    size_t segment_size,
+    size_t max_queue_size,
+    bool direct_io,
+    const std::string &sync,
+    size_t flush_size,
+    double flush_interval) {
+  namespace cc = carla::client;
+  cc::SensorRecorder::Options options;
+  options.segment_size = segment_size;
+  options.max_queue_size = max_queue_size;
+  options.direct_io = direct_io;
+  options.flush_size = flush_size;
+  options.flush_interval = TimeDurationFromSeconds(flush_interval);
+  if (sync == "never") {
+    options.sync_policy = cc::SensorRecorder::SyncPolicy::Never;
+  } else if (sync == "segment") {
+    options.sync_policy = cc::SensorRecorder::SyncPolicy::EverySegment;
+  } else if (sync == "message") {
+    options.sync_policy = cc::SensorRecorder::SyncPolicy::EveryMessage;
+  } else {
+    throw std::invalid_argument("invalid sync policy, use 'never', 'segment', or 'message'");
+  }
+  return carla::MakeShared<cc::SensorRecorder>(std::move(folder), options);
+}
+
+static void RecordSensor(
+    carla::client::SensorRecorder &self,
+    carla::SharedPtr<carla::client::Sensor> sensor) {
+  auto server_side = boost::dynamic_pointer_cast<carla::client::ServerSideSensor>(sensor);
+  if (server_side == nullptr) {
+    throw std::invalid_argument("only server-side sensors can be recorded");
+  }
+  self.Listen(std::move(server_side));
+}
+
+static void CloseSensorRecorder(carla::client::SensorRecorder &self) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Close();
+}
+
+static auto ReadSensorRecording(carla::client::SensorRecording &self, size_t pos) {
+  if (pos >= self.size()) {
+    PyErr_SetString(PyExc_IndexError, "index out of range");
+    boost::python::throw_error_already_set();
+  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.ReadData(pos);
+}
+
+static boost::python::object FindInSensorRecording(
+    const carla::client::SensorRecording &self,
+    uint64_t frame_number) {
+  auto pos = self.Find(frame_number);
+  return pos.has_value() ? boost::python::object(*pos) : boost::python::object();
+}
+
 void export_sensor() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -41,8 +198,80 @@ void export_sensor() {
     .def(self_ns::str(self_ns::self))
   ;
 
-  class_<cc::GnssSensor, bases<cc::Sensor>, boost::noncopyable, boost::shared_ptr<cc::GnssSensor>>
+  class_<cc::GnssSensor, bases<cc::ClientSideSensor>, boost::noncopyable, boost::shared_ptr<cc::GnssSensor>>
       ("GnssSensor", no_init)
     .def(self_ns::str(self_ns::self))
   ;
+
+  class_<cc::SensorBundle, boost::noncopyable, boost::shared_ptr<cc::SensorBundle>>("SensorBundle", no_init)
+    .add_property("frame_number", &cc::SensorBundle::GetFrameNumber)
+    .add_property("timestamp", &GetBundleTimestamp)
+    .add_property("is_complete", &cc::SensorBundle::IsComplete)
+    .def("__len__", &cc::SensorBundle::size)
+    .def("__iter__", range(&cc::SensorBundle::begin, &cc::SensorBundle::end))
+    .def("__getitem__", +[](const cc::SensorBundle &self, size_t pos) {
+      return self.at(pos);
+    })
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::SensorSynchronizer, boost::noncopyable, boost::shared_ptr<cc::SensorSynchronizer>>("SensorSynchronizer", no_init)
+    .def("__init__", make_constructor(
+        &MakeSensorSynchronizer,
+        default_call_policies(),
+        (arg("world"),
+         arg("sensors"),
+         arg("window")=8u,
+         arg("timeout")=2.0,
+         arg("deliver_incomplete")=false)))
+    .add_property("is_listening", &cc::SensorSynchronizer::IsListening)
+    .add_property("dropped_frames", &cc::SensorSynchronizer::GetNumberOfDroppedFrames)
+    .def("listen", &ListenToSynchronizer, (arg("callback")))
+    .def("stop", &cc::SensorSynchronizer::Stop)
+  ;
+
+  class_<cc::SensorQueue, boost::noncopyable, boost::shared_ptr<cc::SensorQueue>>("SensorQueue", no_init)
+    .def("__init__", make_constructor(
+        &MakeSensorQueue,
+        default_call_policies(),
+        (arg("capacity")=64u,
+         arg("drop_oldest")=true)))
+    .add_property("capacity", &cc::SensorQueue::capacity)
+    .add_property("dropped_measurements", &cc::SensorQueue::GetNumberOfDroppedMeasurements)
+    .def("listen", &cc::SensorQueue::Listen, (arg("sensor")))
+    .def("stop", &cc::SensorQueue::Stop)
+    .def("get", &GetFromSensorQueue, (arg("timeout")=1.0, arg("frame")=object()))
+    .def("get_batch", &GetBatchFromSensorQueue, (arg("max_count")=0u, arg("timeout")=0.0))
+    .def("get_latest", &GetLatestFromSensorQueue)
+    .def("__len__", &cc::SensorQueue::size)
+  ;
+
+  class_<cc::SensorRecorder, boost::noncopyable, boost::shared_ptr<cc::SensorRecorder>>("SensorRecorder", no_init)
+    .def("__init__", make_constructor(
+        &MakeSensorRecorder,
+        default_call_policies(),
+        (arg("folder"),
+         arg("segment_size")=1024u * 1024u * 1024u,
+         arg("max_queue_size")=256u * 1024u * 1024u,
+         arg("direct_io")=false,
+         arg("sync")="segment",
+         arg("flush_size")=8u * 1024u * 1024u,
+         arg("flush_interval")=1.0)))
+    .add_property("folder", CALL_RETURNING_COPY(cc::SensorRecorder, GetFolder))
+    .add_property("is_listening", &cc::SensorRecorder::IsListening)
+    .add_property("recorded_messages", &cc::SensorRecorder::GetNumberOfRecordedMessages)
+    .add_property("dropped_messages", &cc::SensorRecorder::GetNumberOfDroppedMessages)
+    .def("listen", &RecordSensor, (arg("sensor")))
+    .def("stop", &cc::SensorRecorder::Stop)
+    .def("close", &CloseSensorRecorder)
+  ;
+
+  class_<cc::SensorRecording, boost::noncopyable, boost::shared_ptr<cc::SensorRecording>>("SensorRecording", no_init)
+    .def(init<std::string>((arg("folder"))))
+    .add_property("folder", CALL_RETURNING_COPY(cc::SensorRecording, GetFolder))
+    .def("get_frame_number", &cc::SensorRecording::GetFrameNumber, (arg("index")))
+    .def("find", &FindInSensorRecording, (arg("frame_number")))
+    .def("__len__", &cc::SensorRecording::size)
+    .def("__getitem__", &ReadSensorRecording)
+  ;
 }
@@ -91,6 +91,64 @@ static auto GetRawDataAsBuffer(T &self) {
   return boost::python::object(boost::python::handle<>(ptr));
 }
 
+static auto GetImageView(const carla::sensor::data::Image &self) {
+  static_assert(sizeof(carla::sensor::data::Color) == 4u, "Color size missmatch");
+  return MakeMemoryView(
+      self.shared_from_this(),
+      self.data(),
+      "B",
+      sizeof(uint8_t),
+      {static_cast<Py_ssize_t>(self.GetHeight()),
+       static_cast<Py_ssize_t>(self.GetWidth()),
+       4});
+}
+
+static auto GetLidarPoints(const carla::sensor::data::LidarMeasurement &self) {
+  return MakeMemoryView(
+      self.shared_from_this(),
+      self.data(),
+      "f",
+      sizeof(float),
+      {static_cast<Py_ssize_t>(self.size()), 3});
+}
+
+static auto GetLidarPointCountPerChannel(const carla::sensor::data::LidarMeasurement &self) {
+  return MakeMemoryView(
+      self.shared_from_this(),
+      self.GetPointCountData(),
+      "I",
+      sizeof(uint32_t),
+      {static_cast<Py_ssize_t>(self.GetChannelCount())});
+}
+
+template <typename T>
+static boost::python::object GetLidarAttribute(
+    const carla::sensor::data::LidarMeasurement &self,
+    const T *data,
+    const char *format) {
+  if (data == nullptr) {
+    return boost::python::object();
+  }
+  return MakeMemoryView(
+      self.shared_from_this(),
+      data,
+      format,
+      sizeof(T),
+      {static_cast<Py_ssize_t>(self.size())});
+}
+
+static auto GetLidarTimes(const carla::sensor::data::LidarMeasurement &self) {
+  return GetLidarAttribute(self, self.GetTimeData(), "f");
+}
+
+static auto GetLidarIntensities(const carla::sensor::data::LidarMeasurement &self) {
+  return GetLidarAttribute(self, self.GetIntensityData(), "f");
+}
+
+static auto GetLidarRings(const carla::sensor::data::LidarMeasurement &self) {
+  return GetLidarAttribute(self, self.GetRingData(), "H");
+}
+
 template <typename T>
 static void ConvertImage(T &self, EColorConverter cc) {
   carla::PythonUtil::ReleaseGIL unlock;
@@ -156,6 +214,7 @@ void export_sensor_data() {
 
   class_<cs::SensorData, boost::noncopyable, boost::shared_ptr<cs::SensorData>>("SensorData", no_init)
     .add_property("frame_number", &cs::SensorData::GetFrameNumber)
+    .add_property("timestamp", &cs::SensorData::GetTimestamp)
     .add_property("transform", CALL_RETURNING_COPY(cs::SensorData, GetSensorTransform))
   ;
 
@@ -171,6 +230,7 @@ void export_sensor_data() {
     .add_property("height", &csd::Image::GetHeight)
     .add_property("fov", &csd::Image::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::Image>)
+    .add_property("view", &GetImageView)
     .def("convert", &ConvertImage<csd::Image>, (arg("color_converter")))
     .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw))
     .def("__len__", &csd::Image::size)
@@ -188,6 +248,11 @@ void export_sensor_data() {
     .add_property("horizontal_angle", &csd::LidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::LidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarMeasurement>)
+    .add_property("points", &GetLidarPoints)
+    .add_property("point_count_per_channel", &GetLidarPointCountPerChannel)
+    .add_property("times", &GetLidarTimes)
+    .add_property("intensities", &GetLidarIntensities)
+    .add_property("rings", &GetLidarRings)
     .def("get_point_count", &csd::LidarMeasurement::GetPointCount, (arg("channel")))
     .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path")))
     .def("__len__", &csd::LidarMeasurement::size)
@@ -219,6 +284,13 @@ void export_sensor_data() {
     .value("Other", cre::LaneMarking::Other)
     .value("Broken", cre::LaneMarking::Broken)
     .value("Solid", cre::LaneMarking::Solid)
+    .value("SolidSolid", cre::LaneMarking::SolidSolid)
+    .value("SolidBroken", cre::LaneMarking::SolidBroken)
+    .value("BrokenSolid", cre::LaneMarking::BrokenSolid)
+    .value("BrokenBroken", cre::LaneMarking::BrokenBroken)
+    .value("BottsDots", cre::LaneMarking::BottsDots)
+    .value("Grass", cre::LaneMarking::Grass)
+    .value("Curb", cre::LaneMarking::Curb)
   ;
 
   class_<csd::LaneInvasionEvent, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::LaneInvasionEvent>>("LaneInvasionEvent", no_init)
@@ -0,0 +1,22 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <carla/TaskExecutor.h>
+
+static void ConfigureTaskExecutor(size_t number_of_workers, bool pin_workers, size_t first_core) {
+  carla::TaskExecutor::Options options;
+  options.number_of_workers = number_of_workers;
+  options.pin_workers = pin_workers;
+  options.first_core = first_core;
+  carla::TaskExecutor::ConfigureDefault(options);
+}
+
+void export_task_executor() {
+  using namespace boost::python;
+
+  def("configure_task_executor", &ConfigureTaskExecutor,
+      (arg("number_of_workers")=0u, arg("pin_workers")=false, arg("first_core")=0u));
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <carla/profiler/Tracer.h>
+
+static void SaveTrace(const std::string &path) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::profiler::Tracer::SaveChromeTrace(path);
+}
+
+void export_tracer() {
+  using namespace boost::python;
+  namespace cp = carla::profiler;
+
+  def("start_tracing", &cp::Tracer::Enable, (arg("events_per_thread")=16384u));
+  def("stop_tracing", &cp::Tracer::Disable);
+  def("clear_trace", &cp::Tracer::Clear);
+  def("save_trace", &SaveTrace, (arg("path")));
+}
@@ -7,10 +7,15 @@
 #include <carla/PythonUtil.h>
 #include <carla/client/Actor.h>
 #include <carla/client/ActorList.h>
+#include <carla/client/HazardDetector.h>
 #include <carla/client/World.h>
+#include <carla/sensor/data/RawEpisodeState.h>
 
+#include <boost/python/stl_iterator.hpp>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+#include <limits>
+
 namespace carla {
 namespace client {
 
@@ -31,6 +36,25 @@ namespace client {
     return out;
   }
 
+  std::ostream &operator<<(std::ostream &out, const ClientSideSensorStats &stats) {
+    out << "ClientSideSensorStats(sensor_id=" << stats.sensor_id
+        << ",display_id=" << stats.display_id
+        << ",tick_count=" << stats.tick_count
+        << ",last_tick_seconds=" << stats.last_tick_seconds
+        << ",max_tick_seconds=" << stats.max_tick_seconds
+        << ",total_tick_seconds=" << stats.total_tick_seconds << ')';
+    return out;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const HazardDetector::Hazards &hazards) {
+    auto id = [](const SharedPtr<Actor> &actor) { return actor != nullptr ? actor->GetId() : 0u; };
+    out << "Hazards(vehicle=" << id(hazards.vehicle)
+        << ",vehicle_distance=" << hazards.vehicle_distance
+        << ",traffic_light=" << id(hazards.traffic_light)
+        << ",traffic_light_distance=" << hazards.traffic_light_distance << ')';
+    return out;
+  }
+
 } // namespace client
 } // namespace carla
 
@@ -52,8 +76,134 @@ static auto WaitForTick(const carla::client::World &world, double seconds) {
   return world.WaitForTick(TimeDurationFromSeconds(seconds));
 }
 
-static void OnTick(carla::client::World &self, boost::python::object callback) {
-  self.OnTick(MakeCallback(std::move(callback)));
+/// Packed struct of an ActorDynamicState, see PEP 3118 for the syntax.
+static const std::string &GetActorStateFormat() {
+  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
+  static_assert(
+      sizeof(ActorDynamicState) ==
+          sizeof(ActorDynamicState::id) + 15u * sizeof(float) + sizeof(ActorDynamicState::state),
+      "Unexpected ActorDynamicState layout");
+  static const std::string format =
+      "T{=I:id:(3)f:location:(3)f:rotation:(3)f:velocity:(3)f:angular_velocity:(3)f:acceleration:" +
+      std::to_string(sizeof(ActorDynamicState::state)) + "x:}";
+  return format;
+}
+
+static boost::python::object GetActorStateArray(const carla::client::World &self) {
+  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
+  auto state = self.GetRawEpisodeState();
+  if (state == nullptr) {
+    return boost::python::object();
+  }
+  return MakeMemoryView(
+      state,
+      state->data(),
+      GetActorStateFormat(),
+      sizeof(ActorDynamicState),
+      {static_cast<Py_ssize_t>(state->size())});
+}
+
+static boost::python::object GetActorStates(
+    const carla::client::World &self,
+    const boost::python::object &actor_ids,
+    const boost::python::object &frame) {
+  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
+  const auto ids = ReadSequence<carla::ActorId>(actor_ids);
+  auto states = carla::MakeShared<std::vector<ActorDynamicState>>();
+  if (frame.is_none()) {
+    carla::PythonUtil::ReleaseGIL unlock;
+    *states = self.GetActorStates(ids);
+  } else {
+    const uint64_t frame_count = boost::python::extract<uint64_t>(frame);
+    carla::PythonUtil::ReleaseGIL unlock;
+    *states = self.GetActorStates(ids, frame_count);
+  }
+  return MakeMemoryView(
+      states,
+      states->data(),
+      GetActorStateFormat(),
+      sizeof(ActorDynamicState),
+      {static_cast<Py_ssize_t>(states->size())});
+}
+
+static boost::python::object GetInterpolatedTransform(
+    const carla::client::World &self,
+    carla::ActorId actor_id,
+    double elapsed_seconds) {
+  boost::optional<carla::geom::Transform> transform;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    transform = self.GetInterpolatedTransform(actor_id, elapsed_seconds);
+  }
+  return transform.has_value() ? boost::python::object(*transform) : boost::python::object();
+}
+
+/// Packed struct of an ActorHistorySample, see PEP 3118 for the syntax.
+static const std::string &GetActorHistoryFormat() {
+  static const std::string format =
+      "T{=Q:frame:d:elapsed_seconds:(3)f:location:(3)f:rotation:(3)f:velocity:(3)f:angular_velocity:(3)f:acceleration:}";
+  return format;
+}
+
+static boost::python::object GetActorHistory(
+    const carla::client::World &self,
+    carla::ActorId actor_id,
+    double from_seconds,
+    double to_seconds) {
+  using ActorHistorySample = carla::client::ActorHistorySample;
+  auto samples = carla::MakeShared<std::vector<ActorHistorySample>>();
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    *samples = self.GetActorHistory(actor_id, from_seconds, to_seconds);
+  }
+  return MakeMemoryView(
+      samples,
+      samples->data(),
+      GetActorHistoryFormat(),
+      sizeof(ActorHistorySample),
+      {static_cast<Py_ssize_t>(samples->size())});
+}
+
+static size_t OnTick(carla::client::World &self, boost::python::object callback) {
+  return self.OnTick(MakeCallback(std::move(callback)));
+}
+
+static boost::python::list GetClientSideSensorStats(const carla::client::World &self) {
+  boost::python::list result;
+  for (auto &&stats : self.GetClientSideSensorStats()) {
+    result.append(stats);
+  }
+  return result;
+}
+
+static auto QueryHazards(
+    carla::client::HazardDetector &self,
+    const carla::client::Actor &ego,
+    double lookahead,
+    bool expand_branches) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.Query(ego, lookahead, expand_branches);
+}
+
+static boost::python::list QueryHazardsBatch(
+    carla::client::HazardDetector &self,
+    const boost::python::object &egos,
+    double lookahead,
+    bool expand_branches) {
+  using ActorPtr = carla::SharedPtr<carla::client::Actor>;
+  std::vector<ActorPtr> ego_list{
+      boost::python::stl_input_iterator<ActorPtr>(egos),
+      boost::python::stl_input_iterator<ActorPtr>()};
+  std::vector<carla::client::HazardDetector::Hazards> result;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    result = self.Query(ego_list, lookahead, expand_branches);
+  }
+  boost::python::list list;
+  for (auto &&hazards : result) {
+    list.append(hazards);
+  }
+  return list;
 }
 
 void export_world() {
@@ -121,13 +271,49 @@ void export_world() {
     .def("spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(SpawnActor))
     .def("try_spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(TrySpawnActor))
     .def("wait_for_tick", &WaitForTick, (arg("seconds")=10.0))
+    .def("get_actor_state_array", &GetActorStateArray)
+    .def("get_actor_states", &GetActorStates, (arg("actor_ids"), arg("frame")=object()))
+    .def("get_state_history_size", &cc::World::GetStateHistorySize)
+    .def("set_state_history_size", &cc::World::SetStateHistorySize, (arg("frames")))
+    .def("get_interpolated_transform", &GetInterpolatedTransform, (arg("actor_id"), arg("elapsed_seconds")))
+    .def("get_actor_history", &GetActorHistory, (arg("actor_id"), arg("from_seconds")=0.0, arg("to_seconds")=std::numeric_limits<double>::infinity()))
+    .def("get_client_side_sensor_stats", &GetClientSideSensorStats)
     .def("on_tick", &OnTick, (arg("callback")))
+    .def("remove_on_tick", &cc::World::RemoveOnTick, (arg("callback_id")))
     .def("tick", &cc::World::Tick)
     .def(self_ns::str(self_ns::self))
   ;
 
 #undef SPAWN_ACTOR_WITHOUT_GIL
 
+  class_<cc::ClientSideSensorStats>("ClientSideSensorStats", no_init)
+    .def_readonly("sensor_id", &cc::ClientSideSensorStats::sensor_id)
+    .def_readonly("display_id", &cc::ClientSideSensorStats::display_id)
+    .def_readonly("tick_count", &cc::ClientSideSensorStats::tick_count)
+    .def_readonly("last_tick_seconds", &cc::ClientSideSensorStats::last_tick_seconds)
+    .def_readonly("max_tick_seconds", &cc::ClientSideSensorStats::max_tick_seconds)
+    .def_readonly("total_tick_seconds", &cc::ClientSideSensorStats::total_tick_seconds)
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  using Hazards = cc::HazardDetector::Hazards;
+  class_<Hazards>("Hazards", no_init)
+    .add_property("vehicle", +[](const Hazards &self) { return self.vehicle; })
+    .def_readonly("vehicle_distance", &Hazards::vehicle_distance)
+    .add_property("traffic_light", +[](const Hazards &self) { return self.traffic_light; })
+    .def_readonly("traffic_light_distance", &Hazards::traffic_light_distance)
+    .def_readonly("traffic_light_state", &Hazards::traffic_light_state)
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::HazardDetector, boost::noncopyable, boost::shared_ptr<cc::HazardDetector>>("HazardDetector", no_init)
+    .def("__init__", make_constructor(+[](const cc::World &world) {
+      return carla::MakeShared<cc::HazardDetector>(world);
+    }, default_call_policies(), (arg("world"))))
+    .def("query", &QueryHazards, (arg("ego"), arg("lookahead")=10.0, arg("expand_branches")=false))
+    .def("query_batch", &QueryHazardsBatch, (arg("egos"), arg("lookahead")=10.0, arg("expand_branches")=false))
+  ;
+
   class_<cc::DebugHelper>("DebugHelper", no_init)
     .def("draw_point", &cc::DebugHelper::DrawPoint,
         (arg("location"),
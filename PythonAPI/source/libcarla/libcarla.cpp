@@ -144,15 +144,20 @@ static auto MakeCallback(boost::python::object callback) {
   };
 }
 
+#include "DataView.cpp"
 #include "Geom.cpp"
 #include "Actor.cpp"
 #include "Blueprint.cpp"
 #include "Client.cpp"
 #include "Control.cpp"
 #include "Exception.cpp"
+#include "Logging.cpp"
 #include "Map.cpp"
+#include "Metrics.cpp"
 #include "Sensor.cpp"
 #include "SensorData.cpp"
+#include "TaskExecutor.cpp"
+#include "Tracer.cpp"
 #include "Weather.cpp"
 #include "World.cpp"
 #include "Commands.cpp"
@@ -161,16 +166,21 @@ BOOST_PYTHON_MODULE(libcarla) {
   using namespace boost::python;
   PyEval_InitThreads();
   scope().attr("__path__") = "libcarla";
+  export_data_view();
   export_geom();
   export_control();
   export_blueprint();
   export_actor();
   export_sensor();
   export_sensor_data();
+  export_task_executor();
+  export_tracer();
   export_weather();
   export_world();
   export_map();
+  export_metrics();
   export_client();
   export_exception();
+  export_logging();
   export_commands();
 }
@@ -6,6 +6,7 @@
 
 import carla
 
+import array
 import sys
 import unittest
 
@@ -20,3 +21,20 @@ class testClient(unittest.TestCase):
         if sys.version_info > (3, 0):
             out = out.decode('utf8')
         self.assertEqual(str(v), str(out.strip()))
+
+    def test_apply_vehicle_controls_reads_sequences(self):
+        c = carla.Client('localhost', 8080)
+        ids = array.array('q', [1, 2, 3, 4, 5, 6])
+        # Native buffers are read directly, any other sequence is iterated;
+        # the check of the throttle length fails before anything is sent.
+        sequences = [
+            ids[:3],
+            array.array('d', [1.0, 2.0, 3.0]),
+            [1, 2, 3],
+            (i for i in range(3))]
+        if sys.version_info > (3, 0):
+            sequences.append(memoryview(ids)[::2])
+        for actor_ids in sequences:
+            with self.assertRaises(ValueError) as context:
+                c.apply_vehicle_controls(actor_ids, throttle=array.array('f', [0.5, 0.5]))
+            self.assertIn('got 2 values for 3 actors', str(context.exception))
@@ -342,8 +342,29 @@ void UActorBlueprintFunctionLibrary::MakeLidarDefinition(
   LowerFOV.Id = TEXT("lower_fov");
   LowerFOV.Type = EActorAttributeType::Float;
   LowerFOV.RecommendedValues = { TEXT("-30.0") };
+  // Optional per-point attributes.
+  auto MakePointAttribute = [](const TCHAR *Id) {
+    FActorVariation Variation;
+    Variation.Id = Id;
+    Variation.Type = EActorAttributeType::Bool;
+    Variation.RecommendedValues = { TEXT("false") };
+    Variation.bRestrictToRecommended = false;
+    return Variation;
+  };
+  FActorVariation PointTime = MakePointAttribute(TEXT("point_time"));
+  FActorVariation PointIntensity = MakePointAttribute(TEXT("point_intensity"));
+  FActorVariation PointRing = MakePointAttribute(TEXT("point_ring"));
 
-  Definition.Variations.Append({Channels, Range, PointsPerSecond, Frequency, UpperFOV, LowerFOV});
+  Definition.Variations.Append({
+    Channels,
+    Range,
+    PointsPerSecond,
+    Frequency,
+    UpperFOV,
+    LowerFOV,
+    PointTime,
+    PointIntensity,
+    PointRing});
 
   Success = CheckActorDefinition(Definition);
 }
@@ -713,6 +734,12 @@ void UActorBlueprintFunctionLibrary::SetLidar(
       RetrieveActorAttributeToFloat("upper_fov", Description.Variations, Lidar.UpperFovLimit);
   Lidar.LowerFovLimit =
       RetrieveActorAttributeToFloat("lower_fov", Description.Variations, Lidar.LowerFovLimit);
+  Lidar.StorePointTime =
+      RetrieveActorAttributeToBool("point_time", Description.Variations, Lidar.StorePointTime);
+  Lidar.StorePointIntensity =
+      RetrieveActorAttributeToBool("point_intensity", Description.Variations, Lidar.StorePointIntensity);
+  Lidar.StorePointRing =
+      RetrieveActorAttributeToBool("point_ring", Description.Variations, Lidar.StorePointRing);
 }
 
 #undef CARLA_ABFL_CHECK_ACTOR
@@ -37,10 +37,10 @@ public:
   ///
   /// @pre This functions needs to be called in the game-thread.
   template <typename SensorT>
-  auto MakeAsyncDataStream(const SensorT &Sensor)
+  auto MakeAsyncDataStream(const SensorT &Sensor, double Timestamp)
   {
     check(Stream.has_value());
-    return FAsyncDataStreamTmpl<T>{Sensor, *Stream};
+    return FAsyncDataStreamTmpl<T>{Sensor, Timestamp, *Stream};
   }
 
   /// Return the token that allows subscribing to this stream.
@@ -39,6 +39,19 @@ struct CARLA_API FLidarDescription
   UPROPERTY(EditAnywhere)
   float LowerFovLimit = -30.0f;
 
+  /// Whether to store the time of each point, in seconds since the beginning
+  /// of the scan.
+  UPROPERTY(EditAnywhere)
+  bool StorePointTime = false;
+
+  /// Whether to store the intensity of each point.
+  UPROPERTY(EditAnywhere)
+  bool StorePointIntensity = false;
+
+  /// Whether to store the ring (index of the laser) of each point.
+  UPROPERTY(EditAnywhere)
+  bool StorePointRing = false;
+
   /// Wether to show debug points of laser hits in simulator.
   UPROPERTY(EditAnywhere)
   bool ShowDebugPoints = false;
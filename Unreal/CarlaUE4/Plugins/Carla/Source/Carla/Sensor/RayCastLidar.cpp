@@ -43,7 +43,20 @@ void ARayCastLidar::Set(const FActorDescription &ActorDescription)
 void ARayCastLidar::Set(const FLidarDescription &LidarDescription)
 {
   Description = LidarDescription;
-  LidarMeasurement = FLidarMeasurement(Description.Channels);
+  uint32 Attributes = 0u;
+  if (Description.StorePointTime)
+  {
+    Attributes |= FLidarMeasurement::Time;
+  }
+  if (Description.StorePointIntensity)
+  {
+    Attributes |= FLidarMeasurement::Intensity;
+  }
+  if (Description.StorePointRing)
+  {
+    Attributes |= FLidarMeasurement::Ring;
+  }
+  LidarMeasurement = FLidarMeasurement(Description.Channels, Attributes);
   CreateLasers();
 }
 
@@ -67,19 +80,22 @@ void ARayCastLidar::Tick(const float DeltaTime)
 {
   Super::Tick(DeltaTime);
 
-  ReadPoints(DeltaTime);
-
   auto DataStream = GetDataStream(*this);
-  DataStream.Send(*this, LidarMeasurement, DataStream.PopBufferFromPool());
+  ReadPoints(DeltaTime, DataStream.PopBufferFromPool());
+  DataStream.Send(*this, LidarMeasurement);
 }
 
-void ARayCastLidar::ReadPoints(const float DeltaTime)
+void ARayCastLidar::ReadPoints(const float DeltaTime, carla::Buffer Buffer)
 {
   const uint32 ChannelCount = Description.Channels;
   const uint32 PointsToScanWithOneLaser =
     FMath::RoundHalfFromZero(
         Description.PointsPerSecond * DeltaTime / float(ChannelCount));
 
+  // Always reset the measurement, even if empty we need to send a valid
+  // header.
+  LidarMeasurement.Reset(ChannelCount * PointsToScanWithOneLaser, std::move(Buffer));
+
   if (PointsToScanWithOneLaser <= 0)
   {
     UE_LOG(
@@ -95,18 +111,18 @@ void ARayCastLidar::ReadPoints(const float DeltaTime)
   const float CurrentHorizontalAngle = LidarMeasurement.GetHorizontalAngle();
   const float AngleDistanceOfTick = Description.RotationFrequency * 360.0f * DeltaTime;
   const float AngleDistanceOfLaserMeasure = AngleDistanceOfTick / PointsToScanWithOneLaser;
-
-  LidarMeasurement.Reset(ChannelCount * PointsToScanWithOneLaser);
+  const float TimeOfLaserMeasure = DeltaTime / PointsToScanWithOneLaser;
 
   for (auto Channel = 0u; Channel < ChannelCount; ++Channel)
   {
     for (auto i = 0u; i < PointsToScanWithOneLaser; ++i)
     {
       FVector Point;
+      float Intensity;
       const float Angle = CurrentHorizontalAngle + AngleDistanceOfLaserMeasure * i;
-      if (ShootLaser(Channel, Angle, Point))
+      if (ShootLaser(Channel, Angle, Point, Intensity))
       {
-        LidarMeasurement.WritePoint(Channel, Point);
+        LidarMeasurement.WritePoint(Channel, Point, TimeOfLaserMeasure * i, Intensity);
       }
     }
   }
@@ -115,7 +131,11 @@ void ARayCastLidar::ReadPoints(const float DeltaTime)
   LidarMeasurement.SetHorizontalAngle(HorizontalAngle);
 }
 
-bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle, FVector &XYZ) const
+bool ARayCastLidar::ShootLaser(
+    const uint32 Channel,
+    const float HorizontalAngle,
+    FVector &XYZ,
+    float &Intensity) const
 {
   const float VerticalAngle = LaserAngles[Channel];
 
@@ -158,6 +178,10 @@ bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle
       );
     }
 
+    // Simple atmospheric attenuation model, distance in meters.
+    constexpr float AttenuationCoefficient = 0.004f;
+    Intensity = FMath::Exp(-AttenuationCoefficient * 1e-2f * HitInfo.Distance);
+
     XYZ = LidarBodyLoc - HitInfo.ImpactPoint;
     XYZ = UKismetMathLibrary::RotateAngleAxis(
       XYZ,
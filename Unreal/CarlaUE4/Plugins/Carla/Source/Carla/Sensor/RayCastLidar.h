@@ -44,11 +44,12 @@ private:
   /// Creates a Laser for each channel.
   void CreateLasers();
 
-  /// Updates LidarMeasurement with the points read in DeltaTime.
-  void ReadPoints(float DeltaTime);
+  /// Updates LidarMeasurement with the points read in DeltaTime, the points
+  /// are written directly into @a Buffer.
+  void ReadPoints(float DeltaTime, carla::Buffer Buffer);
 
   /// Shoot a laser ray-trace, return whether the laser hit something.
-  bool ShootLaser(uint32 Channel, float HorizontalAngle, FVector &Point) const;
+  bool ShootLaser(uint32 Channel, float HorizontalAngle, FVector &Point, float &Intensity) const;
 
   UPROPERTY(EditAnywhere)
   FLidarDescription Description;
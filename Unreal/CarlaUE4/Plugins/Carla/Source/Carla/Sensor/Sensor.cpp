@@ -9,6 +9,7 @@
 
 #include "Carla/Actor/ActorDescription.h"
 #include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
+#include "Carla/Game/CarlaStatics.h"
 
 void ASensor::Set(const FActorDescription &Description)
 {
@@ -26,3 +27,9 @@ void ASensor::EndPlay(EEndPlayReason::Type EndPlayReason)
   Super::EndPlay(EndPlayReason);
   Stream = FDataStream();
 }
+
+double ASensor::GetEpisodeElapsedGameTime() const
+{
+  const auto *Episode = UCarlaStatics::GetCurrentEpisode(this);
+  return Episode != nullptr ? Episode->GetElapsedGameTime() : 0.0;
+}
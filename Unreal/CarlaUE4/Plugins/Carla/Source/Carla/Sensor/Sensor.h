@@ -49,9 +49,13 @@ protected:
   template <typename SensorT>
   FAsyncDataStream GetDataStream(const SensorT &Self)
   {
-    return Stream.MakeAsyncDataStream(Self);
+    return Stream.MakeAsyncDataStream(Self, GetEpisodeElapsedGameTime());
   }
 
+  /// Game seconds since the start of the current episode, used to time-stamp
+  /// the data sent by this sensor.
+  double GetEpisodeElapsedGameTime() const;
+
 private:
 
   FDataStream Stream;
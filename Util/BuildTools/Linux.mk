@@ -59,6 +59,7 @@ check.PythonAPI.3: PythonAPI.3
 benchmark: LibCarla.server
 	@${CARLA_BUILD_TOOLS_FOLDER}/Check.sh --benchmark $(ARGS)
 	@cat profiler.csv
+	@cat $${CARLA_BENCHMARK_OUTPUT:-benchmark_streaming.json}
 
 CarlaUE4Editor: LibCarla.server
 	@${CARLA_BUILD_TOOLS_FOLDER}/BuildCarlaUE4.sh --build